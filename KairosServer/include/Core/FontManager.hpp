@@ -2,6 +2,8 @@
 #pragma once
 
 #include <raylib.h>
+#include <atomic>
+#include <future>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -63,8 +65,10 @@ public:
     FontManager();
     ~FontManager();
     
-    // Initialization
+    // Initialization. System fonts are indexed in the background; lookups
+    // that need the index (findAndLoadFont) wait for it on first use.
     bool initialize();
+    bool isFontIndexReady() const;
     
     // Font loading
     uint32_t loadFont(const std::string& font_path, uint32_t font_size, 
@@ -73,6 +77,9 @@ public:
                                uint32_t font_size, const std::string& font_name);
     bool unloadFont(uint32_t font_id);
     
+    // Reload a file font under the id a previous process gave it
+    bool restoreFont(uint32_t font_id, const std::string& font_path, uint32_t font_size);
+    
     // Font access
     const FontData* getFont(uint32_t font_id) const;
     Font* getRaylibFont(uint32_t font_id);
@@ -100,7 +107,9 @@ public:
 private:
     // Internal management
     void loadDefaultFont();
-    void scanSystemFonts();
+    static std::vector<std::string> scanSystemFonts(const std::vector<std::string>& search_paths);
+    const std::vector<std::string>& getFontIndex() const;   // Blocks until the scan is done
+    size_t getFontIndexSize() const;                        // 0 while the scan is running
     std::string findFontFile(const std::string& family_name, const std::string& style) const;
     void extractFontMetadata(FontData& font_data);
     size_t calculateFontMemoryUsage(const Font& font);
@@ -109,7 +118,7 @@ private:
 
 private:
     std::unordered_map<uint32_t, FontData> m_loaded_fonts;
-    std::vector<std::string> m_available_fonts;
+    std::shared_future<std::vector<std::string>> m_font_index;
     std::vector<std::string> m_font_search_paths;
     
     uint32_t m_default_font_id = 0;
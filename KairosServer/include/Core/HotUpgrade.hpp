@@ -0,0 +1,82 @@
+// KairosServer/include/Core/HotUpgrade.hpp
+#pragma once
+
+#include "InputRouter.hpp"
+#include "NetworkManager.hpp"
+#include "Graphics/SceneState.hpp"
+#include "Network/UnixSocket.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/types.h>
+#endif
+
+namespace Kairos {
+
+/**
+ * @brief Hands a running server over to a freshly exec'd binary (POSIX only)
+ *
+ * The old process spawns the replacement with a control socket
+ * (--takeover-fd). The replacement brings up its window and GL context,
+ * reports ready, and the old process then stops its network threads,
+ * drains its command queue and sends the client sessions (with the routes
+ * of clients attached through proxies), input routing (regions, grabs,
+ * focus and event masks) and scene state followed by the listening and
+ * client sockets (SCM_RIGHTS). Once the new
+ * process acknowledges, the old one exits without closing any connection;
+ * on failure it resumes and the replacement is killed.
+ *
+ * Pixmaps live only in GPU memory and are not part of the scene state, so
+ * the server refuses to upgrade while any client holds one.
+ */
+class HotUpgrade {
+public:
+    struct State {
+        NetworkManager::Handover network;
+        InputRouter::State input;
+        SceneState scene;
+    };
+    
+    static constexpr uint32_t MAGIC = 0x4B555047;       // "KUPG"
+    static constexpr uint32_t FORMAT_VERSION = 3;
+    static constexpr uint32_t ACK_TIMEOUT_MS = 10000;
+
+public:
+    HotUpgrade();
+    ~HotUpgrade();
+    
+    // Old process. command[0] is the binary to exec; --takeover-fd is appended.
+    bool spawnReplacement(const std::vector<std::string>& command);
+    bool isReplacementReady();                          // Non-blocking
+    bool sendState(const State& state);                 // Blocks for the acknowledgement
+    void abort();
+    bool isInProgress() const { return m_child_pid > 0; }
+    
+    // New process
+    bool attach(int control_fd);                        // Reports ready to the old process
+    bool receiveState(State& state);
+    bool acknowledge();
+    
+    static bool isSupported();
+
+private:
+    static void serialize(const State& state, std::vector<uint8_t>& blob, std::vector<int>& fds);
+    static bool deserialize(const std::vector<uint8_t>& blob, const std::vector<int>& fds, State& state);
+    
+    bool sendAll(const void* data, size_t size);
+    bool receiveAll(void* data, size_t size);
+
+private:
+    std::unique_ptr<UnixSocket> m_control;
+#ifndef _WIN32
+    pid_t m_child_pid = -1;
+#else
+    int m_child_pid = -1;
+#endif
+};
+
+} // namespace Kairos
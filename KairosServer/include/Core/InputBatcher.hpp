@@ -0,0 +1,65 @@
+// KairosServer/include/Core/InputBatcher.hpp
+#pragma once
+
+#include <Protocol.hpp>
+#include "InputRouter.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Collects a frame's routed input per client and sends it in one go
+ *
+ * Events queue per client as they are routed; consecutive motion for the
+ * same pointer is folded into the newest event unless the client asked for
+ * motion history. flush() runs once per frame and sends each client either
+ * a single INPUT_BATCH or, for clients that never opted in, one INPUT_EVENT
+ * per remaining event. Events injected from other threads queue too, so
+ * every method locks.
+ */
+class InputBatcher {
+public:
+    struct Stats {
+        uint64_t events_queued = 0;
+        uint64_t events_coalesced = 0;  // Folded into a later event of the same frame
+        uint64_t messages_sent = 0;     // INPUT_EVENT and INPUT_BATCH messages together
+        uint64_t batches_sent = 0;
+    };
+
+    using SendFunction = std::function<bool(uint32_t client_id, const MessageHeader& header, const void* data)>;
+
+public:
+    InputBatcher() = default;
+
+    void add(const InputRouter::Target& target, const InputEvent& event);
+    void flush(uint32_t frame_number, const SendFunction& send);
+    void removeClient(uint32_t client_id);
+
+    Stats getStats() const;
+
+private:
+    struct Pending {
+        std::vector<InputBatchEvent> events;
+        uint8_t delivery_flags = 0;
+        uint16_t coalesced = 0;
+    };
+
+    static bool canCoalesce(const InputEvent& previous, const InputEvent& next);
+    bool sendBatch(uint32_t client_id, uint32_t frame_number, const InputBatchEvent* events, uint16_t count,
+                   uint16_t coalesced, const SendFunction& send);
+
+private:
+    mutable std::mutex m_mutex;
+    Stats m_stats;
+
+    // Entries stay between frames so their vectors keep their capacity
+    std::unordered_map<uint32_t, Pending> m_pending;
+    std::vector<uint8_t> m_buffer;
+};
+
+} // namespace Kairos
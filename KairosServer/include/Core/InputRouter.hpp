@@ -0,0 +1,137 @@
+// KairosServer/include/Core/InputRouter.hpp
+#pragma once
+
+#include <Protocol.hpp>
+#include "Utils/SpatialGrid.hpp"
+
+#include <bitset>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Decides which single client receives each input event
+ *
+ * Clients declare input regions (SET_INPUT_REGION) in canvas coordinates;
+ * they are kept in a spatial grid so a pointer event costs one cell lookup
+ * however many clients and regions there are. Pointer events go to an
+ * explicit pointer grab, else to the client whose press is still held,
+ * else to the topmost region under the pointer. Keyboard events go to the
+ * focused client. An event whose type the target did not select
+ * (SET_INPUT_MASK) is dropped rather than passed to whoever is underneath.
+ * Requests arrive on network threads and routing runs on the render
+ * thread, so every public method locks.
+ */
+class InputRouter {
+public:
+    struct Config {
+        float grid_cell_size = 64.0f;
+        bool click_to_focus = true;     // A press moves keyboard focus unless it is grabbed
+    };
+
+    struct Stats {
+        uint64_t events_routed = 0;
+        uint64_t events_unrouted = 0;   // Nobody under the pointer, or nobody focused
+        uint64_t events_filtered = 0;   // The target's event mask excluded them
+        uint64_t focus_changes = 0;
+        uint32_t regions = 0;
+    };
+
+    struct Target {
+        uint32_t client_id = 0;
+        uint32_t region_id = 0;
+        uint8_t layer_id = 0;
+        uint8_t delivery_flags = 0;     // InputRouting::DELIVER_* chosen by the client
+    };
+
+    // Carried across a hot upgrade. A press held at the time is not: its
+    // implicit grab ends, as the new process saw no button go down.
+    struct State {
+        struct OwnedRegion {
+            uint32_t client_id = 0;
+            InputRegionData region{};
+        };
+        struct OwnedMask {
+            uint32_t client_id = 0;
+            InputMaskData mask{};
+        };
+
+        std::vector<OwnedRegion> regions;   // Oldest first, so stacking ties resolve as before
+        std::vector<OwnedMask> masks;
+        uint32_t pointer_grab = 0;
+        uint32_t focus = 0;
+        bool keyboard_grabbed = false;
+    };
+
+public:
+    explicit InputRouter(const Config& config = Config{});
+
+    // Client requests
+    bool handleRequest(uint32_t client_id, const MessageHeader& header, const std::vector<uint8_t>& data);
+    void setRegion(uint32_t client_id, const InputRegionData& region);
+    void setGrab(uint32_t client_id, const InputGrabData& grab);
+    void setMask(uint32_t client_id, const InputMaskData& mask);
+    void removeClient(uint32_t client_id);
+
+    void exportState(State& state) const;
+    void importState(const State& state);
+
+    // Routing. visible_layers are the layers shown where the event happened
+    // (a viewport's subset minus hidden layers); events from outside every
+    // viewport pass an empty set and only reach grabs.
+    bool route(const InputEvent& event, const std::bitset<256>& visible_layers, Target& target);
+    bool hitTest(float x, float y, const std::bitset<256>& visible_layers, Target& target) const;
+    
+    // Whether the client selected this event type, and how it wants it delivered
+    bool selects(uint32_t client_id, InputEventType type, uint8_t& delivery_flags) const;
+
+    uint32_t getFocusedClient() const;
+    Stats getStats() const;
+
+private:
+    struct Region {
+        uint32_t client_id = 0;
+        uint32_t region_id = 0;
+        uint8_t layer_id = 0;
+        uint64_t order = 0;             // Later regions win ties within a layer
+        SpatialBounds bounds;
+    };
+
+    struct Selection {
+        uint32_t event_mask = InputRouting::EVENT_MASK_ALL;
+        uint8_t delivery_flags = 0;
+    };
+
+    static uint64_t regionKey(uint32_t client_id, uint32_t region_id) {
+        return (static_cast<uint64_t>(client_id) << 32) | region_id;
+    }
+
+    bool hitTestLocked(float x, float y, const std::bitset<256>& visible_layers, Target& target) const;
+    void setFocusLocked(uint32_t client_id);
+    bool selectsLocked(uint32_t client_id, InputEventType type, uint8_t& delivery_flags) const;
+
+private:
+    Config m_config;
+    mutable std::mutex m_mutex;
+    Stats m_stats;
+
+    SpatialGrid<uint64_t> m_grid;
+    std::unordered_map<uint64_t, Region> m_regions;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_client_regions;
+    uint64_t m_next_order = 1;
+    std::unordered_map<uint32_t, Selection> m_selections;   // Only clients that sent SET_INPUT_MASK
+
+    // Pointer
+    uint32_t m_pointer_grab = 0;        // Explicit grab (GRAB_POINTER)
+    Target m_press_target;              // Implicit grab while buttons are held
+    uint32_t m_buttons_down = 0;
+
+    // Keyboard
+    uint32_t m_focus = 0;
+    bool m_keyboard_grabbed = false;
+};
+
+} // namespace Kairos
@@ -3,6 +3,8 @@
 
 #include <Protocol.hpp>
 #include <Graphics/RenderCommand.hpp>
+#include <Utils/Platform.hpp>
+#include <Utils/WakeupEvent.hpp>
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -37,6 +39,7 @@ public:
     ~CommandProcessor();
     
     // Lifecycle
+    void setThreadPolicy(const Platform::ThreadPolicy& policy) { m_thread_policy = policy; }  // Before initialize()
     bool initialize();
     void shutdown();
     
@@ -52,8 +55,6 @@ public:
 private:
     // Internal processing
     void processLayerCommands(uint8_t layer_id, const std::vector<const RenderCommand*>& commands);
-    void processBatchedTexturedQuads(uint8_t layer_id, const std::vector<const RenderCommand*>& commands);
-    void processBatchedText(uint8_t layer_id, const std::vector<const RenderCommand*>& commands);
     
     // Threading
     void processingLoop();
@@ -67,6 +68,8 @@ private:
     std::unique_ptr<RenderCommandQueue> m_command_queue;
     std::thread m_processing_thread;
     std::atomic<bool> m_stop_processing{false};
+    WakeupEvent m_wakeup;                           // Signaled on enqueue and shutdown
+    Platform::ThreadPolicy m_thread_policy;
     
     Stats m_stats;
 };
@@ -78,12 +81,28 @@ class CommandConverter {
 public:
     static RenderCommand fromNetworkMessage(const MessageHeader& header, const void* data);
     static std::vector<RenderCommand> fromNetworkBatch(const std::vector<uint8_t>& buffer);
+    static bool canConvert(MessageType type);  // Keep in sync with fromNetworkMessage()
     
     // Convert specific command types
     static RenderCommand fromDrawPointData(const DrawPointData& data, uint8_t layer_id);
     static RenderCommand fromDrawLineData(const DrawLineData& data, uint8_t layer_id);
     static RenderCommand fromDrawRectangleData(const DrawRectangleData& data, uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawArcData(const DrawArcData& data, uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawPolygonData(const DrawPolygonData& data, const Point* points,
+                                            uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawRoundedRectangleData(const DrawRoundedRectangleData& data,
+                                                     uint8_t layer_id, bool filled);
+    static RenderCommand fromFillGradientData(const FillGradientData& data, uint8_t layer_id);
+    static RenderCommand fromDrawSpritesInstancedData(const DrawSpritesInstancedData& data,
+                                                     const SpriteInstance* instances, uint8_t layer_id);
     static RenderCommand fromDrawTextData(const DrawTextData& data, const std::string& text, uint8_t layer_id);
+    static RenderCommand fromLayerTransformData(const LayerTransformData& data, uint8_t layer_id);
+    static RenderCommand fromClipRectData(const ClipRectData& data, uint8_t layer_id);
+    static RenderCommand fromCreatePixmapData(const CreatePixmapData& data, uint8_t layer_id);
+    static RenderCommand fromPixmapTargetData(const PixmapTargetData& data, uint8_t layer_id);
+    static RenderCommand fromCopyAreaData(const CopyAreaData& data, uint8_t layer_id);
+    static RenderCommand fromObjectData(const ObjectData& data, uint8_t layer_id);
+    static RenderCommand fromObjectUpdateData(const ObjectUpdateData& data, uint8_t layer_id);
     static RenderCommand fromDrawTexturedQuadsData(const DrawTexturedQuadsData& data, 
                                                   const std::vector<TexturedVertex>& vertices, uint8_t layer_id);
     
@@ -4,6 +4,9 @@
 #include "KairosShared/Protocol.hpp"
 #include "Network/Client.hpp"
 #include "Graphics/RenderCommand.hpp"
+#include "Utils/Platform.hpp"
+#include "Utils/SnapshotStore.hpp"
+#include "Utils/WakeupEvent.hpp"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -67,6 +70,9 @@ public:
         bool use_non_blocking_sockets = true;
         bool enable_tcp_nodelay = true;
         bool enable_keepalive = true;
+        Platform::ThreadPolicy accept_thread_policy;
+        Platform::ThreadPolicy network_thread_policy;
+        bool fixed_buffers = false;                 // Real-time: client buffers never grow
         
         // Security
         bool require_handshake = true;
@@ -81,6 +87,7 @@ public:
         std::atomic<uint32_t> total_connections{0};
         std::atomic<uint32_t> failed_connections{0};
         std::atomic<uint32_t> timed_out_connections{0};
+        std::atomic<uint32_t> virtual_clients{0};       // Attached through proxy connections
         
         // Message stats
         std::atomic<uint64_t> messages_received{0};
@@ -88,10 +95,12 @@ public:
         std::atomic<uint64_t> bytes_received{0};
         std::atomic<uint64_t> bytes_sent{0};
         std::atomic<uint32_t> invalid_messages{0};
+        std::atomic<uint64_t> proxy_frames{0};
         
         // Performance stats
         std::atomic<uint32_t> queued_commands{0};
         std::atomic<uint32_t> dropped_commands{0};
+        std::atomic<uint64_t> backpressure_waits{0};   // Iterations that left clients unread
         std::atomic<uint32_t> processed_commands{0};
         double avg_message_processing_time_us = 0.0;
         double avg_network_latency_ms = 0.0;
@@ -107,6 +116,25 @@ public:
     using ClientDisconnectedCallback = std::function<void(uint32_t client_id, const std::string& reason)>;
     using CommandReceivedCallback = std::function<void(uint32_t client_id, RenderCommand&& command)>;
     using ErrorCallback = std::function<void(const std::string& error_message, uint32_t client_id)>;
+    using BackpressureCallback = std::function<bool()>;     // true: stop reading from clients for now
+    using InputRequestCallback = std::function<bool(uint32_t client_id, const MessageHeader& header,
+                                                    const std::vector<uint8_t>& data)>;
+    
+    // Listening sockets and client sessions passed to a replacement process,
+    // with the routes of clients attached through handed-over proxies
+    struct Handover {
+        struct VirtualRoute {
+            uint32_t client_id = 0;
+            uint32_t proxy_id = 0;
+            uint32_t virtual_id = 0;
+        };
+        
+        uint32_t next_client_id = 1;
+        int tcp_socket = -1;
+        int unix_socket = -1;
+        std::vector<Client::Session> clients;
+        std::vector<VirtualRoute> virtual_clients;
+    };
 
 public:
     explicit NetworkManager(const Config& config = Config{});
@@ -117,6 +145,15 @@ public:
     void shutdown();
     bool isRunning() const { return m_running; }
     
+    // Hot upgrade. suspend() stops the network threads but keeps every socket
+    // open; after exportHandover() either resume() (handover failed) or
+    // releaseHandedOver() (the new process owns the sockets now).
+    bool initializeFromHandover(const Handover& handover);
+    bool suspend();
+    void resume();
+    Handover exportHandover() const;
+    void releaseHandedOver();
+    
     // Server management
     bool startTcpServer();
     bool startUnixSocketServer();
@@ -127,6 +164,10 @@ public:
     bool disconnectClient(uint32_t client_id, const std::string& reason = "Server request");
     std::shared_ptr<Client> getClient(uint32_t client_id) const;
     
+    // Adopt an already connected stream socket (e.g. one end of a socketpair).
+    // The peer must have sent CLIENT_HELLO first: the handshake runs inline.
+    bool adoptClient(int socket, const std::string& endpoint);
+    
     // Message sending
     bool sendMessage(uint32_t client_id, const MessageHeader& header, const void* data = nullptr);
     bool broadcastMessage(const MessageHeader& header, const void* data = nullptr);
@@ -142,9 +183,12 @@ public:
     bool sendPing(uint32_t client_id);
     void handlePong(uint32_t client_id, const PongData& pong_data);
     
-    // Configuration
+    // Configuration. While running, limits, timeouts and rate limiting are
+    // published to the network threads (picked up on their next iteration);
+    // listeners, buffers and thread count keep their startup values.
     void setConfig(const Config& config);
     const Config& getConfig() const { return m_config; }
+    Config getLiveConfig() const { return *m_live_config.read(); }
     
     // Statistics
     const Stats& getStats() const { return m_stats; }
@@ -155,10 +199,18 @@ public:
     void setClientDisconnectedCallback(ClientDisconnectedCallback callback);
     void setCommandReceivedCallback(CommandReceivedCallback callback);
     void setErrorCallback(ErrorCallback callback);
+    void setBackpressureCallback(BackpressureCallback callback);
+    void setInputRequestCallback(InputRequestCallback callback);    // SET_INPUT_REGION, SET_INPUT_GRAB
+    
+    // Wakes the network threads, e.g. once the backpressured queue has room again
+    void wakeup();
 
 private:
     // Network thread management
-    void networkThreadMain();
+    void startThreads();
+    void wakeAllThreads();
+    void networkThreadMain(uint32_t index);
+    void waitForActivity(WakeupEvent& wakeup, const std::vector<std::shared_ptr<Client>>& clients);
     void clientHandlerThread(std::shared_ptr<Client> client);
     
     // Socket management
@@ -169,13 +221,15 @@ private:
     std::shared_ptr<Client> acceptUnixConnection();
     
     // Client lifecycle
+    bool handleNewClient(std::shared_ptr<Client> client);
     bool handleClientHandshake(std::shared_ptr<Client> client);
-    void processClientMessages(std::shared_ptr<Client> client);
+    void processClientMessages(std::shared_ptr<Client> client, const Config& config);
     void cleanupClient(uint32_t client_id);
+    void cleanupDisconnectedClients();
     
     // Message processing
     bool processMessage(std::shared_ptr<Client> client, const MessageHeader& header, 
-                       const std::vector<uint8_t>& data);
+                       const std::vector<uint8_t>& data, const Config& config);
     RenderCommand convertMessageToCommand(const MessageHeader& header, const std::vector<uint8_t>& data);
     
     // Protocol handlers
@@ -183,12 +237,20 @@ private:
     void handlePing(std::shared_ptr<Client> client, const PingData& ping);
     void handleDisconnect(std::shared_ptr<Client> client);
     
+    // Virtual clients multiplexed over proxy connections (Capabilities::PROXY)
+    void handleProxyAttach(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data);
+    void handleProxyDetach(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data);
+    bool handleProxyFrame(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data, const Config& config);
+    bool sendToVirtualClient(uint32_t client_id, const MessageHeader& header, const void* data);
+    bool detachVirtualClient(uint32_t client_id, const std::string& reason);
+    void detachProxyClients(uint32_t proxy_id);
+    
     // Rate limiting
-    bool checkRateLimit(uint32_t client_id);
-    void updateRateLimits();
+    bool checkRateLimit(uint32_t client_id, const Config& config);
+    void updateRateLimits(const Config& config);
     
     // Validation
-    bool validateMessage(const MessageHeader& header, const std::vector<uint8_t>& data);
+    bool validateMessage(const MessageHeader& header, const std::vector<uint8_t>& data, const Config& config);
     bool validateClient(uint32_t client_id) const;
     
     // Utilities
@@ -199,11 +261,19 @@ private:
 
 private:
     Config m_config;
+    SnapshotStore<Config> m_live_config;    // Read by network/accept threads at safe points
     Stats m_stats;
     
     std::atomic<bool> m_running{false};
     std::atomic<bool> m_accepting_connections{false};
     
+    // Threads sleep in poll()/select() on their sockets plus one of these
+    std::vector<std::unique_ptr<WakeupEvent>> m_network_wakeups;
+    WakeupEvent m_accept_wakeup;
+    static constexpr int HOUSEKEEPING_INTERVAL_MS = 250;   // Pings, timeouts, rate limit windows
+    bool m_suspended = false;
+    bool m_handed_over = false;     // Sockets belong to another process: close, never unlink
+    
     // Network threads
     std::vector<std::thread> m_network_threads;
     std::thread m_accept_thread;
@@ -217,6 +287,16 @@ private:
     mutable std::mutex m_clients_mutex;
     std::atomic<uint32_t> m_next_client_id{1};
     
+    // Virtual clients get ids from the same sequence; a proxy's virtual id
+    // only means something on that proxy's connection
+    struct VirtualClient {
+        uint32_t proxy_id = 0;
+        uint32_t virtual_id = 0;
+    };
+    std::unordered_map<uint32_t, VirtualClient> m_virtual_clients;     // Client id -> route
+    std::unordered_map<uint64_t, uint32_t> m_virtual_routes;           // proxy id << 32 | virtual id -> client id
+    mutable std::mutex m_virtual_clients_mutex;
+    
     // Rate limiting
     struct RateLimitInfo {
         uint32_t command_count = 0;
@@ -231,6 +311,8 @@ private:
     ClientDisconnectedCallback m_client_disconnected_callback;
     CommandReceivedCallback m_command_received_callback;
     ErrorCallback m_error_callback;
+    BackpressureCallback m_backpressure_callback;
+    InputRequestCallback m_input_request_callback;
     
     // Performance tracking
     std::chrono::steady_clock::time_point m_last_stats_update;
@@ -2,15 +2,23 @@
 #pragma once
 
 #include <raylib.h>
+#include <bitset>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <functional>
 
 #include "KairosShared/Protocol.hpp"
 #include "Graphics/RenderCommand.hpp"
 #include "Graphics/BatchRenderer.hpp"
+#include "Graphics/PrimitiveRenderer.hpp"
+#include "Graphics/OutputViewport.hpp"
+#include "Graphics/SceneState.hpp"
+#include "Graphics/LayerIndex.hpp"
+#include "Graphics/LayerTransform.hpp"
+#include "Graphics/SceneObjects.hpp"
 #include "Utils/Logger.hpp"
 
 namespace Kairos {
@@ -39,6 +47,7 @@ public:
         uint32_t msaa_samples = 4;
         bool fullscreen = false;
         bool hidden = false;          // For headless mode
+        bool null_backend = false;    // No window/GL: commands are counted, not drawn
         std::string window_title = "Kairos Graphics Server";
         
         // Performance settings
@@ -49,6 +58,21 @@ public:
         // Layer settings
         uint32_t max_layers = 255;
         bool layer_caching = true;
+        bool retain_scene = false;    // Keep per-layer commands and texture hashes for snapshots
+        uint32_t transform_settle_ms = 150;   // Unchanged this long, a re-rasterizing layer transform is baked
+        
+        // Multi-viewport output. With viewports, layers are drawn into
+        // canvas-sized caches and each viewport composites its own subset;
+        // needs layer_caching. Without, the canvas fills the window.
+        uint32_t canvas_width = 0;    // 0: window size
+        uint32_t canvas_height = 0;
+        std::vector<OutputViewport> viewports;
+        
+        // Real-time mode
+        bool fixed_pools = false;     // Batch groups prefaulted to their maxima; never grown
+        uint32_t max_batch_groups = 64;
+        uint32_t max_textures = 0;    // 0: unlimited
+        uint32_t max_pixmap_memory_mb = 256;    // All pixmaps together; 0: unlimited
     };
 
     struct Stats {
@@ -57,6 +81,12 @@ public:
         uint64_t vertices_rendered = 0;
         uint64_t draw_calls_issued = 0;
         uint64_t textures_uploaded = 0;
+        uint64_t pool_overflows = 0;  // Fixed pools: early flushes, refused draws and uploads
+        uint64_t commands_culled = 0; // Retained commands skipped as outside every visible region
+        uint64_t layers_rerasterized = 0; // Layer caches redrawn at a settled transform
+        uint64_t commands_clipped = 0; // Drawing skipped as wholly outside its clip
+        uint64_t areas_copied = 0;    // COPY_AREAs carried out
+        uint64_t objects_drawn = 0;   // Retained objects drawn, counted each frame
         
         float current_fps = 0.0f;
         float avg_frame_time_ms = 0.0f;
@@ -65,6 +95,10 @@ public:
         uint32_t active_layers = 0;
         uint32_t cached_layers = 0;
         uint32_t memory_usage_mb = 0;
+        uint32_t pixmaps = 0;
+        uint64_t pixmap_bytes = 0;
+        uint32_t objects = 0;
+        uint32_t object_tweens = 0;   // Running at the frame's start
         
         std::atomic<uint32_t> queued_commands{0};
         std::atomic<uint32_t> batched_draws{0};
@@ -84,8 +118,9 @@ public:
     void endFrame();
     bool shouldClose() const;
 
-    // Command processing
-    void processCommand(const RenderCommand& command);
+    // Command processing: the one dispatch for live and replayed commands,
+    // retaining what is drawn (retain_scene). False for an unknown type.
+    bool processCommand(const RenderCommand& command);
     void processCommands(const std::vector<RenderCommand>& commands);
     void flushBatches();
 
@@ -94,6 +129,56 @@ public:
     void clearAllLayers();
     void setLayerVisibility(uint8_t layer_id, bool visible);
     void setLayerBlendMode(uint8_t layer_id, int blend_mode);
+    
+    // Cached layers are composited through the transform, stretching their
+    // pixels; with rerasterize the cache is redrawn at the transform once it
+    // has not changed for transform_settle_ms (needs retain_scene). Direct
+    // draws are transformed per vertex.
+    void setLayerTransform(uint8_t layer_id, const LayerTransform& transform, bool rerasterize = false);
+    LayerTransform getLayerTransform(uint8_t layer_id) const;
+    
+    // Clip stacks (PUSH_CLIP / POP_CLIP), per client and layer; rectangles
+    // in layer coordinates, each intersected with the one below it
+    void pushClip(uint32_t client_id, uint8_t layer_id, const SpatialBounds& rect);
+    void popClip(uint32_t client_id, uint8_t layer_id);
+    bool hasClips(uint8_t layer_id) const;
+    void removeClient(uint32_t client_id);    // Any thread; takes effect at the next beginFrame()
+    
+    // Pixmaps: offscreen RGBA targets drawn as textures under their id.
+    // Creating an existing one resizes it, keeping its pixels. Only the
+    // creating client resizes, frees or draws into one, and its pixmaps are
+    // freed when it disconnects.
+    bool createPixmap(uint32_t client_id, uint32_t pixmap_id, uint32_t width, uint32_t height);
+    bool freePixmap(uint32_t client_id, uint32_t pixmap_id);
+    
+    // The client's later drawing goes to the pixmap, in its coordinates and
+    // without layer transform or camera (dropped while the pixmap does not
+    // exist); 0 draws to the layers again. Each command drawn into a pixmap
+    // is flushed on its own, after what was batched before it.
+    void setPixmapTarget(uint32_t client_id, uint32_t pixmap_id, bool clear);
+    bool hasPixmapTargets() const { return !m_pixmap_targets.empty(); }
+    
+    // COPY_AREA: moves pixels within what the client draws to (its pixmap
+    // target, else the layer), in the target's pixels; the rectangles may
+    // overlap. Layers keep their pixels from frame to frame only in
+    // viewport mode: a frame whose first use of a layer is a copy keeps
+    // them, so the client draws just what the copy exposed.
+    void copyArea(uint32_t client_id, uint8_t layer_id, int src_x, int src_y, uint32_t width, uint32_t height,
+                  int dst_x, int dst_y);
+    
+    // Retained objects (CREATE_OBJECT / UPDATE_OBJECT / DELETE_OBJECT):
+    // drawn at composition, over their layer's pixels and under the layers
+    // above, through the layer's transform and the camera but no clip. Tweens
+    // are evaluated at each frame's start; updates start theirs at it too.
+    void createObject(const RenderCommand& command);
+    void updateObject(const RenderCommand& command);
+    void deleteObject(uint32_t client_id, uint32_t object_id);
+    
+    // Draw state for one command, for callers issuing its draw calls
+    // themselves: the layer's transform and the sender's clip. False when
+    // the clip hides the command entirely; otherwise call endCommand() after.
+    bool beginCommand(const RenderCommand& command);
+    void endCommand();
 
     // Resource management
     uint32_t uploadTexture(uint32_t texture_id, uint32_t width, uint32_t height,
@@ -114,26 +199,66 @@ public:
                       const Color& color, bool filled = true, uint8_t layer_id = 0);
     void drawCircle(const Point& center, float radius, const Color& color,
                    bool filled = true, uint8_t layer_id = 0);
+    void drawArc(const Point& center, float radius_x, float radius_y, float start_angle, float end_angle,
+                const Color& color, bool filled = true, uint8_t layer_id = 0);
+    void drawPolygon(const std::vector<Point>& points, const Color& color, bool filled = true,
+                    bool known_convex = false, uint8_t layer_id = 0);
+    void drawRoundedRectangle(const Point& position, float width, float height, const float radii[4],
+                             const Color& color, bool filled = true, uint8_t layer_id = 0);
+    void fillGradient(const Point& position, float width, float height, uint8_t shape,
+                     const PrimitiveRenderer::Gradient& gradient, uint8_t layer_id = 0);
     void drawText(const std::string& text, const Point& position, uint32_t font_id,
                  float font_size, const Color& color, uint8_t layer_id = 0);
     void drawTexturedQuads(const std::vector<TexturedVertex>& vertices, uint32_t texture_id,
                           uint8_t layer_id = 0);
+    void drawSprites(const std::vector<SpriteInstance>& instances, uint32_t texture_id, uint8_t layer_id = 0);
 
     // Viewport and transforms
     void setViewport(int x, int y, int width, int height);
     void setCamera2D(const Vector2& target, const Vector2& offset, float rotation, float zoom);
     void resetCamera2D();
+    uint32_t getCanvasWidth() const;
+    uint32_t getCanvasHeight() const;
+    bool usesViewports() const;
 
     // Performance and debugging
     const Stats& getStats() const { return m_stats; }
     void resetStats();
     
+    // Frame readback: the next endFrame() copies the composed frame before presenting
+    void requestFrameCapture();
+    bool takeCapturedFrame(Image& image);  // Caller owns the image (UnloadImage)
+    
     // Configuration
     void setConfig(const Config& config);
     const Config& getConfig() const { return m_config; }
     
+    // Retained state (layer caches and textures) for handover and snapshots.
+    // Texture pixels are read back from the GPU, so call on the render thread;
+    // wants_pixels limits the readback to textures it returns true for.
+    using TextureFilter = std::function<bool(const SceneState::Texture& texture)>;
+    void exportScene(SceneState& scene, const TextureFilter& wants_pixels = nullptr);
+    bool importScene(const SceneState& scene);
+    
     // Events
     void handleWindowResize(int width, int height);
+    
+    // Input, in window coordinates: what changed since the previous call
+    // (endFrame() polls the window system). Call on the render thread.
+    void pollInput(std::vector<InputEvent>& events);
+    
+    // Window position to canvas position, plus the layers visible there
+    // (the viewport's subset minus hidden layers); false outside every viewport
+    bool windowToCanvas(const Point& window_position, Point& canvas_position,
+                        std::bitset<256>& visible_layers) const;
+    
+    // Retained commands (retain_scene) of a layer that may touch a canvas
+    // rectangle or point, in draw order; answered from the layer's index.
+    // Call on the render thread; the pointers last until the layer changes.
+    size_t queryLayer(uint8_t layer_id, const SpatialBounds& rect,
+                      std::vector<const RenderCommand*>& commands) const;
+    size_t pickLayer(uint8_t layer_id, const Point& canvas_position,
+                     std::vector<const RenderCommand*>& commands) const;
 
 private:
     // Internal rendering methods
@@ -145,7 +270,7 @@ private:
     // Resource management internals
     void initializeDefaultResources();
     void cleanupResources();
-    uint32_t generateResourceId();
+    uint32_t generateResourceId();    // Under m_resource_mutex
 
     // Batch management
     struct BatchGroup {
@@ -153,6 +278,7 @@ private:
         Color tint_color = {255, 255, 255, 255};
         std::vector<TexturedVertex> vertices;
         uint8_t layer_id = 0;
+        uint16_t clip_id = 0;         // Index into m_clip_rects plus one; 0: unclipped
         bool needs_flush = false;
         
         void clear() {
@@ -167,7 +293,11 @@ private:
 
     void addToBatch(uint32_t texture_id, const std::vector<TexturedVertex>& vertices,
                    const Color& tint, uint8_t layer_id);
+    void addToFixedBatch(uint32_t texture_id, const std::vector<TexturedVertex>& vertices,
+                         const Color& tint, uint8_t layer_id);
+    void prefaultBatchGroups();
     void flushBatch(BatchGroup& batch);
+    void flushPrimitiveBatches();
 
     // Layer rendering with caching
     struct LayerCache {
@@ -176,12 +306,72 @@ private:
         bool is_visible = true;
         int blend_mode = BLEND_ALPHA;
         std::vector<RenderCommand> commands;
+        LayerIndex index;             // Over commands, by position in the list
         uint64_t last_update_frame = 0;
+        bool replay = false;          // Restored: redrawn every frame until the layer gets new commands
+        LayerTransform rasterized;    // Transform the pixels were drawn at
+        bool rerasterize = false;     // Viewport mode: redraw from the retained commands this frame
+    };
+    
+    struct LayerTransformState {
+        LayerTransform transform;
+        bool pending_bake = false;
+        std::chrono::steady_clock::time_point changed_at;
     };
 
     LayerCache* getOrCreateLayerCache(uint8_t layer_id);
-    void renderToLayerCache(LayerCache& cache);
+    void renderToLayerCache(uint8_t layer_id, LayerCache& cache);
     void compositeLayerCaches();
+    void compositeViewports();
+    LayerCache* beginLayerTarget(uint8_t layer_id);    // Viewport mode: draw into the layer's cache
+    void endLayerTarget(LayerCache* target);
+    void retainCommand(const RenderCommand& command);
+    void replayRestoredLayers();
+    void drawRetainedCommands(uint8_t layer_id, const LayerCache& cache);
+    void visibleCanvasRegions(uint8_t layer_id, std::vector<SpatialBounds>& regions) const;
+    
+    // Layer transforms
+    const LayerTransform& layerTransform(uint8_t layer_id) const;
+    const LayerTransform& rasterTransform(uint8_t layer_id, const LayerCache& cache) const;
+    const LayerTransform* directTransform(uint8_t layer_id) const;   // Null when none applies
+    void bakeSettledTransforms();
+    void drawLayerTexture(const LayerCache& cache, uint8_t layer_id, const Rectangle& source, const Rectangle& dest);
+    
+    // Clipping
+    struct ClipStack {
+        std::vector<SpatialBounds> rects;
+        uint32_t ignored = 0;         // Pushes refused past Limits::MAX_CLIP_DEPTH, popped first
+    };
+    
+    static uint64_t clipKey(uint32_t client_id, uint8_t layer_id) {
+        return (static_cast<uint64_t>(client_id) << 8) | layer_id;
+    }
+    uint16_t clipId(const SpatialBounds& rect);
+    void applyClip(uint16_t clip_id);
+    
+    // Pixmaps
+    struct Pixmap {
+        RenderTexture2D target = {0};
+        uint32_t owner = 0;           // Creating client
+        uint64_t bytes = 0;
+    };
+    
+    bool isPixmap(uint32_t texture_id) const;
+    void flushBatchesUsing(uint32_t texture_id);
+    
+    // Batched draws (tessellated primitives or textured quads) land at their
+    // flush, immediate ones (None) now: a draw of another kind than what is
+    // batched flushes it first, keeping the order commands were sent in
+    enum class DrawKind : uint8_t { None, Primitive, Textured };
+    DrawKind orderDraw(RenderCommand::Type type);
+    void endTextureTarget();      // EndTextureMode(), then the window's camera again
+    void copyPixels(const RenderTexture2D& target, int src_x, int src_y, int width, int height,
+                    int dst_x, int dst_y);
+    
+    // Retained objects, drawn immediately under to_window (layer to window
+    // pixels, on top of the current modelview) times the layer's transform
+    void drawObjects(uint8_t layer_id, const LayerTransform& to_window);
+    void drawObject(const SceneObjects::Object& object);
 
 private:
     Config m_config;
@@ -198,10 +388,43 @@ private:
     std::unordered_map<uint32_t, Texture2D> m_textures;
     std::unordered_map<uint32_t, Font> m_fonts;
     std::unordered_map<uint8_t, LayerCache> m_layer_caches;
+    std::unordered_map<uint32_t, uint64_t> m_texture_hashes;   // Upload content, when retaining the scene
+    bool m_replaying = false;
+    std::vector<SpatialBounds> m_visible_regions;   // Reused by drawRetainedCommands
+    std::vector<uint32_t> m_visible_commands;
+    std::vector<uint32_t> m_region_commands;
+    std::bitset<256> m_layers_drawn;    // Viewport mode: layer caches cleared and drawn this frame
+    std::unordered_map<uint8_t, LayerTransformState> m_layer_transforms;
+    bool m_in_layer_target = false;     // Drawing into a layer cache rather than the window
+    bool m_target_transformed = false;  // beginLayerTarget() pushed a transform
+    bool m_command_transformed = false; // beginCommand() pushed a transform
+    LayerCache* m_command_target = nullptr; // Viewport mode: beginCommand() bound the layer's cache
+    DrawKind m_batched_kind = DrawKind::None;   // What the pending batches hold
+    
+    // Clip stacks by clipKey(), and the clip rectangles batched this frame
+    std::unordered_map<uint64_t, ClipStack> m_clip_stacks;
+    std::vector<SpatialBounds> m_clip_rects;
+    uint16_t m_current_clip = 0;
+    std::vector<uint32_t> m_removed_clients;    // Guarded by m_resource_mutex
+    
+    // Pixmaps by id (guarded by m_resource_mutex, as their textures are in
+    // m_textures), the pixmap each client draws into, and the one the
+    // current command draws into
+    std::unordered_map<uint32_t, Pixmap> m_pixmaps;
+    std::unordered_map<uint32_t, uint32_t> m_pixmap_targets;
+    uint32_t m_drawing_pixmap = 0;
+    
+    // Copies go through this, grown to the largest copied so far
+    RenderTexture2D m_copy_scratch = {0};
+    bool m_copy_area_warned = false;
+    
+    SceneObjects m_objects;
     
     // Batching system
     std::vector<BatchGroup> m_batch_groups;
     std::mutex m_batch_mutex;
+    std::vector<TexturedVertex> m_sprite_vertices;  // Instanced sprites expanded, reused between calls
+    std::unique_ptr<PrimitiveRenderer> m_primitive_renderer;   // Tessellated arcs, polygons, rounded shapes, gradients
     
     // Resource ID generation
     std::atomic<uint32_t> m_next_resource_id{1};
@@ -215,6 +438,14 @@ private:
     std::chrono::steady_clock::time_point m_last_fps_update;
     uint32_t m_frame_count_for_fps = 0;
     
+    // Input polling
+    Vector2 m_last_mouse_position = {-1.0f, -1.0f};
+    std::vector<int> m_keys_down;
+    
+    // Frame readback
+    bool m_capture_requested = false;
+    Image m_captured_frame = {0};
+    
     // Thread safety
     mutable std::mutex m_resource_mutex;
     mutable std::mutex m_stats_mutex;
@@ -0,0 +1,79 @@
+// KairosServer/include/Core/SceneSnapshot.hpp
+#pragma once
+
+#include "Graphics/SceneState.hpp"
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace Kairos {
+
+/**
+ * @brief Periodic on-disk snapshot of the retained scene, restored at startup
+ *
+ * The snapshot file holds a checksummed, versioned SceneState without
+ * texture pixels. Pixels live next to it in <file>.textures/, one file per
+ * content hash, so a texture is read back and written once no matter how
+ * many snapshots reference it. Files are written through a mapping and
+ * renamed into place; the file write runs on a background thread, while the
+ * scene export (GPU readback) stays on the render thread with the caller.
+ */
+class SceneSnapshot {
+public:
+    struct Config {
+        std::string path;
+        uint32_t interval_ms = 5000;
+    };
+    
+    struct Stats {
+        uint64_t snapshots_written = 0;
+        uint64_t textures_written = 0;
+        size_t last_size_bytes = 0;
+        double last_write_ms = 0.0;
+    };
+    
+    static constexpr uint32_t MAGIC = 0x4B534E50;       // "KSNP"
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+public:
+    explicit SceneSnapshot(const Config& config);
+    ~SceneSnapshot();   // Waits for a pending write
+    
+    SceneSnapshot(const SceneSnapshot&) = delete;
+    SceneSnapshot& operator=(const SceneSnapshot&) = delete;
+    
+    // Writing
+    bool isDue() const;                                 // Interval elapsed and no write pending
+    bool hasTexture(uint64_t content_hash) const;       // Pixels already on disk
+    void write(SceneState scene);                       // Returns once the write is queued
+    bool writeNow(SceneState scene);                    // Blocks (e.g. at shutdown)
+    
+    // Restoring
+    bool load(SceneState& scene);
+    
+    void setInterval(uint32_t interval_ms) { m_config.interval_ms = interval_ms; }
+    const Config& getConfig() const { return m_config; }
+    Stats getStats() const;
+
+private:
+    bool writeFiles(SceneState& scene);
+    void removeUnreferencedTextures(const std::unordered_set<uint64_t>& referenced);
+    std::string texturePath(uint64_t content_hash) const;
+    void waitForPendingWrite();
+
+private:
+    Config m_config;
+    std::string m_texture_dir;
+    
+    std::chrono::steady_clock::time_point m_last_write;
+    std::future<bool> m_pending_write;
+    
+    mutable std::mutex m_mutex;                         // Guards the members below
+    std::unordered_set<uint64_t> m_stored_textures;
+    Stats m_stats;
+};
+
+} // namespace Kairos
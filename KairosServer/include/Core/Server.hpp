@@ -6,9 +6,15 @@
 #include "CommandProcessor.hpp"
 #include "LayerManager.hpp"
 #include "FontManager.hpp"
+#include "HotUpgrade.hpp"
+#include "InputRouter.hpp"
+#include "InputBatcher.hpp"
+#include "SceneSnapshot.hpp"
 #include "Graphics/RenderCommand.hpp"
 #include "Utils/Config.hpp"
+#include "Utils/ConfigWatcher.hpp"
 #include "Utils/Logger.hpp"
+#include "Utils/SnapshotStore.hpp"
 
 #include <memory>
 #include <thread>
@@ -16,6 +22,7 @@
 #include <chrono>
 #include <queue>
 #include <unordered_map>
+#include <functional>
 
 namespace Kairos {
 
@@ -90,6 +97,10 @@ public:
         std::chrono::steady_clock::time_point start_time;
         std::atomic<uint64_t> uptime_seconds{0};
         
+        // Startup latency (real time since initialize())
+        std::atomic<uint32_t> startup_accept_ms{0};
+        std::atomic<uint32_t> startup_first_frame_ms{0};
+        
         // Frame statistics
         std::atomic<uint64_t> frames_rendered{0};
         std::atomic<uint64_t> frames_dropped{0};
@@ -124,6 +135,19 @@ public:
         std::atomic<uint32_t> protocol_errors{0};
     };
     
+    /**
+     * @brief Timing of one completed frame, delivered to the frame observer
+     */
+    struct FrameSample {
+        uint64_t frame_number = 0;
+        std::chrono::microseconds frame_time{0};     // Whole frame, including pacing
+        std::chrono::microseconds work_time{0};      // Frame time before pacing
+        // Receive -> processed latency of every command handled this frame
+        const std::vector<uint32_t>* command_latencies_us = nullptr;
+    };
+    
+    using FrameObserver = std::function<void(const FrameSample& sample)>;
+    
     enum class State {
         STOPPED,
         INITIALIZING,
@@ -147,10 +171,23 @@ public:
     bool isRunning() const { return m_state.load() == State::RUNNING; }
     std::string getStateString() const;
     
-    // Configuration
+    // Configuration. While running, reloads publish a new snapshot that the
+    // main loop applies at the next frame start; settings that need a new
+    // window, listener or thread keep their startup values until restart.
     void setConfig(const Config& config);
     const Config& getConfig() const { return m_config; }
     bool reloadConfig(const std::string& config_file = "");
+    void setConfigFile(const std::string& config_file, bool watch = false);  // Set before run()
+    void setConfigOverrides(std::function<void(Kairos::Config&)> overrides);  // Re-applied over every reloaded file
+    void requestConfigReload();                      // Signal-safe; reloads the config file next frame
+    uint64_t getConfigVersion() const { return m_live_config.getVersion(); }
+    
+    // Hot upgrade (POSIX). The upgrade command is this binary's command line;
+    // a takeover fd makes initialize() adopt a running server's state.
+    // Pixmap contents are not handed over, so it is refused while any exist.
+    void setUpgradeCommand(const std::vector<std::string>& command);
+    void setTakeoverFd(int control_fd);              // Set before initialize()
+    void requestHotUpgrade();                        // Signal-safe; SIGUSR2
     
     // Statistics and monitoring
     const Stats& getStats() const { return m_stats; }
@@ -161,6 +198,7 @@ public:
     // Client management (forwarded to NetworkManager)
     std::vector<uint32_t> getConnectedClients() const;
     bool disconnectClient(uint32_t client_id, const std::string& reason = "Server request");
+    bool adoptClientSocket(int socket, const std::string& endpoint);
     
     // Layer management
     void clearLayer(uint8_t layer_id);
@@ -178,6 +216,11 @@ public:
     // Frame synchronization
     void waitForNextFrame();
     void sendFrameCallbacks();
+    void setFrameObserver(FrameObserver observer);  // Called on the main loop thread; set before run()
+    bool stepFrames(uint32_t count);                 // Virtual clock only; runs frames on the caller instead of run()
+    
+    // Command ordering (stateless, exposed for tools/kairos-bench)
+    static void optimizeCommandOrder(std::vector<RenderCommand>& commands);
     
     // Event broadcasting
     void broadcastInputEvent(const InputEvent& event);
@@ -197,13 +240,32 @@ private:
     void processFrame();
     void processCommands();
     void renderFrame();
+    void dispatchInput();
     void updateStatistics();
     
     // Subsystem management
     bool initializeSubsystems();
     void shutdownSubsystems();
     
+    // Live configuration
+    void applyLiveConfig();
+    RaylibRenderer::Config makeRendererConfig(const Config& config) const;
+    NetworkManager::Config makeNetworkConfig(const Config& config) const;
+    Platform::ThreadPolicy makeThreadPolicy(const Config& config, const std::string& role) const;
+    std::vector<OutputViewport> makeViewports(const Config& config) const;
+    
+    // Hot upgrade
+    void startHotUpgrade();
+    void completeHotUpgrade();
+    bool takeOver();
+    void exportScene(SceneState& scene, const RaylibRenderer::TextureFilter& wants_pixels = nullptr) const;
+    void importScene(const SceneState& scene);
+    
+    // Scene snapshots
+    void writeSceneSnapshot(bool blocking);
+    
     // Frame timing
+    uint32_t millisecondsSinceStartup() const;
     void enforceFrameRate();
     void measureFrameTime();
     std::chrono::microseconds getTargetFrameTime() const;
@@ -211,7 +273,8 @@ private:
     // Command processing
     void processCommandBatch(const std::vector<RenderCommand>& commands);
     void handleHighPriorityCommands();
-    void optimizeCommandOrder(std::vector<RenderCommand>& commands);
+    void recordCommandLatencies(const std::vector<RenderCommand>& commands);
+    void notifyFrameObserver(std::chrono::steady_clock::time_point work_end);
     
     // Resource monitoring
     void monitorSystemResources();
@@ -249,6 +312,31 @@ private:
     std::unique_ptr<CommandProcessor> m_command_processor;
     std::unique_ptr<LayerManager> m_layer_manager;
     std::unique_ptr<FontManager> m_font_manager;
+    std::unique_ptr<InputRouter> m_input_router;
+    std::unique_ptr<InputBatcher> m_input_batcher;
+    std::vector<InputEvent> m_input_events;     // Reused every frame
+    
+    // Live configuration (published by reloads, applied by the main loop)
+    SnapshotStore<Config> m_live_config;
+    uint64_t m_applied_config_version = 0;
+    std::mutex m_reload_mutex;
+    std::atomic<bool> m_reload_requested{false};
+    std::string m_config_file;
+    bool m_watch_config_file = false;
+    std::function<void(Kairos::Config&)> m_config_overrides;    // Command line options
+    std::unique_ptr<ConfigWatcher> m_config_watcher;
+    
+    // Hot upgrade
+    std::unique_ptr<HotUpgrade> m_hot_upgrade;
+    std::vector<std::string> m_upgrade_command;
+    std::atomic<bool> m_upgrade_requested{false};
+    int m_takeover_fd = -1;
+    
+    // Scene snapshots (restored at startup, written every snapshot_interval_ms)
+    std::unique_ptr<SceneSnapshot> m_scene_snapshot;
+    
+    // Real-time mode
+    static constexpr size_t REALTIME_STACK_PREFAULT_BYTES = 256 * 1024;
     
     // Threading
     std::thread m_main_thread;
@@ -261,6 +349,7 @@ private:
     std::vector<RenderCommand> m_high_priority_commands;
     
     // Frame timing
+    std::chrono::steady_clock::time_point m_startup_time;
     std::chrono::steady_clock::time_point m_frame_start_time;
     std::chrono::steady_clock::time_point m_last_frame_time;
     std::chrono::microseconds m_accumulated_frame_time{0};
@@ -270,6 +359,10 @@ private:
     std::queue<std::chrono::steady_clock::time_point> m_frame_times;
     static constexpr size_t FRAME_TIME_HISTORY_SIZE = 60;
     
+    // Frame observer (benchmark and test harnesses)
+    FrameObserver m_frame_observer;
+    std::vector<uint32_t> m_frame_command_latencies_us;
+    
     // Performance monitoring
     std::chrono::steady_clock::time_point m_last_stats_update;
     std::chrono::steady_clock::time_point m_last_performance_check;
@@ -0,0 +1,43 @@
+// KairosServer/include/Graphics/LayerIndex.hpp
+#pragma once
+
+#include "Graphics/RenderCommand.hpp"
+#include "Utils/SpatialGrid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Spatial index over one layer's retained commands
+ *
+ * Maps canvas rectangles to the positions of the commands that may touch
+ * them, so replaying, culling and picking cost what is visible rather than
+ * what the layer holds. Bounds are conservative (text is sized from its
+ * glyph count, strokes include their thickness); commands without
+ * geometry are returned by every query. Results come back in draw order.
+ */
+class LayerIndex {
+public:
+    explicit LayerIndex(float cell_size = 128.0f);
+
+    // index is the command's position in the layer's retained list
+    void add(uint32_t index, const RenderCommand& command);
+    void clear();
+    void rebuild(const std::vector<RenderCommand>& commands);
+
+    void query(const SpatialBounds& rect, std::vector<uint32_t>& indices) const;
+    void pick(float x, float y, std::vector<uint32_t>& indices) const;
+
+    size_t size() const { return m_grid.size() + m_unbounded.size(); }
+    bool empty() const { return size() == 0; }
+
+    static bool commandBounds(const RenderCommand& command, SpatialBounds& bounds);
+
+private:
+    SpatialGrid<uint32_t> m_grid;
+    std::vector<uint32_t> m_unbounded;
+};
+
+} // namespace Kairos
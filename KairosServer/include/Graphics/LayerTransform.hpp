@@ -0,0 +1,89 @@
+// KairosServer/include/Graphics/LayerTransform.hpp
+#pragma once
+
+#include <Types.hpp>
+#include "Utils/SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Kairos {
+
+/**
+ * @brief 2D affine map from a layer's coordinates to the canvas
+ *
+ * x' = a*x + c*y + tx, y' = b*x + d*y + ty: the column-major 2x3 matrix
+ * SET_LAYER_TRANSFORM carries. Default-constructed it is the identity.
+ */
+struct LayerTransform {
+    float a = 1.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    float d = 1.0f;
+    float tx = 0.0f;
+    float ty = 0.0f;
+
+    bool isIdentity() const {
+        return a == 1.0f && b == 0.0f && c == 0.0f && d == 1.0f && tx == 0.0f && ty == 0.0f;
+    }
+
+    bool isFinite() const {
+        return std::isfinite(a) && std::isfinite(b) && std::isfinite(c) && std::isfinite(d) &&
+               std::isfinite(tx) && std::isfinite(ty);
+    }
+
+    Point apply(const Point& point) const {
+        return {a * point.x + c * point.y + tx, b * point.x + d * point.y + ty};
+    }
+
+    // Bounding box of the mapped rectangle
+    SpatialBounds apply(const SpatialBounds& bounds) const {
+        const Point corners[] = {apply(Point{bounds.min_x, bounds.min_y}), apply(Point{bounds.max_x, bounds.min_y}),
+                                 apply(Point{bounds.min_x, bounds.max_y}), apply(Point{bounds.max_x, bounds.max_y})};
+        SpatialBounds result{corners[0].x, corners[0].y, corners[0].x, corners[0].y};
+        for (const Point& corner : corners) {
+            result.min_x = std::min(result.min_x, corner.x);
+            result.min_y = std::min(result.min_y, corner.y);
+            result.max_x = std::max(result.max_x, corner.x);
+            result.max_y = std::max(result.max_y, corner.y);
+        }
+        return result;
+    }
+
+    // (*this * other)(p) == apply(other.apply(p))
+    LayerTransform operator*(const LayerTransform& other) const {
+        return {a * other.a + c * other.b, b * other.a + d * other.b,
+                a * other.c + c * other.d, b * other.c + d * other.d,
+                a * other.tx + c * other.ty + tx, b * other.tx + d * other.ty + ty};
+    }
+
+    // False, leaving inverse untouched, when the map collapses the plane
+    bool invert(LayerTransform& inverse) const {
+        const float determinant = a * d - b * c;
+        if (std::fabs(determinant) < 1e-12f) {
+            return false;
+        }
+        const float ia = d / determinant;
+        const float ib = -b / determinant;
+        const float ic = -c / determinant;
+        const float id = a / determinant;
+        inverse = {ia, ib, ic, id, -(ia * tx + ic * ty), -(ib * tx + id * ty)};
+        return true;
+    }
+
+    // Column-major 4x4, as rlMultMatrixf() takes it
+    void toMatrix(float matrix[16]) const {
+        const float values[16] = {a, b, 0.0f, 0.0f,
+                                  c, d, 0.0f, 0.0f,
+                                  0.0f, 0.0f, 1.0f, 0.0f,
+                                  tx, ty, 0.0f, 1.0f};
+        std::copy(values, values + 16, matrix);
+    }
+
+    bool operator==(const LayerTransform& other) const {
+        return a == other.a && b == other.b && c == other.c && d == other.d && tx == other.tx && ty == other.ty;
+    }
+    bool operator!=(const LayerTransform& other) const { return !(*this == other); }
+};
+
+} // namespace Kairos
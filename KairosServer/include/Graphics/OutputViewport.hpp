@@ -0,0 +1,48 @@
+// KairosServer/include/Graphics/OutputViewport.hpp
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+namespace Kairos {
+
+/**
+ * @brief One output region showing part of the shared virtual canvas
+ *
+ * Clients draw into a single canvas; each viewport copies a canvas
+ * rectangle (scaled to fit) into a rectangle of the window, showing only
+ * its own subset of layers. A window spanning several displays can thus
+ * drive a video wall or dual-head setup from one command stream.
+ *
+ * Written as "<x>,<y>,<w>,<h>@<x>,<y>,<w>,<h>[:layers=<list>]": the canvas
+ * rectangle, then the window rectangle; list is like "0-3,7" (default: all
+ * layers). Example: "1920,0,1920,1080@0,0,960,540:layers=0,2".
+ */
+struct OutputViewport {
+    int32_t source_x = 0;               // Canvas rectangle
+    int32_t source_y = 0;
+    int32_t source_width = 0;
+    int32_t source_height = 0;
+    
+    int32_t dest_x = 0;                 // Window rectangle
+    int32_t dest_y = 0;
+    int32_t dest_width = 0;
+    int32_t dest_height = 0;
+    
+    std::bitset<256> layers;            // Shown layers; all when parsed without a list
+    
+    bool showsLayer(uint8_t layer_id) const { return layers.test(layer_id); }
+    float scaleX() const { return source_width > 0 ? static_cast<float>(dest_width) / source_width : 1.0f; }
+    float scaleY() const { return source_height > 0 ? static_cast<float>(dest_height) / source_height : 1.0f; }
+    
+    // Window position to canvas position; false if outside the window rectangle
+    bool windowToCanvas(float window_x, float window_y, float& canvas_x, float& canvas_y) const;
+    
+    bool operator==(const OutputViewport& other) const = default;
+};
+
+bool parseOutputViewport(const std::string& spec, OutputViewport& viewport, std::string& error);
+std::string formatOutputViewport(const OutputViewport& viewport);
+
+} // namespace Kairos
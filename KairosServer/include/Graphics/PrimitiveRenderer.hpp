@@ -5,6 +5,7 @@
 #include <raylib.h>
 #include <vector>
 #include <memory>
+#include <functional>
 
 namespace Kairos {
 
@@ -36,6 +37,7 @@ public:
         std::vector<TriangleVertex> vertices;
         std::vector<uint16_t> indices;
         uint8_t layer_id;
+        uint16_t clip_id = 0;        // 0: unclipped
         
         void clear() {
             vertices.clear();
@@ -46,6 +48,18 @@ public:
             return vertices.empty();
         }
     };
+    
+    // Two-stop gradient: from_color at from, to_color at to (linear) or
+    // from the circle through to outwards (radial), clamped beyond
+    struct Gradient {
+        Point from;
+        Point to;
+        Color from_color;
+        Color to_color;
+        bool radial = false;
+        
+        Color colorAt(const Point& position) const;
+    };
 
 public:
     PrimitiveRenderer();
@@ -72,18 +86,25 @@ public:
     void drawRectangleGradient(const Rectangle& rect, const Color& top_left, const Color& top_right,
                               const Color& bottom_left, const Color& bottom_right);
     void drawRectangleRounded(const Rectangle& rect, float radius, const Color& color, bool filled = true);
+    void drawRectangleRounded(const Rectangle& rect, const float radii[4], const Color& color, bool filled = true);
+    void fillRectangleGradient(const Rectangle& rect, const Gradient& gradient);
     
     // Circle primitives
     void drawCircle(const Point& center, float radius, const Color& color, bool filled = true);
     void drawCircleGradient(const Point& center, float radius, const Color& inner, const Color& outer);
     void drawEllipse(const Point& center, float radius_x, float radius_y, const Color& color, bool filled = true);
+    void fillEllipseGradient(const Point& center, float radius_x, float radius_y, const Gradient& gradient);
     void drawArc(const Point& center, float radius, float start_angle, float end_angle, 
                 const Color& color, bool filled = true);
+    void drawArc(const Point& center, float radius_x, float radius_y, float start_angle, float end_angle,
+                const Color& color, bool filled = true);
     
     // Polygon primitives
     void drawTriangle(const Point& p1, const Point& p2, const Point& p3, const Color& color, bool filled = true);
-    void drawPolygon(const std::vector<Point>& points, const Color& color, bool filled = true);
+    void drawPolygon(const std::vector<Point>& points, const Color& color, bool filled = true,
+                    bool known_convex = false);
     void drawPolygonGradient(const std::vector<Point>& points, const std::vector<Color>& colors, bool filled = true);
+    void fillConvexGradient(const std::vector<Point>& outline, const Gradient& gradient);
     
     // Advanced shapes
     void drawBezierQuadratic(const Point& start, const Point& control, const Point& end, 
@@ -97,6 +118,14 @@ public:
     void endBatch();
     void flushBatches();
     void flushLayer(uint8_t layer_id);
+    void setLayer(uint8_t layer_id) { m_current_layer = layer_id; }
+    std::vector<uint8_t> getPendingLayers() const;
+    
+    // Geometry added from now on batches under clip_id (0: unclipped); a
+    // clipped batch is drawn between clip_handler(clip_id) and clip_handler(0)
+    using ClipHandler = std::function<void(uint16_t clip_id)>;
+    void setClip(uint16_t clip_id) { m_current_clip = clip_id; }
+    void setClipHandler(ClipHandler clip_handler) { m_clip_handler = std::move(clip_handler); }
     
     // Rendering state
     void setAntialiasing(bool enabled);
@@ -129,7 +158,10 @@ private:
                                 bool filled, std::vector<TriangleVertex>& vertices);
     
     // Tessellation
-    std::vector<uint16_t> triangulatePolygon(const std::vector<Point>& points);
+    std::vector<uint16_t> triangulatePolygon(const std::vector<Point>& points, bool known_convex = false);
+    static void earClipPolygon(const std::vector<Point>& points, std::vector<uint16_t>& indices);
+    static int arcSegments(float radius, float angle_range);
+    static std::vector<Point> roundedRectangleOutline(const Rectangle& rect, const float radii[4]);
     void tessellateComplexPolygon(const std::vector<Point>& points, 
                                  std::vector<TriangleVertex>& vertices,
                                  std::vector<uint16_t>& indices);
@@ -156,6 +188,8 @@ private:
     // Batching state
     bool m_in_batch = false;
     uint8_t m_current_layer = 0;
+    uint16_t m_current_clip = 0;
+    ClipHandler m_clip_handler;
     std::vector<PrimitiveBatch> m_primitive_batches;
     
     // Vertex buffers
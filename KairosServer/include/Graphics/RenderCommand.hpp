@@ -3,6 +3,7 @@
 
 #include <Protocol.hpp>
 #include <Types.hpp>
+#include <Clock.hpp>
 #include <vector>
 #include <string>
 #include <memory>
@@ -32,7 +33,21 @@ struct RenderCommand {
         SET_LAYER_VISIBILITY,
         SET_VIEWPORT,
         SET_CAMERA,
-        BATCH_MARKER
+        BATCH_MARKER,
+        DRAW_ARC,
+        DRAW_ROUNDED_RECTANGLE,
+        FILL_GRADIENT,
+        DRAW_SPRITES,
+        SET_LAYER_TRANSFORM,
+        PUSH_CLIP,
+        POP_CLIP,
+        CREATE_PIXMAP,
+        FREE_PIXMAP,
+        SET_PIXMAP_TARGET,
+        COPY_AREA,
+        CREATE_OBJECT,
+        UPDATE_OBJECT,
+        DELETE_OBJECT
     };
     
     enum class Priority : uint8_t {
@@ -82,6 +97,47 @@ struct RenderCommand {
             bool filled;
         } circle;
         
+        // Elliptical arc drawing; angles in degrees, clockwise on screen from 3 o'clock
+        struct {
+            Point center;
+            float radius_x;
+            float radius_y;
+            float start_angle;
+            float end_angle;
+            Color color;
+            bool filled;         // Pie slice
+        } arc;
+        
+        // Polygon drawing (points in polygon_points)
+        struct {
+            Color color;
+            bool filled;
+            bool convex;         // Known convex: fan triangulation, no ear clipping
+        } polygon;
+        
+        // Rounded rectangle drawing; radii clockwise from the top-left corner
+        struct {
+            Point position;
+            float width;
+            float height;
+            float radii[4];
+            Color color;
+            bool filled;
+        } rounded_rectangle;
+        
+        // Two-stop gradient fill of a rectangle or an ellipse (see FillGradientData)
+        struct {
+            Point position;
+            float width;
+            float height;
+            Point from;
+            Point to;
+            Color from_color;
+            Color to_color;
+            uint8_t shape;       // Constants::GRADIENT_SHAPE_*
+            bool radial;
+        } gradient;
+        
         // Text drawing
         struct {
             Point position;
@@ -97,11 +153,62 @@ struct RenderCommand {
             // Vertices stored separately
         } textured_quads;
         
+        // Instanced sprites
+        struct {
+            uint32_t texture_id;
+            // Instances stored separately
+        } sprites;
+        
         // Layer operations
         struct {
             bool visible;
         } layer_visibility;
         
+        struct {
+            float a, b, c, d;
+            float tx, ty;
+            bool rerasterize;
+        } layer_transform;
+        
+        // Clip rectangle, in layer coordinates
+        struct {
+            float x, y;
+            float width, height;
+        } clip;
+        
+        // Pixmaps; id 0 in SET_PIXMAP_TARGET draws to the layers again
+        struct {
+            uint32_t id;
+            uint32_t width, height;
+            bool clear;
+        } pixmap;
+        
+        // Pixels moved within the layer or pixmap drawn to
+        struct {
+            int32_t src_x, src_y;
+            uint32_t width, height;
+            int32_t dst_x, dst_y;
+        } copy_area;
+        
+        // Retained objects (see ObjectData / ObjectUpdateData); DELETE_OBJECT
+        // uses only the id, UPDATE_OBJECT only the fields it names
+        struct {
+            uint32_t id;
+            uint8_t shape;       // Constants::OBJECT_SHAPE_*
+            uint8_t fields;      // Constants::OBJECT_FIELD_*
+            uint8_t easing;      // Constants::EASING_*
+            uint8_t flags;       // Constants::OBJECT_TWEEN_*
+            uint32_t texture_id;
+            uint32_t duration_ms;
+            Point position;
+            float width;
+            float height;
+            float rotation;
+            float corner_radius;
+            Color color;
+            float opacity;
+        } object;
+        
         // Viewport setting
         struct {
             int x, y;
@@ -121,6 +228,7 @@ struct RenderCommand {
     std::string text_string;                    // For text commands
     std::vector<Point> polygon_points;          // For polygon commands
     std::vector<TexturedVertex> vertices;       // For textured quad commands
+    std::vector<SpriteInstance> sprite_instances; // For instanced sprite commands
     
     // Metadata
     std::chrono::steady_clock::time_point created_time;
@@ -129,12 +237,12 @@ struct RenderCommand {
     
     // Constructors
     RenderCommand() : type(Type::DRAW_POINT), priority(Priority::NORMAL) {
-        created_time = std::chrono::steady_clock::now();
+        created_time = Clock::now();
     }
     
     explicit RenderCommand(Type cmd_type, uint8_t layer = 0, Priority prio = Priority::NORMAL) 
         : type(cmd_type), priority(prio), layer_id(layer) {
-        created_time = std::chrono::steady_clock::now();
+        created_time = Clock::now();
     }
     
     // Factory methods for creating specific commands
@@ -170,6 +278,21 @@ struct RenderCommand {
     bool operator>(const RenderCommand& other) const;
 };
 
+// Commands acting on the sender's pixmaps or pixmap target, which are the
+// client's rather than a layer's: a batch holding them runs in the order
+// it was sent across all layers
+inline bool isClientWide(RenderCommand::Type type) {
+    switch (type) {
+        case RenderCommand::Type::CREATE_PIXMAP:
+        case RenderCommand::Type::FREE_PIXMAP:
+        case RenderCommand::Type::SET_PIXMAP_TARGET:
+        case RenderCommand::Type::COPY_AREA:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /**
  * @brief Batch of render commands for efficient processing
  */
@@ -184,7 +307,7 @@ struct RenderCommandBatch {
     std::chrono::steady_clock::time_point created_time;
     
     RenderCommandBatch() {
-        created_time = std::chrono::steady_clock::now();
+        created_time = Clock::now();
         commands.reserve(1000); // Reasonable default
     }
     
@@ -272,12 +395,28 @@ class CommandConverter {
 public:
     static RenderCommand fromNetworkMessage(const MessageHeader& header, const void* data);
     static std::vector<RenderCommand> fromNetworkBatch(const std::vector<uint8_t>& buffer);
+    static bool canConvert(MessageType type);  // Keep in sync with fromNetworkMessage()
     
     // Convert specific command types
     static RenderCommand fromDrawPointData(const DrawPointData& data, uint8_t layer_id);
     static RenderCommand fromDrawLineData(const DrawLineData& data, uint8_t layer_id);
     static RenderCommand fromDrawRectangleData(const DrawRectangleData& data, uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawArcData(const DrawArcData& data, uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawPolygonData(const DrawPolygonData& data, const Point* points,
+                                            uint8_t layer_id, bool filled);
+    static RenderCommand fromDrawRoundedRectangleData(const DrawRoundedRectangleData& data,
+                                                     uint8_t layer_id, bool filled);
+    static RenderCommand fromFillGradientData(const FillGradientData& data, uint8_t layer_id);
+    static RenderCommand fromDrawSpritesInstancedData(const DrawSpritesInstancedData& data,
+                                                     const SpriteInstance* instances, uint8_t layer_id);
     static RenderCommand fromDrawTextData(const DrawTextData& data, const std::string& text, uint8_t layer_id);
+    static RenderCommand fromLayerTransformData(const LayerTransformData& data, uint8_t layer_id);
+    static RenderCommand fromClipRectData(const ClipRectData& data, uint8_t layer_id);
+    static RenderCommand fromCreatePixmapData(const CreatePixmapData& data, uint8_t layer_id);
+    static RenderCommand fromPixmapTargetData(const PixmapTargetData& data, uint8_t layer_id);
+    static RenderCommand fromCopyAreaData(const CopyAreaData& data, uint8_t layer_id);
+    static RenderCommand fromObjectData(const ObjectData& data, uint8_t layer_id);
+    static RenderCommand fromObjectUpdateData(const ObjectUpdateData& data, uint8_t layer_id);
     static RenderCommand fromDrawTexturedQuadsData(const DrawTexturedQuadsData& data, 
                                                   const std::vector<TexturedVertex>& vertices, uint8_t layer_id);
     
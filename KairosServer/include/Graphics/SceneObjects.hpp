@@ -0,0 +1,102 @@
+// KairosServer/include/Graphics/SceneObjects.hpp
+#pragma once
+
+#include "Graphics/RenderCommand.hpp"
+#include "Graphics/SceneState.hpp"
+
+#include <Clock.hpp>
+#include <Constants.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Retained objects and the tweens animating them
+ *
+ * Objects (CREATE_OBJECT / UPDATE_OBJECT / DELETE_OBJECT) are kept per
+ * client and id, each on one layer, listed per layer in creation order.
+ * Tweens run on Clock time: advance() settles every object's values for a
+ * frame, and updates start their tweens from the values at the time given.
+ * Not thread-safe; the renderer calls it on the render thread.
+ */
+class SceneObjects {
+public:
+    // Animated values, one float each; colour channels are 0..255
+    enum Property : uint8_t {
+        X, Y, WIDTH, HEIGHT, ROTATION, RED, GREEN, BLUE, ALPHA, OPACITY,
+        PROPERTY_COUNT
+    };
+
+    struct Object {
+        uint32_t client_id = 0;
+        uint32_t object_id = 0;
+        uint8_t layer_id = 0;
+        uint8_t shape = Constants::OBJECT_SHAPE_RECTANGLE;
+        uint32_t texture_id = 0;
+        float corner_radius = 0.0f;
+        std::array<float, PROPERTY_COUNT> values{};     // As of the last advance()
+    };
+
+    // Creating an existing id replaces the object, tweens and all, and puts
+    // it on top of its (possibly new) layer
+    bool create(uint32_t client_id, const RenderCommand& command);
+    bool update(uint32_t client_id, const RenderCommand& command, Clock::time_point now);
+    bool remove(uint32_t client_id, uint32_t object_id);
+    void removeClient(uint32_t client_id);
+    void clear();
+
+    void advance(Clock::time_point now);
+
+    // Hot upgrade: tweens carry how far along they are at now, and go on
+    // from there against the importing process's clock
+    void exportObjects(std::vector<SceneState::Object>& objects, Clock::time_point now) const;
+    void importObjects(const std::vector<SceneState::Object>& objects, Clock::time_point now);
+
+    // In creation order
+    template<typename Function>
+    void forEachOnLayer(uint8_t layer_id, Function&& function) const {
+        for (uint64_t key : m_layers[layer_id]) {
+            function(m_entries.at(key).object);
+        }
+    }
+
+    bool hasObjects(uint8_t layer_id) const { return !m_layers[layer_id].empty(); }
+    size_t size() const { return m_entries.size(); }
+    size_t activeTweens() const { return m_active_tweens; }
+
+    // t in 0..1 to progress along the curve (Constants::EASING_*)
+    static float ease(uint8_t easing, float t);
+
+private:
+    struct Tween {
+        bool active = false;
+        float from = 0.0f;
+        float to = 0.0f;
+        Clock::time_point start;
+        uint32_t duration_ms = 0;
+        uint8_t easing = Constants::EASING_LINEAR;
+        uint8_t flags = 0;            // Constants::OBJECT_TWEEN_*
+    };
+
+    struct Entry {
+        Object object;
+        std::array<Tween, PROPERTY_COUNT> tweens;
+    };
+
+    static uint64_t key(uint32_t client_id, uint32_t object_id) {
+        return (static_cast<uint64_t>(client_id) << 32) | object_id;
+    }
+    static float evaluate(const Tween& tween, Clock::time_point now, bool& finished);
+    void erase(std::unordered_map<uint64_t, Entry>::iterator it);
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::array<std::vector<uint64_t>, 256> m_layers;    // Keys, in creation order
+    std::unordered_map<uint32_t, uint32_t> m_client_objects;
+    size_t m_active_tweens = 0;
+};
+
+} // namespace Kairos
@@ -0,0 +1,88 @@
+// KairosServer/include/Graphics/SceneState.hpp
+#pragma once
+
+#include "Graphics/RenderCommand.hpp"
+#include "Graphics/LayerTransform.hpp"
+#include "Utils/BinaryIO.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Retained rendering state that outlives a server process
+ *
+ * Layer properties, per-layer retained command lists, textures, fonts
+ * loaded from files and retained objects with their running tweens.
+ * Objects belong to connected clients, so only hot upgrades carry them;
+ * snapshots leave them out. Serialized field by field (never as raw structs) with
+ * a format version, so a newer build can read what an older one wrote or
+ * refuse it cleanly.
+ */
+struct SceneState {
+    static constexpr uint32_t FORMAT_VERSION = 8;
+
+    struct Layer {
+        uint8_t id = 0;
+        bool visible = true;
+        float opacity = 1.0f;
+        float z_order = 0.0f;
+        int blend_mode = 0;                     // Raylib BlendMode
+        LayerTransform transform;               // Layer to canvas (SET_LAYER_TRANSFORM)
+        std::vector<RenderCommand> commands;
+    };
+
+    struct Texture {
+        uint32_t id = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;                    // Constants::PIXEL_FORMAT_*
+        uint64_t content_hash = 0;              // Of the uploaded data; 0 if unknown
+        std::vector<uint8_t> pixels;            // Empty when not read back (or no GL context)
+    };
+
+    struct FontRef {
+        uint32_t id = 0;
+        std::string file_path;
+        uint32_t font_size = 0;
+    };
+
+    struct ObjectTween {
+        uint8_t property = 0;                   // SceneObjects::Property
+        float from = 0.0f;
+        float to = 0.0f;
+        double elapsed_ms = 0.0;                // Since it started, when exported
+        uint32_t duration_ms = 0;
+        uint8_t easing = 0;                     // Constants::EASING_*
+        uint8_t flags = 0;                      // Constants::OBJECT_TWEEN_*
+    };
+
+    struct Object {
+        uint32_t client_id = 0;
+        uint32_t object_id = 0;
+        uint8_t layer_id = 0;
+        uint8_t shape = 0;                      // Constants::OBJECT_SHAPE_*
+        uint32_t texture_id = 0;
+        float corner_radius = 0.0f;
+        std::vector<float> values;              // One per SceneObjects::Property
+        std::vector<ObjectTween> tweens;        // Running ones
+    };
+
+    std::vector<Layer> layers;
+    std::vector<Texture> textures;
+    std::vector<FontRef> fonts;
+    std::vector<Object> objects;                // Per layer, in creation order
+
+    void serialize(BinaryWriter& writer) const;
+    bool deserialize(BinaryReader& reader);
+
+    static void writeCommand(BinaryWriter& writer, const RenderCommand& command);
+    static bool readCommand(BinaryReader& reader, RenderCommand& command);
+    
+    // FNV-1a; identifies texture content across processes and snapshots
+    static uint64_t contentHash(const void* data, size_t size);
+};
+
+} // namespace Kairos
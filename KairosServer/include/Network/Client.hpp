@@ -80,12 +80,38 @@ public:
         uint32_t max_message_size = 10 * 1024 * 1024; // 10MB
         bool enable_keep_alive = true;
         bool enable_nagle = false;  // TCP_NODELAY for low latency
+        bool fixed_buffers = false; // Real-time: prefaulted once, never grown
+    };
+    
+    // Everything needed to carry a connected client over to another process.
+    // The socket itself travels separately (SCM_RIGHTS); `socket` is only
+    // meaningful inside the process that produced or received it.
+    struct Session {
+        socket_t socket = -1;
+        uint32_t client_id = 0;
+        Type connection_type = Type::TCP;
+        std::string client_name;
+        uint32_t client_version = 0;
+        uint32_t capabilities = 0;
+        uint32_t requested_layers = 1;
+        std::string endpoint_address;
+        uint16_t endpoint_port = 0;
+        uint32_t ping_sequence = 0;
+        
+        uint64_t messages_sent = 0;
+        uint64_t messages_received = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t bytes_received = 0;
+        
+        std::vector<uint8_t> pending_receive;   // Partial message not parsed yet
+        std::vector<uint8_t> pending_send;      // Bytes the socket has not accepted yet
     };
 
 public:
     // Factory methods
     static std::shared_ptr<Client> createTcp(socket_t socket, const std::string& address, uint16_t port);
     static std::shared_ptr<Client> createUnix(socket_t socket, const std::string& path);
+    static std::shared_ptr<Client> restore(const Session& session, const Config& config = Config{});
     
     ~Client();
     
@@ -94,6 +120,7 @@ public:
     Type getType() const { return m_info.connection_type; }
     State getState() const { return m_state.load(); }
     const Info& getInfo() const { return m_info; }
+    socket_t getSocket() const { return m_socket; }
     
     // Connection management
     bool initialize(uint32_t client_id, const Config& config = Config{});
@@ -104,10 +131,13 @@ public:
     // Message handling
     bool sendMessage(const MessageHeader& header, const void* data = nullptr);
     bool receiveMessages(std::vector<std::pair<MessageHeader, std::vector<uint8_t>>>& messages);
+    bool waitForData(int timeout_ms);       // Until readable, closed or timed out
     
     // Handshake
+    void applyClientHello(const ClientHello& hello);    // Name, capabilities, layers
     bool performHandshake(const ServerHello& server_hello);
     bool isHandshakeComplete() const { return m_state.load() == State::CONNECTED; }
+    bool isProxy() const { return (m_info.capabilities & Capabilities::PROXY) != 0; }
     
     // Keep-alive
     void sendPing();
@@ -125,6 +155,11 @@ public:
     // Configuration
     void setConfig(const Config& config) { m_config = config; }
     const Config& getConfig() const { return m_config; }
+    
+    // Handover. After exporting, the caller owns the socket: use release()
+    // so destroying this client does not close it.
+    Session exportSession() const;
+    void release();
 
 private:
     explicit Client(socket_t socket, Type type);
@@ -134,10 +169,13 @@ private:
     bool receiveRawData();
     bool parseMessages();
     
+    bool waitForSocket(bool writable, int timeout_ms);
+    
     // Buffer management
     bool ensureReceiveBufferSpace(size_t needed_space);
     bool ensureSendBufferSpace(size_t needed_space);
     void compactReceiveBuffer();
+    void prefaultBuffers();
     
     // Socket configuration
     bool configureSocket();
@@ -0,0 +1,114 @@
+// KairosServer/include/Utils/BinaryIO.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Appends plain values to a byte buffer in host byte order
+ *
+ * Used for state that is only ever read back on the same host (process
+ * handover, local snapshot files), so no byte swapping is done.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer) {}
+
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::write needs a trivially copyable type");
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    void writeString(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    template<typename T>
+    void writeVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::writeVector needs a trivially copyable type");
+        write(static_cast<uint32_t>(values.size()));
+        writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    size_t size() const { return m_buffer.size(); }
+
+private:
+    std::vector<uint8_t>& m_buffer;
+};
+
+/**
+ * @brief Reads values written by BinaryWriter, failing softly on truncation
+ *
+ * Every read past the end leaves the target untouched and marks the reader
+ * invalid, so callers can read a whole record and check isValid() once.
+ */
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    template<typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::read needs a trivially copyable type");
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readBytes(void* data, size_t size) {
+        if (!m_valid || size > m_size - m_position) {
+            m_valid = false;
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+        std::memcpy(data, m_data + m_position, size);
+        m_position += size;
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint32_t length = 0;
+        if (!read(length) || length > remaining()) {
+            m_valid = false;
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data + m_position), length);
+        m_position += length;
+        return true;
+    }
+
+    template<typename T>
+    bool readVector(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::readVector needs a trivially copyable type");
+        uint32_t count = 0;
+        if (!read(count) || static_cast<size_t>(count) * sizeof(T) > remaining()) {
+            m_valid = false;
+            return false;
+        }
+        values.resize(count);
+        return readBytes(values.data(), count * sizeof(T));
+    }
+
+    bool isValid() const { return m_valid; }
+    size_t remaining() const { return m_size - m_position; }
+    size_t position() const { return m_position; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position = 0;
+    bool m_valid = true;
+};
+
+} // namespace Kairos
@@ -29,7 +29,7 @@ public:
         uint32_t client_timeout_seconds = 30;
         uint32_t handshake_timeout_seconds = 5;
         
-        size_t receive_buffer_size = 64 * 1024;
+        size_t receive_buffer_size = 64 * 1024;     // Per client; realtime_mode raises it to the largest message
         size_t send_buffer_size = 64 * 1024;
         size_t message_queue_size = 10000;
         
@@ -48,6 +48,7 @@ public:
         uint32_t msaa_samples = 4;
         bool fullscreen = false;
         bool hidden = false;
+        bool null_backend = false;      // No window/GL; commands are counted, not drawn
         std::string window_title = "Kairos Graphics Server";
         
         uint32_t max_batch_size = 10000;
@@ -55,6 +56,12 @@ public:
         uint32_t texture_atlas_size = 2048;
         uint32_t max_layers = 255;
         bool layer_caching = true;
+        
+        // Multi-viewport output: clients draw into the canvas, and each
+        // viewport shows part of it in a region of the window
+        uint32_t canvas_width = 0;      // 0: window size
+        uint32_t canvas_height = 0;
+        std::vector<std::string> viewports;     // "<canvas x,y,w,h>@<window x,y,w,h>[:layers=<list>]"
     };
     
     struct PerformanceConfig {
@@ -66,11 +73,17 @@ public:
         bool enable_frame_pacing = true;
         bool enable_adaptive_quality = true;
         bool enable_statistics = true;
+        bool virtual_clock = false;     // Time advances only when stepped (deterministic runs)
+        bool realtime_mode = false;     // Locked, prefaulted memory; pools never grow
+        size_t realtime_heap_reserve_mb = 64;
         
         uint32_t max_textures = 1000;
         uint32_t max_fonts = 100;
         uint32_t max_render_commands_per_frame = 10000;
         size_t max_memory_usage_mb = 512;
+        
+        // Role (render, commands, accept, network) -> "<cpus>[:nice=<n>|:fifo=<n>]"
+        std::unordered_map<std::string, std::string> thread_policies;
     };
     
     struct FeaturesConfig {
@@ -83,6 +96,9 @@ public:
         uint32_t max_layers = 255;
         bool layer_compositing = true;
         bool hardware_acceleration = true;
+        
+        std::string snapshot_file;              // Empty disables scene snapshots
+        uint32_t snapshot_interval_ms = 5000;
     };
     
     struct LoggingConfig {
@@ -171,6 +187,10 @@ private:
 class ConfigBuilder {
 public:
     ConfigBuilder();
+    explicit ConfigBuilder(const Config& base);     // Builder calls override base
+    
+    // Loads a file as the base; builder calls made afterwards override it
+    bool loadFromFile(const std::string& filename);
     
     // Network configuration
     ConfigBuilder& withTcpPort(uint16_t port);
@@ -188,6 +208,9 @@ public:
     ConfigBuilder& enableAntialiasing(bool enabled = true);
     ConfigBuilder& enableFullscreen(bool enabled = true);
     ConfigBuilder& enableHiddenWindow(bool enabled = true);
+    ConfigBuilder& enableNullRenderer(bool enabled = true);
+    ConfigBuilder& withCanvasSize(uint32_t width, uint32_t height);
+    ConfigBuilder& withViewport(const std::string& spec);
     
     // Performance configuration
     ConfigBuilder& withMaxLayers(uint32_t max_layers);
@@ -195,11 +218,17 @@ public:
     ConfigBuilder& withMemoryLimit(size_t limit_mb);
     ConfigBuilder& enableLayerCaching(bool enabled = true);
     ConfigBuilder& enableBatching(bool enabled = true);
+    ConfigBuilder& enableVirtualClock(bool enabled = true);
+    ConfigBuilder& enableRealtimeMode(bool enabled = true);
+    ConfigBuilder& withRealtimeHeapReserve(size_t reserve_mb);
+    ConfigBuilder& withThreadPolicy(const std::string& role, const std::string& policy);
     
     // Features configuration
     ConfigBuilder& enableProfiling(bool enabled = true);
     ConfigBuilder& enableDebugOverlay(bool enabled = true);
     ConfigBuilder& enableStatistics(bool enabled = true);
+    ConfigBuilder& withSceneSnapshot(const std::string& path);
+    ConfigBuilder& withSnapshotInterval(uint32_t interval_ms);
     
     // Logging configuration
     ConfigBuilder& withLogLevel(const std::string& level);
@@ -0,0 +1,48 @@
+// KairosServer/include/Utils/ConfigWatcher.hpp
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace Kairos {
+
+/**
+ * @brief Watches a configuration file and reports when it has been rewritten
+ *
+ * Uses inotify on Linux. The file's directory is watched rather than the
+ * file itself, so editors that save by writing a temporary file and renaming
+ * it over the original are still noticed. Other platforms poll the file's
+ * modification time. The callback runs on the watcher thread.
+ */
+class ConfigWatcher {
+public:
+    using ChangeCallback = std::function<void(const std::string& path)>;
+
+public:
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    bool start(const std::string& path, ChangeCallback callback);
+    void stop();
+    bool isRunning() const { return m_running; }
+
+private:
+    void watchLoop();
+
+private:
+    std::string m_path;
+    ChangeCallback m_callback;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+#ifdef __linux__
+    int m_inotify_fd = -1;
+#endif
+};
+
+} // namespace Kairos
@@ -0,0 +1,64 @@
+// KairosServer/include/Utils/InitGraph.hpp
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Runs startup steps as a dependency graph instead of a fixed sequence
+ *
+ * Each step names the steps it needs. A step starts as soon as all of its
+ * dependencies have finished: background steps get their own thread, and
+ * main-thread steps (anything touching the window or GL context) run on
+ * the thread calling run(), so independent work overlaps. A failed step is
+ * not retried, and steps depending on it are skipped.
+ */
+class InitGraph {
+public:
+    enum class Affinity {
+        MainThread,     // Runs on the caller of run()
+        Background      // Runs on a worker thread
+    };
+
+    using Step = std::function<bool()>;
+
+    struct StepResult {
+        std::string name;
+        Affinity affinity = Affinity::MainThread;
+        bool succeeded = false;
+        bool skipped = false;                       // A dependency failed
+        std::chrono::microseconds started_at{0};    // Relative to the start of run()
+        std::chrono::microseconds finished_at{0};
+    };
+
+public:
+    void addStep(const std::string& name, std::vector<std::string> dependencies,
+                 Affinity affinity, Step step);
+
+    // Returns false if a step failed or the dependencies are unknown or cyclic
+    bool run();
+
+    const std::vector<StepResult>& getResults() const { return m_results; }
+    const StepResult* getResult(const std::string& name) const;
+    std::string getTimingReport() const;
+
+private:
+    struct Node {
+        std::string name;
+        std::vector<std::string> dependencies;
+        Affinity affinity;
+        Step step;
+    };
+
+    static bool runStep(const Node& node);
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<StepResult> m_results;
+};
+
+} // namespace Kairos
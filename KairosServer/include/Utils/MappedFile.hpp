@@ -0,0 +1,43 @@
+// KairosServer/include/Utils/MappedFile.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Read-only view of a whole file, memory mapped where supported
+ *
+ * On POSIX systems the file is mmap'd, so parsing reads straight from the
+ * page cache without a copy. Other platforms read the file into memory.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_data != nullptr; }
+
+    // Writes through a shared mapping of <path>.tmp and renames it over path,
+    // so readers (and a crash mid-write) see either the old or the new file
+    static bool writeAtomically(const std::string& path, const void* data, size_t size);
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<uint8_t> m_buffer;      // Fallback when mmap is unavailable
+};
+
+} // namespace Kairos
@@ -0,0 +1,58 @@
+// KairosServer/include/Utils/Platform.hpp
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <vector>
+
+namespace Kairos {
+
+namespace Platform {
+    // Platform information
+    std::string getPlatformName();
+    uint32_t getCpuCoreCount();
+    uint64_t getTotalMemoryBytes();
+    uint64_t getAvailableMemoryBytes();
+    
+    // Debug utilities
+    bool isDebuggerPresent();
+    std::string getExecutablePath();
+    
+    /**
+     * @brief CPU placement and scheduling for one thread role
+     *
+     * Written as "<cpus>[:<policy>]": cpus is a list like "2", "2-3,6" or
+     * empty (any CPU); policy is "nice=<-20..19>" (SCHED_OTHER) or
+     * "fifo=<1..99>" (SCHED_FIFO). Examples: "3:fifo=80", ":nice=10".
+     */
+    struct ThreadPolicy {
+        std::vector<uint32_t> cpus;         // Empty: not pinned
+        bool realtime = false;              // SCHED_FIFO instead of SCHED_OTHER
+        bool has_priority = false;          // false: keep the inherited scheduling
+        int priority = 0;                   // Nice value, or FIFO priority when realtime
+        size_t stack_prefault_bytes = 0;    // Touched at thread start (real-time mode)
+        
+        bool operator==(const ThreadPolicy& other) const = default;
+    };
+    
+    bool parseThreadPolicy(const std::string& spec, ThreadPolicy& policy, std::string& error);
+    std::string formatThreadPolicy(const ThreadPolicy& policy);
+    
+    // Calling thread only; failures are logged with the reason
+    bool setThreadName(const std::string& name);            // Truncated to 15 characters
+    bool setThreadAffinity(const std::vector<uint32_t>& cpus);
+    bool setThreadPriority(int priority);                   // Nice value (Windows: THREAD_PRIORITY_*)
+    bool setThreadRealtime(int priority);                   // SCHED_FIFO priority
+    
+    // Applies everything policy asks for; role only labels the log messages
+    bool applyThreadPolicy(const std::string& role, const ThreadPolicy& policy);
+    
+    // Real-time memory: lock every current and future page, then fault pages
+    // in up front so the hot path never takes a page fault. On glibc every
+    // thread started afterwards allocates from the one prefaulted arena.
+    bool lockMemory();
+    void prefaultHeap(size_t bytes);        // Freed back to the allocator, which keeps it
+    void prefaultStack(size_t bytes);       // Calling thread's stack
+}
+
+} // namespace Kairos
@@ -0,0 +1,164 @@
+// KairosServer/include/Utils/SnapshotStore.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Read-copy-update holder for an immutable value (typically a config)
+ *
+ * Writers publish a complete new copy; readers pin the current copy with a
+ * Snapshot guard and read it without locks for as long as the guard lives.
+ * Replaced copies are reclaimed by epoch: each pinned reader records the
+ * global epoch in a slot, and a retired copy is freed once no slot holds an
+ * epoch at or before the one in which it was replaced.
+ *
+ * Guards are meant to be short-lived and taken at safe points (frame start,
+ * one network loop iteration), not stored.
+ */
+template<typename T>
+class SnapshotStore {
+    struct Entry {
+        T value;
+        uint64_t version;
+    };
+
+public:
+    static constexpr size_t MAX_READERS = 64;
+
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept
+            : m_store(std::exchange(other.m_store, nullptr)), m_slot(other.m_slot), m_value(other.m_value) {}
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot() {
+            if (m_store) {
+                m_store->unpin(m_slot);
+            }
+        }
+
+        const T& operator*() const { return m_value->value; }
+        const T* operator->() const { return &m_value->value; }
+        uint64_t version() const { return m_value->version; }
+
+    private:
+        friend class SnapshotStore;
+        Snapshot(const SnapshotStore* store, size_t slot, const Entry* value)
+            : m_store(store), m_slot(slot), m_value(value) {}
+
+        const SnapshotStore* m_store;
+        size_t m_slot;
+        const Entry* m_value;
+    };
+
+public:
+    explicit SnapshotStore(const T& initial = T{}) {
+        m_current.store(new Entry{initial, 1});
+    }
+
+    ~SnapshotStore() {
+        delete m_current.load();
+        for (auto& retired : m_retired) {
+            delete retired.second;
+        }
+    }
+
+    SnapshotStore(const SnapshotStore&) = delete;
+    SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+    // Pins the current value until the returned guard is destroyed
+    Snapshot read() const {
+        size_t slot = pin();
+        return Snapshot(this, slot, m_current.load());
+    }
+
+    // Replaces the value; returns the new version
+    uint64_t publish(const T& value) {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+
+        uint64_t version = m_current.load()->version + 1;
+        const Entry* previous = m_current.exchange(new Entry{value, version});
+        uint64_t retired_epoch = m_epoch.fetch_add(1);
+
+        m_retired.emplace_back(retired_epoch, previous);
+        reclaim();
+        return version;
+    }
+
+    uint64_t getVersion() const { return m_current.load()->version; }
+
+    size_t getPendingReclaimCount() const {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        return m_retired.size();
+    }
+
+private:
+    // One cache line per reader so pinning does not bounce other readers' lines
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};     // 0 = not pinned
+        std::atomic<bool> in_use{false};
+    };
+
+    size_t pin() const {
+        size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_READERS;
+        while (true) {
+            for (size_t i = 0; i < MAX_READERS; ++i) {
+                size_t index = (start + i) % MAX_READERS;
+                bool expected = false;
+                if (m_slots[index].in_use.compare_exchange_strong(expected, true)) {
+                    // Publish the epoch before loading the pointer (both seq_cst)
+                    m_slots[index].epoch.store(m_epoch.load());
+                    return index;
+                }
+            }
+            std::this_thread::yield();   // More than MAX_READERS concurrent guards
+        }
+    }
+
+    void unpin(size_t slot) const {
+        m_slots[slot].epoch.store(0);
+        m_slots[slot].in_use.store(false);
+    }
+
+    // Caller holds m_write_mutex
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (const auto& slot : m_slots) {
+            uint64_t epoch = slot.epoch.load();
+            if (epoch != 0 && epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+
+        // A reader pinned at epoch E may hold anything retired at epoch >= E
+        auto it = m_retired.begin();
+        while (it != m_retired.end()) {
+            if (it->first < oldest) {
+                delete it->second;
+                it = m_retired.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    std::atomic<const Entry*> m_current{nullptr};
+    std::atomic<uint64_t> m_epoch{1};
+    mutable std::array<ReaderSlot, MAX_READERS> m_slots;
+
+    mutable std::mutex m_write_mutex;
+    std::vector<std::pair<uint64_t, const Entry*>> m_retired;
+};
+
+} // namespace Kairos
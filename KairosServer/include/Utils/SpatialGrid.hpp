@@ -0,0 +1,217 @@
+// KairosServer/include/Utils/SpatialGrid.hpp
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Kairos {
+
+/**
+ * @brief Axis-aligned bounds, min inclusive and max exclusive
+ */
+struct SpatialBounds {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+
+    static SpatialBounds fromRect(float x, float y, float width, float height) {
+        return {std::min(x, x + width), std::min(y, y + height), std::max(x, x + width), std::max(y, y + height)};
+    }
+
+    bool contains(float x, float y) const { return x >= min_x && y >= min_y && x < max_x && y < max_y; }
+    bool intersects(const SpatialBounds& other) const {
+        return min_x < other.max_x && other.min_x < max_x && min_y < other.max_y && other.min_y < max_y;
+    }
+    bool isEmpty() const { return !(max_x > min_x && max_y > min_y); }
+};
+
+/**
+ * @brief Uniform hashed grid answering "which items touch this point/rect"
+ *
+ * Items are stored in every cell their bounds overlap; cells live in a hash
+ * map, so the grid is unbounded and costs nothing where nothing is. Items
+ * that would span more than max_cells_per_item cells are kept in a side
+ * list checked by every query instead of being smeared across the grid.
+ *
+ * Not thread-safe; queries use a per-grid stamp to report each item once.
+ */
+template<typename Id>
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cell_size = 64.0f, uint32_t max_cells_per_item = 256)
+        : m_cell_size(cell_size > 0.0f ? cell_size : 64.0f), m_max_cells_per_item(max_cells_per_item) {}
+
+    // Adds the item or moves it to new bounds
+    void insert(Id id, const SpatialBounds& bounds) {
+        remove(id);
+
+        Item item;
+        item.bounds = bounds;
+        item.oversized = cellCount(bounds) > m_max_cells_per_item;
+        if (item.oversized) {
+            m_oversized.push_back(id);
+        } else {
+            forEachCell(bounds, [&](uint64_t key) { m_cells[key].push_back(id); });
+        }
+        m_items.emplace(id, item);
+    }
+
+    bool remove(Id id) {
+        auto it = m_items.find(id);
+        if (it == m_items.end()) {
+            return false;
+        }
+
+        if (it->second.oversized) {
+            eraseFrom(m_oversized, id);
+        } else {
+            forEachCell(it->second.bounds, [&](uint64_t key) {
+                auto cell = m_cells.find(key);
+                if (cell != m_cells.end()) {
+                    eraseFrom(cell->second, id);
+                    if (cell->second.empty()) {
+                        m_cells.erase(cell);
+                    }
+                }
+            });
+        }
+        m_items.erase(it);
+        return true;
+    }
+
+    void clear() {
+        m_items.clear();
+        m_cells.clear();
+        m_oversized.clear();
+    }
+
+    size_t size() const { return m_items.size(); }
+    bool empty() const { return m_items.empty(); }
+
+    const SpatialBounds* getBounds(Id id) const {
+        auto it = m_items.find(id);
+        return it != m_items.end() ? &it->second.bounds : nullptr;
+    }
+
+    // fn(Id, const SpatialBounds&) for every item containing the point
+    template<typename Fn>
+    void queryPoint(float x, float y, Fn&& fn) const {
+        auto visit = [&](Id id) {
+            const Item& item = m_items.at(id);
+            if (item.bounds.contains(x, y)) {
+                fn(id, item.bounds);
+            }
+        };
+
+        auto cell = m_cells.find(cellKey(cellIndex(x), cellIndex(y)));
+        if (cell != m_cells.end()) {
+            for (Id id : cell->second) {
+                visit(id);
+            }
+        }
+        for (Id id : m_oversized) {
+            visit(id);
+        }
+    }
+
+    // fn(Id, const SpatialBounds&) once for every item intersecting the rect
+    template<typename Fn>
+    void queryRect(const SpatialBounds& rect, Fn&& fn) const {
+        if (rect.isEmpty()) {
+            return;
+        }
+        const uint64_t stamp = ++m_query_stamp;
+        auto visit = [&](Id id) {
+            const Item& item = m_items.at(id);
+            if (item.stamp != stamp && item.bounds.intersects(rect)) {
+                item.stamp = stamp;
+                fn(id, item.bounds);
+            }
+        };
+
+        // A huge query rect visits the occupied cells rather than every empty one
+        if (cellCount(rect) > m_cells.size()) {
+            for (const auto& [key, ids] : m_cells) {
+                for (Id id : ids) {
+                    visit(id);
+                }
+            }
+        } else {
+            forEachCell(rect, [&](uint64_t key) {
+                auto cell = m_cells.find(key);
+                if (cell != m_cells.end()) {
+                    for (Id id : cell->second) {
+                        visit(id);
+                    }
+                }
+            });
+        }
+        for (Id id : m_oversized) {
+            visit(id);
+        }
+    }
+
+private:
+    struct Item {
+        SpatialBounds bounds;
+        bool oversized = false;
+        mutable uint64_t stamp = 0;
+    };
+
+    int32_t cellIndex(float coordinate) const {
+        float index = std::floor(coordinate / m_cell_size);
+        if (std::isnan(index)) {
+            return 0;   // clamp() passes NaN through, and casting it is undefined
+        }
+        return static_cast<int32_t>(std::clamp(index, -1.0e9f, 1.0e9f));
+    }
+
+    static uint64_t cellKey(int32_t cx, int32_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    uint64_t cellCount(const SpatialBounds& bounds) const {
+        if (bounds.isEmpty()) {
+            return 1;
+        }
+        uint64_t columns = static_cast<uint64_t>(cellIndex(bounds.max_x) - cellIndex(bounds.min_x)) + 1;
+        uint64_t rows = static_cast<uint64_t>(cellIndex(bounds.max_y) - cellIndex(bounds.min_y)) + 1;
+        return columns * rows;
+    }
+
+    // Degenerate bounds (a point, a zero-width line) still occupy their cell
+    template<typename Fn>
+    void forEachCell(const SpatialBounds& bounds, Fn&& fn) const {
+        const int32_t x0 = cellIndex(bounds.min_x);
+        const int32_t y0 = cellIndex(bounds.min_y);
+        const int32_t x1 = std::max(x0, cellIndex(bounds.max_x));
+        const int32_t y1 = std::max(y0, cellIndex(bounds.max_y));
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cx = x0; cx <= x1; ++cx) {
+                fn(cellKey(cx, cy));
+            }
+        }
+    }
+
+    static void eraseFrom(std::vector<Id>& ids, Id id) {
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end()) {
+            *it = ids.back();
+            ids.pop_back();
+        }
+    }
+
+private:
+    float m_cell_size;
+    uint32_t m_max_cells_per_item;
+    std::unordered_map<Id, Item> m_items;
+    std::unordered_map<uint64_t, std::vector<Id>> m_cells;
+    std::vector<Id> m_oversized;
+    mutable uint64_t m_query_stamp = 0;
+};
+
+} // namespace Kairos
@@ -0,0 +1,46 @@
+// KairosServer/include/Utils/WakeupEvent.hpp
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+namespace Kairos {
+
+/**
+ * @brief Cross-thread "there is work" signal that a thread can sleep on
+ *
+ * On Linux this is an eventfd, elsewhere on Unix a non-blocking pipe, so
+ * the descriptor can sit in the same poll()/select() set as the sockets a
+ * thread already waits on. Notifications coalesce: any number of notify()
+ * calls before a wait wake it once. Windows has no descriptor (fd() is -1)
+ * and waits on a condition variable instead.
+ */
+class WakeupEvent {
+public:
+    WakeupEvent();
+    ~WakeupEvent();
+    
+    WakeupEvent(const WakeupEvent&) = delete;
+    WakeupEvent& operator=(const WakeupEvent&) = delete;
+    
+    void notify();
+    
+    // Sleeps until notified or timeout_ms passes (-1: no timeout); consumes the notification
+    bool wait(int timeout_ms = -1);
+    
+    // For callers polling fd() themselves: consumes a pending notification
+    void drain();
+    
+    int fd() const { return m_read_fd; }
+
+private:
+    int m_read_fd = -1;
+    int m_write_fd = -1;     // Same as m_read_fd for an eventfd
+    
+    // Windows fallback
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_signaled = false;
+};
+
+} // namespace Kairos
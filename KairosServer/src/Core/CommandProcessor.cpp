@@ -5,6 +5,7 @@
 #include "FontManager.hpp"
 #include "Utils/Logger.hpp"
 #include <cstring>
+#include <cmath>
 #include <algorithm>
 
 namespace Kairos {
@@ -20,6 +21,7 @@ CommandProcessor::CommandProcessor(RaylibRenderer& renderer, LayerManager& layer
 CommandProcessor::~CommandProcessor() {
     if (m_processing_thread.joinable()) {
         m_stop_processing = true;
+        m_wakeup.notify();
         m_processing_thread.join();
     }
 }
@@ -34,6 +36,7 @@ bool CommandProcessor::initialize() {
 
 void CommandProcessor::shutdown() {
     m_stop_processing = true;
+    m_wakeup.notify();
     
     if (m_processing_thread.joinable()) {
         m_processing_thread.join();
@@ -68,6 +71,7 @@ bool CommandProcessor::processNetworkMessage(const MessageHeader& header, const
     
     if (success) {
         m_stats.commands_received.fetch_add(1);
+        m_wakeup.notify();
     } else {
         m_stats.commands_dropped.fetch_add(1);
         Logger::warning("Command queue full, dropped command from client {}", header.client_id);
@@ -83,26 +87,41 @@ void CommandProcessor::processCommandBatch(const std::vector<RenderCommand>& com
     
     auto start_time = std::chrono::steady_clock::now();
     
-    // Group commands by type and layer for optimal processing
-    std::unordered_map<uint8_t, std::vector<const RenderCommand*>> commands_by_layer;
-    std::vector<const RenderCommand*> high_priority_commands;
+    // A pixmap target switch lands between the sender's draws on every
+    // layer, so such a batch is not split up by layer at all
+    const bool in_order = std::any_of(commands.begin(), commands.end(), [](const RenderCommand& command) {
+        return isClientWide(command.type);
+    });
     
-    for (const auto& command : commands) {
-        if (command.priority >= RenderCommand::Priority::HIGH) {
-            high_priority_commands.push_back(&command);
-        } else {
-            commands_by_layer[command.layer_id].push_back(&command);
+    if (in_order) {
+        for (const auto& command : commands) {
+            if (command.priority < RenderCommand::Priority::HIGH) {
+                m_layer_manager.markLayerDirty(command.layer_id);
+            }
+            processCommand(command);
+        }
+    } else {
+        // Group commands by layer, each layer's in the order they were sent
+        std::unordered_map<uint8_t, std::vector<const RenderCommand*>> commands_by_layer;
+        std::vector<const RenderCommand*> high_priority_commands;
+        
+        for (const auto& command : commands) {
+            if (command.priority >= RenderCommand::Priority::HIGH) {
+                high_priority_commands.push_back(&command);
+            } else {
+                commands_by_layer[command.layer_id].push_back(&command);
+            }
+        }
+        
+        // Process high priority commands first
+        for (const auto* command : high_priority_commands) {
+            processCommand(*command);
+        }
+        
+        // Process regular commands by layer
+        for (auto& [layer_id, layer_commands] : commands_by_layer) {
+            processLayerCommands(layer_id, layer_commands);
         }
-    }
-    
-    // Process high priority commands first
-    for (const auto* command : high_priority_commands) {
-        processCommand(*command);
-    }
-    
-    // Process regular commands by layer
-    for (auto& [layer_id, layer_commands] : commands_by_layer) {
-        processLayerCommands(layer_id, layer_commands);
     }
     
     auto end_time = std::chrono::steady_clock::now();
@@ -115,72 +134,24 @@ void CommandProcessor::processCommandBatch(const std::vector<RenderCommand>& com
 }
 
 void CommandProcessor::processCommand(const RenderCommand& command) {
+    // The layer manager's bookkeeping; drawing (and retaining it for
+    // snapshots and hot upgrades) is the renderer's one dispatch
     switch (command.type) {
-        case RenderCommand::Type::DRAW_POINT:
-            m_renderer.drawPoint(command.point.position, command.point.color, command.layer_id);
-            break;
-            
-        case RenderCommand::Type::DRAW_LINE:
-            m_renderer.drawLine(command.line.start, command.line.end, 
-                              command.line.color, command.line.thickness, command.layer_id);
-            break;
-            
-        case RenderCommand::Type::DRAW_RECTANGLE:
-            m_renderer.drawRectangle(command.rectangle.position, 
-                                   command.rectangle.width, command.rectangle.height,
-                                   command.rectangle.color, command.rectangle.filled, 
-                                   command.layer_id);
-            break;
-            
-        case RenderCommand::Type::DRAW_CIRCLE:
-            m_renderer.drawCircle(command.circle.center, command.circle.radius,
-                                command.circle.color, command.circle.filled, command.layer_id);
-            break;
-            
-        case RenderCommand::Type::DRAW_TEXT:
-            if (!command.text_string.empty()) {
-                m_renderer.drawText(command.text_string, command.text.position,
-                                  command.text.font_id, command.text.font_size,
-                                  command.text.color, command.layer_id);
-            }
-            break;
-            
-        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
-            if (!command.vertices.empty()) {
-                m_renderer.drawTexturedQuads(command.vertices, 
-                                           command.textured_quads.texture_id, 
-                                           command.layer_id);
-            }
-            break;
-            
         case RenderCommand::Type::CLEAR_LAYER:
-            m_renderer.clearLayer(command.layer_id);
             m_layer_manager.markLayerDirty(command.layer_id);
             break;
             
         case RenderCommand::Type::SET_LAYER_VISIBILITY:
-            m_renderer.setLayerVisibility(command.layer_id, command.layer_visibility.visible);
             m_layer_manager.setLayerVisibility(command.layer_id, command.layer_visibility.visible);
             break;
             
-        case RenderCommand::Type::SET_VIEWPORT:
-            m_renderer.setViewport(command.viewport.x, command.viewport.y,
-                                 command.viewport.width, command.viewport.height);
-            break;
-            
-        case RenderCommand::Type::SET_CAMERA:
-            {
-                Vector2 target = {command.camera.target.x, command.camera.target.y};
-                Vector2 offset = {command.camera.offset.x, command.camera.offset.y};
-                m_renderer.setCamera2D(target, offset, command.camera.rotation, command.camera.zoom);
-            }
-            break;
-            
         default:
-            Logger::warning("Unknown render command type: {}", static_cast<int>(command.type));
-            m_stats.invalid_commands.fetch_add(1);
             break;
     }
+    
+    if (!m_renderer.processCommand(command)) {
+        m_stats.invalid_commands.fetch_add(1);
+    }
 }
 
 void CommandProcessor::processLayerCommands(uint8_t layer_id, 
@@ -192,81 +163,17 @@ void CommandProcessor::processLayerCommands(uint8_t layer_id,
     // Mark layer as dirty for this frame
     m_layer_manager.markLayerDirty(layer_id);
     
-    // Group commands by type for potential batching
-    std::vector<const RenderCommand*> text_commands;
-    std::vector<const RenderCommand*> textured_commands;
-    std::vector<const RenderCommand*> primitive_commands;
-    
+    // A layer is drawn in the order it was sent: later draws cover earlier
+    // ones (a label over its background), and the renderer batches what
+    // it can without reordering across kinds
     for (const auto* command : commands) {
-        switch (command->type) {
-            case RenderCommand::Type::DRAW_TEXT:
-                text_commands.push_back(command);
-                break;
-            case RenderCommand::Type::DRAW_TEXTURED_QUADS:
-                textured_commands.push_back(command);
-                break;
-            default:
-                primitive_commands.push_back(command);
-                break;
-        }
-    }
-    
-    // Process batched commands
-    if (!textured_commands.empty()) {
-        processBatchedTexturedQuads(layer_id, textured_commands);
-    }
-    
-    if (!text_commands.empty()) {
-        processBatchedText(layer_id, text_commands);
-    }
-    
-    // Process primitive commands individually
-    for (const auto* command : primitive_commands) {
         processCommand(*command);
     }
 }
 
-void CommandProcessor::processBatchedTexturedQuads(uint8_t layer_id, 
-                                                  const std::vector<const RenderCommand*>& commands) {
-    // Group by texture for optimal batching
-    std::unordered_map<uint32_t, std::vector<TexturedVertex>> vertices_by_texture;
-    
-    for (const auto* command : commands) {
-        uint32_t texture_id = command->textured_quads.texture_id;
-        auto& vertices = vertices_by_texture[texture_id];
-        vertices.insert(vertices.end(), command->vertices.begin(), command->vertices.end());
-    }
-    
-    // Render each texture batch
-    for (const auto& [texture_id, vertices] : vertices_by_texture) {
-        m_renderer.drawTexturedQuads(vertices, texture_id, layer_id);
-    }
-    
-    Logger::debug("Batched {} textured quad commands into {} texture draws", 
-                 commands.size(), vertices_by_texture.size());
-}
-
-void CommandProcessor::processBatchedText(uint8_t layer_id, 
-                                        const std::vector<const RenderCommand*>& commands) {
-    // Group by font for optimal batching
-    std::unordered_map<uint32_t, std::vector<const RenderCommand*>> commands_by_font;
-    
-    for (const auto* command : commands) {
-        commands_by_font[command->text.font_id].push_back(command);
-    }
-    
-    // Process each font group
-    for (const auto& [font_id, font_commands] : commands_by_font) {
-        for (const auto* command : font_commands) {
-            processCommand(*command);
-        }
-    }
-    
-    Logger::debug("Batched {} text commands by {} fonts", 
-                 commands.size(), commands_by_font.size());
-}
-
 void CommandProcessor::processingLoop() {
+    Platform::setThreadName("kairos-commands");
+    Platform::applyThreadPolicy("Command processor", m_thread_policy);
     Logger::info("Command processing loop started");
     
     while (!m_stop_processing) {
@@ -277,8 +184,8 @@ void CommandProcessor::processingLoop() {
             if (!commands.empty()) {
                 processCommandBatch(commands);
             } else {
-                // No commands to process, sleep briefly
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                // Sleep until a command arrives; the timeout only keeps statistics fresh
+                m_wakeup.wait(1000);
             }
             
             // Update statistics periodically
@@ -351,6 +258,68 @@ RenderCommand CommandConverter::fromNetworkMessage(const MessageHeader& header,
             return fromDrawRectangleData(*rect_data, header.layer_id, true);
         }
         
+        case MessageType::DRAW_ARC:
+        case MessageType::FILL_ARC: {
+            if (header.data_size < sizeof(DrawArcData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* arc_data = static_cast<const DrawArcData*>(data);
+            return fromDrawArcData(*arc_data, header.layer_id, header.type == MessageType::FILL_ARC);
+        }
+        
+        case MessageType::DRAW_POLYGON:
+        case MessageType::FILL_POLYGON: {
+            if (header.data_size < sizeof(DrawPolygonData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* polygon_data = static_cast<const DrawPolygonData*>(data);
+            const size_t available = (header.data_size - sizeof(DrawPolygonData)) / sizeof(Point);
+            if (polygon_data->point_count > available) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            if (polygon_data->point_count > Limits::MAX_POLYGON_POINTS) {
+                const uint32_t point_count = polygon_data->point_count;
+                Logger::warning("{} with {} points from client {} exceeds the limit of {}",
+                               messageTypeToString(header.type), point_count,
+                               header.client_id, Limits::MAX_POLYGON_POINTS);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* points = reinterpret_cast<const Point*>(
+                static_cast<const uint8_t*>(data) + sizeof(DrawPolygonData));
+            return fromDrawPolygonData(*polygon_data, points, header.layer_id,
+                                       header.type == MessageType::FILL_POLYGON);
+        }
+        
+        case MessageType::DRAW_ROUNDED_RECTANGLE:
+        case MessageType::FILL_ROUNDED_RECTANGLE: {
+            if (header.data_size < sizeof(DrawRoundedRectangleData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* rounded_data = static_cast<const DrawRoundedRectangleData*>(data);
+            return fromDrawRoundedRectangleData(*rounded_data, header.layer_id,
+                                                header.type == MessageType::FILL_ROUNDED_RECTANGLE);
+        }
+        
+        case MessageType::FILL_GRADIENT: {
+            if (header.data_size < sizeof(FillGradientData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* gradient_data = static_cast<const FillGradientData*>(data);
+            if (gradient_data->shape > Constants::GRADIENT_SHAPE_ELLIPSE ||
+                gradient_data->kind > Constants::GRADIENT_RADIAL) {
+                const uint8_t shape = gradient_data->shape;
+                const uint8_t kind = gradient_data->kind;
+                Logger::warning("Unknown gradient shape {} / kind {} from client {}", shape, kind, header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromFillGradientData(*gradient_data, header.layer_id);
+        }
+        
         case MessageType::DRAW_TEXT: {
             const auto* text_data = static_cast<const DrawTextData*>(data);
             std::string text(static_cast<const char*>(data) + sizeof(DrawTextData), text_data->text_length);
@@ -365,11 +334,147 @@ RenderCommand CommandConverter::fromNetworkMessage(const MessageHeader& header,
             return fromDrawTexturedQuadsData(*quad_data, vertex_vector, header.layer_id);
         }
         
+        case MessageType::DRAW_SPRITES_INSTANCED: {
+            if (header.data_size < sizeof(DrawSpritesInstancedData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* sprite_data = static_cast<const DrawSpritesInstancedData*>(data);
+            const size_t available = (header.data_size - sizeof(DrawSpritesInstancedData)) / sizeof(SpriteInstance);
+            if (sprite_data->instance_count > available) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* instances = reinterpret_cast<const SpriteInstance*>(
+                static_cast<const uint8_t*>(data) + sizeof(DrawSpritesInstancedData));
+            return fromDrawSpritesInstancedData(*sprite_data, instances, header.layer_id);
+        }
+        
+        case MessageType::COPY_AREA: {
+            if (header.data_size < sizeof(CopyAreaData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromCopyAreaData(*static_cast<const CopyAreaData*>(data), header.layer_id);
+        }
+        
         case MessageType::CLEAR_LAYER: {
             RenderCommand command(RenderCommand::Type::CLEAR_LAYER, header.layer_id);
             return command;
         }
         
+        case MessageType::SET_LAYER_TRANSFORM: {
+            if (header.data_size < sizeof(LayerTransformData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* transform_data = static_cast<const LayerTransformData*>(data);
+            const float values[] = {transform_data->a, transform_data->b, transform_data->c,
+                                    transform_data->d, transform_data->tx, transform_data->ty};
+            if (!std::all_of(std::begin(values), std::end(values), [](float v) { return std::isfinite(v); })) {
+                Logger::warning("Non-finite layer transform from client {}", header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromLayerTransformData(*transform_data, header.layer_id);
+        }
+        
+        case MessageType::PUSH_CLIP: {
+            if (header.data_size < sizeof(ClipRectData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* clip_data = static_cast<const ClipRectData*>(data);
+            const float values[] = {clip_data->x, clip_data->y, clip_data->width, clip_data->height};
+            if (!std::all_of(std::begin(values), std::end(values), [](float v) { return std::isfinite(v); })) {
+                Logger::warning("Non-finite clip rectangle from client {}", header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromClipRectData(*clip_data, header.layer_id);
+        }
+        
+        case MessageType::POP_CLIP:
+            return RenderCommand(RenderCommand::Type::POP_CLIP, header.layer_id);
+        
+        case MessageType::CREATE_PIXMAP: {
+            if (header.data_size < sizeof(CreatePixmapData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* pixmap_data = static_cast<const CreatePixmapData*>(data);
+            if (pixmap_data->depth != 0 && pixmap_data->depth != 32) {
+                Logger::warning("Unsupported pixmap depth {} from client {}", pixmap_data->depth, header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromCreatePixmapData(*pixmap_data, header.layer_id);
+        }
+        
+        case MessageType::FREE_PIXMAP: {
+            if (header.data_size < sizeof(FreePixmapData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            RenderCommand command(RenderCommand::Type::FREE_PIXMAP, header.layer_id);
+            command.pixmap.id = static_cast<const FreePixmapData*>(data)->pixmap_id;
+            return command;
+        }
+        
+        case MessageType::SET_PIXMAP_TARGET: {
+            if (header.data_size < sizeof(PixmapTargetData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromPixmapTargetData(*static_cast<const PixmapTargetData*>(data), header.layer_id);
+        }
+        
+        case MessageType::CREATE_OBJECT: {
+            if (header.data_size < sizeof(ObjectData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* object_data = static_cast<const ObjectData*>(data);
+            const float values[] = {object_data->position.x, object_data->position.y, object_data->width,
+                                    object_data->height, object_data->rotation, object_data->corner_radius,
+                                    object_data->opacity};
+            if (!std::all_of(std::begin(values), std::end(values), [](float v) { return std::isfinite(v); })) {
+                Logger::warning("Non-finite object from client {}", header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            if (object_data->shape > Constants::OBJECT_SHAPE_IMAGE) {
+                Logger::warning("Unknown object shape {} from client {}", object_data->shape, header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromObjectData(*object_data, header.layer_id);
+        }
+        
+        case MessageType::UPDATE_OBJECT: {
+            if (header.data_size < sizeof(ObjectUpdateData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            const auto* update_data = static_cast<const ObjectUpdateData*>(data);
+            const float values[] = {update_data->position.x, update_data->position.y, update_data->width,
+                                    update_data->height, update_data->rotation, update_data->opacity};
+            if (!std::all_of(std::begin(values), std::end(values), [](float v) { return std::isfinite(v); })) {
+                Logger::warning("Non-finite object update from client {}", header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            if (update_data->easing > Constants::EASING_OUT_BACK) {
+                Logger::warning("Unknown easing {} from client {}", update_data->easing, header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            return fromObjectUpdateData(*update_data, header.layer_id);
+        }
+        
+        case MessageType::DELETE_OBJECT: {
+            if (header.data_size < sizeof(DeleteObjectData)) {
+                Logger::warning("Truncated {} from client {}", messageTypeToString(header.type), header.client_id);
+                return RenderCommand(RenderCommand::Type::BATCH_MARKER, header.layer_id);
+            }
+            RenderCommand command(RenderCommand::Type::DELETE_OBJECT, header.layer_id);
+            command.object.id = static_cast<const DeleteObjectData*>(data)->object_id;
+            return command;
+        }
+        
         default: {
             Logger::warning("Unknown message type for conversion: {}", static_cast<int>(header.type));
             return RenderCommand{}; // Default empty command
@@ -377,6 +482,39 @@ RenderCommand CommandConverter::fromNetworkMessage(const MessageHeader& header,
     }
 }
 
+bool CommandConverter::canConvert(MessageType type) {
+    switch (type) {
+        case MessageType::DRAW_POINT:
+        case MessageType::DRAW_LINE:
+        case MessageType::DRAW_RECTANGLE:
+        case MessageType::FILL_RECTANGLE:
+        case MessageType::DRAW_ARC:
+        case MessageType::FILL_ARC:
+        case MessageType::DRAW_POLYGON:
+        case MessageType::FILL_POLYGON:
+        case MessageType::DRAW_ROUNDED_RECTANGLE:
+        case MessageType::FILL_ROUNDED_RECTANGLE:
+        case MessageType::FILL_GRADIENT:
+        case MessageType::DRAW_TEXT:
+        case MessageType::DRAW_TEXTURED_QUADS:
+        case MessageType::DRAW_SPRITES_INSTANCED:
+        case MessageType::COPY_AREA:
+        case MessageType::CLEAR_LAYER:
+        case MessageType::SET_LAYER_TRANSFORM:
+        case MessageType::PUSH_CLIP:
+        case MessageType::POP_CLIP:
+        case MessageType::CREATE_PIXMAP:
+        case MessageType::FREE_PIXMAP:
+        case MessageType::SET_PIXMAP_TARGET:
+        case MessageType::CREATE_OBJECT:
+        case MessageType::UPDATE_OBJECT:
+        case MessageType::DELETE_OBJECT:
+            return true;
+        default:
+            return false;
+    }
+}
+
 RenderCommand CommandConverter::fromDrawPointData(const DrawPointData& data, uint8_t layer_id) {
     RenderCommand command(RenderCommand::Type::DRAW_POINT, layer_id);
     command.point.position = data.position;
@@ -407,6 +545,79 @@ RenderCommand CommandConverter::fromDrawRectangleData(const DrawRectangleData& d
     return command;
 }
 
+RenderCommand CommandConverter::fromDrawArcData(const DrawArcData& data, uint8_t layer_id, bool filled) {
+    RenderCommand command(RenderCommand::Type::DRAW_ARC, layer_id);
+    command.arc.center = data.center;
+    command.arc.radius_x = std::fabs(data.width) * 0.5f;
+    command.arc.radius_y = std::fabs(data.height) * 0.5f;
+    
+    // Counter-clockwise in y-up 1/64 degrees becomes a clockwise range of
+    // degrees on screen
+    const float start = static_cast<float>(data.angle1) / 64.0f;
+    const float extent = std::clamp(static_cast<float>(data.angle2) / 64.0f, -360.0f, 360.0f);
+    command.arc.start_angle = -std::max(start, start + extent);
+    command.arc.end_angle = -std::min(start, start + extent);
+    
+    command.arc.color = Color{255, 255, 255, 255}; // Default white
+    command.arc.filled = filled;
+    command.estimated_vertex_count = filled ? 96 : 64; // Tessellated; depends on radius
+    return command;
+}
+
+RenderCommand CommandConverter::fromDrawPolygonData(const DrawPolygonData& data, const Point* points,
+                                                   uint8_t layer_id, bool filled) {
+    RenderCommand command(RenderCommand::Type::DRAW_POLYGON, layer_id);
+    command.polygon.color = Color{255, 255, 255, 255}; // Default white
+    command.polygon.filled = filled;
+    command.polygon.convex = data.shape == Constants::CONVEX;
+    
+    command.polygon_points.reserve(data.point_count);
+    Point previous;
+    for (uint16_t i = 0; i < data.point_count; ++i) {
+        Point point;
+        std::memcpy(&point, points + i, sizeof(Point));
+        if (data.coord_mode == Constants::COORD_MODE_PREVIOUS && i > 0) {
+            point.x += previous.x;
+            point.y += previous.y;
+        }
+        command.polygon_points.push_back(point);
+        previous = point;
+    }
+    
+    const size_t count = command.polygon_points.size();
+    command.estimated_vertex_count = filled ? std::max<size_t>(count, 2) * 3 - 6 : count * 2;
+    command.estimated_memory_usage = sizeof(RenderCommand) + command.polygon_points.size() * sizeof(Point);
+    return command;
+}
+
+RenderCommand CommandConverter::fromDrawRoundedRectangleData(const DrawRoundedRectangleData& data,
+                                                            uint8_t layer_id, bool filled) {
+    RenderCommand command(RenderCommand::Type::DRAW_ROUNDED_RECTANGLE, layer_id);
+    command.rounded_rectangle.position = data.position;
+    command.rounded_rectangle.width = data.width;
+    command.rounded_rectangle.height = data.height;
+    std::memcpy(command.rounded_rectangle.radii, data.radii, sizeof(data.radii));
+    command.rounded_rectangle.color = Color{255, 255, 255, 255}; // Default white
+    command.rounded_rectangle.filled = filled;
+    command.estimated_vertex_count = filled ? 96 : 192; // Tessellated; depends on the radii
+    return command;
+}
+
+RenderCommand CommandConverter::fromFillGradientData(const FillGradientData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::FILL_GRADIENT, layer_id);
+    command.gradient.position = data.position;
+    command.gradient.width = data.width;
+    command.gradient.height = data.height;
+    command.gradient.from = data.from;
+    command.gradient.to = data.to;
+    command.gradient.from_color = Color(static_cast<uint32_t>(data.from_rgba));
+    command.gradient.to_color = Color(static_cast<uint32_t>(data.to_rgba));
+    command.gradient.shape = data.shape;
+    command.gradient.radial = data.kind == Constants::GRADIENT_RADIAL;
+    command.estimated_vertex_count = command.gradient.radial ? 512 : 96; // Radial fills are meshed finer
+    return command;
+}
+
 RenderCommand CommandConverter::fromDrawTextData(const DrawTextData& data, 
                                                 const std::string& text, uint8_t layer_id) {
     RenderCommand command(RenderCommand::Type::DRAW_TEXT, layer_id);
@@ -431,6 +642,108 @@ RenderCommand CommandConverter::fromDrawTexturedQuadsData(const DrawTexturedQuad
     return command;
 }
 
+RenderCommand CommandConverter::fromDrawSpritesInstancedData(const DrawSpritesInstancedData& data,
+                                                            const SpriteInstance* instances, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::DRAW_SPRITES, layer_id);
+    command.sprites.texture_id = data.texture_id;
+    
+    // Kept compact; expanded to quads only when drawn
+    command.sprite_instances.resize(data.instance_count);
+    std::memcpy(command.sprite_instances.data(), instances, data.instance_count * sizeof(SpriteInstance));
+    
+    command.estimated_vertex_count = command.sprite_instances.size() * 4;
+    command.estimated_memory_usage = sizeof(RenderCommand) + command.sprite_instances.size() * sizeof(SpriteInstance);
+    return command;
+}
+
+RenderCommand CommandConverter::fromLayerTransformData(const LayerTransformData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::SET_LAYER_TRANSFORM, layer_id);
+    command.layer_transform.a = data.a;
+    command.layer_transform.b = data.b;
+    command.layer_transform.c = data.c;
+    command.layer_transform.d = data.d;
+    command.layer_transform.tx = data.tx;
+    command.layer_transform.ty = data.ty;
+    command.layer_transform.rerasterize = (data.flags & Constants::LAYER_TRANSFORM_RERASTERIZE) != 0;
+    return command;
+}
+
+RenderCommand CommandConverter::fromClipRectData(const ClipRectData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::PUSH_CLIP, layer_id);
+    command.clip.x = data.x;
+    command.clip.y = data.y;
+    command.clip.width = data.width;
+    command.clip.height = data.height;
+    return command;
+}
+
+RenderCommand CommandConverter::fromCreatePixmapData(const CreatePixmapData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::CREATE_PIXMAP, layer_id);
+    command.pixmap.id = data.pixmap_id;
+    command.pixmap.width = data.width;
+    command.pixmap.height = data.height;
+    command.pixmap.clear = false;
+    return command;
+}
+
+RenderCommand CommandConverter::fromPixmapTargetData(const PixmapTargetData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::SET_PIXMAP_TARGET, layer_id);
+    command.pixmap.id = data.pixmap_id;
+    command.pixmap.width = 0;
+    command.pixmap.height = 0;
+    command.pixmap.clear = (data.flags & Constants::PIXMAP_TARGET_CLEAR) != 0;
+    return command;
+}
+
+RenderCommand CommandConverter::fromCopyAreaData(const CopyAreaData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::COPY_AREA, layer_id);
+    command.copy_area.src_x = data.src_x;
+    command.copy_area.src_y = data.src_y;
+    command.copy_area.width = data.width;
+    command.copy_area.height = data.height;
+    command.copy_area.dst_x = data.dst_x;
+    command.copy_area.dst_y = data.dst_y;
+    return command;
+}
+
+RenderCommand CommandConverter::fromObjectData(const ObjectData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::CREATE_OBJECT, layer_id);
+    command.object.id = data.object_id;
+    command.object.shape = data.shape;
+    command.object.fields = 0;
+    command.object.easing = Constants::EASING_LINEAR;
+    command.object.flags = 0;
+    command.object.texture_id = data.texture_id;
+    command.object.duration_ms = 0;
+    command.object.position = data.position;
+    command.object.width = data.width;
+    command.object.height = data.height;
+    command.object.rotation = data.rotation;
+    command.object.corner_radius = data.corner_radius;
+    command.object.color = Color(data.color);
+    command.object.opacity = data.opacity;
+    return command;
+}
+
+RenderCommand CommandConverter::fromObjectUpdateData(const ObjectUpdateData& data, uint8_t layer_id) {
+    RenderCommand command(RenderCommand::Type::UPDATE_OBJECT, layer_id);
+    command.object.id = data.object_id;
+    command.object.shape = 0;
+    command.object.fields = data.fields;
+    command.object.easing = data.easing;
+    command.object.flags = data.flags;
+    command.object.texture_id = 0;
+    command.object.duration_ms = data.duration_ms;
+    command.object.position = data.position;
+    command.object.width = data.width;
+    command.object.height = data.height;
+    command.object.rotation = data.rotation;
+    command.object.corner_radius = 0.0f;
+    command.object.color = Color(data.color);
+    command.object.opacity = data.opacity;
+    return command;
+}
+
 RenderCommand::Priority CommandConverter::assignPriority(MessageType message_type, uint8_t layer_id) {
     // Layer 0 is typically high priority (UI/HUD)
     if (layer_id == 0) {
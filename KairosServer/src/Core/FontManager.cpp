@@ -24,14 +24,23 @@ bool FontManager::initialize() {
     addFontSearchPath("./assets/fonts/");             // Local fonts
     addFontSearchPath("./fonts/");                    // Alternative local path
     
-    // Scan for available fonts
-    scanSystemFonts();
+    // Scan for available fonts off the startup path
+    std::vector<std::string> search_paths;
+    {
+        std::lock_guard<std::mutex> lock(m_fonts_mutex);
+        search_paths = m_font_search_paths;
+    }
+    m_font_index = std::async(std::launch::async, &FontManager::scanSystemFonts, std::move(search_paths)).share();
     
-    Logger::info("FontManager initialization complete. Found {} system fonts", 
-                m_available_fonts.size());
+    Logger::info("FontManager initialization complete, indexing system fonts in the background");
     return true;
 }
 
+bool FontManager::isFontIndexReady() const {
+    return m_font_index.valid() &&
+           m_font_index.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
 uint32_t FontManager::loadFont(const std::string& font_path, uint32_t font_size, 
                               const std::vector<int>& codepoints) {
     std::lock_guard<std::mutex> lock(m_fonts_mutex);
@@ -88,6 +97,35 @@ uint32_t FontManager::loadFont(const std::string& font_path, uint32_t font_size,
     }
 }
 
+bool FontManager::restoreFont(uint32_t font_id, const std::string& font_path, uint32_t font_size) {
+    uint32_t loaded_id = loadFont(font_path, font_size);
+    if (loaded_id == 0) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_fonts_mutex);
+    
+    if (loaded_id != font_id) {
+        if (m_loaded_fonts.count(font_id)) {
+            Logger::warning("Cannot restore font {} from {}: id already in use, keeping id {}",
+                           font_id, font_path, loaded_id);
+            return false;
+        }
+        
+        auto node = m_loaded_fonts.extract(loaded_id);
+        node.key() = font_id;
+        node.mapped().id = font_id;
+        m_loaded_fonts.insert(std::move(node));
+    }
+    
+    // Keep restored ids from colliding with ones generated from now on
+    uint32_t next_id = m_next_font_id.load();
+    while (next_id <= font_id && !m_next_font_id.compare_exchange_weak(next_id, font_id + 1)) {
+    }
+    
+    return true;
+}
+
 uint32_t FontManager::loadFontFromMemory(const void* data, size_t data_size, 
                                         uint32_t font_size, const std::string& font_name) {
     std::lock_guard<std::mutex> lock(m_fonts_mutex);
@@ -221,8 +259,7 @@ std::vector<FontManager::FontInfo> FontManager::getLoadedFonts() const {
 }
 
 std::vector<std::string> FontManager::getAvailableSystemFonts() const {
-    std::lock_guard<std::mutex> lock(m_fonts_mutex);
-    return m_available_fonts;
+    return getFontIndex();
 }
 
 void FontManager::addFontSearchPath(const std::string& path) {
@@ -254,7 +291,7 @@ FontManager::Stats FontManager::getStats() const {
     
     Stats stats;
     stats.loaded_fonts = m_loaded_fonts.size();
-    stats.available_system_fonts = m_available_fonts.size();
+    stats.available_system_fonts = getFontIndexSize();
     stats.default_font_id = m_default_font_id;
     
     for (const auto& [font_id, font_data] : m_loaded_fonts) {
@@ -351,10 +388,10 @@ void FontManager::loadDefaultFont() {
     Logger::debug("Default font loaded with ID {}", m_default_font_id);
 }
 
-void FontManager::scanSystemFonts() {
-    m_available_fonts.clear();
+std::vector<std::string> FontManager::scanSystemFonts(const std::vector<std::string>& search_paths) {
+    std::vector<std::string> available_fonts;
     
-    for (const std::string& search_path : m_font_search_paths) {
+    for (const std::string& search_path : search_paths) {
         if (!std::filesystem::exists(search_path)) {
             continue;
         }
@@ -367,7 +404,7 @@ void FontManager::scanSystemFonts() {
                     
                     if (extension == ".ttf" || extension == ".otf" || 
                         extension == ".ttc" || extension == ".otc") {
-                        m_available_fonts.push_back(entry.path().string());
+                        available_fonts.push_back(entry.path().string());
                     }
                 }
             }
@@ -376,7 +413,17 @@ void FontManager::scanSystemFonts() {
         }
     }
     
-    Logger::debug("Scanned system fonts: found {} font files", m_available_fonts.size());
+    Logger::debug("Scanned system fonts: found {} font files", available_fonts.size());
+    return available_fonts;
+}
+
+const std::vector<std::string>& FontManager::getFontIndex() const {
+    static const std::vector<std::string> empty;
+    return m_font_index.valid() ? m_font_index.get() : empty;
+}
+
+size_t FontManager::getFontIndexSize() const {
+    return isFontIndexReady() ? m_font_index.get().size() : 0;
 }
 
 std::string FontManager::findFontFile(const std::string& family_name, const std::string& style) const {
@@ -387,7 +434,7 @@ std::string FontManager::findFontFile(const std::string& family_name, const std:
     std::transform(target_style.begin(), target_style.end(), target_style.begin(), ::tolower);
     
     // Simple heuristic font matching
-    for (const std::string& font_path : m_available_fonts) {
+    for (const std::string& font_path : getFontIndex()) {
         std::string filename = std::filesystem::path(font_path).filename().string();
         std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
         
@@ -483,7 +530,7 @@ std::string FontManager::getDebugInfo() const {
     std::stringstream ss;
     ss << "FontManager Debug Info:\n";
     ss << "Loaded fonts: " << m_loaded_fonts.size() << "\n";
-    ss << "Available system fonts: " << m_available_fonts.size() << "\n";
+    ss << "Available system fonts: " << getFontIndexSize() << (isFontIndexReady() ? "" : " (indexing)") << "\n";
     ss << "Default font ID: " << m_default_font_id << "\n";
     ss << "Search paths: " << m_font_search_paths.size() << "\n\n";
     
@@ -0,0 +1,416 @@
+// KairosServer/src/Core/HotUpgrade.cpp
+#include <Core/HotUpgrade.hpp>
+#include <Utils/BinaryIO.hpp>
+#include <Utils/Logger.hpp>
+
+#ifndef _WIN32
+    #include <sys/socket.h>
+    #include <sys/wait.h>
+    #include <csignal>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace Kairos {
+
+namespace {
+
+constexpr char READY_BYTE = 'R';
+constexpr char ACK_BYTE = 'A';
+
+// magic, version, blob size, fd count
+constexpr size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+void closeDescriptors(const std::vector<int>& fds) {
+#ifndef _WIN32
+    for (int fd : fds) {
+        ::close(fd);
+    }
+#endif
+}
+
+} // anonymous namespace
+
+HotUpgrade::HotUpgrade() = default;
+
+HotUpgrade::~HotUpgrade() {
+    abort();
+}
+
+bool HotUpgrade::isSupported() {
+    return UnixSocket::isSupported();
+}
+
+bool HotUpgrade::spawnReplacement(const std::vector<std::string>& command) {
+#ifndef _WIN32
+    if (isInProgress()) {
+        Logger::warning("Hot upgrade already in progress");
+        return false;
+    }
+    if (command.empty()) {
+        Logger::error("Hot upgrade needs the command line of the new binary");
+        return false;
+    }
+    
+    int pair[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0) {
+        Logger::error("Failed to create hot upgrade control socket: {}", strerror(errno));
+        return false;
+    }
+    
+    // Everything the child needs is prepared before fork(): after it only
+    // async-signal-safe calls are allowed
+    std::vector<std::string> args = command;
+    args.push_back("--takeover-fd");
+    args.push_back(std::to_string(pair[1]));
+    
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    
+    long max_fd = sysconf(_SC_OPEN_MAX);
+    if (max_fd < 0) {
+        max_fd = 1024;
+    }
+    
+    pid_t pid = fork();
+    if (pid < 0) {
+        Logger::error("Failed to fork replacement process: {}", strerror(errno));
+        ::close(pair[0]);
+        ::close(pair[1]);
+        return false;
+    }
+    
+    if (pid == 0) {
+        // Sockets reach the new process only through the control socket, so
+        // it never holds a client it does not know about
+        for (int fd = 3; fd < max_fd; ++fd) {
+            if (fd != pair[1]) {
+                ::close(fd);
+            }
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    
+    ::close(pair[1]);
+    m_control = std::make_unique<UnixSocket>(pair[0]);
+    m_child_pid = pid;
+    
+    Logger::info("Started replacement process {} ({})", pid, command[0]);
+    return true;
+#else
+    (void)command;
+    Logger::error("Hot upgrade is not supported on this platform");
+    return false;
+#endif
+}
+
+bool HotUpgrade::isReplacementReady() {
+    if (!isInProgress() || !m_control) {
+        return false;
+    }
+    
+#ifndef _WIN32
+    int status = 0;
+    if (waitpid(m_child_pid, &status, WNOHANG) == m_child_pid) {
+        Logger::error("Replacement process {} exited before taking over", m_child_pid);
+        m_child_pid = -1;
+        m_control.reset();
+        return false;
+    }
+#endif
+    
+    if (!m_control->isDataAvailable(0)) {
+        return false;
+    }
+    
+    char byte = 0;
+    if (m_control->receive(&byte, 1) != 1 || byte != READY_BYTE) {
+        Logger::error("Replacement process closed the control socket before becoming ready");
+        abort();
+        return false;
+    }
+    
+    return true;
+}
+
+bool HotUpgrade::sendState(const State& state) {
+    if (!m_control) {
+        return false;
+    }
+    
+    std::vector<uint8_t> blob;
+    std::vector<int> fds;
+    serialize(state, blob, fds);
+    
+    std::vector<uint8_t> header;
+    BinaryWriter writer(header);
+    writer.write(MAGIC);
+    writer.write(FORMAT_VERSION);
+    writer.write(static_cast<uint64_t>(blob.size()));
+    writer.write(static_cast<uint32_t>(fds.size()));
+    
+    if (!sendAll(header.data(), header.size()) || !sendAll(blob.data(), blob.size())) {
+        Logger::error("Failed to send upgrade state to the replacement process");
+        return false;
+    }
+    
+    for (int fd : fds) {
+        if (!m_control->sendFileDescriptor(fd)) {
+            return false;
+        }
+    }
+    
+    Logger::info("Sent {} KB of state and {} sockets, waiting for the replacement",
+                 blob.size() / 1024, fds.size());
+    
+    char ack = 0;
+    m_control->setReceiveTimeout(ACK_TIMEOUT_MS);
+    if (!receiveAll(&ack, 1) || ack != ACK_BYTE) {
+        Logger::error("Replacement process did not acknowledge the handover");
+        return false;
+    }
+    
+    // The replacement outlives us; it is no longer ours to kill
+    m_child_pid = -1;
+    m_control.reset();
+    return true;
+}
+
+void HotUpgrade::abort() {
+    m_control.reset();
+    
+#ifndef _WIN32
+    if (m_child_pid > 0) {
+        Logger::warning("Stopping replacement process {}", m_child_pid);
+        kill(m_child_pid, SIGKILL);
+        waitpid(m_child_pid, nullptr, 0);
+    }
+#endif
+    m_child_pid = -1;
+}
+
+bool HotUpgrade::attach(int control_fd) {
+#ifndef _WIN32
+    // Not inherited by anything this process might exec later
+    fcntl(control_fd, F_SETFD, FD_CLOEXEC);
+#endif
+    
+    m_control = std::make_unique<UnixSocket>(control_fd);
+    m_control->setReceiveTimeout(ACK_TIMEOUT_MS);
+    
+    if (!sendAll(&READY_BYTE, 1)) {
+        Logger::error("Failed to reach the previous process on control socket {}", control_fd);
+        m_control.reset();
+        return false;
+    }
+    return true;
+}
+
+bool HotUpgrade::receiveState(State& state) {
+    if (!m_control) {
+        return false;
+    }
+    
+    uint8_t header[HEADER_SIZE];
+    if (!receiveAll(header, sizeof(header))) {
+        Logger::error("Failed to receive upgrade header from the previous process");
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t blob_size = 0;
+    uint32_t fd_count = 0;
+    BinaryReader reader(header, sizeof(header));
+    reader.read(magic);
+    reader.read(version);
+    reader.read(blob_size);
+    reader.read(fd_count);
+    
+    if (magic != MAGIC || version != FORMAT_VERSION) {
+        Logger::error("Incompatible upgrade state (magic {:#x}, version {}, expected version {})",
+                      magic, version, FORMAT_VERSION);
+        return false;
+    }
+    
+    std::vector<uint8_t> blob(static_cast<size_t>(blob_size));
+    if (!receiveAll(blob.data(), blob.size())) {
+        Logger::error("Upgrade state truncated ({} bytes expected)", blob_size);
+        return false;
+    }
+    
+    std::vector<int> fds;
+    for (uint32_t i = 0; i < fd_count; ++i) {
+        int fd = m_control->receiveFileDescriptor();
+        if (fd < 0) {
+            closeDescriptors(fds);
+            return false;
+        }
+        fds.push_back(fd);
+    }
+    
+    if (!deserialize(blob, fds, state)) {
+        closeDescriptors(fds);
+        return false;
+    }
+    
+    Logger::info("Received upgrade state: {} clients, {} layers, {} textures, {} fonts",
+                 state.network.clients.size(), state.scene.layers.size(),
+                 state.scene.textures.size(), state.scene.fonts.size());
+    return true;
+}
+
+bool HotUpgrade::acknowledge() {
+    bool ok = sendAll(&ACK_BYTE, 1);
+    m_control.reset();
+    return ok;
+}
+
+void HotUpgrade::serialize(const State& state, std::vector<uint8_t>& blob, std::vector<int>& fds) {
+    // Sockets are written as indices into the descriptor list sent after the blob
+    auto descriptorIndex = [&fds](int fd) -> int32_t {
+        if (fd < 0) {
+            return -1;
+        }
+        fds.push_back(fd);
+        return static_cast<int32_t>(fds.size() - 1);
+    };
+    
+    const auto& network = state.network;
+    BinaryWriter writer(blob);
+    writer.write(network.next_client_id);
+    writer.write(descriptorIndex(network.tcp_socket));
+    writer.write(descriptorIndex(network.unix_socket));
+    
+    writer.write(static_cast<uint32_t>(network.clients.size()));
+    for (const auto& session : network.clients) {
+        writer.write(descriptorIndex(session.socket));
+        writer.write(session.client_id);
+        writer.write(static_cast<uint8_t>(session.connection_type));
+        writer.writeString(session.client_name);
+        writer.write(session.client_version);
+        writer.write(session.capabilities);
+        writer.write(session.requested_layers);
+        writer.writeString(session.endpoint_address);
+        writer.write(session.endpoint_port);
+        writer.write(session.ping_sequence);
+        writer.write(session.messages_sent);
+        writer.write(session.messages_received);
+        writer.write(session.bytes_sent);
+        writer.write(session.bytes_received);
+        writer.writeVector(session.pending_receive);
+        writer.writeVector(session.pending_send);
+    }
+    writer.writeVector(network.virtual_clients);
+    
+    const auto& input = state.input;
+    writer.writeVector(input.regions);
+    writer.writeVector(input.masks);
+    writer.write(input.pointer_grab);
+    writer.write(input.focus);
+    writer.write(static_cast<uint8_t>(input.keyboard_grabbed));
+    
+    state.scene.serialize(writer);
+}
+
+bool HotUpgrade::deserialize(const std::vector<uint8_t>& blob, const std::vector<int>& fds, State& state) {
+    bool fds_valid = true;
+    auto descriptor = [&fds, &fds_valid](int32_t index) -> int {
+        if (index < 0) {
+            return -1;
+        }
+        if (static_cast<size_t>(index) >= fds.size()) {
+            fds_valid = false;
+            return -1;
+        }
+        return fds[index];
+    };
+    
+    auto& network = state.network;
+    BinaryReader reader(blob.data(), blob.size());
+    int32_t tcp_index = -1;
+    int32_t unix_index = -1;
+    uint32_t client_count = 0;
+    reader.read(network.next_client_id);
+    reader.read(tcp_index);
+    reader.read(unix_index);
+    reader.read(client_count);
+    network.tcp_socket = descriptor(tcp_index);
+    network.unix_socket = descriptor(unix_index);
+    
+    network.clients.clear();
+    for (uint32_t i = 0; i < client_count && reader.isValid(); ++i) {
+        Client::Session session;
+        int32_t socket_index = -1;
+        uint8_t type = 0;
+        reader.read(socket_index);
+        reader.read(session.client_id);
+        reader.read(type);
+        reader.readString(session.client_name);
+        reader.read(session.client_version);
+        reader.read(session.capabilities);
+        reader.read(session.requested_layers);
+        reader.readString(session.endpoint_address);
+        reader.read(session.endpoint_port);
+        reader.read(session.ping_sequence);
+        reader.read(session.messages_sent);
+        reader.read(session.messages_received);
+        reader.read(session.bytes_sent);
+        reader.read(session.bytes_received);
+        reader.readVector(session.pending_receive);
+        reader.readVector(session.pending_send);
+        session.socket = descriptor(socket_index);
+        session.connection_type = static_cast<Client::Type>(type);
+        network.clients.push_back(std::move(session));
+    }
+    reader.readVector(network.virtual_clients);
+    
+    auto& input = state.input;
+    uint8_t keyboard_grabbed = 0;
+    reader.readVector(input.regions);
+    reader.readVector(input.masks);
+    reader.read(input.pointer_grab);
+    reader.read(input.focus);
+    reader.read(keyboard_grabbed);
+    input.keyboard_grabbed = keyboard_grabbed != 0;
+    
+    if (!reader.isValid() || !fds_valid) {
+        Logger::error("Upgrade state is corrupt");
+        return false;
+    }
+    
+    return state.scene.deserialize(reader);
+}
+
+bool HotUpgrade::sendAll(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        int sent = m_control->send(bytes, size);
+        if (sent <= 0) {
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool HotUpgrade::receiveAll(void* data, size_t size) {
+    auto* bytes = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        int received = m_control->receive(bytes, size);
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+} // namespace Kairos
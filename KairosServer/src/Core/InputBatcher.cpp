@@ -0,0 +1,122 @@
+// KairosServer/src/Core/InputBatcher.cpp
+#include "InputBatcher.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Kairos {
+
+void InputBatcher::add(const InputRouter::Target& target, const InputEvent& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Pending& pending = m_pending[target.client_id];
+    pending.delivery_flags = target.delivery_flags;
+    m_stats.events_queued++;
+
+    if (!(target.delivery_flags & InputRouting::DELIVER_MOTION_HISTORY) && !pending.events.empty()) {
+        InputBatchEvent& last = pending.events.back();
+        if (canCoalesce(last.event, event)) {
+            const float wheel_delta = last.event.wheel_delta;
+            last.event = event;
+            if (event.type == InputEventType::MOUSE_WHEEL) {
+                last.event.wheel_delta = wheel_delta + event.wheel_delta;
+            }
+            last.region_id = target.region_id;
+            last.layer_id = target.layer_id;
+            pending.coalesced++;
+            m_stats.events_coalesced++;
+            return;
+        }
+    }
+
+    InputBatchEvent entry{};
+    entry.region_id = target.region_id;
+    entry.layer_id = target.layer_id;
+    entry.event = event;
+    pending.events.push_back(entry);
+}
+
+bool InputBatcher::canCoalesce(const InputEvent& previous, const InputEvent& next) {
+    if (previous.type != next.type) {
+        return false;
+    }
+    switch (next.type) {
+        case InputEventType::MOUSE_MOVE:
+            return true;
+        case InputEventType::TOUCH_MOVE:
+            return previous.button == next.button;      // Same touch point
+        case InputEventType::MOUSE_WHEEL:
+            return previous.modifiers == next.modifiers;
+        default:
+            return false;
+    }
+}
+
+void InputBatcher::flush(uint32_t frame_number, const SendFunction& send) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& [client_id, pending] : m_pending) {
+        if (pending.events.empty()) {
+            continue;
+        }
+
+        if (pending.delivery_flags & InputRouting::DELIVER_BATCHED) {
+            const size_t total = pending.events.size();
+            for (size_t offset = 0; offset < total; offset += Limits::MAX_INPUT_BATCH_EVENTS) {
+                const auto count = static_cast<uint16_t>(
+                    std::min<size_t>(Limits::MAX_INPUT_BATCH_EVENTS, total - offset));
+                const uint16_t coalesced = offset == 0 ? pending.coalesced : 0;
+                if (!sendBatch(client_id, frame_number, pending.events.data() + offset, count, coalesced, send)) {
+                    break;
+                }
+            }
+        } else {
+            for (const InputBatchEvent& entry : pending.events) {
+                MessageHeader header = ProtocolHelper::createHeader(MessageType::INPUT_EVENT, client_id, 0,
+                                                                    sizeof(InputEvent), entry.layer_id);
+                if (!send(client_id, header, &entry.event)) {
+                    break;
+                }
+                m_stats.messages_sent++;
+            }
+        }
+
+        pending.events.clear();
+        pending.coalesced = 0;
+    }
+}
+
+bool InputBatcher::sendBatch(uint32_t client_id, uint32_t frame_number, const InputBatchEvent* events,
+                             uint16_t count, uint16_t coalesced, const SendFunction& send) {
+    InputBatchHeader batch{};
+    batch.frame_number = frame_number;
+    batch.event_count = count;
+    batch.coalesced_count = coalesced;
+
+    const size_t events_size = static_cast<size_t>(count) * sizeof(InputBatchEvent);
+    m_buffer.resize(sizeof(InputBatchHeader) + events_size);
+    std::memcpy(m_buffer.data(), &batch, sizeof(InputBatchHeader));
+    std::memcpy(m_buffer.data() + sizeof(InputBatchHeader), events, events_size);
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::INPUT_BATCH, client_id, 0,
+                                                        static_cast<uint32_t>(m_buffer.size()));
+    if (!send(client_id, header, m_buffer.data())) {
+        Logger::debug("Dropped an input batch of {} events for client {}", count, client_id);
+        return false;
+    }
+    m_stats.messages_sent++;
+    m_stats.batches_sent++;
+    return true;
+}
+
+void InputBatcher::removeClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.erase(client_id);
+}
+
+InputBatcher::Stats InputBatcher::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace Kairos
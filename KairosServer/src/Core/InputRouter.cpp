@@ -0,0 +1,353 @@
+// KairosServer/src/Core/InputRouter.cpp
+#include "InputRouter.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace Kairos {
+
+namespace {
+
+bool isPointerEvent(InputEventType type) {
+    switch (type) {
+        case InputEventType::MOUSE_MOVE:
+        case InputEventType::MOUSE_PRESS:
+        case InputEventType::MOUSE_RELEASE:
+        case InputEventType::MOUSE_WHEEL:
+        case InputEventType::TOUCH_BEGIN:
+        case InputEventType::TOUCH_MOVE:
+        case InputEventType::TOUCH_END:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // anonymous namespace
+
+InputRouter::InputRouter(const Config& config)
+    : m_config(config), m_grid(config.grid_cell_size) {
+}
+
+bool InputRouter::handleRequest(uint32_t client_id, const MessageHeader& header, const std::vector<uint8_t>& data) {
+    switch (header.type) {
+        case MessageType::SET_INPUT_REGION: {
+            if (data.size() != sizeof(InputRegionData)) {
+                return false;
+            }
+            InputRegionData region;
+            std::memcpy(&region, data.data(), sizeof(InputRegionData));
+            setRegion(client_id, region);
+            return true;
+        }
+
+        case MessageType::SET_INPUT_GRAB: {
+            if (data.size() != sizeof(InputGrabData)) {
+                return false;
+            }
+            InputGrabData grab;
+            std::memcpy(&grab, data.data(), sizeof(InputGrabData));
+            setGrab(client_id, grab);
+            return true;
+        }
+
+        case MessageType::SET_INPUT_MASK: {
+            if (data.size() != sizeof(InputMaskData)) {
+                return false;
+            }
+            InputMaskData mask;
+            std::memcpy(&mask, data.data(), sizeof(InputMaskData));
+            setMask(client_id, mask);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void InputRouter::setRegion(uint32_t client_id, const InputRegionData& data) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint32_t region_id = data.region_id;
+    const uint64_t key = regionKey(client_id, region_id);
+    auto& owned = m_client_regions[client_id];
+
+    if (data.flags & InputRouting::REGION_REMOVE) {
+        if (m_grid.remove(key)) {
+            m_regions.erase(key);
+            owned.erase(std::remove(owned.begin(), owned.end(), region_id), owned.end());
+        }
+    } else {
+        const float values[] = {data.x, data.y, data.width, data.height};
+        if (!std::all_of(std::begin(values), std::end(values), [](float v) { return std::isfinite(v); })) {
+            Logger::warning("Non-finite input region from client {}", client_id);
+            if (owned.empty()) {
+                m_client_regions.erase(client_id);
+            }
+            return;
+        }
+        if (m_regions.find(key) == m_regions.end() && owned.size() >= Limits::MAX_INPUT_REGIONS_PER_CLIENT) {
+            Logger::warning("Client {} has {} input regions; region {} refused", client_id, owned.size(), region_id);
+            return;
+        }
+
+        Region region;
+        region.client_id = client_id;
+        region.region_id = region_id;
+        region.layer_id = data.layer_id;
+        region.order = m_next_order++;
+        region.bounds = SpatialBounds::fromRect(data.x, data.y, data.width, data.height);
+
+        if (m_regions.find(key) == m_regions.end()) {
+            owned.push_back(region_id);
+        }
+        m_regions[key] = region;
+        m_grid.insert(key, region.bounds);
+    }
+
+    if (owned.empty()) {
+        m_client_regions.erase(client_id);
+    }
+    m_stats.regions = static_cast<uint32_t>(m_regions.size());
+}
+
+void InputRouter::setGrab(uint32_t client_id, const InputGrabData& grab) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if ((grab.release & InputRouting::GRAB_POINTER) && m_pointer_grab == client_id) {
+        m_pointer_grab = 0;
+    }
+    if ((grab.release & InputRouting::GRAB_KEYBOARD) && m_focus == client_id) {
+        m_keyboard_grabbed = false;
+    }
+
+    // First grabber wins until it lets go, as with X11 active grabs
+    if (grab.acquire & InputRouting::GRAB_POINTER) {
+        if (m_pointer_grab == 0 || m_pointer_grab == client_id) {
+            m_pointer_grab = client_id;
+        } else {
+            Logger::debug("Client {} cannot grab the pointer: client {} holds it", client_id, m_pointer_grab);
+        }
+    }
+
+    const bool keyboard_free = !m_keyboard_grabbed || m_focus == client_id;
+    if (grab.acquire & (InputRouting::GRAB_KEYBOARD | InputRouting::FOCUS_KEYBOARD)) {
+        if (keyboard_free) {
+            setFocusLocked(client_id);
+            if (grab.acquire & InputRouting::GRAB_KEYBOARD) {
+                m_keyboard_grabbed = true;
+            }
+        } else {
+            Logger::debug("Client {} cannot take keyboard focus: client {} grabbed it", client_id, m_focus);
+        }
+    }
+}
+
+void InputRouter::setMask(uint32_t client_id, const InputMaskData& mask) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Selection& selection = m_selections[client_id];
+    selection.event_mask = mask.event_mask;
+    selection.delivery_flags = mask.flags;
+}
+
+void InputRouter::removeClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto owned = m_client_regions.find(client_id);
+    if (owned != m_client_regions.end()) {
+        for (uint32_t region_id : owned->second) {
+            uint64_t key = regionKey(client_id, region_id);
+            m_grid.remove(key);
+            m_regions.erase(key);
+        }
+        m_client_regions.erase(owned);
+    }
+
+    if (m_pointer_grab == client_id) {
+        m_pointer_grab = 0;
+    }
+    if (m_press_target.client_id == client_id) {
+        m_press_target = Target{};
+    }
+    if (m_focus == client_id) {
+        m_focus = 0;
+        m_keyboard_grabbed = false;
+    }
+    m_selections.erase(client_id);
+    m_stats.regions = static_cast<uint32_t>(m_regions.size());
+}
+
+void InputRouter::exportState(State& state) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    state.regions.clear();
+    for (const auto& [key, region] : m_regions) {
+        State::OwnedRegion owned;
+        owned.client_id = region.client_id;
+        owned.region.region_id = region.region_id;
+        owned.region.layer_id = region.layer_id;
+        owned.region.x = region.bounds.min_x;
+        owned.region.y = region.bounds.min_y;
+        owned.region.width = region.bounds.max_x - region.bounds.min_x;
+        owned.region.height = region.bounds.max_y - region.bounds.min_y;
+        state.regions.push_back(owned);
+    }
+    std::sort(state.regions.begin(), state.regions.end(), [this](const State::OwnedRegion& a, const State::OwnedRegion& b) {
+        return m_regions.at(regionKey(a.client_id, a.region.region_id)).order <
+               m_regions.at(regionKey(b.client_id, b.region.region_id)).order;
+    });
+
+    state.masks.clear();
+    for (const auto& [client_id, selection] : m_selections) {
+        State::OwnedMask owned;
+        owned.client_id = client_id;
+        owned.mask.event_mask = selection.event_mask;
+        owned.mask.flags = selection.delivery_flags;
+        state.masks.push_back(owned);
+    }
+
+    state.pointer_grab = m_pointer_grab;
+    state.focus = m_focus;
+    state.keyboard_grabbed = m_keyboard_grabbed;
+}
+
+void InputRouter::importState(const State& state) {
+    for (const auto& owned : state.regions) {
+        setRegion(owned.client_id, owned.region);
+    }
+    for (const auto& owned : state.masks) {
+        setMask(owned.client_id, owned.mask);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pointer_grab = state.pointer_grab;
+    m_focus = state.focus;
+    m_keyboard_grabbed = state.focus != 0 && state.keyboard_grabbed;
+}
+
+bool InputRouter::route(const InputEvent& event, const std::bitset<256>& visible_layers, Target& target) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    target = Target{};
+    bool routed = false;
+
+    if (!isPointerEvent(event.type)) {
+        if (m_focus != 0) {
+            target.client_id = m_focus;
+            routed = true;
+        }
+    } else {
+        const bool press = event.type == InputEventType::MOUSE_PRESS || event.type == InputEventType::TOUCH_BEGIN;
+        const bool release = event.type == InputEventType::MOUSE_RELEASE || event.type == InputEventType::TOUCH_END;
+        const uint32_t button_bit = 1u << (event.button & 31);
+
+        Target hit;
+        const bool found = hitTestLocked(event.position.x, event.position.y, visible_layers, hit);
+
+        if (m_pointer_grab != 0) {
+            target = (found && hit.client_id == m_pointer_grab) ? hit : Target{m_pointer_grab, 0, 0};
+            routed = true;
+        } else if (m_press_target.client_id != 0) {
+            target = m_press_target;
+            routed = true;
+        } else if (found) {
+            target = hit;
+            routed = true;
+        }
+
+        if (press) {
+            // The pressed client keeps the pointer until every button is up
+            if (m_buttons_down == 0 && m_pointer_grab == 0 && found) {
+                m_press_target = hit;
+            }
+            m_buttons_down |= button_bit;
+
+            if (m_config.click_to_focus && !m_keyboard_grabbed && found) {
+                setFocusLocked(hit.client_id);
+            }
+        } else if (release) {
+            m_buttons_down &= ~button_bit;
+            if (m_buttons_down == 0) {
+                m_press_target = Target{};
+            }
+        }
+    }
+
+    if (!routed) {
+        m_stats.events_unrouted++;
+        return false;
+    }
+    if (!selectsLocked(target.client_id, event.type, target.delivery_flags)) {
+        m_stats.events_filtered++;
+        return false;
+    }
+    m_stats.events_routed++;
+    return true;
+}
+
+bool InputRouter::hitTest(float x, float y, const std::bitset<256>& visible_layers, Target& target) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return hitTestLocked(x, y, visible_layers, target);
+}
+
+bool InputRouter::hitTestLocked(float x, float y, const std::bitset<256>& visible_layers, Target& target) const {
+    const Region* best = nullptr;
+    m_grid.queryPoint(x, y, [&](uint64_t key, const SpatialBounds&) {
+        const Region& region = m_regions.at(key);
+        if (!visible_layers.test(region.layer_id)) {
+            return;
+        }
+        // Layers composite in id order, so the highest layer is on top
+        if (!best || region.layer_id > best->layer_id ||
+            (region.layer_id == best->layer_id && region.order > best->order)) {
+            best = &region;
+        }
+    });
+
+    if (!best) {
+        return false;
+    }
+    target.client_id = best->client_id;
+    target.region_id = best->region_id;
+    target.layer_id = best->layer_id;
+    return true;
+}
+
+bool InputRouter::selects(uint32_t client_id, InputEventType type, uint8_t& delivery_flags) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return selectsLocked(client_id, type, delivery_flags);
+}
+
+bool InputRouter::selectsLocked(uint32_t client_id, InputEventType type, uint8_t& delivery_flags) const {
+    auto it = m_selections.find(client_id);
+    if (it == m_selections.end()) {
+        delivery_flags = 0;
+        return true;
+    }
+    delivery_flags = it->second.delivery_flags;
+    const uint32_t bit = 1u << (static_cast<uint8_t>(type) & 31);
+    return (it->second.event_mask & bit) != 0;
+}
+
+void InputRouter::setFocusLocked(uint32_t client_id) {
+    if (m_focus != client_id) {
+        m_focus = client_id;
+        m_stats.focus_changes++;
+    }
+}
+
+uint32_t InputRouter::getFocusedClient() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_focus;
+}
+
+InputRouter::Stats InputRouter::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace Kairos
@@ -3,8 +3,10 @@
 #include <Network/Client.hpp>
 #include <Utils/Logger.hpp>
 #include <Graphics/RenderCommand.hpp>
+#include <Clock.hpp>
 #include <thread>
 #include <algorithm>
+#include <cstring>
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -22,7 +24,42 @@
 
 namespace Kairos {
 
-NetworkManager::NetworkManager(const Config& config) : m_config(config) {
+namespace {
+
+/**
+ * @brief Copies settings that cannot change under a running manager from current into next
+ * @return true if next asked to change any of them
+ */
+bool keepRestartOnlySettings(const NetworkManager::Config& current, NetworkManager::Config& next) {
+    bool changed = next.tcp_bind_address != current.tcp_bind_address ||
+                   next.tcp_port != current.tcp_port ||
+                   next.enable_tcp != current.enable_tcp ||
+                   next.unix_socket_path != current.unix_socket_path ||
+                   next.enable_unix_socket != current.enable_unix_socket ||
+                   next.network_thread_count != current.network_thread_count ||
+                   next.use_non_blocking_sockets != current.use_non_blocking_sockets ||
+                   next.enable_tcp_nodelay != current.enable_tcp_nodelay ||
+                   next.accept_thread_policy != current.accept_thread_policy ||
+                   next.network_thread_policy != current.network_thread_policy ||
+                   next.fixed_buffers != current.fixed_buffers;
+
+    next.tcp_bind_address = current.tcp_bind_address;
+    next.tcp_port = current.tcp_port;
+    next.enable_tcp = current.enable_tcp;
+    next.unix_socket_path = current.unix_socket_path;
+    next.enable_unix_socket = current.enable_unix_socket;
+    next.network_thread_count = current.network_thread_count;
+    next.use_non_blocking_sockets = current.use_non_blocking_sockets;
+    next.enable_tcp_nodelay = current.enable_tcp_nodelay;
+    next.accept_thread_policy = current.accept_thread_policy;
+    next.network_thread_policy = current.network_thread_policy;
+    next.fixed_buffers = current.fixed_buffers;
+    return changed;
+}
+
+} // anonymous namespace
+
+NetworkManager::NetworkManager(const Config& config) : m_config(config), m_live_config(config) {
     Logger::info("NetworkManager created");
 }
 
@@ -67,11 +104,7 @@ bool NetworkManager::initialize() {
         m_running = true;
         m_accepting_connections = true;
         
-        for (uint32_t i = 0; i < m_config.network_thread_count; ++i) {
-            m_network_threads.emplace_back(&NetworkManager::networkThreadMain, this);
-        }
-        
-        m_accept_thread = std::thread(&NetworkManager::acceptConnections, this);
+        startThreads();
         
         Logger::info("NetworkManager initialized successfully");
         return true;
@@ -83,7 +116,146 @@ bool NetworkManager::initialize() {
     }
 }
 
+bool NetworkManager::initializeFromHandover(const Handover& handover) {
+    if (m_running) {
+        Logger::warning("NetworkManager already initialized");
+        return true;
+    }
+    
+    Logger::info("Initializing NetworkManager from handover ({} clients)...", handover.clients.size());
+    
+    m_tcp_socket = handover.tcp_socket;
+    m_unix_socket = handover.unix_socket;
+    m_next_client_id = handover.next_client_id;
+    
+    auto config = m_live_config.read();
+    Client::Config client_config;
+    client_config.receive_buffer_size = config->receive_buffer_size;
+    client_config.send_buffer_size = config->send_buffer_size;
+    client_config.timeout_seconds = config->client_timeout_seconds;
+    client_config.fixed_buffers = config->fixed_buffers;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        for (const auto& session : handover.clients) {
+            m_clients[session.client_id] = Client::restore(session, client_config);
+        }
+    }
+    m_stats.active_connections = static_cast<uint32_t>(handover.clients.size());
+    
+    // Proxies keep their virtual clients: frames for them route as before
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        for (const auto& route : handover.virtual_clients) {
+            m_virtual_routes[(static_cast<uint64_t>(route.proxy_id) << 32) | route.virtual_id] = route.client_id;
+            m_virtual_clients[route.client_id] = VirtualClient{route.proxy_id, route.virtual_id};
+        }
+    }
+    m_stats.virtual_clients = static_cast<uint32_t>(handover.virtual_clients.size());
+    
+    m_running = true;
+    m_accepting_connections = true;
+    
+    startThreads();
+    
+    Logger::info("NetworkManager resumed {} clients from the previous process", handover.clients.size());
+    return true;
+}
+
+bool NetworkManager::suspend() {
+    if (!m_running || m_suspended) {
+        return false;
+    }
+    
+    m_running = false;
+    m_accepting_connections = false;
+    wakeAllThreads();
+    
+    if (m_accept_thread.joinable()) {
+        m_accept_thread.join();
+    }
+    for (auto& thread : m_network_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_network_threads.clear();
+    
+    m_suspended = true;
+    Logger::info("NetworkManager suspended for handover");
+    return true;
+}
+
+void NetworkManager::resume() {
+    if (!m_suspended) {
+        return;
+    }
+    
+    m_suspended = false;
+    m_running = true;
+    m_accepting_connections = true;
+    
+    startThreads();
+    
+    Logger::info("NetworkManager resumed");
+}
+
+NetworkManager::Handover NetworkManager::exportHandover() const {
+    Handover handover;
+    handover.next_client_id = m_next_client_id.load();
+    handover.tcp_socket = m_tcp_socket;
+    handover.unix_socket = m_unix_socket;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        for (const auto& [client_id, client] : m_clients) {
+            if (client->isConnected()) {
+                handover.clients.push_back(client->exportSession());
+            }
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+    for (const auto& [client_id, route] : m_virtual_clients) {
+        const bool proxy_handed_over = std::any_of(handover.clients.begin(), handover.clients.end(),
+            [&route](const Client::Session& session) { return session.client_id == route.proxy_id; });
+        if (proxy_handed_over) {
+            handover.virtual_clients.push_back({client_id, route.proxy_id, route.virtual_id});
+        }
+    }
+    return handover;
+}
+
+void NetworkManager::releaseHandedOver() {
+    m_handed_over = true;
+    m_suspended = false;
+    
+    // Closing our copies leaves the connections open in the new process
+    {
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        for (auto& [client_id, client] : m_clients) {
+            client->disconnect("Handed over");
+        }
+        m_clients.clear();
+    }
+    m_stats.active_connections = 0;
+    
+    stopAllServers();
+}
+
 void NetworkManager::shutdown() {
+    if (m_suspended) {
+        // Threads are already stopped; only the sockets are left
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        for (auto& [client_id, client] : m_clients) {
+            client->disconnect("Server shutdown");
+        }
+        m_clients.clear();
+        stopAllServers();
+        m_suspended = false;
+        return;
+    }
+    
     if (!m_running) {
         return;
     }
@@ -92,6 +264,7 @@ void NetworkManager::shutdown() {
     
     m_running = false;
     m_accepting_connections = false;
+    wakeAllThreads();
     
     // Stop accepting new connections
     if (m_accept_thread.joinable()) {
@@ -209,7 +382,9 @@ void NetworkManager::stopAllServers() {
     if (m_unix_socket != -1) {
 #ifndef _WIN32
         close(m_unix_socket);
-        unlink(m_config.unix_socket_path.c_str());
+        if (!m_handed_over) {
+            unlink(m_config.unix_socket_path.c_str());
+        }
 #endif
         m_unix_socket = -1;
     }
@@ -229,16 +404,21 @@ std::vector<uint32_t> NetworkManager::getConnectedClients() const {
 }
 
 bool NetworkManager::disconnectClient(uint32_t client_id, const std::string& reason) {
-    std::lock_guard<std::mutex> lock(m_clients_mutex);
-    
-    auto it = m_clients.find(client_id);
-    if (it != m_clients.end()) {
-        it->second->disconnect(reason);
-        Logger::info("Disconnected client {} ({})", client_id, reason);
-        return true;
+    {
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        
+        auto it = m_clients.find(client_id);
+        if (it != m_clients.end()) {
+            it->second->disconnect(reason);
+            Logger::info("Disconnected client {} ({})", client_id, reason);
+            return true;
+        }
     }
     
-    return false;
+    // A virtual client: its proxy closes the local connection on DISCONNECT
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::DISCONNECT, client_id);
+    sendToVirtualClient(client_id, header, nullptr);
+    return detachVirtualClient(client_id, reason);
 }
 
 std::shared_ptr<Client> NetworkManager::getClient(uint32_t client_id) const {
@@ -250,7 +430,10 @@ std::shared_ptr<Client> NetworkManager::getClient(uint32_t client_id) const {
 
 bool NetworkManager::sendMessage(uint32_t client_id, const MessageHeader& header, const void* data) {
     auto client = getClient(client_id);
-    if (!client || !client->isConnected()) {
+    if (!client) {
+        return sendToVirtualClient(client_id, header, data);
+    }
+    if (!client->isConnected()) {
         return false;
     }
     
@@ -332,11 +515,18 @@ void NetworkManager::handlePong(uint32_t client_id, const PongData& pong_data) {
 
 void NetworkManager::setConfig(const Config& config) {
     if (m_running) {
-        Logger::warning("Cannot change NetworkManager configuration while running");
+        Config live = config;
+        if (keepRestartOnlySettings(m_config, live)) {
+            Logger::warning("Network listener and thread settings only change on restart");
+        }
+        
+        uint64_t version = m_live_config.publish(live);
+        Logger::info("NetworkManager live configuration updated (version {})", version);
         return;
     }
     
     m_config = config;
+    m_live_config.publish(config);
     Logger::info("NetworkManager configuration updated");
 }
 
@@ -365,17 +555,60 @@ void NetworkManager::setErrorCallback(ErrorCallback callback) {
     m_error_callback = callback;
 }
 
+void NetworkManager::setBackpressureCallback(BackpressureCallback callback) {
+    m_backpressure_callback = callback;
+}
+
+void NetworkManager::setInputRequestCallback(InputRequestCallback callback) {
+    m_input_request_callback = callback;
+}
+
+void NetworkManager::wakeup() {
+    for (auto& wakeup : m_network_wakeups) {
+        wakeup->notify();
+    }
+}
+
 // Private methods implementation
 
-void NetworkManager::networkThreadMain() {
+void NetworkManager::startThreads() {
+    m_network_wakeups.clear();
+    for (uint32_t i = 0; i < m_config.network_thread_count; ++i) {
+        m_network_wakeups.push_back(std::make_unique<WakeupEvent>());
+    }
+    
+    for (uint32_t i = 0; i < m_config.network_thread_count; ++i) {
+        m_network_threads.emplace_back(&NetworkManager::networkThreadMain, this, i);
+    }
+    m_accept_thread = std::thread(&NetworkManager::acceptConnections, this);
+}
+
+void NetworkManager::wakeAllThreads() {
+    wakeup();
+    m_accept_wakeup.notify();
+}
+
+void NetworkManager::networkThreadMain(uint32_t index) {
+    Platform::setThreadName("kairos-net-" + std::to_string(index));
+    Platform::applyThreadPolicy("Network", m_config.network_thread_policy);
     Logger::debug("Network thread started");
     
     while (m_running) {
         try {
+            // Safe point: one configuration snapshot per iteration
+            auto config = m_live_config.read();
+            
             // Process client messages
             std::vector<std::shared_ptr<Client>> clients_to_process;
             
-            {
+            // Unread data stays in the kernel socket buffers, so TCP flow
+            // control slows the clients down instead of commands being dropped
+            bool saturated = m_backpressure_callback && m_backpressure_callback();
+            if (saturated) {
+                m_stats.backpressure_waits.fetch_add(1);
+            }
+            
+            if (!saturated) {
                 std::lock_guard<std::mutex> lock(m_clients_mutex);
                 for (auto& [client_id, client] : m_clients) {
                     if (client->isConnected()) {
@@ -385,17 +618,17 @@ void NetworkManager::networkThreadMain() {
             }
             
             for (auto& client : clients_to_process) {
-                processClientMessages(client);
+                processClientMessages(client, *config);
             }
             
             // Cleanup disconnected clients
             cleanupDisconnectedClients();
             
             // Update rate limits
-            updateRateLimits();
+            updateRateLimits(*config);
             
-            // Sleep briefly to avoid busy waiting
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            // Backpressured: leave the sockets out so readable data does not wake us
+            waitForActivity(*m_network_wakeups[index], clients_to_process);
             
         } catch (const std::exception& e) {
             Logger::error("Exception in network thread: {}", e.what());
@@ -405,7 +638,37 @@ void NetworkManager::networkThreadMain() {
     Logger::debug("Network thread stopped");
 }
 
+void NetworkManager::waitForActivity(WakeupEvent& wakeup, const std::vector<std::shared_ptr<Client>>& clients) {
+#ifdef _WIN32
+    // No pollable wakeup descriptor: fall back to a short sleep
+    (void)wakeup;
+    (void)clients;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#else
+    // Sleeps until a client sends data, another thread has work for us, or
+    // housekeeping (pings, timeouts, rate limit windows) is due
+    std::vector<pollfd> fds;
+    fds.reserve(clients.size() + 1);
+    fds.push_back(pollfd{wakeup.fd(), POLLIN, 0});
+    for (const auto& client : clients) {
+        if (client->isConnected()) {
+            fds.push_back(pollfd{client->getSocket(), POLLIN, 0});
+        }
+    }
+    
+    int result = poll(fds.data(), fds.size(), HOUSEKEEPING_INTERVAL_MS);
+    if (result < 0 && errno != EINTR) {
+        Logger::error("Network poll failed: {}", strerror(errno));
+    }
+    if (result > 0 && (fds[0].revents & POLLIN)) {
+        wakeup.drain();
+    }
+#endif
+}
+
 void NetworkManager::acceptConnections() {
+    Platform::setThreadName("kairos-accept");
+    Platform::applyThreadPolicy("Accept", m_config.accept_thread_policy);
     Logger::debug("Accept thread started");
     
     while (m_accepting_connections) {
@@ -426,13 +689,20 @@ void NetworkManager::acceptConnections() {
                 max_fd = std::max(max_fd, m_unix_socket);
             }
             
+            // Stopping signals the wakeup descriptor, so no timeout is needed
+            const int wakeup_fd = m_accept_wakeup.fd();
+            if (wakeup_fd != -1) {
+                FD_SET(wakeup_fd, &read_fds);
+                max_fd = std::max(max_fd, wakeup_fd);
+            }
+            
             if (max_fd == -1) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                m_accept_wakeup.wait();
                 continue;
             }
             
-            struct timeval timeout = {0, 100000}; // 100ms timeout
-            int result = select(max_fd + 1, &read_fds, nullptr, nullptr, &timeout);
+            struct timeval timeout = {0, 100000}; // Only without a wakeup descriptor (Windows)
+            int result = select(max_fd + 1, &read_fds, nullptr, nullptr, wakeup_fd != -1 ? nullptr : &timeout);
             
             if (result < 0) {
                 if (errno != EINTR) {
@@ -445,6 +715,10 @@ void NetworkManager::acceptConnections() {
                 continue; // Timeout
             }
             
+            if (wakeup_fd != -1 && FD_ISSET(wakeup_fd, &read_fds)) {
+                m_accept_wakeup.drain();
+            }
+            
             // Check for TCP connections
             if (m_tcp_socket != -1 && FD_ISSET(m_tcp_socket, &read_fds)) {
                 auto client = acceptTcpConnection();
@@ -512,33 +786,51 @@ std::shared_ptr<Client> NetworkManager::acceptUnixConnection() {
 #endif
 }
 
-void NetworkManager::handleNewClient(std::shared_ptr<Client> client) {
+bool NetworkManager::adoptClient(int socket, const std::string& endpoint) {
+    if (!m_running) {
+        Logger::error("Cannot adopt client socket: network manager is not running");
+        return false;
+    }
+    
+    auto client = Client::createUnix(socket, endpoint);
+    if (!client) {
+        Logger::error("Failed to create client for adopted socket {}", socket);
+        return false;
+    }
+    
+    return handleNewClient(client);
+}
+
+bool NetworkManager::handleNewClient(std::shared_ptr<Client> client) {
+    auto config = m_live_config.read();
+    
     // Check connection limits
     {
         std::lock_guard<std::mutex> lock(m_clients_mutex);
-        if (m_clients.size() >= m_config.max_clients) {
+        if (m_clients.size() >= config->max_clients) {
             Logger::warning("Connection limit reached, rejecting client");
             client->disconnect("Server full");
-            return;
+            return false;
         }
     }
     
     // Initialize client
     uint32_t client_id = generateClientId();
     Client::Config client_config;
-    client_config.receive_buffer_size = m_config.receive_buffer_size;
-    client_config.send_buffer_size = m_config.send_buffer_size;
-    client_config.timeout_seconds = m_config.client_timeout_seconds;
+    client_config.receive_buffer_size = config->receive_buffer_size;
+    client_config.send_buffer_size = config->send_buffer_size;
+    client_config.timeout_seconds = config->client_timeout_seconds;
+    client_config.fixed_buffers = config->fixed_buffers;
     
     if (!client->initialize(client_id, client_config)) {
         Logger::error("Failed to initialize client {}", client_id);
-        return;
+        return false;
     }
     
     // Perform handshake
     if (!handleClientHandshake(client)) {
         Logger::error("Handshake failed for client {}", client_id);
-        return;
+        return false;
     }
     
     // Add to client list
@@ -546,6 +838,7 @@ void NetworkManager::handleNewClient(std::shared_ptr<Client> client) {
         std::lock_guard<std::mutex> lock(m_clients_mutex);
         m_clients[client_id] = client;
     }
+    wakeup();   // Network threads add the new socket to their wait set
     
     m_stats.total_connections.fetch_add(1);
     m_stats.active_connections.fetch_add(1);
@@ -557,14 +850,17 @@ void NetworkManager::handleNewClient(std::shared_ptr<Client> client) {
     }
     
     Logger::info("Client {} connected successfully", client_id);
+    return true;
 }
 
 bool NetworkManager::handleClientHandshake(std::shared_ptr<Client> client) {
     // Wait for CLIENT_HELLO message
     std::vector<std::pair<MessageHeader, std::vector<uint8_t>>> messages;
     
+    // Real time on purpose: this is a blocking socket wait, not part of the schedule
+    auto timeout = std::chrono::seconds(m_live_config.read()->handshake_timeout_seconds);
     auto timeout_start = std::chrono::steady_clock::now();
-    while (std::chrono::steady_clock::now() - timeout_start < std::chrono::seconds(m_config.handshake_timeout_seconds)) {
+    while (std::chrono::steady_clock::now() - timeout_start < timeout) {
         if (client->receiveMessages(messages) && !messages.empty()) {
             for (const auto& [header, data] : messages) {
                 if (header.type == MessageType::CLIENT_HELLO && data.size() == sizeof(ClientHello)) {
@@ -577,7 +873,9 @@ bool NetworkManager::handleClientHandshake(std::shared_ptr<Client> client) {
             }
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            timeout - (std::chrono::steady_clock::now() - timeout_start));
+        client->waitForData(static_cast<int>(std::max<int64_t>(remaining.count(), 0)));
     }
     
     Logger::warning("Handshake timeout for client");
@@ -598,12 +896,13 @@ void NetworkManager::handleClientHello(std::shared_ptr<Client> client, const Cli
     }
     
     // Perform handshake
+    client->applyClientHello(hello);
     client->performHandshake(server_hello);
     
     Logger::info("Handshake completed for client {}", client->getId());
 }
 
-void NetworkManager::processClientMessages(std::shared_ptr<Client> client) {
+void NetworkManager::processClientMessages(std::shared_ptr<Client> client, const Config& config) {
     if (!client->isConnected()) {
         return;
     }
@@ -624,7 +923,7 @@ void NetworkManager::processClientMessages(std::shared_ptr<Client> client) {
     std::vector<std::pair<MessageHeader, std::vector<uint8_t>>> messages;
     if (client->receiveMessages(messages)) {
         for (auto& [header, data] : messages) {
-            if (!processMessage(client, header, data)) {
+            if (!processMessage(client, header, data, config)) {
                 Logger::warning("Failed to process message from client {}", client->getId());
                 m_stats.invalid_messages.fetch_add(1);
             }
@@ -635,9 +934,9 @@ void NetworkManager::processClientMessages(std::shared_ptr<Client> client) {
 }
 
 bool NetworkManager::processMessage(std::shared_ptr<Client> client, const MessageHeader& header, 
-                                   const std::vector<uint8_t>& data) {
+                                   const std::vector<uint8_t>& data, const Config& config) {
     // Validate message
-    if (!validateMessage(header, data)) {
+    if (!validateMessage(header, data, config)) {
         return false;
     }
     
@@ -669,6 +968,34 @@ bool NetworkManager::processMessage(std::shared_ptr<Client> client, const Messag
             break;
         }
         
+        case MessageType::PROXY_ATTACH:
+        case MessageType::PROXY_DETACH:
+        case MessageType::PROXY_FRAME: {
+            if (!client->isProxy()) {
+                Logger::warning("Client {} sent {} without the proxy capability",
+                               client->getId(), messageTypeToString(header.type));
+                return false;
+            }
+            if (header.type == MessageType::PROXY_ATTACH) {
+                handleProxyAttach(client, data);
+            } else if (header.type == MessageType::PROXY_DETACH) {
+                handleProxyDetach(client, data);
+            } else if (!handleProxyFrame(client, data, config)) {
+                return false;
+            }
+            break;
+        }
+        
+        case MessageType::SET_INPUT_REGION:
+        case MessageType::SET_INPUT_GRAB:
+        case MessageType::SET_INPUT_MASK: {
+            if (m_input_request_callback && !m_input_request_callback(client->getId(), header, data)) {
+                Logger::warning("Client {} sent a malformed {}", client->getId(), messageTypeToString(header.type));
+                m_stats.invalid_messages.fetch_add(1);
+            }
+            break;
+        }
+        
         default: {
             // Convert to render command and forward to callback
             if (m_command_received_callback) {
@@ -697,6 +1024,213 @@ void NetworkManager::handleDisconnect(std::shared_ptr<Client> client) {
     client->disconnect("Client request");
 }
 
+void NetworkManager::handleProxyAttach(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data) {
+    if (data.size() != sizeof(ProxyAttachData)) {
+        Logger::warning("Malformed PROXY_ATTACH from proxy {}", proxy->getId());
+        return;
+    }
+    
+    ProxyAttachData attach;
+    std::memcpy(&attach, data.data(), sizeof(ProxyAttachData));
+    const uint32_t virtual_id = attach.virtual_id;
+    const uint64_t route = (static_cast<uint64_t>(proxy->getId()) << 32) | virtual_id;
+    
+    uint32_t client_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        if (m_virtual_routes.count(route) > 0) {
+            Logger::warning("Proxy {} attached virtual client {} twice", proxy->getId(), virtual_id);
+            return;
+        }
+        client_id = generateClientId();
+        m_virtual_routes[route] = client_id;
+        m_virtual_clients[client_id] = VirtualClient{proxy->getId(), virtual_id};
+    }
+    
+    m_stats.total_connections.fetch_add(1);
+    m_stats.virtual_clients.fetch_add(1);
+    
+    // Tell the proxy which id the server uses for this client
+    attach.assigned_client_id = client_id;
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::PROXY_ATTACH, proxy->getId(), 0, sizeof(ProxyAttachData));
+    proxy->sendMessage(header, &attach);
+    
+    std::string name(attach.client_name, strnlen(attach.client_name, sizeof(attach.client_name)));
+    if (m_client_connected_callback) {
+        m_client_connected_callback(client_id, name);
+    }
+    
+    Logger::info("Client {} ({}) attached through proxy {}", client_id, name, proxy->getId());
+}
+
+void NetworkManager::handleProxyDetach(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data) {
+    if (data.size() != sizeof(ProxyDetachData)) {
+        Logger::warning("Malformed PROXY_DETACH from proxy {}", proxy->getId());
+        return;
+    }
+    
+    ProxyDetachData detach;
+    std::memcpy(&detach, data.data(), sizeof(ProxyDetachData));
+    const uint64_t route = (static_cast<uint64_t>(proxy->getId()) << 32) | detach.virtual_id;
+    
+    uint32_t client_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        auto it = m_virtual_routes.find(route);
+        if (it == m_virtual_routes.end()) {
+            return;
+        }
+        client_id = it->second;
+    }
+    detachVirtualClient(client_id, "Detached by proxy");
+}
+
+bool NetworkManager::handleProxyFrame(std::shared_ptr<Client> proxy, const std::vector<uint8_t>& data,
+                                      const Config& config) {
+    m_stats.proxy_frames.fetch_add(1);
+    
+    size_t offset = 0;
+    while (offset < data.size()) {
+        MessageHeader inner;
+        if (data.size() - offset < sizeof(MessageHeader)) {
+            Logger::warning("Truncated message in PROXY_FRAME from proxy {}", proxy->getId());
+            return false;
+        }
+        std::memcpy(&inner, data.data() + offset, sizeof(MessageHeader));
+        ProtocolHelper::networkToHost(inner);
+        
+        const size_t message_size = sizeof(MessageHeader) + inner.data_size;
+        if (!ProtocolHelper::validateHeader(inner) || data.size() - offset < message_size) {
+            Logger::warning("Malformed message in PROXY_FRAME from proxy {}", proxy->getId());
+            return false;
+        }
+        
+        const uint8_t* payload = data.data() + offset + sizeof(MessageHeader);
+        std::vector<uint8_t> message_data(payload, payload + inner.data_size);
+        offset += message_size;
+        
+        const uint32_t virtual_id = inner.client_id;
+        uint32_t client_id = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+            auto it = m_virtual_routes.find((static_cast<uint64_t>(proxy->getId()) << 32) | virtual_id);
+            if (it != m_virtual_routes.end()) {
+                client_id = it->second;
+            }
+        }
+        if (client_id == 0) {
+            Logger::debug("Dropping message for unknown virtual client {} of proxy {}", virtual_id, proxy->getId());
+            m_stats.invalid_messages.fetch_add(1);
+            continue;
+        }
+        
+        m_stats.messages_received.fetch_add(1);
+        switch (inner.type) {
+            case MessageType::DISCONNECT:
+                detachVirtualClient(client_id, "Client request");
+                break;
+            
+            // The proxy answers handshakes and keep-alives locally
+            case MessageType::CLIENT_HELLO:
+            case MessageType::PING:
+            case MessageType::PONG:
+            case MessageType::PROXY_ATTACH:
+            case MessageType::PROXY_DETACH:
+            case MessageType::PROXY_FRAME:
+                break;
+            
+            case MessageType::SET_INPUT_REGION:
+            case MessageType::SET_INPUT_GRAB:
+            case MessageType::SET_INPUT_MASK:
+                if (m_input_request_callback && !m_input_request_callback(client_id, inner, message_data)) {
+                    m_stats.invalid_messages.fetch_add(1);
+                }
+                break;
+            
+            default:
+                if (!validateMessage(inner, message_data, config)) {
+                    m_stats.invalid_messages.fetch_add(1);
+                    break;
+                }
+                if (m_command_received_callback) {
+                    inner.client_id = client_id;
+                    RenderCommand command = CommandConverter::fromNetworkMessage(inner, message_data.data());
+                    m_command_received_callback(client_id, std::move(command));
+                }
+                break;
+        }
+    }
+    
+    return true;
+}
+
+bool NetworkManager::sendToVirtualClient(uint32_t client_id, const MessageHeader& header, const void* data) {
+    VirtualClient route;
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        auto it = m_virtual_clients.find(client_id);
+        if (it == m_virtual_clients.end()) {
+            return false;
+        }
+        route = it->second;
+    }
+    
+    auto proxy = getClient(route.proxy_id);
+    if (!proxy || !proxy->isConnected()) {
+        return false;
+    }
+    
+    // Wrap the message in a frame addressed to the proxy's virtual id
+    MessageHeader inner = header;
+    inner.client_id = route.virtual_id;
+    std::vector<uint8_t> frame = ProtocolHelper::createMessage(inner, data);
+    
+    MessageHeader outer = ProtocolHelper::createHeader(MessageType::PROXY_FRAME, route.proxy_id, 0,
+                                                       static_cast<uint32_t>(frame.size()));
+    bool success = proxy->sendMessage(outer, frame.data());
+    if (success) {
+        m_stats.messages_sent.fetch_add(1);
+        m_stats.bytes_sent.fetch_add(sizeof(MessageHeader) + frame.size());
+    }
+    return success;
+}
+
+bool NetworkManager::detachVirtualClient(uint32_t client_id, const std::string& reason) {
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        auto it = m_virtual_clients.find(client_id);
+        if (it == m_virtual_clients.end()) {
+            return false;
+        }
+        m_virtual_routes.erase((static_cast<uint64_t>(it->second.proxy_id) << 32) | it->second.virtual_id);
+        m_virtual_clients.erase(it);
+    }
+    m_stats.virtual_clients.fetch_sub(1);
+    
+    if (m_client_disconnected_callback) {
+        m_client_disconnected_callback(client_id, reason);
+    }
+    
+    Logger::info("Virtual client {} detached ({})", client_id, reason);
+    return true;
+}
+
+void NetworkManager::detachProxyClients(uint32_t proxy_id) {
+    std::vector<uint32_t> client_ids;
+    {
+        std::lock_guard<std::mutex> lock(m_virtual_clients_mutex);
+        for (const auto& [client_id, route] : m_virtual_clients) {
+            if (route.proxy_id == proxy_id) {
+                client_ids.push_back(client_id);
+            }
+        }
+    }
+    
+    for (uint32_t client_id : client_ids) {
+        detachVirtualClient(client_id, "Proxy disconnected");
+    }
+}
+
 void NetworkManager::cleanupDisconnectedClients() {
     std::lock_guard<std::mutex> lock(m_clients_mutex);
     
@@ -705,6 +1239,10 @@ void NetworkManager::cleanupDisconnectedClients() {
         if (!it->second->isConnected()) {
             uint32_t client_id = it->first;
             
+            if (it->second->isProxy()) {
+                detachProxyClients(client_id);
+            }
+            
             // Notify callback
             if (m_client_disconnected_callback) {
                 m_client_disconnected_callback(client_id, "Disconnected");
@@ -756,13 +1294,13 @@ bool NetworkManager::createUnixSocket() {
 #endif
 }
 
-void NetworkManager::updateRateLimits() {
-    if (!m_config.enable_rate_limiting) {
+void NetworkManager::updateRateLimits(const Config& config) {
+    if (!config.enable_rate_limiting) {
         return;
     }
     
     std::lock_guard<std::mutex> lock(m_rate_limit_mutex);
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     
     for (auto& [client_id, rate_info] : m_rate_limits) {
         // Reset rate limit window every second
@@ -774,8 +1312,8 @@ void NetworkManager::updateRateLimits() {
     }
 }
 
-bool NetworkManager::checkRateLimit(uint32_t client_id) {
-    if (!m_config.enable_rate_limiting) {
+bool NetworkManager::checkRateLimit(uint32_t client_id, const Config& config) {
+    if (!config.enable_rate_limiting) {
         return true;
     }
     
@@ -784,7 +1322,7 @@ bool NetworkManager::checkRateLimit(uint32_t client_id) {
     
     rate_info.command_count++;
     
-    if (rate_info.command_count > m_config.max_commands_per_second) {
+    if (rate_info.command_count > config.max_commands_per_second) {
         if (!rate_info.is_limited) {
             Logger::warning("Rate limit exceeded for client {}", client_id);
             rate_info.is_limited = true;
@@ -795,7 +1333,8 @@ bool NetworkManager::checkRateLimit(uint32_t client_id) {
     return true;
 }
 
-bool NetworkManager::validateMessage(const MessageHeader& header, const std::vector<uint8_t>& data) {
+bool NetworkManager::validateMessage(const MessageHeader& header, const std::vector<uint8_t>& data,
+                                     const Config& config) {
     if (!ProtocolHelper::validateHeader(header)) {
         return false;
     }
@@ -804,7 +1343,7 @@ bool NetworkManager::validateMessage(const MessageHeader& header, const std::vec
         return false;
     }
     
-    if (header.data_size > m_config.max_message_size) {
+    if (header.data_size > config.max_message_size) {
         return false;
     }
     
@@ -832,7 +1371,7 @@ std::string NetworkManager::getClientEndpointInfo(std::shared_ptr<Client> client
 void NetworkManager::updateStats() {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     if (now - m_last_stats_update >= std::chrono::seconds(1)) {
         // Update periodic statistics here
         m_last_stats_update = now;
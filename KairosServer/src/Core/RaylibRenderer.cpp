@@ -1,12 +1,48 @@
 // KairosServer/src/Core/RaylibRenderer.cpp
 #include "RaylibRenderer.hpp"
 #include "Utils/Logger.hpp"
+#include <Clock.hpp>
 #include <chrono>
+#include <rlgl.h>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace Kairos {
 
+namespace {
+
+const LayerTransform IDENTITY_TRANSFORM{};
+
+bool isDrawing(RenderCommand::Type type) {
+    switch (type) {
+        case RenderCommand::Type::DRAW_POINT:
+        case RenderCommand::Type::DRAW_LINE:
+        case RenderCommand::Type::DRAW_RECTANGLE:
+        case RenderCommand::Type::DRAW_CIRCLE:
+        case RenderCommand::Type::DRAW_ARC:
+        case RenderCommand::Type::DRAW_POLYGON:
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+        case RenderCommand::Type::FILL_GRADIENT:
+        case RenderCommand::Type::DRAW_TEXT:
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
+        case RenderCommand::Type::DRAW_SPRITES:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Multiplied into rlgl's modelview, so it applies before any camera
+void pushTransform(const LayerTransform& transform) {
+    float matrix[16];
+    transform.toMatrix(matrix);
+    rlPushMatrix();
+    rlMultMatrixf(matrix);
+}
+
+} // anonymous namespace
+
 RaylibRenderer::RaylibRenderer(const Config& config) 
     : m_config(config) {
     
@@ -18,7 +54,11 @@ RaylibRenderer::RaylibRenderer(const Config& config)
     m_camera2d.zoom = 1.0f;
     
     // Reserve batch groups
-    m_batch_groups.reserve(256);  // Reasonable default
+    if (m_config.fixed_pools) {
+        prefaultBatchGroups();
+    } else {
+        m_batch_groups.reserve(256);  // Reasonable default
+    }
     
     Logger::info("RaylibRenderer created with {}x{} resolution", 
                 m_config.window_width, m_config.window_height);
@@ -37,7 +77,15 @@ bool RaylibRenderer::initialize() {
     }
     
     Logger::info("Initializing RaylibRenderer...");
-    
+
+    if (m_config.null_backend) {
+        // No window or GL context: draw calls are accounted for but never issued
+        m_last_fps_update = Clock::now();
+        m_initialized = true;
+        Logger::info("RaylibRenderer initialized with null backend");
+        return true;
+    }
+
     try {
         // Set Raylib configuration flags
         unsigned int flags = 0;
@@ -75,6 +123,14 @@ bool RaylibRenderer::initialize() {
         // Initialize default resources
         initializeDefaultResources();
         
+        m_primitive_renderer = std::make_unique<PrimitiveRenderer>();
+        if (!m_primitive_renderer->initialize()) {
+            Logger::warning("Primitive renderer unavailable; arcs and polygons will not be drawn");
+            m_primitive_renderer.reset();
+        } else {
+            m_primitive_renderer->setClipHandler([this](uint16_t clip_id) { applyClip(clip_id); });
+        }
+        
         // Initialize layer caches if enabled
         if (m_config.layer_caching) {
             // Pre-create layer 0 (always exists)
@@ -83,6 +139,13 @@ bool RaylibRenderer::initialize() {
         
         m_initialized = true;
         
+        if (!m_config.viewports.empty() && !m_config.layer_caching) {
+            Logger::warning("Viewports need layer caching; showing the whole canvas instead");
+        }
+        for (const auto& viewport : m_config.viewports) {
+            Logger::info("Viewport: {}", formatOutputViewport(viewport));
+        }
+        
         Logger::info("RaylibRenderer initialized successfully");
         Logger::info("Raylib version: {}", GetRaylibVersion());
         Logger::info("OpenGL version: {}.{}", 
@@ -103,6 +166,11 @@ void RaylibRenderer::shutdown() {
     
     Logger::info("Shutting down RaylibRenderer...");
     
+    if (m_primitive_renderer) {
+        m_primitive_renderer->shutdown();
+        m_primitive_renderer.reset();
+    }
+    
     // Clean up resources
     cleanupResources();
     
@@ -120,18 +188,51 @@ void RaylibRenderer::beginFrame() {
         return;
     }
     
-    m_frame_start_time = std::chrono::steady_clock::now();
+    m_frame_start_time = Clock::now();
+    
+    std::vector<std::pair<uint32_t, uint32_t>> orphaned_pixmaps;     // Pixmap, owner
+    {
+        std::lock_guard<std::mutex> lock(m_resource_mutex);
+        for (uint32_t client_id : m_removed_clients) {
+            for (auto it = m_clip_stacks.begin(); it != m_clip_stacks.end();) {
+                it = (it->first >> 8) == client_id ? m_clip_stacks.erase(it) : std::next(it);
+            }
+            m_pixmap_targets.erase(client_id);
+            m_objects.removeClient(client_id);
+            for (const auto& [pixmap_id, pixmap] : m_pixmaps) {
+                if (pixmap.owner == client_id) {
+                    orphaned_pixmaps.emplace_back(pixmap_id, client_id);
+                }
+            }
+        }
+        m_removed_clients.clear();
+    }
+    for (const auto& [pixmap_id, owner] : orphaned_pixmaps) {
+        freePixmap(owner, pixmap_id);
+    }
     
+    // Objects hold still for the frame: tweens are evaluated once, at its start
+    m_objects.advance(m_frame_start_time);
+    m_stats.objects = static_cast<uint32_t>(m_objects.size());
+    m_stats.object_tweens = static_cast<uint32_t>(m_objects.activeTweens());
+
+    if (m_config.null_backend) {
+        m_stats.queued_commands.store(0);
+        m_stats.batched_draws.store(0);
+        return;
+    }
+
     // Begin Raylib drawing
     BeginDrawing();
     
     // Clear background
     ClearBackground(BLACK);
     
-    // Apply camera if needed
-    if (m_using_camera2d) {
+    // Apply camera if needed (viewport mode applies it per layer cache)
+    if (m_using_camera2d && !usesViewports()) {
         BeginMode2D(m_camera2d);
     }
+    m_layers_drawn.reset();
     
     // Reset per-frame stats
     m_stats.queued_commands.store(0);
@@ -143,6 +244,22 @@ void RaylibRenderer::endFrame() {
         return;
     }
     
+    if (m_config.null_backend) {
+        {
+            std::lock_guard<std::mutex> lock(m_batch_mutex);
+            m_batch_groups.clear();
+        }
+        m_clip_rects.clear();
+        updateStats();
+        m_stats.frames_rendered++;
+        return;
+    }
+
+    // Layers whose transform has settled are redrawn at it, along with
+    // layers restored from a snapshot (on screen until their clients redraw them)
+    bakeSettledTransforms();
+    replayRestoredLayers();
+    
     // Flush any remaining batches
     flushBatches();
     
@@ -150,10 +267,19 @@ void RaylibRenderer::endFrame() {
     renderLayers();
     
     // End camera mode if active
-    if (m_using_camera2d) {
+    if (m_using_camera2d && !usesViewports()) {
         EndMode2D();
     }
     
+    // Read back before EndDrawing() swaps the buffers
+    if (m_capture_requested) {
+        if (m_captured_frame.data) {
+            UnloadImage(m_captured_frame);
+        }
+        m_captured_frame = LoadImageFromScreen();
+        m_capture_requested = false;
+    }
+    
     // End Raylib drawing
     EndDrawing();
     
@@ -170,15 +296,26 @@ bool RaylibRenderer::shouldClose() const {
     return m_window_should_close;
 }
 
-void RaylibRenderer::processCommand(const RenderCommand& command) {
+bool RaylibRenderer::processCommand(const RenderCommand& command) {
     if (!m_initialized) {
         Logger::warning("Attempting to process command on uninitialized renderer");
-        return;
+        return false;
     }
     
     m_stats.commands_processed++;
     m_stats.queued_commands.fetch_add(1);
     
+    // Drawing into a pixmap is not the layer's content
+    if (m_config.retain_scene && !m_replaying && m_pixmap_targets.find(command.client_id) == m_pixmap_targets.end()) {
+        retainCommand(command);
+    }
+    
+    // Drawing goes through the layer's transform and the sender's clip
+    if (!beginCommand(command)) {
+        return true;
+    }
+    
+    bool known = true;
     switch (command.type) {
         case RenderCommand::Type::DRAW_POINT:
             drawPoint(command.point.position, command.point.color, command.layer_id);
@@ -201,26 +338,126 @@ void RaylibRenderer::processCommand(const RenderCommand& command) {
                       command.circle.color, command.circle.filled, command.layer_id);
             break;
             
+        case RenderCommand::Type::DRAW_ARC:
+            drawArc(command.arc.center, command.arc.radius_x, command.arc.radius_y,
+                   command.arc.start_angle, command.arc.end_angle,
+                   command.arc.color, command.arc.filled, command.layer_id);
+            break;
+            
+        case RenderCommand::Type::DRAW_POLYGON:
+            drawPolygon(command.polygon_points, command.polygon.color, command.polygon.filled,
+                       command.polygon.convex, command.layer_id);
+            break;
+            
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+            drawRoundedRectangle(command.rounded_rectangle.position,
+                                command.rounded_rectangle.width, command.rounded_rectangle.height,
+                                command.rounded_rectangle.radii, command.rounded_rectangle.color,
+                                command.rounded_rectangle.filled, command.layer_id);
+            break;
+            
+        case RenderCommand::Type::FILL_GRADIENT: {
+            const auto& fill = command.gradient;
+            fillGradient(fill.position, fill.width, fill.height, fill.shape,
+                        {fill.from, fill.to, fill.from_color, fill.to_color, fill.radial}, command.layer_id);
+            break;
+        }
+            
         case RenderCommand::Type::DRAW_TEXT:
-            drawText(command.text.text, command.text.position,
-                    command.text.font_id, command.text.font_size,
-                    command.text.color, command.layer_id);
+            if (!command.text_string.empty()) {
+                drawText(command.text_string, command.text.position,
+                        command.text.font_id, command.text.font_size,
+                        command.text.color, command.layer_id);
+            }
             break;
             
         case RenderCommand::Type::DRAW_TEXTURED_QUADS:
-            drawTexturedQuads(command.textured_quads.vertices,
-                             command.textured_quads.texture_id, command.layer_id);
+            if (!command.vertices.empty()) {
+                drawTexturedQuads(command.vertices, command.textured_quads.texture_id, command.layer_id);
+            }
+            break;
+            
+        case RenderCommand::Type::DRAW_SPRITES:
+            if (!command.sprite_instances.empty()) {
+                drawSprites(command.sprite_instances, command.sprites.texture_id, command.layer_id);
+            }
             break;
             
         case RenderCommand::Type::CLEAR_LAYER:
             clearLayer(command.layer_id);
             break;
             
+        case RenderCommand::Type::SET_LAYER_VISIBILITY:
+            setLayerVisibility(command.layer_id, command.layer_visibility.visible);
+            break;
+            
+        case RenderCommand::Type::SET_LAYER_TRANSFORM: {
+            const auto& t = command.layer_transform;
+            setLayerTransform(command.layer_id, {t.a, t.b, t.c, t.d, t.tx, t.ty}, t.rerasterize);
+            break;
+        }
+            
+        case RenderCommand::Type::PUSH_CLIP:
+            pushClip(command.client_id, command.layer_id,
+                     SpatialBounds::fromRect(command.clip.x, command.clip.y, command.clip.width, command.clip.height));
+            break;
+            
+        case RenderCommand::Type::POP_CLIP:
+            popClip(command.client_id, command.layer_id);
+            break;
+            
+        case RenderCommand::Type::CREATE_PIXMAP:
+            createPixmap(command.client_id, command.pixmap.id, command.pixmap.width, command.pixmap.height);
+            break;
+            
+        case RenderCommand::Type::FREE_PIXMAP:
+            freePixmap(command.client_id, command.pixmap.id);
+            break;
+            
+        case RenderCommand::Type::SET_PIXMAP_TARGET:
+            setPixmapTarget(command.client_id, command.pixmap.id, command.pixmap.clear);
+            break;
+            
+        case RenderCommand::Type::COPY_AREA: {
+            const auto& copy = command.copy_area;
+            copyArea(command.client_id, command.layer_id, copy.src_x, copy.src_y, copy.width, copy.height,
+                     copy.dst_x, copy.dst_y);
+            break;
+        }
+            
+        case RenderCommand::Type::CREATE_OBJECT:
+            createObject(command);
+            break;
+            
+        case RenderCommand::Type::UPDATE_OBJECT:
+            updateObject(command);
+            break;
+            
+        case RenderCommand::Type::DELETE_OBJECT:
+            deleteObject(command.client_id, command.object.id);
+            break;
+            
+        case RenderCommand::Type::SET_VIEWPORT:
+            setViewport(command.viewport.x, command.viewport.y,
+                       command.viewport.width, command.viewport.height);
+            break;
+            
+        case RenderCommand::Type::SET_CAMERA: {
+            Vector2 target = {command.camera.target.x, command.camera.target.y};
+            Vector2 offset = {command.camera.offset.x, command.camera.offset.y};
+            setCamera2D(target, offset, command.camera.rotation, command.camera.zoom);
+            break;
+        }
+            
         default:
             Logger::warning("Unknown render command type: {}", 
                            static_cast<int>(command.type));
+            known = false;
             break;
     }
+    
+    endCommand();
+    return known;
 }
 
 void RaylibRenderer::processCommands(const std::vector<RenderCommand>& commands) {
@@ -235,7 +472,9 @@ void RaylibRenderer::drawPoint(const Point& position, const Color& color, uint8_
     ::Color raylib_color = kairosColorToRaylib(color);
     
     // For now, draw directly - in a real implementation, this should be batched
-    DrawPixel(static_cast<int>(pos.x), static_cast<int>(pos.y), raylib_color);
+    if (!m_config.null_backend) {
+        DrawPixel(static_cast<int>(pos.x), static_cast<int>(pos.y), raylib_color);
+    }
     
     m_stats.vertices_rendered++;
 }
@@ -246,7 +485,9 @@ void RaylibRenderer::drawLine(const Point& start, const Point& end,
     Vector2 end_pos = pointToVector2(end);
     ::Color raylib_color = kairosColorToRaylib(color);
     
-    if (thickness <= 1.0f) {
+    if (m_config.null_backend) {
+        // Accounted below, nothing to issue
+    } else if (thickness <= 1.0f) {
         DrawLineV(start_pos, end_pos, raylib_color);
     } else {
         DrawLineEx(start_pos, end_pos, thickness, raylib_color);
@@ -261,7 +502,9 @@ void RaylibRenderer::drawRectangle(const Point& position, float width, float hei
     Vector2 pos = pointToVector2(position);
     ::Color raylib_color = kairosColorToRaylib(color);
     
-    if (filled) {
+    if (m_config.null_backend) {
+        // Accounted below, nothing to issue
+    } else if (filled) {
         DrawRectangleV(pos, {width, height}, raylib_color);
     } else {
         DrawRectangleLinesEx({pos.x, pos.y, width, height}, 1.0f, raylib_color);
@@ -276,7 +519,9 @@ void RaylibRenderer::drawCircle(const Point& center, float radius,
     Vector2 center_pos = pointToVector2(center);
     ::Color raylib_color = kairosColorToRaylib(color);
     
-    if (filled) {
+    if (m_config.null_backend) {
+        // Accounted below, nothing to issue
+    } else if (filled) {
         DrawCircleV(center_pos, radius, raylib_color);
     } else {
         DrawCircleLinesV(center_pos, radius, raylib_color);
@@ -288,6 +533,69 @@ void RaylibRenderer::drawCircle(const Point& center, float radius,
     m_stats.draw_calls_issued++;
 }
 
+void RaylibRenderer::drawArc(const Point& center, float radius_x, float radius_y, float start_angle,
+                             float end_angle, const Color& color, bool filled, uint8_t layer_id) {
+    if (!m_primitive_renderer) {
+        // Null backend: nothing to tessellate into, estimate as for circles
+        m_stats.vertices_rendered += static_cast<int>(std::max(radius_x, radius_y) * 0.5f) + 12;
+        return;
+    }
+    
+    // Tessellated into the primitive batches, flushed before the next draw
+    // of another kind or with the frame's other batches
+    const uint64_t before = m_primitive_renderer->getStats().vertices_processed;
+    m_primitive_renderer->setLayer(layer_id);
+    m_primitive_renderer->drawArc(center, radius_x, radius_y, start_angle, end_angle, color, filled);
+    m_stats.vertices_rendered += m_primitive_renderer->getStats().vertices_processed - before;
+}
+
+void RaylibRenderer::drawPolygon(const std::vector<Point>& points, const Color& color, bool filled,
+                                 bool known_convex, uint8_t layer_id) {
+    if (points.size() < 3) {
+        return;
+    }
+    if (!m_primitive_renderer) {
+        m_stats.vertices_rendered += points.size();
+        return;
+    }
+    
+    const uint64_t before = m_primitive_renderer->getStats().vertices_processed;
+    m_primitive_renderer->setLayer(layer_id);
+    m_primitive_renderer->drawPolygon(points, color, filled, known_convex);
+    m_stats.vertices_rendered += m_primitive_renderer->getStats().vertices_processed - before;
+}
+
+void RaylibRenderer::drawRoundedRectangle(const Point& position, float width, float height, const float radii[4],
+                                          const Color& color, bool filled, uint8_t layer_id) {
+    if (!m_primitive_renderer) {
+        m_stats.vertices_rendered += 4 * (static_cast<int>(std::max({radii[0], radii[1], radii[2], radii[3]}) * 0.25f) + 4);
+        return;
+    }
+    
+    const uint64_t before = m_primitive_renderer->getStats().vertices_processed;
+    m_primitive_renderer->setLayer(layer_id);
+    m_primitive_renderer->drawRectangleRounded({position.x, position.y, width, height}, radii, color, filled);
+    m_stats.vertices_rendered += m_primitive_renderer->getStats().vertices_processed - before;
+}
+
+void RaylibRenderer::fillGradient(const Point& position, float width, float height, uint8_t shape,
+                                  const PrimitiveRenderer::Gradient& gradient, uint8_t layer_id) {
+    if (!m_primitive_renderer) {
+        m_stats.vertices_rendered += gradient.radial ? 512 : 32;
+        return;
+    }
+    
+    // Shaded per vertex, so gradients batch with the other tessellated geometry
+    const uint64_t before = m_primitive_renderer->getStats().vertices_processed;
+    m_primitive_renderer->setLayer(layer_id);
+    if (shape == Constants::GRADIENT_SHAPE_ELLIPSE) {
+        m_primitive_renderer->fillEllipseGradient(position, width * 0.5f, height * 0.5f, gradient);
+    } else {
+        m_primitive_renderer->fillRectangleGradient({position.x, position.y, width, height}, gradient);
+    }
+    m_stats.vertices_rendered += m_primitive_renderer->getStats().vertices_processed - before;
+}
+
 void RaylibRenderer::drawText(const std::string& text, const Point& position,
                              uint32_t font_id, float font_size, 
                              const Color& color, uint8_t layer_id) {
@@ -295,7 +603,9 @@ void RaylibRenderer::drawText(const std::string& text, const Point& position,
     ::Color raylib_color = kairosColorToRaylib(color);
     
     Font* font = getFont(font_id);
-    if (font && font->texture.id != 0) {
+    if (m_config.null_backend) {
+        // Accounted below, nothing to issue
+    } else if (font && font->texture.id != 0) {
         DrawTextEx(*font, text.c_str(), pos, font_size, 1.0f, raylib_color);
     } else {
         // Fallback to default font
@@ -314,6 +624,18 @@ void RaylibRenderer::drawTexturedQuads(const std::vector<TexturedVertex>& vertic
         return;
     }
     
+    if (m_config.null_backend) {
+        // Batches are discarded in endFrame(), so only the vertex count matters
+        m_stats.vertices_rendered += vertices.size();
+        m_stats.batched_draws.fetch_add(1);
+        return;
+    }
+    
+    if (texture_id == m_drawing_pixmap) {
+        Logger::warning("Pixmap {} cannot be drawn into itself", texture_id);
+        return;
+    }
+    
     Texture2D* texture = getTexture(texture_id);
     if (!texture || texture->id == 0) {
         Logger::warning("Invalid texture ID: {}", texture_id);
@@ -326,21 +648,99 @@ void RaylibRenderer::drawTexturedQuads(const std::vector<TexturedVertex>& vertic
     m_stats.vertices_rendered += vertices.size();
 }
 
+void RaylibRenderer::drawSprites(const std::vector<SpriteInstance>& instances, uint32_t texture_id,
+                                 uint8_t layer_id) {
+    if (instances.empty()) {
+        return;
+    }
+    
+    if (m_config.null_backend) {
+        m_stats.vertices_rendered += instances.size() * 4;
+        m_stats.batched_draws.fetch_add(1);
+        return;
+    }
+    
+    if (texture_id == m_drawing_pixmap) {
+        Logger::warning("Pixmap {} cannot be drawn into itself", texture_id);
+        return;
+    }
+    
+    Texture2D* texture = getTexture(texture_id);
+    if (!texture || texture->id == 0 || texture->width <= 0 || texture->height <= 0) {
+        Logger::warning("Invalid texture ID: {}", texture_id);
+        return;
+    }
+    
+    const float inverse_width = 1.0f / static_cast<float>(texture->width);
+    const float inverse_height = 1.0f / static_cast<float>(texture->height);
+    
+    // Expanded in chunks a batch group can hold, so a fixed pool accepts them
+    const size_t chunk = std::max<size_t>(m_config.max_batch_size / 4, 1);
+    for (size_t first = 0; first < instances.size(); first += chunk) {
+        const size_t last = std::min(instances.size(), first + chunk);
+        m_sprite_vertices.clear();
+        m_sprite_vertices.reserve((last - first) * 4);
+        
+        for (size_t i = first; i < last; ++i) {
+            const SpriteInstance& sprite = instances[i];
+            const float half_width = sprite.atlas_width * sprite.scale_x * 0.5f;
+            const float half_height = sprite.atlas_height * sprite.scale_y * 0.5f;
+            const float radians = sprite.rotation * static_cast<float>(M_PI) / 180.0f;
+            const float c = std::cos(radians);
+            const float s = std::sin(radians);
+            
+            const float u0 = sprite.atlas_x * inverse_width;
+            const float v0 = sprite.atlas_y * inverse_height;
+            const float u1 = (sprite.atlas_x + sprite.atlas_width) * inverse_width;
+            const float v1 = (sprite.atlas_y + sprite.atlas_height) * inverse_height;
+            
+            // Corners clockwise from the top-left, as clients send textured quads
+            const float corners[4][4] = {
+                {-half_width, -half_height, u0, v0},
+                {half_width, -half_height, u1, v0},
+                {half_width, half_height, u1, v1},
+                {-half_width, half_height, u0, v1}
+            };
+            for (const auto& corner : corners) {
+                m_sprite_vertices.emplace_back(sprite.position.x + corner[0] * c - corner[1] * s,
+                                               sprite.position.y + corner[0] * s + corner[1] * c,
+                                               corner[2], corner[3], sprite.color);
+            }
+        }
+        
+        addToBatch(texture_id, m_sprite_vertices, {255, 255, 255, 255}, layer_id);
+    }
+    
+    m_stats.vertices_rendered += instances.size() * 4;
+}
+
 void RaylibRenderer::flushBatches() {
     std::lock_guard<std::mutex> lock(m_batch_mutex);
     
+    flushPrimitiveBatches();
+    
     for (auto& batch : m_batch_groups) {
         if (!batch.isEmpty() && batch.needs_flush) {
             flushBatch(batch);
         }
     }
     
-    // Clear batches
-    m_batch_groups.clear();
+    // Clear batches (fixed pools keep their groups and vertex storage)
+    if (m_config.fixed_pools) {
+        for (auto& batch : m_batch_groups) {
+            batch.clear();
+        }
+    } else {
+        m_batch_groups.clear();
+    }
+    m_clip_rects.clear();
+    m_batched_kind = DrawKind::None;
 }
 
 void RaylibRenderer::renderLayers() {
-    if (m_config.layer_caching) {
+    if (usesViewports()) {
+        compositeViewports();
+    } else if (m_config.layer_caching) {
         compositeLayerCaches();
     } else {
         // Direct rendering without caching
@@ -354,6 +754,9 @@ void RaylibRenderer::renderLayer(uint8_t layer_id) {
     // This is a simplified version - in practice, layers would maintain
     // their own command lists or render to textures
     
+    // Batches went straight to the window; objects go over them
+    drawObjects(layer_id, IDENTITY_TRANSFORM);
+    
     m_stats.active_layers++;
 }
 
@@ -361,8 +764,29 @@ uint32_t RaylibRenderer::uploadTexture(uint32_t texture_id, uint32_t width, uint
                                       uint32_t format, const void* pixel_data, uint32_t data_size) {
     std::lock_guard<std::mutex> lock(m_resource_mutex);
     
+    if (m_config.max_textures > 0 && m_textures.size() >= m_config.max_textures &&
+        m_textures.find(texture_id) == m_textures.end()) {
+        Logger::error("Refusing texture upload: limit of {} textures reached", m_config.max_textures);
+        m_stats.pool_overflows++;
+        return 0;
+    }
+    
     if (texture_id == 0) {
         texture_id = generateResourceId();
+    } else if (m_pixmaps.find(texture_id) != m_pixmaps.end()) {
+        Logger::error("Refusing texture upload: {} is a pixmap", texture_id);
+        return 0;
+    }
+    
+    if (m_config.null_backend) {
+        // Keep the metadata only; id 0 means there is no GL texture to unload
+        Texture2D texture = {0};
+        texture.width = static_cast<int>(width);
+        texture.height = static_cast<int>(height);
+        texture.mipmaps = 1;
+        m_textures[texture_id] = texture;
+        m_stats.textures_uploaded++;
+        return texture_id;
     }
     
     try {
@@ -413,6 +837,11 @@ uint32_t RaylibRenderer::uploadTexture(uint32_t texture_id, uint32_t width, uint
         m_textures[texture_id] = texture;
         m_stats.textures_uploaded++;
         
+        if (m_config.retain_scene) {
+            m_texture_hashes[texture_id] = SceneState::contentHash(pixel_data, data_size) ^
+                                           (static_cast<uint64_t>(width) << 32 | height);
+        }
+        
         Logger::debug("Uploaded texture {} ({}x{}, format={})", 
                      texture_id, width, height, format);
         
@@ -466,6 +895,8 @@ void RaylibRenderer::clearLayer(uint8_t layer_id) {
         if (cache) {
             cache->is_dirty = true;
             cache->commands.clear();
+            cache->index.clear();
+            cache->replay = false;
         }
     }
 }
@@ -475,6 +906,8 @@ void RaylibRenderer::clearAllLayers() {
         for (auto& [layer_id, cache] : m_layer_caches) {
             cache.is_dirty = true;
             cache.commands.clear();
+            cache.index.clear();
+            cache.replay = false;
         }
     }
 }
@@ -498,6 +931,27 @@ void RaylibRenderer::initializeDefaultResources() {
 void RaylibRenderer::cleanupResources() {
     std::lock_guard<std::mutex> lock(m_resource_mutex);
     
+    if (m_captured_frame.data) {
+        UnloadImage(m_captured_frame);
+        m_captured_frame = {0};
+    }
+    
+    // Unload pixmaps, whose textures belong to their render targets
+    for (auto& [id, pixmap] : m_pixmaps) {
+        if (pixmap.target.id != 0) {
+            UnloadRenderTexture(pixmap.target);
+        }
+        m_textures.erase(id);
+    }
+    m_pixmaps.clear();
+    m_pixmap_targets.clear();
+    m_stats.pixmaps = 0;
+    m_stats.pixmap_bytes = 0;
+    if (m_copy_scratch.id != 0) {
+        UnloadRenderTexture(m_copy_scratch);
+        m_copy_scratch = {0};
+    }
+    
     // Unload textures
     for (auto& [id, texture] : m_textures) {
         if (texture.id != 0) {
@@ -525,20 +979,200 @@ void RaylibRenderer::cleanupResources() {
     Logger::debug("Resources cleaned up");
 }
 
+void RaylibRenderer::retainCommand(const RenderCommand& command) {
+    // Only drawing is retained, with the clips around it; layer state lives in the cache
+    if (!isDrawing(command.type) && command.type != RenderCommand::Type::PUSH_CLIP &&
+        command.type != RenderCommand::Type::POP_CLIP) {
+        return;
+    }
+    
+    auto* cache = getOrCreateLayerCache(command.layer_id);
+    if (!cache) {
+        return;
+    }
+    
+    // Drawing is immediate mode: a layer shows what the latest frame that
+    // touched it drew, so that frame's commands replace the retained ones
+    if (cache->replay || cache->last_update_frame != m_stats.frames_rendered) {
+        cache->commands.clear();
+        cache->index.clear();
+        cache->replay = false;
+        cache->last_update_frame = m_stats.frames_rendered;
+    }
+    cache->commands.push_back(command);
+    cache->index.add(static_cast<uint32_t>(cache->commands.size() - 1), command);
+}
+
+void RaylibRenderer::replayRestoredLayers() {
+    for (auto& [layer_id, cache] : m_layer_caches) {
+        const bool redraw = cache.replay || cache.rerasterize;
+        cache.rerasterize = false;
+        if (!redraw || !cache.is_visible) {
+            continue;
+        }
+        drawRetainedCommands(layer_id, cache);
+    }
+}
+
+void RaylibRenderer::drawRetainedCommands(uint8_t layer_id, const LayerCache& cache) {
+    visibleCanvasRegions(layer_id, m_visible_regions);
+    
+    m_visible_commands.clear();
+    for (const auto& region : m_visible_regions) {
+        cache.index.query(region, m_region_commands);
+        m_visible_commands.insert(m_visible_commands.end(), m_region_commands.begin(), m_region_commands.end());
+    }
+    if (m_visible_regions.size() > 1) {
+        std::sort(m_visible_commands.begin(), m_visible_commands.end());
+        m_visible_commands.erase(std::unique(m_visible_commands.begin(), m_visible_commands.end()),
+                                 m_visible_commands.end());
+    }
+    
+    // Replayed commands must not be retained again while the list is walked
+    m_replaying = true;
+    for (uint32_t index : m_visible_commands) {
+        processCommand(cache.commands[index]);
+    }
+    m_replaying = false;
+    
+    m_stats.commands_culled += cache.commands.size() - m_visible_commands.size();
+}
+
+void RaylibRenderer::visibleCanvasRegions(uint8_t layer_id, std::vector<SpatialBounds>& regions) const {
+    regions.clear();
+    if (usesViewports()) {
+        for (const auto& viewport : m_config.viewports) {
+            if (viewport.showsLayer(layer_id)) {
+                regions.push_back(SpatialBounds::fromRect(
+                    static_cast<float>(viewport.source_x), static_cast<float>(viewport.source_y),
+                    static_cast<float>(viewport.source_width), static_cast<float>(viewport.source_height)));
+            }
+        }
+    } else {
+        // Direct draws land in the window, cached ones in the canvas
+        regions.push_back(SpatialBounds::fromRect(
+            0.0f, 0.0f,
+            static_cast<float>(std::max(getCanvasWidth(), m_config.window_width)),
+            static_cast<float>(std::max(getCanvasHeight(), m_config.window_height))));
+    }
+    
+    // Commands are in camera space: map each region's corners back through the camera
+    if (m_using_camera2d) {
+        for (auto& region : regions) {
+            const Vector2 corners[] = {
+                GetScreenToWorld2D({region.min_x, region.min_y}, m_camera2d),
+                GetScreenToWorld2D({region.max_x, region.min_y}, m_camera2d),
+                GetScreenToWorld2D({region.min_x, region.max_y}, m_camera2d),
+                GetScreenToWorld2D({region.max_x, region.max_y}, m_camera2d)};
+            SpatialBounds world{corners[0].x, corners[0].y, corners[0].x, corners[0].y};
+            for (const auto& corner : corners) {
+                world.min_x = std::min(world.min_x, corner.x);
+                world.min_y = std::min(world.min_y, corner.y);
+                world.max_x = std::max(world.max_x, corner.x);
+                world.max_y = std::max(world.max_y, corner.y);
+            }
+            region = world;
+        }
+    }
+    
+    // ...and through the layer's transform, as drawn now, to layer coordinates
+    const LayerTransform* transform = &layerTransform(layer_id);
+    if (m_in_layer_target || usesViewports()) {
+        auto it = m_layer_caches.find(layer_id);
+        if (it != m_layer_caches.end()) {
+            transform = &rasterTransform(layer_id, it->second);
+        }
+    }
+    if (!transform->isIdentity()) {
+        LayerTransform inverse;
+        if (!transform->invert(inverse)) {
+            regions.clear();    // Collapsed to a line: nothing of the layer shows
+            return;
+        }
+        for (auto& region : regions) {
+            region = inverse.apply(region);
+        }
+    }
+}
+
+size_t RaylibRenderer::queryLayer(uint8_t layer_id, const SpatialBounds& rect,
+                                  std::vector<const RenderCommand*>& commands) const {
+    commands.clear();
+    auto it = m_layer_caches.find(layer_id);
+    if (it == m_layer_caches.end()) {
+        return 0;
+    }
+    
+    // Commands are in layer coordinates
+    SpatialBounds layer_rect = rect;
+    const LayerTransform& transform = layerTransform(layer_id);
+    if (!transform.isIdentity()) {
+        LayerTransform inverse;
+        if (!transform.invert(inverse)) {
+            return 0;
+        }
+        layer_rect = inverse.apply(rect);
+    }
+    
+    std::vector<uint32_t> indices;
+    it->second.index.query(layer_rect, indices);
+    for (uint32_t index : indices) {
+        commands.push_back(&it->second.commands[index]);
+    }
+    return commands.size();
+}
+
+size_t RaylibRenderer::pickLayer(uint8_t layer_id, const Point& canvas_position,
+                                 std::vector<const RenderCommand*>& commands) const {
+    commands.clear();
+    auto it = m_layer_caches.find(layer_id);
+    if (it == m_layer_caches.end()) {
+        return 0;
+    }
+    
+    Point layer_position = canvas_position;
+    const LayerTransform& transform = layerTransform(layer_id);
+    if (!transform.isIdentity()) {
+        LayerTransform inverse;
+        if (!transform.invert(inverse)) {
+            return 0;
+        }
+        layer_position = inverse.apply(canvas_position);
+    }
+    
+    std::vector<uint32_t> indices;
+    it->second.index.pick(layer_position.x, layer_position.y, indices);
+    for (uint32_t index : indices) {
+        commands.push_back(&it->second.commands[index]);
+    }
+    return commands.size();
+}
+
 uint32_t RaylibRenderer::generateResourceId() {
-    return m_next_resource_id.fetch_add(1);
+    // Clients pick pixmap and texture ids in the same space: skip any taken
+    uint32_t id = m_next_resource_id.fetch_add(1);
+    while (id == 0 || m_pixmaps.find(id) != m_pixmaps.end() || m_textures.find(id) != m_textures.end()) {
+        id = m_next_resource_id.fetch_add(1);
+    }
+    return id;
 }
 
 void RaylibRenderer::addToBatch(uint32_t texture_id, const std::vector<TexturedVertex>& vertices,
                                const Color& tint, uint8_t layer_id) {
     std::lock_guard<std::mutex> lock(m_batch_mutex);
     
+    if (m_config.fixed_pools) {
+        addToFixedBatch(texture_id, vertices, tint, layer_id);
+        return;
+    }
+    
     // Find or create batch group
     BatchGroup* target_batch = nullptr;
     
     for (auto& batch : m_batch_groups) {
         if (batch.texture_id == texture_id && 
             batch.layer_id == layer_id &&
+            batch.clip_id == m_current_clip &&
             batch.tint_color.rgba == tint.rgba) {
             target_batch = &batch;
             break;
@@ -551,6 +1185,7 @@ void RaylibRenderer::addToBatch(uint32_t texture_id, const std::vector<TexturedV
         target_batch->texture_id = texture_id;
         target_batch->tint_color = tint;
         target_batch->layer_id = layer_id;
+        target_batch->clip_id = m_current_clip;
     }
     
     // Add vertices to batch
@@ -564,42 +1199,127 @@ void RaylibRenderer::addToBatch(uint32_t texture_id, const std::vector<TexturedV
     }
 }
 
-void RaylibRenderer::flushBatch(BatchGroup& batch) {
-    if (batch.isEmpty()) {
+void RaylibRenderer::addToFixedBatch(uint32_t texture_id, const std::vector<TexturedVertex>& vertices,
+                                     const Color& tint, uint8_t layer_id) {
+    if (vertices.size() > m_config.max_batch_size) {
+        Logger::warning("Refusing {} vertices for texture {}: a batch holds at most {}",
+                       vertices.size(), texture_id, m_config.max_batch_size);
+        m_stats.pool_overflows++;
         return;
     }
     
-    Texture2D* texture = getTexture(batch.texture_id);
-    if (!texture) {
-        Logger::warning("Cannot flush batch: invalid texture {}", batch.texture_id);
-        batch.clear();
-        return;
-    }
-    
-    // Convert vertices to Raylib format and draw
-    // This is a simplified version - real implementation would use vertex buffers
-    ::Color tint = kairosColorToRaylib(batch.tint_color);
-    
-    // Draw in groups of 4 vertices (quads)
+    BatchGroup* target_batch = nullptr;
+    BatchGroup* free_batch = nullptr;
+    for (auto& batch : m_batch_groups) {
+        if (batch.isEmpty()) {
+            free_batch = free_batch ? free_batch : &batch;
+        } else if (batch.texture_id == texture_id &&
+                   batch.layer_id == layer_id &&
+                   batch.clip_id == m_current_clip &&
+                   batch.tint_color.rgba == tint.rgba) {
+            target_batch = &batch;
+            break;
+        }
+    }
+    
+    if (target_batch && target_batch->vertices.size() + vertices.size() > m_config.max_batch_size) {
+        flushBatch(*target_batch);
+        m_stats.pool_overflows++;
+    }
+    
+    if (!target_batch) {
+        if (!free_batch) {
+            // Every group is in use: draw them now instead of growing the pool
+            for (auto& batch : m_batch_groups) {
+                flushBatch(batch);
+            }
+            m_stats.pool_overflows++;
+            free_batch = &m_batch_groups.front();
+        }
+        target_batch = free_batch;
+        target_batch->texture_id = texture_id;
+        target_batch->tint_color = tint;
+        target_batch->layer_id = layer_id;
+        target_batch->clip_id = m_current_clip;
+    }
+    
+    // Fits in the reserved capacity, so this never allocates
+    target_batch->vertices.insert(target_batch->vertices.end(), vertices.begin(), vertices.end());
+    target_batch->needs_flush = true;
+}
+
+void RaylibRenderer::prefaultBatchGroups() {
+    m_batch_groups.resize(std::max<uint32_t>(m_config.max_batch_groups, 1));
+    for (auto& batch : m_batch_groups) {
+        // Writing every vertex once faults the pages in; clearing keeps the capacity
+        batch.vertices.resize(m_config.max_batch_size);
+        batch.clear();
+    }
+    
+    Logger::info("Prefaulted {} batch groups of {} vertices ({} KB)", m_batch_groups.size(),
+                 m_config.max_batch_size,
+                 m_batch_groups.size() * m_config.max_batch_size * sizeof(TexturedVertex) / 1024);
+}
+
+void RaylibRenderer::flushBatch(BatchGroup& batch) {
+    if (batch.isEmpty()) {
+        return;
+    }
+    
+    Texture2D* texture = getTexture(batch.texture_id);
+    if (!texture) {
+        Logger::warning("Cannot flush batch: invalid texture {}", batch.texture_id);
+        batch.clear();
+        return;
+    }
+    
+    // Drawing into a pixmap: that is the target already
+    LayerCache* target = nullptr;
+    const LayerTransform* direct = nullptr;
+    if (usesViewports() && m_drawing_pixmap == 0) {
+        target = beginLayerTarget(batch.layer_id);
+        if (!target) {
+            batch.clear();
+            return;
+        }
+    } else if ((direct = directTransform(batch.layer_id))) {
+        pushTransform(*direct);
+    }
+    if (batch.clip_id != 0) {
+        applyClip(batch.clip_id);
+    }
+    
+    // One vertex stream for the whole batch, so rotated quads and per-vertex
+    // colours survive; rlgl only splits it when its own buffer fills
+    const Color& tint = batch.tint_color;
+    auto modulate = [](uint8_t a, uint8_t b) { return static_cast<unsigned char>((a * b + 127) / 255); };
+    const bool flip_v = isPixmap(batch.texture_id);    // Render targets are stored bottom row first
+    
+    rlSetTexture(texture->id);
+    rlDisableBackfaceCulling();     // Mirrored sprites wind the other way
+    rlBegin(RL_QUADS);
     for (size_t i = 0; i + 3 < batch.vertices.size(); i += 4) {
-        const auto& v0 = batch.vertices[i];
-        const auto& v1 = batch.vertices[i + 1];
-        const auto& v2 = batch.vertices[i + 2];
-        const auto& v3 = batch.vertices[i + 3];
-        
-        // Draw textured quad
-        Rectangle source = {
-            v0.u * texture->width, v0.v * texture->height,
-            (v2.u - v0.u) * texture->width, (v2.v - v0.v) * texture->height
-        };
-        
-        Rectangle dest = {
-            v0.x, v0.y,
-            v2.x - v0.x, v2.y - v0.y
-        };
-        
-        DrawTexturePro(*texture, source, dest, {0, 0}, 0.0f, tint);
+        rlCheckRenderBatchLimit(4);
+        for (size_t k = i; k < i + 4; ++k) {
+            const TexturedVertex& vertex = batch.vertices[k];
+            const Color color(vertex.color);
+            rlColor4ub(modulate(color.r, tint.r), modulate(color.g, tint.g),
+                       modulate(color.b, tint.b), modulate(color.a, tint.a));
+            rlTexCoord2f(vertex.u, flip_v ? 1.0f - vertex.v : vertex.v);
+            rlVertex2f(vertex.x, vertex.y);
+        }
+    }
+    rlEnd();
+    rlEnableBackfaceCulling();
+    rlSetTexture(0);
+    
+    if (batch.clip_id != 0) {
+        applyClip(0);
+    }
+    if (direct) {
+        rlPopMatrix();
     }
+    endLayerTarget(target);
     
     m_stats.draw_calls_issued++;
     m_stats.batched_draws.fetch_add(1);
@@ -607,15 +1327,88 @@ void RaylibRenderer::flushBatch(BatchGroup& batch) {
     batch.clear();
 }
 
+void RaylibRenderer::flushPrimitiveBatches() {
+    if (!m_primitive_renderer) {
+        return;
+    }
+    
+    if (usesViewports() && m_drawing_pixmap == 0) {
+        for (uint8_t layer_id : m_primitive_renderer->getPendingLayers()) {
+            LayerCache* target = beginLayerTarget(layer_id);
+            if (target) {
+                m_primitive_renderer->flushLayer(layer_id);
+                endLayerTarget(target);
+            }
+        }
+    } else {
+        // Transformed layers flush on their own, under their transform
+        for (uint8_t layer_id : m_primitive_renderer->getPendingLayers()) {
+            if (const LayerTransform* direct = directTransform(layer_id)) {
+                pushTransform(*direct);
+                m_primitive_renderer->flushLayer(layer_id);
+                rlPopMatrix();
+            }
+        }
+    }
+    
+    // Direct mode draws to the window (or the pixmap being drawn into); so
+    // does anything left whose layer has no cache
+    m_primitive_renderer->flushBatches();
+}
+
+RaylibRenderer::LayerCache* RaylibRenderer::beginLayerTarget(uint8_t layer_id) {
+    // Viewport mode draws into the layer's canvas cache, not the window;
+    // the first draw of a frame replaces what the layer showed before
+    LayerCache* target = getOrCreateLayerCache(layer_id);
+    if (!target) {
+        return nullptr;
+    }
+    BeginTextureMode(target->render_texture);
+    if (!m_layers_drawn.test(layer_id)) {
+        ClearBackground(BLANK);
+        m_layers_drawn.set(layer_id);
+    }
+    if (m_using_camera2d) {
+        BeginMode2D(m_camera2d);
+    }
+    const LayerTransform& raster = rasterTransform(layer_id, *target);
+    m_target_transformed = !raster.isIdentity();
+    if (m_target_transformed) {
+        pushTransform(raster);
+    }
+    m_in_layer_target = true;
+    return target;
+}
+
+void RaylibRenderer::endLayerTarget(LayerCache* target) {
+    if (!target) {
+        return;
+    }
+    if (m_target_transformed) {
+        rlPopMatrix();
+        m_target_transformed = false;
+    }
+    m_in_layer_target = false;
+    if (m_using_camera2d) {
+        EndMode2D();
+    }
+    EndTextureMode();
+    target->is_dirty = false;
+}
+
 RaylibRenderer::LayerCache* RaylibRenderer::getOrCreateLayerCache(uint8_t layer_id) {
     auto it = m_layer_caches.find(layer_id);
     if (it != m_layer_caches.end()) {
         return &it->second;
     }
     
+    if (m_config.null_backend) {
+        return nullptr;  // Render textures need a GL context
+    }
+    
     // Create new layer cache
     LayerCache cache;
-    cache.render_texture = LoadRenderTexture(m_config.window_width, m_config.window_height);
+    cache.render_texture = LoadRenderTexture(getCanvasWidth(), getCanvasHeight());
     cache.is_dirty = true;
     cache.is_visible = true;
     
@@ -630,7 +1423,7 @@ RaylibRenderer::LayerCache* RaylibRenderer::getOrCreateLayerCache(uint8_t layer_
     return &m_layer_caches[layer_id];
 }
 
-void RaylibRenderer::renderToLayerCache(LayerCache& cache) {
+void RaylibRenderer::renderToLayerCache(uint8_t layer_id, LayerCache& cache) {
     if (!cache.is_dirty) {
         return;
     }
@@ -639,9 +1432,19 @@ void RaylibRenderer::renderToLayerCache(LayerCache& cache) {
     BeginTextureMode(cache.render_texture);
     ClearBackground(BLANK);  // Transparent background
     
-    // Render all commands for this layer
-    for (const auto& command : cache.commands) {
-        processCommand(command);
+    // Render the layer's commands that can show anywhere, at the transform
+    // the composite expects the pixels to have
+    const LayerTransform& raster = rasterTransform(layer_id, cache);
+    const bool transformed = !raster.isIdentity();
+    if (transformed) {
+        pushTransform(raster);
+    }
+    m_in_layer_target = true;
+    drawRetainedCommands(layer_id, cache);
+    flushBatches();     // The replay's batched draws belong in the cache, under its transform
+    m_in_layer_target = false;
+    if (transformed) {
+        rlPopMatrix();
     }
     
     EndTextureMode();
@@ -652,37 +1455,138 @@ void RaylibRenderer::renderToLayerCache(LayerCache& cache) {
 }
 
 void RaylibRenderer::compositeLayerCaches() {
+    // Caches span the canvas and are stretched over the window; so are objects
+    const LayerTransform to_window{static_cast<float>(m_config.window_width) / getCanvasWidth(), 0.0f, 0.0f,
+                                   static_cast<float>(m_config.window_height) / getCanvasHeight(), 0.0f, 0.0f};
+    
     // Render layers in order from 0 to max
     for (uint8_t layer_id = 0; layer_id < m_config.max_layers; ++layer_id) {
         auto it = m_layer_caches.find(layer_id);
-        if (it != m_layer_caches.end() && it->second.is_visible) {
+        if (it != m_layer_caches.end() && !it->second.is_visible) {
+            continue;
+        }
+        if (it != m_layer_caches.end()) {
             LayerCache& cache = it->second;
             
             // Update cache if dirty
             if (cache.is_dirty) {
-                renderToLayerCache(cache);
+                renderToLayerCache(layer_id, cache);
             }
             
             // Composite layer to screen
             Rectangle source = {0, 0, 
                               static_cast<float>(cache.render_texture.texture.width),
-                              -static_cast<float>(cache.render_texture.texture.height)};
+                              static_cast<float>(cache.render_texture.texture.height)};
             Rectangle dest = {0, 0, 
                             static_cast<float>(m_config.window_width),
                             static_cast<float>(m_config.window_height)};
             
             // Set blend mode for layer
             BeginBlendMode(cache.blend_mode);
-            DrawTexturePro(cache.render_texture.texture, source, dest, {0, 0}, 0.0f, WHITE);
+            drawLayerTexture(cache, layer_id, source, dest);
             EndBlendMode();
             
             m_stats.draw_calls_issued++;
         }
+        drawObjects(layer_id, to_window);
     }
 }
 
+void RaylibRenderer::compositeViewports() {
+    // Cleared layers nobody drew to this frame must not keep their old pixels
+    for (auto& [layer_id, cache] : m_layer_caches) {
+        if (cache.is_dirty && !m_layers_drawn.test(layer_id)) {
+            BeginTextureMode(cache.render_texture);
+            ClearBackground(BLANK);
+            EndTextureMode();
+            cache.is_dirty = false;
+        }
+    }
+    
+    // Caches were drawn under the camera; objects are drawn through it here
+    LayerTransform camera;
+    if (m_using_camera2d) {
+        const Matrix matrix = GetCameraMatrix2D(m_camera2d);
+        camera = {matrix.m0, matrix.m1, matrix.m4, matrix.m5, matrix.m12, matrix.m13};
+    }
+    
+    for (const auto& viewport : m_config.viewports) {
+        BeginScissorMode(viewport.dest_x, viewport.dest_y, viewport.dest_width, viewport.dest_height);
+        
+        Rectangle source = {static_cast<float>(viewport.source_x), static_cast<float>(viewport.source_y),
+                            static_cast<float>(viewport.source_width),
+                            static_cast<float>(viewport.source_height)};
+        Rectangle dest = {static_cast<float>(viewport.dest_x), static_cast<float>(viewport.dest_y),
+                          static_cast<float>(viewport.dest_width), static_cast<float>(viewport.dest_height)};
+        const bool maps_objects = source.width > 0.0f && source.height > 0.0f;
+        const float scale_x = maps_objects ? dest.width / source.width : 0.0f;
+        const float scale_y = maps_objects ? dest.height / source.height : 0.0f;
+        const LayerTransform to_window = LayerTransform{scale_x, 0.0f, 0.0f, scale_y,
+                                                        dest.x - source.x * scale_x, dest.y - source.y * scale_y} *
+                                         camera;
+        
+        for (uint32_t layer_id = 0; layer_id < m_config.max_layers; ++layer_id) {
+            if (!viewport.showsLayer(static_cast<uint8_t>(layer_id))) {
+                continue;
+            }
+            auto it = m_layer_caches.find(static_cast<uint8_t>(layer_id));
+            if (it != m_layer_caches.end() && !it->second.is_visible) {
+                continue;
+            }
+            
+            if (it != m_layer_caches.end()) {
+                BeginBlendMode(it->second.blend_mode);
+                drawLayerTexture(it->second, static_cast<uint8_t>(layer_id), source, dest);
+                EndBlendMode();
+                m_stats.draw_calls_issued++;
+            }
+            if (maps_objects) {
+                drawObjects(static_cast<uint8_t>(layer_id), to_window);
+            }
+        }
+        
+        EndScissorMode();
+    }
+}
+
+void RaylibRenderer::drawLayerTexture(const LayerCache& cache, uint8_t layer_id, const Rectangle& source,
+                                      const Rectangle& dest) {
+    const Texture2D& texture = cache.render_texture.texture;
+    const float texture_width = static_cast<float>(texture.width);
+    const float texture_height = static_cast<float>(texture.height);
+    
+    // What the layer's transform adds to the pixels as they were drawn
+    LayerTransform composite;
+    LayerTransform inverse;
+    if (rasterTransform(layer_id, cache).invert(inverse)) {
+        composite = layerTransform(layer_id) * inverse;
+    }
+    
+    if (composite.isIdentity()) {
+        // Render textures are stored upside down: flip the canvas rectangle
+        Rectangle flipped = {source.x, texture_height - source.y - source.height, source.width, -source.height};
+        DrawTexturePro(texture, flipped, dest, {0, 0}, 0.0f, WHITE);
+        return;
+    }
+    if (source.width <= 0.0f || source.height <= 0.0f) {
+        return;
+    }
+    
+    // The whole canvas, moved by the composite transform, then mapped to
+    // the window as source is to dest; the caller's scissor (or the window)
+    // clips what falls outside dest
+    const float scale_x = dest.width / source.width;
+    const float scale_y = dest.height / source.height;
+    const LayerTransform to_window{scale_x, 0.0f, 0.0f, scale_y,
+                                   dest.x - source.x * scale_x, dest.y - source.y * scale_y};
+    pushTransform(to_window * composite);
+    DrawTexturePro(texture, {0, 0, texture_width, -texture_height}, {0, 0, texture_width, texture_height},
+                   {0, 0}, 0.0f, WHITE);
+    rlPopMatrix();
+}
+
 void RaylibRenderer::updateStats() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     auto frame_duration = std::chrono::duration_cast<std::chrono::microseconds>(
         now - m_frame_start_time);
     
@@ -705,7 +1609,7 @@ void RaylibRenderer::updateStats() {
     
     size_t layer_memory = 0;
     for (const auto& [id, cache] : m_layer_caches) {
-        layer_memory += m_config.window_width * m_config.window_height * 4; // RGBA
+        layer_memory += static_cast<size_t>(getCanvasWidth()) * getCanvasHeight() * 4; // RGBA
     }
     
     m_stats.memory_usage_mb = static_cast<uint32_t>((texture_memory + layer_memory) / (1024 * 1024));
@@ -729,15 +1633,709 @@ void RaylibRenderer::setLayerBlendMode(uint8_t layer_id, int blend_mode) {
     }
 }
 
+void RaylibRenderer::setLayerTransform(uint8_t layer_id, const LayerTransform& transform, bool rerasterize) {
+    if (!transform.isFinite()) {
+        Logger::warning("Ignoring non-finite transform for layer {}", layer_id);
+        return;
+    }
+    
+    if (transform.isIdentity() && !rerasterize) {
+        m_layer_transforms.erase(layer_id);
+        return;
+    }
+    
+    // Every change restarts the wait, so a zoom in progress is never
+    // re-rasterized mid-gesture
+    auto& state = m_layer_transforms[layer_id];
+    if (state.transform != transform || state.changed_at == std::chrono::steady_clock::time_point{}) {
+        state.transform = transform;
+        state.changed_at = Clock::now();
+    }
+    state.pending_bake = rerasterize;
+}
+
+LayerTransform RaylibRenderer::getLayerTransform(uint8_t layer_id) const {
+    return layerTransform(layer_id);
+}
+
+const LayerTransform& RaylibRenderer::layerTransform(uint8_t layer_id) const {
+    auto it = m_layer_transforms.find(layer_id);
+    return it != m_layer_transforms.end() ? it->second.transform : IDENTITY_TRANSFORM;
+}
+
+const LayerTransform& RaylibRenderer::rasterTransform(uint8_t layer_id, const LayerCache& cache) const {
+    // Viewport-mode caches are drawn under the camera, which a composite
+    // transform cannot get beneath: draw those at the layer's transform
+    if (usesViewports() && m_using_camera2d) {
+        return layerTransform(layer_id);
+    }
+    return cache.rasterized;
+}
+
+const LayerTransform* RaylibRenderer::directTransform(uint8_t layer_id) const {
+    if (m_in_layer_target || m_config.null_backend) {
+        return nullptr;     // Cache targets carry their own raster transform
+    }
+    const LayerTransform& transform = layerTransform(layer_id);
+    return transform.isIdentity() ? nullptr : &transform;
+}
+
+void RaylibRenderer::bakeSettledTransforms() {
+    // Re-rasterizing replays the retained commands
+    if (!m_config.retain_scene || m_layer_transforms.empty() || (usesViewports() && m_using_camera2d)) {
+        return;
+    }
+    
+    const auto now = Clock::now();
+    const auto settle = std::chrono::milliseconds(m_config.transform_settle_ms);
+    for (auto& [layer_id, state] : m_layer_transforms) {
+        if (!state.pending_bake || now - state.changed_at < settle) {
+            continue;
+        }
+        auto it = m_layer_caches.find(layer_id);
+        if (it == m_layer_caches.end()) {
+            state.pending_bake = false;
+            continue;
+        }
+        LayerCache& cache = it->second;
+        if (!cache.is_visible) {
+            continue;   // Baked once shown again
+        }
+        state.pending_bake = false;
+        
+        LayerTransform inverse;
+        if (cache.rasterized == state.transform || !state.transform.invert(inverse)) {
+            continue;
+        }
+        cache.rasterized = state.transform;
+        if (usesViewports()) {
+            // A layer drawn this frame flushes its batches at the new transform anyway
+            cache.rerasterize = cache.last_update_frame != m_stats.frames_rendered;
+        } else {
+            cache.is_dirty = true;
+        }
+        m_stats.layers_rerasterized++;
+    }
+}
+
+void RaylibRenderer::pushClip(uint32_t client_id, uint8_t layer_id, const SpatialBounds& rect) {
+    ClipStack& stack = m_clip_stacks[clipKey(client_id, layer_id)];
+    if (stack.rects.size() >= Limits::MAX_CLIP_DEPTH) {
+        if (stack.ignored++ == 0) {
+            Logger::warning("Client {} nests clips on layer {} deeper than {}; ignoring the deepest",
+                           client_id, layer_id, Limits::MAX_CLIP_DEPTH);
+        }
+        return;
+    }
+    
+    SpatialBounds clip = rect;
+    if (!stack.rects.empty()) {
+        const SpatialBounds& outer = stack.rects.back();
+        clip = {std::max(clip.min_x, outer.min_x), std::max(clip.min_y, outer.min_y),
+                std::min(clip.max_x, outer.max_x), std::min(clip.max_y, outer.max_y)};
+    }
+    stack.rects.push_back(clip);
+}
+
+void RaylibRenderer::popClip(uint32_t client_id, uint8_t layer_id) {
+    auto it = m_clip_stacks.find(clipKey(client_id, layer_id));
+    if (it == m_clip_stacks.end()) {
+        Logger::warning("POP_CLIP without PUSH_CLIP from client {} on layer {}", client_id, layer_id);
+        return;
+    }
+    
+    ClipStack& stack = it->second;
+    if (stack.ignored > 0) {
+        stack.ignored--;
+    } else {
+        stack.rects.pop_back();
+    }
+    if (stack.rects.empty() && stack.ignored == 0) {
+        m_clip_stacks.erase(it);
+    }
+}
+
+bool RaylibRenderer::hasClips(uint8_t layer_id) const {
+    return std::any_of(m_clip_stacks.begin(), m_clip_stacks.end(),
+                       [layer_id](const auto& entry) { return (entry.first & 0xFF) == layer_id; });
+}
+
+void RaylibRenderer::removeClient(uint32_t client_id) {
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    m_removed_clients.push_back(client_id);
+}
+
+bool RaylibRenderer::createPixmap(uint32_t client_id, uint32_t pixmap_id, uint32_t width, uint32_t height) {
+    if (pixmap_id == 0 || width == 0 || height == 0 ||
+        width > Limits::MAX_PIXMAP_SIZE || height > Limits::MAX_PIXMAP_SIZE) {
+        Logger::warning("Refusing pixmap {} of {}x{} from client {}", pixmap_id, width, height, client_id);
+        return false;
+    }
+    
+    flushBatchesUsing(pixmap_id);
+    
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    
+    auto existing = m_pixmaps.find(pixmap_id);
+    if (existing == m_pixmaps.end() && m_textures.find(pixmap_id) != m_textures.end()) {
+        Logger::warning("Refusing pixmap {} from client {}: the id is an uploaded texture", pixmap_id, client_id);
+        return false;
+    }
+    if (existing != m_pixmaps.end() && existing->second.owner != client_id) {
+        Logger::warning("Refusing pixmap {} from client {}: it belongs to client {}",
+                       pixmap_id, client_id, existing->second.owner);
+        return false;
+    }
+    if (existing != m_pixmaps.end() && existing->second.target.texture.width == static_cast<int>(width) &&
+        existing->second.target.texture.height == static_cast<int>(height)) {
+        return true;
+    }
+    
+    const uint64_t bytes = static_cast<uint64_t>(width) * height * 4;
+    const uint64_t replaced = existing != m_pixmaps.end() ? existing->second.bytes : 0;
+    const uint64_t limit = static_cast<uint64_t>(m_config.max_pixmap_memory_mb) * 1024 * 1024;
+    if (limit > 0 && m_stats.pixmap_bytes - replaced + bytes > limit) {
+        Logger::warning("Refusing pixmap {} of {}x{} from client {}: pixmaps would exceed {} MB",
+                       pixmap_id, width, height, client_id, m_config.max_pixmap_memory_mb);
+        return false;
+    }
+    
+    Pixmap pixmap;
+    pixmap.owner = client_id;
+    pixmap.bytes = bytes;
+    if (m_config.null_backend) {
+        // Metadata only, as for textures
+        pixmap.target.texture.width = static_cast<int>(width);
+        pixmap.target.texture.height = static_cast<int>(height);
+        pixmap.target.texture.mipmaps = 1;
+    } else {
+        pixmap.target = LoadRenderTexture(static_cast<int>(width), static_cast<int>(height));
+        if (pixmap.target.id == 0) {
+            Logger::error("Failed to create pixmap {} ({}x{})", pixmap_id, width, height);
+            return false;
+        }
+        
+        // Transparent, then what it held before a resize, top left anchored
+        BeginTextureMode(pixmap.target);
+        ClearBackground(BLANK);
+        if (existing != m_pixmaps.end()) {
+            const Texture2D& previous = existing->second.target.texture;
+            const float previous_width = static_cast<float>(previous.width);
+            const float previous_height = static_cast<float>(previous.height);
+            DrawTexturePro(previous, {0.0f, 0.0f, previous_width, -previous_height},
+                           {0.0f, 0.0f, previous_width, previous_height}, {0.0f, 0.0f}, 0.0f, WHITE);
+        }
+        endTextureTarget();
+    }
+    
+    if (existing != m_pixmaps.end()) {
+        if (existing->second.target.id != 0) {
+            UnloadRenderTexture(existing->second.target);
+        }
+        existing->second = pixmap;
+    } else {
+        m_pixmaps.emplace(pixmap_id, pixmap);
+    }
+    m_textures[pixmap_id] = pixmap.target.texture;
+    m_stats.pixmaps = static_cast<uint32_t>(m_pixmaps.size());
+    m_stats.pixmap_bytes = m_stats.pixmap_bytes - replaced + bytes;
+    
+    Logger::debug("{} pixmap {} ({}x{}) for client {}", replaced ? "Resized" : "Created",
+                 pixmap_id, width, height, client_id);
+    return true;
+}
+
+bool RaylibRenderer::freePixmap(uint32_t client_id, uint32_t pixmap_id) {
+    {
+        std::lock_guard<std::mutex> lock(m_resource_mutex);
+        auto it = m_pixmaps.find(pixmap_id);
+        if (it == m_pixmaps.end()) {
+            Logger::warning("Client {} cannot free unknown pixmap {}", client_id, pixmap_id);
+            return false;
+        }
+        if (it->second.owner != client_id) {
+            Logger::warning("Client {} cannot free pixmap {}: it belongs to client {}",
+                           client_id, pixmap_id, it->second.owner);
+            return false;
+        }
+    }
+    
+    flushBatchesUsing(pixmap_id);
+    
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    
+    auto it = m_pixmaps.find(pixmap_id);
+    if (it == m_pixmaps.end()) {
+        return false;
+    }
+    
+    if (it->second.target.id != 0) {
+        UnloadRenderTexture(it->second.target);
+    }
+    m_stats.pixmap_bytes -= it->second.bytes;
+    m_pixmaps.erase(it);
+    m_textures.erase(pixmap_id);
+    m_stats.pixmaps = static_cast<uint32_t>(m_pixmaps.size());
+    
+    Logger::debug("Freed pixmap {}", pixmap_id);
+    return true;
+}
+
+void RaylibRenderer::setPixmapTarget(uint32_t client_id, uint32_t pixmap_id, bool clear) {
+    if (pixmap_id == 0) {
+        m_pixmap_targets.erase(client_id);
+        return;
+    }
+    
+    // Kept even for an unknown pixmap, so what was meant for it is dropped
+    m_pixmap_targets[client_id] = pixmap_id;
+    if (clear) {
+        flushBatchesUsing(pixmap_id);
+    }
+    
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    auto it = m_pixmaps.find(pixmap_id);
+    if (it == m_pixmaps.end()) {
+        Logger::warning("Client {} draws into unknown pixmap {}", client_id, pixmap_id);
+        return;
+    }
+    if (it->second.owner != client_id) {
+        Logger::warning("Client {} cannot draw into pixmap {}: it belongs to client {}",
+                       client_id, pixmap_id, it->second.owner);
+        return;
+    }
+    if (clear && it->second.target.id != 0) {
+        BeginTextureMode(it->second.target);
+        ClearBackground(BLANK);
+        endTextureTarget();
+    }
+}
+
+void RaylibRenderer::flushBatchesUsing(uint32_t texture_id) {
+    // A pixmap drawn earlier in the frame shows what it held then, not
+    // what it is resized, cleared or freed to
+    bool batched = false;
+    {
+        std::lock_guard<std::mutex> lock(m_batch_mutex);
+        batched = std::any_of(m_batch_groups.begin(), m_batch_groups.end(), [texture_id](const BatchGroup& batch) {
+            return batch.texture_id == texture_id && !batch.isEmpty();
+        });
+    }
+    if (batched) {
+        flushBatches();
+    }
+}
+
+RaylibRenderer::DrawKind RaylibRenderer::orderDraw(RenderCommand::Type type) {
+    // Immediate draws land now, batched ones at their flush: a label sent
+    // after its background must not end up under it
+    DrawKind kind = DrawKind::None;
+    switch (type) {
+        case RenderCommand::Type::DRAW_ARC:
+        case RenderCommand::Type::DRAW_POLYGON:
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+        case RenderCommand::Type::FILL_GRADIENT:
+            kind = DrawKind::Primitive;
+            break;
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
+        case RenderCommand::Type::DRAW_SPRITES:
+            kind = DrawKind::Textured;
+            break;
+        default:
+            break;
+    }
+    
+    if (m_batched_kind != DrawKind::None && m_batched_kind != kind) {
+        flushBatches();
+    }
+    m_batched_kind = kind;
+    return kind;
+}
+
+bool RaylibRenderer::isPixmap(uint32_t texture_id) const {
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    return m_pixmaps.find(texture_id) != m_pixmaps.end();
+}
+
+void RaylibRenderer::endTextureTarget() {
+    // EndTextureMode() resets the matrices to the window's: the camera
+    // the frame began with must be reapplied for what follows
+    EndTextureMode();
+    if (m_using_camera2d && !usesViewports()) {
+        BeginMode2D(m_camera2d);
+    }
+}
+
+void RaylibRenderer::copyArea(uint32_t client_id, uint8_t layer_id, int src_x, int src_y, uint32_t width,
+                              uint32_t height, int dst_x, int dst_y) {
+    if (width == 0 || height == 0 || (src_x == dst_x && src_y == dst_y)) {
+        return;
+    }
+    const int copy_width = static_cast<int>(std::min<uint32_t>(width, Limits::MAX_PIXMAP_SIZE));
+    const int copy_height = static_cast<int>(std::min<uint32_t>(height, Limits::MAX_PIXMAP_SIZE));
+    
+    // Into the sender's pixmap, or nowhere once it is gone
+    auto aimed = m_pixmap_targets.find(client_id);
+    if (aimed != m_pixmap_targets.end()) {
+        const uint32_t pixmap_id = aimed->second;
+        flushBatchesUsing(pixmap_id);
+        
+        RenderTexture2D target = {0};
+        {
+            std::lock_guard<std::mutex> lock(m_resource_mutex);
+            auto pixmap = m_pixmaps.find(pixmap_id);
+            if (pixmap == m_pixmaps.end() || pixmap->second.owner != client_id) {
+                return;
+            }
+            target = pixmap->second.target;
+        }
+        if (!m_config.null_backend) {
+            copyPixels(target, src_x, src_y, copy_width, copy_height, dst_x, dst_y);
+        }
+        m_stats.areas_copied++;
+        return;
+    }
+    
+    if (m_config.null_backend) {
+        m_stats.areas_copied++;
+        return;
+    }
+    
+    // Only viewport mode keeps a layer's pixels: elsewhere the layer is
+    // drawn straight to the window, or redrawn from its retained commands
+    if (!usesViewports()) {
+        if (!m_copy_area_warned) {
+            Logger::warning("COPY_AREA on layers needs viewport mode; copy within a pixmap instead");
+            m_copy_area_warned = true;
+        }
+        return;
+    }
+    
+    LayerCache* cache = getOrCreateLayerCache(layer_id);
+    if (!cache) {
+        return;
+    }
+    
+    // What the layer got earlier this frame is drawn before it is copied.
+    // The frame's first draw of a layer replaces its pixels; a copy keeps
+    // them instead, unless the layer was cleared
+    flushBatches();
+    if (!m_layers_drawn.test(layer_id)) {
+        if (cache->is_dirty) {
+            BeginTextureMode(cache->render_texture);
+            ClearBackground(BLANK);
+            EndTextureMode();
+        }
+        m_layers_drawn.set(layer_id);
+    }
+    
+    copyPixels(cache->render_texture, src_x, src_y, copy_width, copy_height, dst_x, dst_y);
+    cache->is_dirty = false;
+    m_stats.areas_copied++;
+}
+
+void RaylibRenderer::copyPixels(const RenderTexture2D& target, int src_x, int src_y, int width, int height,
+                                int dst_x, int dst_y) {
+    // Source pixels outside the target are not copied; the destination
+    // keeps what it held there
+    const int texture_width = target.texture.width;
+    const int texture_height = target.texture.height;
+    const int left = std::max(src_x, 0);
+    const int top = std::max(src_y, 0);
+    const int right = std::min(src_x + width, texture_width);
+    const int bottom = std::min(src_y + height, texture_height);
+    if (right <= left || bottom <= top) {
+        return;
+    }
+    dst_x += left - src_x;
+    dst_y += top - src_y;
+    
+    const float w = static_cast<float>(right - left);
+    const float h = static_cast<float>(bottom - top);
+    if (m_copy_scratch.id == 0 || m_copy_scratch.texture.width < right - left ||
+        m_copy_scratch.texture.height < bottom - top) {
+        const int scratch_width = std::max(right - left, m_copy_scratch.texture.width);
+        const int scratch_height = std::max(bottom - top, m_copy_scratch.texture.height);
+        if (m_copy_scratch.id != 0) {
+            UnloadRenderTexture(m_copy_scratch);
+        }
+        m_copy_scratch = LoadRenderTexture(scratch_width, scratch_height);
+        if (m_copy_scratch.id == 0) {
+            Logger::error("Failed to create a {}x{} copy buffer", scratch_width, scratch_height);
+            return;
+        }
+    }
+    
+    // Out to the scratch texture and back: a framebuffer cannot be read
+    // while it is drawn to, and this way overlapping rectangles copy as if
+    // the source were read whole first. Pixels are replaced, alpha
+    // included, not blended. Render textures are stored bottom row first,
+    // so each source rectangle is taken flipped
+    const float scratch_height = static_cast<float>(m_copy_scratch.texture.height);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    
+    BeginTextureMode(m_copy_scratch);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTexturePro(target.texture, {static_cast<float>(left), static_cast<float>(texture_height - bottom), w, -h},
+                   {0.0f, 0.0f, w, h}, {0.0f, 0.0f}, 0.0f, WHITE);
+    EndBlendMode();
+    EndTextureMode();
+    
+    BeginTextureMode(target);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTexturePro(m_copy_scratch.texture, {0.0f, scratch_height - h, w, -h},
+                   {static_cast<float>(dst_x), static_cast<float>(dst_y), w, h}, {0.0f, 0.0f}, 0.0f, WHITE);
+    EndBlendMode();
+    endTextureTarget();
+    
+    m_stats.draw_calls_issued += 2;
+}
+
+void RaylibRenderer::createObject(const RenderCommand& command) {
+    m_objects.create(command.client_id, command);
+    m_stats.objects = static_cast<uint32_t>(m_objects.size());
+}
+
+void RaylibRenderer::updateObject(const RenderCommand& command) {
+    m_objects.update(command.client_id, command, m_frame_start_time);
+}
+
+void RaylibRenderer::deleteObject(uint32_t client_id, uint32_t object_id) {
+    m_objects.remove(client_id, object_id);
+    m_stats.objects = static_cast<uint32_t>(m_objects.size());
+}
+
+void RaylibRenderer::drawObjects(uint8_t layer_id, const LayerTransform& to_window) {
+    if (!m_objects.hasObjects(layer_id)) {
+        return;
+    }
+    
+    pushTransform(to_window * layerTransform(layer_id));
+    rlDisableBackfaceCulling();     // A mirroring transform winds shapes the other way
+    m_objects.forEachOnLayer(layer_id, [this](const SceneObjects::Object& object) { drawObject(object); });
+    rlDrawRenderBatchActive();      // rlgl culls when it draws, not when the vertices are added
+    rlEnableBackfaceCulling();
+    rlPopMatrix();
+}
+
+void RaylibRenderer::drawObject(const SceneObjects::Object& object) {
+    const auto& values = object.values;
+    const float width = values[SceneObjects::WIDTH];
+    const float height = values[SceneObjects::HEIGHT];
+    auto channel = [](float value) { return static_cast<unsigned char>(std::lround(std::clamp(value, 0.0f, 255.0f))); };
+    const float opacity = std::clamp(values[SceneObjects::OPACITY], 0.0f, 1.0f);
+    const ::Color color = {channel(values[SceneObjects::RED]), channel(values[SceneObjects::GREEN]),
+                           channel(values[SceneObjects::BLUE]), channel(values[SceneObjects::ALPHA] * opacity)};
+    if (width <= 0.0f || height <= 0.0f || color.a == 0) {
+        return;
+    }
+    
+    // Drawn centred on the origin, then rotated and moved to the object's centre
+    rlPushMatrix();
+    rlTranslatef(values[SceneObjects::X], values[SceneObjects::Y], 0.0f);
+    rlRotatef(values[SceneObjects::ROTATION], 0.0f, 0.0f, 1.0f);
+    const ::Rectangle bounds = {-width * 0.5f, -height * 0.5f, width, height};
+    
+    switch (object.shape) {
+        case Constants::OBJECT_SHAPE_ROUNDED_RECTANGLE: {
+            const float shorter = std::min(width, height);
+            const float radius = std::clamp(object.corner_radius, 0.0f, shorter * 0.5f);
+            DrawRectangleRounded(bounds, radius * 2.0f / shorter, 0, color);
+            break;
+        }
+            
+        case Constants::OBJECT_SHAPE_ELLIPSE:
+            DrawEllipse(0, 0, width * 0.5f, height * 0.5f, color);
+            break;
+            
+        case Constants::OBJECT_SHAPE_IMAGE: {
+            Texture2D texture = {0};
+            bool flip = false;      // Pixmaps are stored bottom row first
+            {
+                std::lock_guard<std::mutex> lock(m_resource_mutex);
+                auto it = m_textures.find(object.texture_id);
+                if (it != m_textures.end()) {
+                    texture = it->second;
+                    flip = m_pixmaps.find(object.texture_id) != m_pixmaps.end();
+                }
+            }
+            if (texture.id != 0) {
+                const float texture_height = static_cast<float>(texture.height);
+                DrawTexturePro(texture, {0.0f, 0.0f, static_cast<float>(texture.width),
+                                         flip ? -texture_height : texture_height},
+                               bounds, {0, 0}, 0.0f, color);
+            }
+            break;
+        }
+            
+        default:
+            DrawRectangleRec(bounds, color);
+            break;
+    }
+    
+    rlPopMatrix();
+    m_stats.objects_drawn++;
+}
+
+bool RaylibRenderer::beginCommand(const RenderCommand& command) {
+    if (!isDrawing(command.type)) {
+        return true;
+    }
+    
+    // Drawing aimed at a pixmap lands there, or nowhere once it is gone
+    uint32_t pixmap_id = 0;
+    RenderTexture2D pixmap_target = {0};
+    auto aimed = m_pixmap_targets.find(command.client_id);
+    if (aimed != m_pixmap_targets.end()) {
+        std::lock_guard<std::mutex> lock(m_resource_mutex);
+        auto pixmap = m_pixmaps.find(aimed->second);
+        if (pixmap == m_pixmaps.end() || pixmap->second.owner != command.client_id) {
+            return false;
+        }
+        pixmap_id = pixmap->first;
+        pixmap_target = pixmap->second.target;
+    }
+    
+    // Wholly outside the sender's clip: skipped before any tessellation
+    const SpatialBounds* clip = nullptr;
+    auto stack = m_clip_stacks.find(clipKey(command.client_id, command.layer_id));
+    if (stack != m_clip_stacks.end() && !stack->second.rects.empty()) {
+        clip = &stack->second.rects.back();
+        SpatialBounds bounds;
+        if (clip->isEmpty() || (LayerIndex::commandBounds(command, bounds) && !clip->intersects(bounds))) {
+            m_stats.commands_clipped++;
+            return false;
+        }
+    }
+    
+    const DrawKind kind = orderDraw(command.type);
+    
+    if (pixmap_id != 0) {
+        // What is batched belongs to the layers: draw it before binding
+        // the pixmap, so the command's own batches are all that endCommand()
+        // flushes into it. Pixmap coordinates: no layer transform or camera
+        flushBatches();
+        if (!m_config.null_backend) {
+            BeginTextureMode(pixmap_target);
+        }
+        m_drawing_pixmap = pixmap_id;
+        m_in_layer_target = true;
+    } else if (usesViewports() && !m_in_layer_target) {
+        // Viewports composite the layer caches: immediate draws go into
+        // the layer's, as its batches do at their flush
+        if (kind == DrawKind::None) {
+            m_command_target = beginLayerTarget(command.layer_id);
+            if (!m_command_target) {
+                return false;
+            }
+        }
+    } else if (const LayerTransform* direct = directTransform(command.layer_id)) {
+        // Immediate draws land in the window now: transform their vertices
+        pushTransform(*direct);
+        m_command_transformed = true;
+    }
+    if (clip) {
+        m_current_clip = clipId(*clip);     // After any flush: flushing resets clip ids
+    }
+    
+    // Batched draws carry the clip to their flush; immediate ones are scissored now
+    if (m_current_clip != 0) {
+        if (m_primitive_renderer) {
+            m_primitive_renderer->setClip(m_current_clip);
+        }
+        if (!m_config.null_backend) {
+            applyClip(m_current_clip);
+        }
+    }
+    return true;
+}
+
+void RaylibRenderer::endCommand() {
+    if (m_drawing_pixmap != 0) {
+        flushBatches();
+    }
+    if (m_current_clip != 0) {
+        if (!m_config.null_backend) {
+            applyClip(0);
+        }
+        if (m_primitive_renderer) {
+            m_primitive_renderer->setClip(0);
+        }
+        m_current_clip = 0;
+    }
+    if (m_command_transformed) {
+        rlPopMatrix();
+        m_command_transformed = false;
+    }
+    if (m_command_target) {
+        endLayerTarget(m_command_target);
+        m_command_target = nullptr;
+    }
+    if (m_drawing_pixmap != 0) {
+        if (!m_config.null_backend) {
+            endTextureTarget();
+        }
+        m_in_layer_target = false;
+        m_drawing_pixmap = 0;
+    }
+}
+
+uint16_t RaylibRenderer::clipId(const SpatialBounds& rect) {
+    // Neighbouring commands mostly share a clip: look among the latest few
+    const size_t oldest = m_clip_rects.size() > 8 ? m_clip_rects.size() - 8 : 0;
+    for (size_t i = m_clip_rects.size(); i > oldest; --i) {
+        const SpatialBounds& known = m_clip_rects[i - 1];
+        if (known.min_x == rect.min_x && known.min_y == rect.min_y &&
+            known.max_x == rect.max_x && known.max_y == rect.max_y) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    
+    // Ids are per frame; draw what holds the old ones before reusing them
+    if (m_clip_rects.size() >= UINT16_MAX) {
+        flushBatches();
+    }
+    m_clip_rects.push_back(rect);
+    return static_cast<uint16_t>(m_clip_rects.size());
+}
+
+void RaylibRenderer::applyClip(uint16_t clip_id) {
+    if (clip_id == 0 || clip_id > m_clip_rects.size()) {
+        EndScissorMode();
+        return;
+    }
+    
+    // Clips are in layer coordinates: map them as rlgl maps vertices right
+    // now (layer transform, then camera) to the target's pixels. Under a
+    // rotation the scissor is the clip's bounding box; rlgl has no stencil
+    const Matrix transform = rlGetMatrixTransform();
+    const Matrix modelview = rlGetMatrixModelview();
+    const LayerTransform to_pixels =
+        LayerTransform{modelview.m0, modelview.m1, modelview.m4, modelview.m5, modelview.m12, modelview.m13} *
+        LayerTransform{transform.m0, transform.m1, transform.m4, transform.m5, transform.m12, transform.m13};
+    const SpatialBounds pixels = to_pixels.apply(m_clip_rects[clip_id - 1]);
+    
+    const int x = static_cast<int>(std::floor(pixels.min_x));
+    const int y = static_cast<int>(std::floor(pixels.min_y));
+    BeginScissorMode(x, y, std::max(0, static_cast<int>(std::ceil(pixels.max_x)) - x),
+                     std::max(0, static_cast<int>(std::ceil(pixels.max_y)) - y));
+}
+
 bool RaylibRenderer::deleteTexture(uint32_t texture_id) {
     std::lock_guard<std::mutex> lock(m_resource_mutex);
     
+    if (m_pixmaps.find(texture_id) != m_pixmaps.end()) {
+        Logger::warning("Texture {} is a pixmap; free it as one", texture_id);
+        return false;
+    }
+    
     auto it = m_textures.find(texture_id);
     if (it != m_textures.end()) {
         if (it->second.id != 0) {
             UnloadTexture(it->second);
         }
         m_textures.erase(it);
+        m_texture_hashes.erase(texture_id);
         Logger::debug("Deleted texture {}", texture_id);
         return true;
     }
@@ -792,16 +2390,46 @@ void RaylibRenderer::resetCamera2D() {
     m_using_camera2d = false;
 }
 
+uint32_t RaylibRenderer::getCanvasWidth() const {
+    return m_config.canvas_width > 0 ? m_config.canvas_width : m_config.window_width;
+}
+
+uint32_t RaylibRenderer::getCanvasHeight() const {
+    return m_config.canvas_height > 0 ? m_config.canvas_height : m_config.window_height;
+}
+
+bool RaylibRenderer::usesViewports() const {
+    return m_config.layer_caching && !m_config.null_backend && !m_config.viewports.empty();
+}
+
 void RaylibRenderer::resetStats() {
     std::lock_guard<std::mutex> lock(m_stats_mutex);
     m_stats = Stats{};
     Logger::debug("Renderer statistics reset");
 }
 
+void RaylibRenderer::requestFrameCapture() {
+    if (m_config.null_backend) {
+        Logger::warning("Frame capture is not available with the null backend");
+        return;
+    }
+    m_capture_requested = true;
+}
+
+bool RaylibRenderer::takeCapturedFrame(Image& image) {
+    if (!m_captured_frame.data) {
+        return false;
+    }
+    
+    image = m_captured_frame;
+    m_captured_frame = {0};
+    return true;
+}
+
 void RaylibRenderer::setConfig(const Config& config) {
     m_config = config;
     
-    if (m_initialized) {
+    if (m_initialized && !m_config.null_backend) {
         // Apply config changes that can be applied at runtime
         SetTargetFPS(m_config.target_fps);
         
@@ -809,12 +2437,123 @@ void RaylibRenderer::setConfig(const Config& config) {
     }
 }
 
+void RaylibRenderer::exportScene(SceneState& scene, const TextureFilter& wants_pixels) {
+    for (const auto& [layer_id, cache] : m_layer_caches) {
+        SceneState::Layer layer;
+        layer.id = layer_id;
+        layer.visible = cache.is_visible;
+        layer.blend_mode = cache.blend_mode;
+        layer.transform = layerTransform(layer_id);
+        layer.commands = cache.commands;
+        scene.layers.push_back(std::move(layer));
+    }
+    for (const auto& [layer_id, state] : m_layer_transforms) {
+        if (m_layer_caches.find(layer_id) == m_layer_caches.end()) {
+            SceneState::Layer layer;
+            layer.id = layer_id;
+            layer.blend_mode = BLEND_ALPHA;
+            layer.transform = state.transform;
+            scene.layers.push_back(std::move(layer));
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_resource_mutex);
+    for (const auto& [texture_id, texture] : m_textures) {
+        if (texture_id == m_white_texture_id || m_pixmaps.find(texture_id) != m_pixmaps.end()) {
+            continue;  // Recreated by every renderer; pixmaps by their clients
+        }
+        
+        SceneState::Texture entry;
+        entry.id = texture_id;
+        entry.width = static_cast<uint32_t>(texture.width);
+        entry.height = static_cast<uint32_t>(texture.height);
+        entry.format = Constants::PIXEL_FORMAT_RGBA8;
+        
+        auto hash = m_texture_hashes.find(texture_id);
+        if (hash != m_texture_hashes.end()) {
+            entry.content_hash = hash->second;
+        }
+        
+        if (!m_config.null_backend && texture.id != 0 && (!wants_pixels || wants_pixels(entry))) {
+            Image image = LoadImageFromTexture(texture);
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            size_t size = static_cast<size_t>(GetPixelDataSize(image.width, image.height, image.format));
+            const auto* pixels = static_cast<const uint8_t*>(image.data);
+            entry.pixels.assign(pixels, pixels + size);
+            UnloadImage(image);
+        }
+        
+        scene.textures.push_back(std::move(entry));
+    }
+    
+    m_objects.exportObjects(scene.objects, Clock::now());
+}
+
+bool RaylibRenderer::importScene(const SceneState& scene) {
+    uint32_t highest_id = 0;
+    size_t skipped = 0;
+    
+    for (const auto& texture : scene.textures) {
+        highest_id = std::max(highest_id, texture.id);
+        
+        if (texture.pixels.empty() && !m_config.null_backend) {
+            ++skipped;  // Exported by a null renderer: nothing to upload
+            continue;
+        }
+        
+        if (uploadTexture(texture.id, texture.width, texture.height, texture.format,
+                          texture.pixels.data(), static_cast<uint32_t>(texture.pixels.size())) == 0) {
+            ++skipped;
+            continue;
+        }
+        
+        // Keep the original upload's hash, not one of the read-back copy
+        if (m_config.retain_scene && texture.content_hash != 0) {
+            std::lock_guard<std::mutex> lock(m_resource_mutex);
+            m_texture_hashes[texture.id] = texture.content_hash;
+        }
+    }
+    
+    // Keep restored ids from colliding with ones generated from now on
+    uint32_t next_id = m_next_resource_id.load();
+    while (next_id <= highest_id && !m_next_resource_id.compare_exchange_weak(next_id, highest_id + 1)) {
+    }
+    
+    for (const auto& layer : scene.layers) {
+        setLayerTransform(layer.id, layer.transform);
+        
+        LayerCache* cache = getOrCreateLayerCache(layer.id);
+        if (!cache) {
+            continue;  // Null backend keeps no layer caches
+        }
+        LayerTransform inverse;
+        if (layer.transform.invert(inverse)) {
+            cache->rasterized = layer.transform;   // Replayed below at the transform
+        }
+        cache->is_visible = layer.visible;
+        cache->blend_mode = layer.blend_mode;
+        cache->commands = layer.commands;
+        cache->index.rebuild(cache->commands);
+        cache->replay = !layer.commands.empty();
+        cache->is_dirty = true;
+    }
+    
+    m_objects.importObjects(scene.objects, Clock::now());
+    
+    if (skipped > 0) {
+        Logger::warning("Scene import skipped {} of {} textures", skipped, scene.textures.size());
+    }
+    Logger::info("Imported scene: {} layers, {} textures, {} objects",
+                 scene.layers.size(), scene.textures.size() - skipped, m_objects.size());
+    return skipped == 0;
+}
+
 void RaylibRenderer::handleWindowResize(int width, int height) {
     m_config.window_width = width;
     m_config.window_height = height;
     
-    // Recreate layer caches with new size
-    if (m_config.layer_caching) {
+    // Recreate layer caches with new size (a fixed canvas keeps its size)
+    if (m_config.layer_caching && m_config.canvas_width == 0) {
         for (auto& [layer_id, cache] : m_layer_caches) {
             if (cache.render_texture.id != 0) {
                 UnloadRenderTexture(cache.render_texture);
@@ -827,6 +2566,101 @@ void RaylibRenderer::handleWindowResize(int width, int height) {
     Logger::info("Window resized to {}x{}", width, height);
 }
 
+void RaylibRenderer::pollInput(std::vector<InputEvent>& events) {
+    if (!m_initialized || m_config.null_backend) {
+        return;
+    }
+    
+    const Vector2 mouse = GetMousePosition();
+    uint16_t modifiers = 0;
+    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) modifiers |= InputRouting::MOD_SHIFT;
+    if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) modifiers |= InputRouting::MOD_CONTROL;
+    if (IsKeyDown(KEY_LEFT_ALT) || IsKeyDown(KEY_RIGHT_ALT)) modifiers |= InputRouting::MOD_ALT;
+    if (IsKeyDown(KEY_LEFT_SUPER) || IsKeyDown(KEY_RIGHT_SUPER)) modifiers |= InputRouting::MOD_SUPER;
+    
+    const uint64_t timestamp = Clock::nowMicros();
+    auto emit = [&](InputEventType type, uint8_t button) -> InputEvent& {
+        InputEvent event{};
+        event.type = type;
+        event.button = button;
+        event.modifiers = modifiers;
+        event.position = vector2ToPoint(mouse);
+        event.wheel_delta = 0.0f;
+        event.timestamp = timestamp;
+        events.push_back(event);
+        return events.back();
+    };
+    
+    if (mouse.x != m_last_mouse_position.x || mouse.y != m_last_mouse_position.y) {
+        emit(InputEventType::MOUSE_MOVE, 0);
+        m_last_mouse_position = mouse;
+    }
+    
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; ++button) {
+        if (IsMouseButtonPressed(button)) {
+            emit(InputEventType::MOUSE_PRESS, static_cast<uint8_t>(button));
+        }
+        if (IsMouseButtonReleased(button)) {
+            emit(InputEventType::MOUSE_RELEASE, static_cast<uint8_t>(button));
+        }
+    }
+    
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) {
+        emit(InputEventType::MOUSE_WHEEL, 0).wheel_delta = wheel;
+    }
+    
+    // Key codes from 256 up are shifted down to fit the one-byte field
+    auto wire_key = [](int key) {
+        return static_cast<uint8_t>(key >= 256 ? key - InputRouting::SPECIAL_KEY_OFFSET : key);
+    };
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        emit(InputEventType::KEY_PRESS, wire_key(key));
+        if (std::find(m_keys_down.begin(), m_keys_down.end(), key) == m_keys_down.end()) {
+            m_keys_down.push_back(key);
+        }
+    }
+    for (auto it = m_keys_down.begin(); it != m_keys_down.end();) {
+        if (IsKeyReleased(*it) || !IsKeyDown(*it)) {
+            emit(InputEventType::KEY_RELEASE, wire_key(*it));
+            it = m_keys_down.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool RaylibRenderer::windowToCanvas(const Point& window_position, Point& canvas_position,
+                                    std::bitset<256>& visible_layers) const {
+    visible_layers.reset();
+    
+    if (usesViewports()) {
+        // Later viewports are composited on top, so they win where they overlap
+        bool inside = false;
+        for (auto it = m_config.viewports.rbegin(); it != m_config.viewports.rend() && !inside; ++it) {
+            if (it->windowToCanvas(window_position.x, window_position.y, canvas_position.x, canvas_position.y)) {
+                visible_layers = it->layers;
+                inside = true;
+            }
+        }
+        if (!inside) {
+            return false;
+        }
+    } else {
+        // The canvas is stretched over the whole window
+        canvas_position.x = window_position.x * getCanvasWidth() / std::max<uint32_t>(m_config.window_width, 1);
+        canvas_position.y = window_position.y * getCanvasHeight() / std::max<uint32_t>(m_config.window_height, 1);
+        visible_layers.set();
+    }
+    
+    for (const auto& [layer_id, cache] : m_layer_caches) {
+        if (!cache.is_visible) {
+            visible_layers.reset(layer_id);
+        }
+    }
+    return true;
+}
+
 // Utility functions implementation
 
 Vector2 pointToVector2(const Point& point) {
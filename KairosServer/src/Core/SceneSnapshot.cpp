@@ -0,0 +1,215 @@
+// KairosServer/src/Core/SceneSnapshot.cpp
+#include <Core/SceneSnapshot.hpp>
+#include <Utils/BinaryIO.hpp>
+#include <Utils/Logger.hpp>
+#include <Utils/MappedFile.hpp>
+#include <Clock.hpp>
+
+#include <cstdio>
+#include <filesystem>
+
+namespace Kairos {
+
+namespace {
+
+// magic, version, payload size, payload hash
+constexpr size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+
+constexpr const char* TEXTURE_EXTENSION = ".rgba";
+
+} // anonymous namespace
+
+SceneSnapshot::SceneSnapshot(const Config& config)
+    : m_config(config), m_texture_dir(config.path + ".textures"), m_last_write(Clock::now()) {
+    // Pixels left by a previous run can be referenced again without a readback
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(m_texture_dir, ec)) {
+        if (entry.path().extension() == TEXTURE_EXTENSION) {
+            try {
+                m_stored_textures.insert(std::stoull(entry.path().stem().string(), nullptr, 16));
+            } catch (const std::exception&) {
+                // Not one of ours
+            }
+        }
+    }
+}
+
+SceneSnapshot::~SceneSnapshot() {
+    waitForPendingWrite();
+}
+
+bool SceneSnapshot::isDue() const {
+    if (m_pending_write.valid() &&
+        m_pending_write.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    return Clock::now() - m_last_write >= std::chrono::milliseconds(m_config.interval_ms);
+}
+
+bool SceneSnapshot::hasTexture(uint64_t content_hash) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stored_textures.count(content_hash) > 0;
+}
+
+void SceneSnapshot::write(SceneState scene) {
+    waitForPendingWrite();
+    m_last_write = Clock::now();
+    m_pending_write = std::async(std::launch::async, [this, scene = std::move(scene)]() mutable {
+        return writeFiles(scene);
+    });
+}
+
+bool SceneSnapshot::writeNow(SceneState scene) {
+    waitForPendingWrite();
+    m_last_write = Clock::now();
+    return writeFiles(scene);
+}
+
+bool SceneSnapshot::writeFiles(SceneState& scene) {
+    // Real time on purpose: this measures disk I/O, not scheduled work
+    auto start = std::chrono::steady_clock::now();
+    
+    std::error_code ec;
+    std::filesystem::create_directories(m_texture_dir, ec);
+    
+    // Move pixels out to content-addressed files; the snapshot keeps the hash
+    std::unordered_set<uint64_t> referenced;
+    uint64_t textures_written = 0;
+    for (auto& texture : scene.textures) {
+        if (texture.content_hash == 0 && !texture.pixels.empty()) {
+            texture.content_hash = SceneState::contentHash(texture.pixels.data(), texture.pixels.size());
+        }
+        if (texture.content_hash == 0) {
+            continue;
+        }
+        
+        referenced.insert(texture.content_hash);
+        if (!texture.pixels.empty() && !hasTexture(texture.content_hash)) {
+            if (!MappedFile::writeAtomically(texturePath(texture.content_hash),
+                                             texture.pixels.data(), texture.pixels.size())) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stored_textures.insert(texture.content_hash);
+            ++textures_written;
+        }
+        texture.pixels.clear();
+    }
+    
+    std::vector<uint8_t> payload;
+    BinaryWriter payload_writer(payload);
+    scene.serialize(payload_writer);
+    
+    std::vector<uint8_t> file;
+    file.reserve(HEADER_SIZE + payload.size());
+    BinaryWriter writer(file);
+    writer.write(MAGIC);
+    writer.write(FORMAT_VERSION);
+    writer.write(static_cast<uint64_t>(payload.size()));
+    writer.write(SceneState::contentHash(payload.data(), payload.size()));
+    writer.writeBytes(payload.data(), payload.size());
+    
+    if (!MappedFile::writeAtomically(m_config.path, file.data(), file.size())) {
+        return false;
+    }
+    
+    removeUnreferencedTextures(referenced);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.snapshots_written++;
+    m_stats.textures_written += textures_written;
+    m_stats.last_size_bytes = file.size();
+    m_stats.last_write_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    Logger::debug("Scene snapshot written: {} layers, {} textures ({} new), {} KB in {:.1f} ms",
+                  scene.layers.size(), scene.textures.size(), textures_written,
+                  file.size() / 1024, m_stats.last_write_ms);
+    return true;
+}
+
+bool SceneSnapshot::load(SceneState& scene) {
+    MappedFile file;
+    if (!file.open(m_config.path)) {
+        Logger::info("No scene snapshot at {}", m_config.path);
+        return false;
+    }
+    
+    BinaryReader header(file.data(), file.size());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t payload_size = 0;
+    uint64_t payload_hash = 0;
+    header.read(magic);
+    header.read(version);
+    header.read(payload_size);
+    header.read(payload_hash);
+    
+    if (!header.isValid() || magic != MAGIC || version != FORMAT_VERSION) {
+        Logger::warning("Ignoring scene snapshot {}: unknown format (version {})", m_config.path, version);
+        return false;
+    }
+    
+    const uint8_t* payload = file.data() + HEADER_SIZE;
+    if (payload_size != file.size() - HEADER_SIZE ||
+        SceneState::contentHash(payload, static_cast<size_t>(payload_size)) != payload_hash) {
+        Logger::warning("Ignoring scene snapshot {}: checksum mismatch", m_config.path);
+        return false;
+    }
+    
+    BinaryReader reader(payload, static_cast<size_t>(payload_size));
+    if (!scene.deserialize(reader)) {
+        Logger::warning("Ignoring scene snapshot {}: unreadable scene state", m_config.path);
+        return false;
+    }
+    
+    size_t missing = 0;
+    for (auto& texture : scene.textures) {
+        MappedFile pixels;
+        size_t expected = static_cast<size_t>(texture.width) * texture.height * 4;
+        if (!pixels.open(texturePath(texture.content_hash)) || pixels.size() != expected) {
+            ++missing;
+            continue;
+        }
+        texture.pixels.assign(pixels.data(), pixels.data() + pixels.size());
+    }
+    
+    if (missing > 0) {
+        Logger::warning("Scene snapshot is missing pixels for {} textures", missing);
+    }
+    Logger::info("Loaded scene snapshot {}: {} layers, {} textures, {} fonts",
+                 m_config.path, scene.layers.size(), scene.textures.size(), scene.fonts.size());
+    return true;
+}
+
+SceneSnapshot::Stats SceneSnapshot::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void SceneSnapshot::removeUnreferencedTextures(const std::unordered_set<uint64_t>& referenced) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_stored_textures.begin(); it != m_stored_textures.end();) {
+        if (referenced.count(*it)) {
+            ++it;
+            continue;
+        }
+        std::error_code ec;
+        std::filesystem::remove(texturePath(*it), ec);
+        it = m_stored_textures.erase(it);
+    }
+}
+
+std::string SceneSnapshot::texturePath(uint64_t content_hash) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(content_hash));
+    return m_texture_dir + "/" + name + TEXTURE_EXTENSION;
+}
+
+void SceneSnapshot::waitForPendingWrite() {
+    if (m_pending_write.valid()) {
+        m_pending_write.get();
+    }
+}
+
+} // namespace Kairos
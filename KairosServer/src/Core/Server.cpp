@@ -5,7 +5,12 @@
 #include <Core/CommandProcessor.hpp>
 #include <Core/LayerManager.hpp>
 #include <Core/FontManager.hpp>
+#include <Utils/InitGraph.hpp>
 #include <Utils/Logger.hpp>
+#include <Utils/Platform.hpp>
+#include <Clock.hpp>
+#include <bitset>
+#include <csignal>
 #include <iostream>
 #include <sstream>
 
@@ -15,14 +20,74 @@ namespace Kairos {
 Server* Server::s_instance = nullptr;
 std::mutex Server::s_instance_mutex;
 
-Server::Server(const Config& config) : m_config(config) {
+namespace {
+
+Logger::Level parseLogLevel(const std::string& level) {
+    if (level == "debug") return Logger::Level::Debug;
+    if (level == "info") return Logger::Level::Info;
+    if (level == "warning") return Logger::Level::Warning;
+    return Logger::Level::Error;
+}
+
+/**
+ * @brief Copies settings that need a restart from current into next
+ * @return true if next asked to change any of them
+ */
+bool keepRestartOnlySettings(const Config& current, Config& next) {
+    bool changed = false;
+    auto keep = [&changed](auto& next_value, const auto& current_value) {
+        if (next_value != current_value) {
+            next_value = current_value;
+            changed = true;
+        }
+    };
+    
+    // Listeners and network threads
+    keep(next.network().tcp_bind_address, current.network().tcp_bind_address);
+    keep(next.network().tcp_port, current.network().tcp_port);
+    keep(next.network().enable_tcp, current.network().enable_tcp);
+    keep(next.network().unix_socket_path, current.network().unix_socket_path);
+    keep(next.network().enable_unix_socket, current.network().enable_unix_socket);
+    keep(next.performance().network_thread_count, current.performance().network_thread_count);
+    keep(next.performance().thread_policies, current.performance().thread_policies);
+    keep(next.performance().realtime_mode, current.performance().realtime_mode);
+    keep(next.performance().realtime_heap_reserve_mb, current.performance().realtime_heap_reserve_mb);
+    
+    // Window and graphics context
+    keep(next.renderer().window_width, current.renderer().window_width);
+    keep(next.renderer().window_height, current.renderer().window_height);
+    keep(next.renderer().fullscreen, current.renderer().fullscreen);
+    keep(next.renderer().hidden, current.renderer().hidden);
+    keep(next.renderer().null_backend, current.renderer().null_backend);
+    keep(next.renderer().enable_vsync, current.renderer().enable_vsync);
+    keep(next.renderer().enable_antialiasing, current.renderer().enable_antialiasing);
+    keep(next.renderer().window_title, current.renderer().window_title);
+    keep(next.renderer().canvas_width, current.renderer().canvas_width);
+    keep(next.renderer().canvas_height, current.renderer().canvas_height);
+    
+    // Allocated or process-wide at startup
+    keep(next.features().max_layers, current.features().max_layers);
+    keep(next.features().snapshot_file, current.features().snapshot_file);
+    keep(next.performance().virtual_clock, current.performance().virtual_clock);
+    keep(next.logging().log_file, current.logging().log_file);
+    keep(next.logging().log_to_file, current.logging().log_to_file);
+    keep(next.logging().log_to_console, current.logging().log_to_console);
+    
+    return changed;
+}
+
+} // anonymous namespace
+
+Server::Server(const Config& config) : m_config(config), m_live_config(config) {
+    m_applied_config_version = m_live_config.getVersion();
+    
     // Set global instance for signal handling
     {
         std::lock_guard<std::mutex> lock(s_instance_mutex);
         s_instance = this;
     }
     
-    m_stats.start_time = std::chrono::steady_clock::now();
+    m_stats.start_time = Clock::now();
     
     Logger::info("Server created with configuration:");
     Logger::info(m_config.getConfigSummary());
@@ -49,8 +114,25 @@ bool Server::initialize() {
     }
     
     m_state = State::INITIALIZING;
+    m_startup_time = std::chrono::steady_clock::now();
     Logger::info("Initializing Kairos server...");
     
+    if (m_config.performance().virtual_clock && !Clock::isVirtual()) {
+        Clock::setMode(Clock::Mode::Virtual);
+        Logger::info("Virtual clock enabled: time advances only when stepped");
+    }
+    
+    // Lock first so every later allocation (pools, threads, textures) is locked too
+    if (m_config.performance().realtime_mode) {
+        if (Platform::lockMemory()) {
+            Platform::prefaultHeap(m_config.performance().realtime_heap_reserve_mb * 1024 * 1024);
+            Logger::info("Real-time mode: memory locked, {} MB heap prefaulted",
+                         m_config.performance().realtime_heap_reserve_mb);
+        } else {
+            Logger::error("Real-time mode without locked memory: page faults can still stall frames");
+        }
+    }
+    
     try {
         if (!initializeSubsystems()) {
             m_state = State::ERROR;
@@ -77,6 +159,13 @@ void Server::run() {
     Logger::info("Starting Kairos server main loop");
     m_state = State::RUNNING;
     
+    if (m_watch_config_file && !m_config_file.empty()) {
+        m_config_watcher = std::make_unique<ConfigWatcher>();
+        m_config_watcher->start(m_config_file, [this](const std::string& path) {
+            reloadConfig(path);
+        });
+    }
+    
     try {
         mainLoop();
     } catch (const std::exception& e) {
@@ -84,6 +173,11 @@ void Server::run() {
         m_state = State::ERROR;
     }
     
+    if (m_config_watcher) {
+        m_config_watcher->stop();
+        m_config_watcher.reset();
+    }
+    
     Logger::info("Server main loop ended");
 }
 
@@ -93,6 +187,10 @@ void Server::shutdown() {
     m_state = State::STOPPING;
     m_shutdown_requested = true;
     
+    if (m_config_watcher) {
+        m_config_watcher->stop();
+    }
+    
     // Wait for main thread to finish
     if (m_main_thread.joinable()) {
         m_main_thread.join();
@@ -129,52 +227,91 @@ void Server::setConfig(const Config& config) {
     }
     
     m_config = config;
+    m_applied_config_version = m_live_config.publish(config);
     Logger::info("Server configuration updated");
 }
 
 bool Server::reloadConfig(const std::string& config_file) {
+    std::lock_guard<std::mutex> lock(m_reload_mutex);
+    
+    // Values missing from the file keep their current setting, and command
+    // line options still override the file
+    Config new_config = *m_live_config.read();
     if (!config_file.empty()) {
-        Config new_config;
         if (!new_config.loadFromFile(config_file)) {
             Logger::error("Failed to load configuration from file: {}", config_file);
             return false;
         }
-        setConfig(new_config);
+        
+        if (m_config_overrides) {
+            m_config_overrides(new_config);
+        }
+        
+        if (!new_config.validate()) {
+            Logger::error("Rejected invalid configuration from file: {}", config_file);
+            return false;
+        }
     }
     
+    if (m_state.load() != State::STOPPED) {
+        // The main loop owns m_config and the subsystems; hand the new
+        // snapshot over and let applyLiveConfig() pick it up next frame
+        if (keepRestartOnlySettings(*m_live_config.read(), new_config)) {
+            Logger::warning("Listener, window and thread settings only change on restart");
+        }
+        
+        uint64_t version = m_live_config.publish(new_config);
+        Logger::info("Configuration version {} published", version);
+        return true;
+    }
+    
+    m_config = new_config;
+    m_applied_config_version = m_live_config.publish(new_config);
+    
     // Apply configuration changes to subsystems
     if (m_renderer) {
-        RaylibRenderer::Config renderer_config;
-        renderer_config.window_width = m_config.renderer().window_width;
-        renderer_config.window_height = m_config.renderer().window_height;
-        renderer_config.target_fps = m_config.renderer().target_fps;
-        renderer_config.enable_vsync = m_config.renderer().enable_vsync;
-        renderer_config.enable_antialiasing = m_config.renderer().enable_antialiasing;
-        renderer_config.layer_caching = m_config.renderer().layer_caching;
-        m_renderer->setConfig(renderer_config);
+        m_renderer->setConfig(makeRendererConfig(m_config));
     }
     
     if (m_network_manager) {
-        NetworkManager::Config network_config;
-        network_config.tcp_bind_address = m_config.network().tcp_bind_address;
-        network_config.tcp_port = m_config.network().tcp_port;
-        network_config.enable_tcp = m_config.network().enable_tcp;
-        network_config.unix_socket_path = m_config.network().unix_socket_path;
-        network_config.enable_unix_socket = m_config.network().enable_unix_socket;
-        network_config.max_clients = m_config.network().max_clients;
-        m_network_manager->setConfig(network_config);
+        m_network_manager->setConfig(makeNetworkConfig(m_config));
     }
     
     return true;
 }
 
+void Server::setConfigFile(const std::string& config_file, bool watch) {
+    m_config_file = config_file;
+    m_watch_config_file = watch;
+}
+
+void Server::setConfigOverrides(std::function<void(Kairos::Config&)> overrides) {
+    m_config_overrides = std::move(overrides);
+}
+
+void Server::requestConfigReload() {
+    m_reload_requested = true;
+}
+
+void Server::setUpgradeCommand(const std::vector<std::string>& command) {
+    m_upgrade_command = command;
+}
+
+void Server::setTakeoverFd(int control_fd) {
+    m_takeover_fd = control_fd;
+}
+
+void Server::requestHotUpgrade() {
+    m_upgrade_requested = true;
+}
+
 const Server::Stats& Server::getStats() const {
     return m_stats;
 }
 
 void Server::resetStats() {
     m_stats = Stats{};
-    m_stats.start_time = std::chrono::steady_clock::now();
+    m_stats.start_time = Clock::now();
     Logger::debug("Server statistics reset");
 }
 
@@ -233,6 +370,13 @@ bool Server::disconnectClient(uint32_t client_id, const std::string& reason) {
     return false;
 }
 
+bool Server::adoptClientSocket(int socket, const std::string& endpoint) {
+    if (m_network_manager) {
+        return m_network_manager->adoptClient(socket, endpoint);
+    }
+    return false;
+}
+
 void Server::clearLayer(uint8_t layer_id) {
     if (m_layer_manager) {
         m_layer_manager->clearLayer(layer_id);
@@ -298,20 +442,44 @@ bool Server::deleteTexture(uint32_t texture_id) {
 
 void Server::waitForNextFrame() {
     auto target_frame_time = getTargetFrameTime();
-    auto elapsed = std::chrono::steady_clock::now() - m_frame_start_time;
+    auto elapsed = Clock::now() - m_frame_start_time;
     
     if (elapsed < target_frame_time) {
-        std::this_thread::sleep_for(target_frame_time - elapsed);
+        // With the virtual clock this steps time instead of blocking
+        Clock::sleepFor(target_frame_time - elapsed);
     }
 }
 
+bool Server::stepFrames(uint32_t count) {
+    if (!Clock::isVirtual()) {
+        Logger::error("Frame stepping requires the virtual clock");
+        return false;
+    }
+    
+    if (m_state.load() != State::STOPPED || !m_renderer) {
+        Logger::error("Cannot step frames - server must be initialized and not running: {}", getStateString());
+        return false;
+    }
+    
+    // Without pacing nothing steps the clock, so step it here
+    bool pacing = m_config.performance().enable_frame_pacing;
+    for (uint32_t i = 0; i < count && !m_shutdown_requested; ++i) {
+        processFrame();
+        updateStatistics();
+        if (!pacing) {
+            Clock::advance(getTargetFrameTime());
+        }
+    }
+    
+    return true;
+}
+
 void Server::sendFrameCallbacks() {
     if (!m_network_manager) return;
     
     FrameCallback callback;
     callback.frame_number = static_cast<uint32_t>(m_stats.frames_rendered.load());
-    callback.frame_time = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    callback.frame_time = Clock::nowMicros();
     callback.frame_rate = m_stats.current_fps.load();
     callback.dropped_frames = static_cast<uint32_t>(m_stats.frames_dropped.load());
     
@@ -322,6 +490,16 @@ void Server::sendFrameCallbacks() {
     m_network_manager->broadcastMessage(header, &callback);
 }
 
+void Server::setFrameObserver(FrameObserver observer) {
+    if (m_state.load() == State::RUNNING) {
+        Logger::warning("Cannot change frame observer while server is running");
+        return;
+    }
+    
+    m_frame_observer = std::move(observer);
+    m_frame_command_latencies_us.reserve(m_config.performance().command_batch_size);
+}
+
 void Server::broadcastInputEvent(const InputEvent& event) {
     if (!m_network_manager) return;
     
@@ -335,7 +513,17 @@ void Server::broadcastInputEvent(const InputEvent& event) {
 void Server::sendInputEventToClient(uint32_t client_id, const InputEvent& event) {
     if (!m_network_manager) return;
     
-    m_network_manager->sendInputEvent(client_id, event);
+    if (!m_input_router || !m_input_batcher) {
+        m_network_manager->sendInputEvent(client_id, event);
+        return;
+    }
+    
+    // Goes out with the frame's other input, coalesced like polled events
+    InputRouter::Target target;
+    target.client_id = client_id;
+    if (m_input_router->selects(client_id, event.type, target.delivery_flags)) {
+        m_input_batcher->add(target, event);
+    }
 }
 
 void Server::enableDebugOverlay(bool enabled) {
@@ -401,10 +589,23 @@ void Server::handleSignal(int signal) {
         case SIGTERM: signal_name = "SIGTERM"; break;
 #ifndef _WIN32
         case SIGHUP: signal_name = "SIGHUP"; break;
+        case SIGUSR2: signal_name = "SIGUSR2"; break;
 #endif
     }
     
     Logger::info("Received signal {} ({})", signal, signal_name);
+    
+#ifndef _WIN32
+    if (signal == SIGHUP) {
+        requestConfigReload();
+        return;
+    }
+    if (signal == SIGUSR2) {
+        requestHotUpgrade();
+        return;
+    }
+#endif
+    
     requestShutdown("Signal received");
 }
 
@@ -413,6 +614,9 @@ void Server::handleSignal(int signal) {
 void Server::mainLoop() {
     Logger::info("Entering main server loop");
     
+    // This is the process's main thread, so it keeps its name (renaming it renames the process)
+    Platform::applyThreadPolicy("Render", makeThreadPolicy(m_config, "render"));
+    
     setupSignalHandlers();
     
     while (!m_shutdown_requested && m_state.load() == State::RUNNING) {
@@ -443,7 +647,17 @@ void Server::mainLoop() {
 }
 
 void Server::processFrame() {
-    m_frame_start_time = std::chrono::steady_clock::now();
+    m_frame_start_time = Clock::now();
+    
+    // Frame start is the main loop's safe point for configuration changes
+    if (m_reload_requested.exchange(false)) {
+        reloadConfig(m_config_file);
+    }
+    applyLiveConfig();
+    
+    if (m_upgrade_requested.exchange(false)) {
+        startHotUpgrade();
+    }
     
     // Begin rendering frame
     if (m_renderer) {
@@ -453,6 +667,10 @@ void Server::processFrame() {
     // Process incoming commands
     processCommands();
     
+    if (m_hot_upgrade && m_hot_upgrade->isReplacementReady()) {
+        completeHotUpgrade();
+    }
+    
     // Render frame
     renderFrame();
     
@@ -466,11 +684,20 @@ void Server::processFrame() {
         }
     }
     
+    // endFrame() polled the window system; route what it saw
+    dispatchInput();
+    
+    if (m_scene_snapshot && m_scene_snapshot->isDue()) {
+        writeSceneSnapshot(false);
+    }
+    
     // Send frame callbacks to clients
     if (m_config.features().enable_layers) {
         sendFrameCallbacks();
     }
     
+    auto work_end = Clock::now();
+    
     // Enforce frame rate
     if (m_config.performance().enable_frame_pacing) {
         enforceFrameRate();
@@ -479,7 +706,15 @@ void Server::processFrame() {
     // Measure frame time
     measureFrameTime();
     
-    m_stats.frames_rendered.fetch_add(1);
+    if (m_stats.frames_rendered.fetch_add(1) == 0 && m_stats.startup_first_frame_ms == 0) {
+        m_stats.startup_first_frame_ms = millisecondsSinceStartup();
+        Logger::info("First frame {} ms after startup (accepting clients after {} ms)",
+                     m_stats.startup_first_frame_ms.load(), m_stats.startup_accept_ms.load());
+    }
+    
+    if (m_frame_observer) {
+        notifyFrameObserver(work_end);
+    }
 }
 
 void Server::processCommands() {
@@ -489,11 +724,20 @@ void Server::processCommands() {
     handleHighPriorityCommands();
     
     // Process regular command queue
+    bool was_full = m_command_queue.full();
     auto commands = m_command_queue.dequeueBatch(m_config.performance().command_batch_size);
+    if (was_full && !commands.empty() && m_network_manager) {
+        // Network threads stop reading while the queue is full; let them resume
+        m_network_manager->wakeup();
+    }
     if (!commands.empty()) {
         optimizeCommandOrder(commands);
         m_command_processor->processCommandBatch(commands);
         m_stats.commands_processed.fetch_add(commands.size());
+        
+        if (m_frame_observer) {
+            recordCommandLatencies(commands);
+        }
     }
 }
 
@@ -508,9 +752,36 @@ void Server::renderFrame() {
     // Additional rendering logic would go here
 }
 
+void Server::dispatchInput() {
+    if (!m_renderer || !m_input_router || !m_input_batcher || !m_network_manager) return;
+    
+    m_input_events.clear();
+    m_renderer->pollInput(m_input_events);
+    
+    for (InputEvent& event : m_input_events) {
+        // Clients get canvas coordinates; outside every viewport only grabs see the event
+        std::bitset<256> visible_layers;
+        Point canvas_position;
+        if (m_renderer->windowToCanvas(event.position, canvas_position, visible_layers)) {
+            event.position = canvas_position;
+        }
+        
+        InputRouter::Target target;
+        if (m_input_router->route(event, visible_layers, target)) {
+            m_input_batcher->add(target, event);
+        }
+    }
+    
+    // One message per client that got input this frame
+    m_input_batcher->flush(static_cast<uint32_t>(m_stats.frames_rendered.load()),
+        [this](uint32_t client_id, const MessageHeader& header, const void* data) {
+            return m_network_manager->sendMessage(client_id, header, data);
+        });
+}
+
 void Server::updateStatistics() {
-    static auto last_update = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
+    static auto last_update = Clock::now();
+    auto now = Clock::now();
     
     if (now - last_update >= std::chrono::seconds(1)) {
         // Update uptime
@@ -551,81 +822,129 @@ void Server::updateStatistics() {
 bool Server::initializeSubsystems() {
     Logger::info("Initializing server subsystems...");
     
-    // Initialize renderer
-    Logger::info("Initializing renderer...");
-    RaylibRenderer::Config renderer_config;
-    renderer_config.window_width = m_config.renderer().window_width;
-    renderer_config.window_height = m_config.renderer().window_height;
-    renderer_config.target_fps = m_config.renderer().target_fps;
-    renderer_config.enable_vsync = m_config.renderer().enable_vsync;
-    renderer_config.enable_antialiasing = m_config.renderer().enable_antialiasing;
-    renderer_config.fullscreen = m_config.renderer().fullscreen;
-    renderer_config.hidden = m_config.renderer().hidden;
-    renderer_config.window_title = m_config.renderer().window_title;
-    renderer_config.layer_caching = m_config.renderer().layer_caching;
-    
-    m_renderer = std::make_unique<RaylibRenderer>(renderer_config);
-    if (!m_renderer->initialize()) {
-        Logger::error("Failed to initialize renderer");
-        return false;
+    // Independent work overlaps: sockets bind and start accepting (handshakes
+    // complete, commands queue) while the window and GL context come up on
+    // this thread, and system fonts are indexed in the background.
+    InitGraph graph;
+    
+    // A takeover restores the previous process's scene before adopting its
+    // clients, so it waits for the GL context and runs on this thread
+    const bool takeover = m_takeover_fd >= 0;
+    m_input_router = std::make_unique<InputRouter>();
+    m_input_batcher = std::make_unique<InputBatcher>();
+    
+    // Network threads tell the renderer about disconnects as soon as they
+    // start, so it exists (without its window yet) before any step runs
+    m_renderer = std::make_unique<RaylibRenderer>(makeRendererConfig(m_config));
+    std::vector<std::string> network_dependencies;
+    if (takeover) {
+        network_dependencies = {"commands"};
     }
     
-    // Initialize layer manager
-    Logger::info("Initializing layer manager...");
-    m_layer_manager = std::make_unique<LayerManager>(m_config.features().max_layers);
+    graph.addStep("network", network_dependencies,
+                  takeover ? InitGraph::Affinity::MainThread : InitGraph::Affinity::Background,
+                  [this, takeover]() {
+        m_network_manager = std::make_unique<NetworkManager>(makeNetworkConfig(m_config));
+        
+        // Callbacks go in before the listeners start so no early client is missed
+        m_network_manager->setClientConnectedCallback(
+            [this](uint32_t client_id, const std::string& client_info) {
+                onClientConnected(client_id, client_info);
+            });
+        
+        m_network_manager->setClientDisconnectedCallback(
+            [this](uint32_t client_id, const std::string& reason) {
+                onClientDisconnected(client_id, reason);
+            });
+        
+        m_network_manager->setCommandReceivedCallback(
+            [this](uint32_t client_id, RenderCommand&& command) {
+                onCommandReceived(client_id, std::move(command));
+            });
+        
+        m_network_manager->setErrorCallback(
+            [this](const std::string& error_message, uint32_t client_id) {
+                onNetworkError(error_message, client_id);
+            });
+        
+        m_network_manager->setInputRequestCallback(
+            [this](uint32_t client_id, const MessageHeader& header, const std::vector<uint8_t>& data) {
+                return m_input_router->handleRequest(client_id, header, data);
+            });
+        
+        if (m_config.performance().realtime_mode) {
+            // A full queue holds clients back instead of dropping their commands
+            m_network_manager->setBackpressureCallback([this]() {
+                return m_command_queue.full();
+            });
+        }
+        
+        if (takeover ? !takeOver() : !m_network_manager->initialize()) {
+            Logger::error("Failed to initialize network manager");
+            return false;
+        }
+        
+        m_stats.startup_accept_ms = millisecondsSinceStartup();
+        return true;
+    });
     
-    // Initialize font manager
-    Logger::info("Initializing font manager...");
-    m_font_manager = std::make_unique<FontManager>();
-    if (!m_font_manager->initialize()) {
-        Logger::error("Failed to initialize font manager");
-        return false;
-    }
+    // Window, layer render textures and the default font all need the GL
+    // context, which belongs to this thread
+    graph.addStep("renderer", {}, InitGraph::Affinity::MainThread, [this]() {
+        if (!m_renderer->initialize()) {
+            Logger::error("Failed to initialize renderer");
+            return false;
+        }
+        return true;
+    });
     
-    // Initialize command processor
-    Logger::info("Initializing command processor...");
-    m_command_processor = std::make_unique<CommandProcessor>(*m_renderer, *m_layer_manager, *m_font_manager);
-    if (!m_command_processor->initialize()) {
-        Logger::error("Failed to initialize command processor");
-        return false;
-    }
+    graph.addStep("layers", {"renderer"}, InitGraph::Affinity::MainThread, [this]() {
+        m_layer_manager = std::make_unique<LayerManager>(m_config.features().max_layers);
+        return true;
+    });
     
-    // Initialize network manager
-    Logger::info("Initializing network manager...");
-    NetworkManager::Config network_config;
-    network_config.tcp_bind_address = m_config.network().tcp_bind_address;
-    network_config.tcp_port = m_config.network().tcp_port;
-    network_config.enable_tcp = m_config.network().enable_tcp;
-    network_config.unix_socket_path = m_config.network().unix_socket_path;
-    network_config.enable_unix_socket = m_config.network().enable_unix_socket;
-    network_config.max_clients = m_config.network().max_clients;
-    
-    m_network_manager = std::make_unique<NetworkManager>(network_config);
-    if (!m_network_manager->initialize()) {
-        Logger::error("Failed to initialize network manager");
-        return false;
-    }
+    graph.addStep("fonts", {"renderer"}, InitGraph::Affinity::MainThread, [this]() {
+        m_font_manager = std::make_unique<FontManager>();
+        if (!m_font_manager->initialize()) {
+            Logger::error("Failed to initialize font manager");
+            return false;
+        }
+        return true;
+    });
     
-    // Set up network callbacks
-    m_network_manager->setClientConnectedCallback(
-        [this](uint32_t client_id, const std::string& client_info) {
-            onClientConnected(client_id, client_info);
-        });
+    graph.addStep("commands", {"renderer", "layers", "fonts"}, InitGraph::Affinity::MainThread, [this]() {
+        m_command_processor = std::make_unique<CommandProcessor>(*m_renderer, *m_layer_manager, *m_font_manager);
+        m_command_processor->setThreadPolicy(makeThreadPolicy(m_config, "commands"));
+        if (!m_command_processor->initialize()) {
+            Logger::error("Failed to initialize command processor");
+            return false;
+        }
+        return true;
+    });
     
-    m_network_manager->setClientDisconnectedCallback(
-        [this](uint32_t client_id, const std::string& reason) {
-            onClientDisconnected(client_id, reason);
+    // A handed-over scene is newer than any snapshot, so only a cold start restores one
+    if (!m_config.features().snapshot_file.empty()) {
+        graph.addStep("snapshot", {"commands"}, InitGraph::Affinity::MainThread, [this, takeover]() {
+            SceneSnapshot::Config snapshot_config;
+            snapshot_config.path = m_config.features().snapshot_file;
+            snapshot_config.interval_ms = m_config.features().snapshot_interval_ms;
+            m_scene_snapshot = std::make_unique<SceneSnapshot>(snapshot_config);
+            
+            SceneState scene;
+            if (!takeover && m_scene_snapshot->load(scene)) {
+                importScene(scene);
+            }
+            return true;    // Starting with an empty scene is not an error
         });
+    }
     
-    m_network_manager->setCommandReceivedCallback(
-        [this](uint32_t client_id, RenderCommand&& command) {
-            onCommandReceived(client_id, std::move(command));
-        });
+    bool ok = graph.run();
+    Logger::info("Subsystem startup timeline:\n{}", graph.getTimingReport());
     
-    m_network_manager->setErrorCallback(
-        [this](const std::string& error_message, uint32_t client_id) {
-            onNetworkError(error_message, client_id);
-        });
+    if (!ok) {
+        Logger::error("Server subsystem initialization failed");
+        return false;
+    }
     
     Logger::info("All subsystems initialized successfully");
     return true;
@@ -638,12 +957,20 @@ void Server::shutdownSubsystems() {
         m_network_manager->shutdown();
         m_network_manager.reset();
     }
+    m_input_router.reset();
+    m_input_batcher.reset();
     
     if (m_command_processor) {
         m_command_processor->shutdown();
         m_command_processor.reset();
     }
     
+    // Last snapshot while the GL context can still read textures back
+    if (m_scene_snapshot) {
+        writeSceneSnapshot(true);
+        m_scene_snapshot.reset();
+    }
+    
     if (m_font_manager) {
         m_font_manager.reset();
     }
@@ -660,6 +987,263 @@ void Server::shutdownSubsystems() {
     Logger::info("All subsystems shut down");
 }
 
+void Server::applyLiveConfig() {
+    auto config = m_live_config.read();
+    if (config.version() == m_applied_config_version) {
+        return;
+    }
+    
+    m_config = *config;
+    m_applied_config_version = config.version();
+    
+    Logger::setLevel(parseLogLevel(m_config.logging().log_level));
+    
+    if (m_renderer) {
+        // Start from the renderer's own config so runtime state (e.g. resized window) is kept
+        RaylibRenderer::Config renderer_config = m_renderer->getConfig();
+        renderer_config.target_fps = m_config.renderer().target_fps;
+        renderer_config.layer_caching = m_config.renderer().layer_caching;
+        renderer_config.viewports = makeViewports(m_config);
+        m_renderer->setConfig(renderer_config);
+    }
+    
+    if (m_scene_snapshot) {
+        m_scene_snapshot->setInterval(m_config.features().snapshot_interval_ms);
+    }
+    
+    if (m_network_manager) {
+        m_network_manager->setConfig(makeNetworkConfig(m_config));
+    }
+    
+    Logger::info("Applied configuration version {}", m_applied_config_version);
+}
+
+void Server::startHotUpgrade() {
+    if (m_hot_upgrade) {
+        Logger::warning("Hot upgrade already in progress");
+        return;
+    }
+    if (!HotUpgrade::isSupported() || m_upgrade_command.empty()) {
+        Logger::error("Hot upgrade is not available (no upgrade command or unsupported platform)");
+        return;
+    }
+    if (m_renderer && m_renderer->getStats().pixmaps > 0) {
+        Logger::error("Hot upgrade refused: {} pixmaps would be lost", m_renderer->getStats().pixmaps);
+        return;
+    }
+    
+    m_hot_upgrade = std::make_unique<HotUpgrade>();
+    if (!m_hot_upgrade->spawnReplacement(m_upgrade_command)) {
+        m_hot_upgrade.reset();
+        return;
+    }
+    
+    // Keep serving until the replacement has its window up and reports ready
+    Logger::info("Hot upgrade started, waiting for the replacement to initialize");
+}
+
+void Server::completeHotUpgrade() {
+    if (!m_network_manager || !m_network_manager->suspend()) {
+        m_hot_upgrade.reset();
+        return;
+    }
+    
+    // Commands already received are drawn into the scene being handed over
+    while (!m_command_queue.empty()) {
+        processCommands();
+    }
+    
+    // Pixmaps created while the replacement was starting up
+    if (m_renderer && m_renderer->getStats().pixmaps > 0) {
+        Logger::error("Hot upgrade refused: {} pixmaps would be lost", m_renderer->getStats().pixmaps);
+        m_hot_upgrade.reset();
+        m_network_manager->resume();
+        return;
+    }
+    
+    HotUpgrade::State state;
+    state.network = m_network_manager->exportHandover();
+    if (m_input_router) {
+        m_input_router->exportState(state.input);
+    }
+    exportScene(state.scene);
+    
+    if (!m_hot_upgrade->sendState(state)) {
+        Logger::error("Hot upgrade failed, this process keeps serving");
+        m_hot_upgrade.reset();
+        m_network_manager->resume();
+        return;
+    }
+    
+    m_network_manager->releaseHandedOver();
+    m_hot_upgrade.reset();
+    Logger::info("Handed {} clients over to the new process", state.network.clients.size());
+    requestShutdown("Handed over to new process");
+}
+
+bool Server::takeOver() {
+    HotUpgrade upgrade;
+    if (!upgrade.attach(m_takeover_fd)) {
+        return false;
+    }
+    
+    HotUpgrade::State state;
+    if (!upgrade.receiveState(state)) {
+        return false;
+    }
+    
+    importScene(state.scene);
+    if (m_input_router) {
+        m_input_router->importState(state.input);
+    }
+    
+    if (!m_network_manager->initializeFromHandover(state.network)) {
+        return false;
+    }
+    
+    m_takeover_fd = -1;
+    return upgrade.acknowledge();
+}
+
+void Server::exportScene(SceneState& scene, const RaylibRenderer::TextureFilter& wants_pixels) const {
+    if (m_renderer) {
+        m_renderer->exportScene(scene, wants_pixels);
+    }
+    
+    if (m_font_manager) {
+        // Memory fonts have no file to reload from; clients re-send those
+        for (const auto& info : m_font_manager->getLoadedFonts()) {
+            const auto* font = m_font_manager->getFont(info.id);
+            if (info.is_default || !font || font->loaded_from_memory) {
+                continue;
+            }
+            scene.fonts.push_back(SceneState::FontRef{info.id, info.file_path, info.font_size});
+        }
+    }
+}
+
+void Server::importScene(const SceneState& scene) {
+    if (m_renderer) {
+        m_renderer->importScene(scene);
+    }
+    
+    if (m_layer_manager) {
+        for (const auto& layer : scene.layers) {
+            m_layer_manager->setLayerVisibility(layer.id, layer.visible);
+        }
+    }
+    
+    if (m_font_manager) {
+        for (const auto& font : scene.fonts) {
+            if (!m_font_manager->restoreFont(font.id, font.file_path, font.font_size)) {
+                Logger::warning("Could not restore font {} from {}", font.id, font.file_path);
+            }
+        }
+    }
+}
+
+void Server::writeSceneSnapshot(bool blocking) {
+    // Only textures the snapshot has never stored are read back from the GPU
+    SceneState scene;
+    exportScene(scene, [this](const SceneState::Texture& texture) {
+        return texture.content_hash == 0 || !m_scene_snapshot->hasTexture(texture.content_hash);
+    });
+    scene.objects.clear();      // Their clients do not outlive this process
+    
+    if (blocking) {
+        m_scene_snapshot->writeNow(std::move(scene));
+    } else {
+        m_scene_snapshot->write(std::move(scene));
+    }
+}
+
+RaylibRenderer::Config Server::makeRendererConfig(const Config& config) const {
+    RaylibRenderer::Config renderer_config;
+    renderer_config.window_width = config.renderer().window_width;
+    renderer_config.window_height = config.renderer().window_height;
+    renderer_config.target_fps = config.renderer().target_fps;
+    renderer_config.enable_vsync = config.renderer().enable_vsync;
+    renderer_config.enable_antialiasing = config.renderer().enable_antialiasing;
+    renderer_config.fullscreen = config.renderer().fullscreen;
+    renderer_config.hidden = config.renderer().hidden;
+    renderer_config.window_title = config.renderer().window_title;
+    renderer_config.layer_caching = config.renderer().layer_caching;
+    renderer_config.null_backend = config.renderer().null_backend;
+    renderer_config.canvas_width = config.renderer().canvas_width;
+    renderer_config.canvas_height = config.renderer().canvas_height;
+    renderer_config.viewports = makeViewports(config);
+    renderer_config.retain_scene = !config.features().snapshot_file.empty();
+    if (config.performance().realtime_mode) {
+        renderer_config.fixed_pools = true;
+        renderer_config.max_textures = config.performance().max_textures;
+    }
+    return renderer_config;
+}
+
+NetworkManager::Config Server::makeNetworkConfig(const Config& config) const {
+    NetworkManager::Config network_config;
+    network_config.tcp_bind_address = config.network().tcp_bind_address;
+    network_config.tcp_port = config.network().tcp_port;
+    network_config.enable_tcp = config.network().enable_tcp;
+    network_config.unix_socket_path = config.network().unix_socket_path;
+    network_config.enable_unix_socket = config.network().enable_unix_socket;
+    network_config.max_clients = config.network().max_clients;
+    network_config.client_timeout_seconds = config.network().client_timeout_seconds;
+    network_config.handshake_timeout_seconds = config.network().handshake_timeout_seconds;
+    network_config.enable_rate_limiting = config.network().enable_rate_limiting;
+    network_config.max_commands_per_second = config.network().max_commands_per_second;
+    network_config.network_thread_count = config.performance().network_thread_count;
+    network_config.accept_thread_policy = makeThreadPolicy(config, "accept");
+    network_config.network_thread_policy = makeThreadPolicy(config, "network");
+    network_config.receive_buffer_size = config.network().receive_buffer_size;
+    network_config.send_buffer_size = config.network().send_buffer_size;
+    network_config.fixed_buffers = config.performance().realtime_mode;
+    if (network_config.fixed_buffers) {
+        // A fixed receive buffer never grows, so it holds the largest
+        // message the protocol allows (a big texture upload) from the start
+        network_config.receive_buffer_size = std::max<size_t>(network_config.receive_buffer_size,
+                                                              sizeof(MessageHeader) + Limits::MAX_MESSAGE_SIZE);
+    }
+    return network_config;
+}
+
+std::vector<OutputViewport> Server::makeViewports(const Config& config) const {
+    std::vector<OutputViewport> viewports;
+    for (const auto& spec : config.renderer().viewports) {
+        OutputViewport viewport;
+        std::string error;
+        if (!parseOutputViewport(spec, viewport, error)) {
+            Logger::error("Ignoring viewport: {}", error);
+            continue;
+        }
+        viewports.push_back(viewport);
+    }
+    return viewports;
+}
+
+Platform::ThreadPolicy Server::makeThreadPolicy(const Config& config, const std::string& role) const {
+    Platform::ThreadPolicy policy;
+    auto it = config.performance().thread_policies.find(role);
+    if (it != config.performance().thread_policies.end()) {
+        std::string error;
+        if (!Platform::parseThreadPolicy(it->second, policy, error)) {
+            Logger::error("Ignoring thread policy for {}: {}", role, error);
+            policy = Platform::ThreadPolicy{};
+        }
+    }
+    
+    if (config.performance().realtime_mode) {
+        policy.stack_prefault_bytes = REALTIME_STACK_PREFAULT_BYTES;
+    }
+    return policy;
+}
+
+uint32_t Server::millisecondsSinceStartup() const {
+    // Real time on purpose: startup latency is what restarting clients see
+    auto elapsed = std::chrono::steady_clock::now() - m_startup_time;
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
 std::chrono::microseconds Server::getTargetFrameTime() const {
     return std::chrono::microseconds(1000000 / m_config.renderer().target_fps);
 }
@@ -669,7 +1253,7 @@ void Server::enforceFrameRate() {
 }
 
 void Server::measureFrameTime() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     auto frame_time = std::chrono::duration_cast<std::chrono::microseconds>(now - m_frame_start_time);
     
     // Update frame time history
@@ -682,7 +1266,9 @@ void Server::measureFrameTime() {
     if (m_frame_times.size() >= 2) {
         auto time_span = now - m_frame_times.front();
         double seconds = std::chrono::duration<double>(time_span).count();
-        m_stats.current_fps.store(static_cast<float>((m_frame_times.size() - 1) / seconds));
+        if (seconds > 0.0) {
+            m_stats.current_fps.store(static_cast<float>((m_frame_times.size() - 1) / seconds));
+        }
     }
     
     m_stats.avg_frame_time_ms.store(frame_time.count() / 1000.0f);
@@ -696,17 +1282,49 @@ void Server::handleHighPriorityCommands() {
                 m_command_processor->processCommand(command);
             }
         }
+        
+        if (m_frame_observer) {
+            recordCommandLatencies(m_high_priority_commands);
+        }
         m_high_priority_commands.clear();
     }
 }
 
+void Server::recordCommandLatencies(const std::vector<RenderCommand>& commands) {
+    // created_time is stamped when the network thread converts the message
+    auto now = Clock::now();
+    for (const auto& command : commands) {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - command.created_time);
+        m_frame_command_latencies_us.push_back(static_cast<uint32_t>(latency.count()));
+    }
+}
+
+void Server::notifyFrameObserver(std::chrono::steady_clock::time_point work_end) {
+    auto now = Clock::now();
+    
+    FrameSample sample;
+    sample.frame_number = m_stats.frames_rendered.load();
+    sample.frame_time = std::chrono::duration_cast<std::chrono::microseconds>(now - m_frame_start_time);
+    sample.work_time = std::chrono::duration_cast<std::chrono::microseconds>(work_end - m_frame_start_time);
+    sample.command_latencies_us = &m_frame_command_latencies_us;
+    
+    m_frame_observer(sample);
+    m_frame_command_latencies_us.clear();
+}
+
 void Server::optimizeCommandOrder(std::vector<RenderCommand>& commands) {
-    // Sort commands by layer first, then by type for optimal rendering
-    std::sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
-        if (a.layer_id != b.layer_id) {
-            return a.layer_id < b.layer_id;
-        }
-        return static_cast<int>(a.type) < static_cast<int>(b.type);
+    // Pixmaps and targets span the client's layers, so batches using them
+    // keep their order
+    if (std::any_of(commands.begin(), commands.end(), [](const RenderCommand& command) {
+            return isClientWide(command.type);
+        })) {
+        return;
+    }
+    
+    // Grouped by layer; within a layer later draws cover earlier ones, so
+    // the order they were sent in is kept
+    std::stable_sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.layer_id < b.layer_id;
     });
 }
 
@@ -747,13 +1365,21 @@ void Server::onClientConnected(uint32_t client_id, const std::string& client_inf
 
 void Server::onClientDisconnected(uint32_t client_id, const std::string& reason) {
     Logger::info("Client {} disconnected: {}", client_id, reason);
+    if (m_input_router) {
+        m_input_router->removeClient(client_id);
+    }
+    if (m_input_batcher) {
+        m_input_batcher->removeClient(client_id);
+    }
+    if (m_renderer) {
+        m_renderer->removeClient(client_id);    // Clips it left pushed, pixmaps and objects it created
+    }
 }
 
 void Server::onCommandReceived(uint32_t client_id, RenderCommand&& command) {
     // Set command metadata
     command.client_id = client_id;
-    command.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    command.timestamp = Clock::nowMicros();
     
     // Queue command for processing
     if (command.priority >= RenderCommand::Priority::HIGH) {
@@ -791,8 +1417,8 @@ void Server::logPerformanceMetrics() {
 void Server::detectPerformanceIssues() {
     // Check for low FPS
     if (m_stats.current_fps.load() < m_config.renderer().target_fps * 0.8f) {
-        static auto last_warning = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
+        static auto last_warning = Clock::now();
+        auto now = Clock::now();
         
         if (now - last_warning > std::chrono::seconds(10)) {
             Logger::warning("Low FPS detected: {:.1f} (target: {})", 
@@ -803,8 +1429,8 @@ void Server::detectPerformanceIssues() {
     
     // Check for high frame time
     if (m_stats.avg_frame_time_ms.load() > m_config.performance().max_frame_time_ms) {
-        static auto last_warning = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
+        static auto last_warning = Clock::now();
+        auto now = Clock::now();
         
         if (now - last_warning > std::chrono::seconds(10)) {
             Logger::warning("High frame time detected: {:.2f}ms (limit: {}ms)", 
@@ -820,6 +1446,7 @@ void Server::setupSignalHandlers() {
     std::signal(SIGTERM, signalHandler);
 #ifndef _WIN32
     std::signal(SIGHUP, signalHandler);
+    std::signal(SIGUSR2, signalHandler);
     std::signal(SIGPIPE, SIG_IGN);  // Ignore broken pipe
 #endif
 }
@@ -0,0 +1,178 @@
+// KairosServer/src/Graphics/LayerIndex.cpp
+#include "Graphics/LayerIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Kairos {
+
+namespace {
+
+constexpr SpatialBounds EMPTY_BOUNDS{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                                     std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+void extend(SpatialBounds& bounds, float x, float y) {
+    bounds.min_x = std::min(bounds.min_x, x);
+    bounds.min_y = std::min(bounds.min_y, y);
+    bounds.max_x = std::max(bounds.max_x, x);
+    bounds.max_y = std::max(bounds.max_y, y);
+}
+
+SpatialBounds expanded(const SpatialBounds& bounds, float margin) {
+    return {bounds.min_x - margin, bounds.min_y - margin, bounds.max_x + margin, bounds.max_y + margin};
+}
+
+} // anonymous namespace
+
+LayerIndex::LayerIndex(float cell_size)
+    : m_grid(cell_size) {
+}
+
+void LayerIndex::add(uint32_t index, const RenderCommand& command) {
+    SpatialBounds bounds;
+    if (commandBounds(command, bounds)) {
+        m_grid.insert(index, bounds);
+    } else {
+        m_unbounded.push_back(index);
+    }
+}
+
+void LayerIndex::clear() {
+    m_grid.clear();
+    m_unbounded.clear();
+}
+
+void LayerIndex::rebuild(const std::vector<RenderCommand>& commands) {
+    clear();
+    for (size_t i = 0; i < commands.size(); ++i) {
+        add(static_cast<uint32_t>(i), commands[i]);
+    }
+}
+
+void LayerIndex::query(const SpatialBounds& rect, std::vector<uint32_t>& indices) const {
+    indices.clear();
+    m_grid.queryRect(rect, [&](uint32_t index, const SpatialBounds&) { indices.push_back(index); });
+    indices.insert(indices.end(), m_unbounded.begin(), m_unbounded.end());
+    std::sort(indices.begin(), indices.end());
+}
+
+void LayerIndex::pick(float x, float y, std::vector<uint32_t>& indices) const {
+    indices.clear();
+    m_grid.queryPoint(x, y, [&](uint32_t index, const SpatialBounds&) { indices.push_back(index); });
+    indices.insert(indices.end(), m_unbounded.begin(), m_unbounded.end());
+    std::sort(indices.begin(), indices.end());
+}
+
+bool LayerIndex::commandBounds(const RenderCommand& command, SpatialBounds& bounds) {
+    switch (command.type) {
+        case RenderCommand::Type::DRAW_POINT: {
+            const Point& p = command.point.position;
+            bounds = {p.x, p.y, p.x + 1.0f, p.y + 1.0f};
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_LINE: {
+            SpatialBounds line = EMPTY_BOUNDS;
+            extend(line, command.line.start.x, command.line.start.y);
+            extend(line, command.line.end.x, command.line.end.y);
+            bounds = expanded(line, std::max(1.0f, command.line.thickness * 0.5f));
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_RECTANGLE: {
+            const auto& rect = command.rectangle;
+            // Outlines are drawn 1px wide on the edge
+            bounds = expanded(SpatialBounds::fromRect(rect.position.x, rect.position.y, rect.width, rect.height), 1.0f);
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_CIRCLE: {
+            const auto& circle = command.circle;
+            const float r = std::fabs(circle.radius) + 1.0f;
+            bounds = {circle.center.x - r, circle.center.y - r, circle.center.x + r, circle.center.y + r};
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_ARC: {
+            // The whole ellipse: cheaper than bounding the swept angles, and still conservative
+            const auto& arc = command.arc;
+            const float rx = std::fabs(arc.radius_x) + 1.0f;
+            const float ry = std::fabs(arc.radius_y) + 1.0f;
+            bounds = {arc.center.x - rx, arc.center.y - ry, arc.center.x + rx, arc.center.y + ry};
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE: {
+            const auto& rect = command.rounded_rectangle;
+            bounds = expanded(SpatialBounds::fromRect(rect.position.x, rect.position.y, rect.width, rect.height), 1.0f);
+            return true;
+        }
+
+        case RenderCommand::Type::FILL_GRADIENT: {
+            const auto& fill = command.gradient;
+            if (fill.shape == Constants::GRADIENT_SHAPE_ELLIPSE) {
+                const float rx = std::fabs(fill.width) * 0.5f;
+                const float ry = std::fabs(fill.height) * 0.5f;
+                bounds = {fill.position.x - rx, fill.position.y - ry, fill.position.x + rx, fill.position.y + ry};
+            } else {
+                bounds = SpatialBounds::fromRect(fill.position.x, fill.position.y, fill.width, fill.height);
+            }
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_TEXT: {
+            // No font metrics here: allow a full em per glyph, one line per newline
+            const auto& text = command.text;
+            const size_t glyphs = std::max<size_t>(command.text_string.size(), 1);
+            const size_t lines = 1 + std::count(command.text_string.begin(), command.text_string.end(), '\n');
+            bounds = SpatialBounds::fromRect(text.position.x, text.position.y,
+                                             text.font_size * static_cast<float>(glyphs),
+                                             text.font_size * 1.5f * static_cast<float>(lines));
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS: {
+            if (command.vertices.empty()) {
+                return false;
+            }
+            bounds = EMPTY_BOUNDS;
+            for (const auto& vertex : command.vertices) {
+                extend(bounds, vertex.x, vertex.y);
+            }
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_SPRITES: {
+            if (command.sprite_instances.empty()) {
+                return false;
+            }
+            // Any rotation stays within the circle through the sprite's corners
+            bounds = EMPTY_BOUNDS;
+            for (const auto& sprite : command.sprite_instances) {
+                const float half_width = std::fabs(sprite.atlas_width * sprite.scale_x) * 0.5f;
+                const float half_height = std::fabs(sprite.atlas_height * sprite.scale_y) * 0.5f;
+                const float reach = std::sqrt(half_width * half_width + half_height * half_height);
+                extend(bounds, sprite.position.x - reach, sprite.position.y - reach);
+                extend(bounds, sprite.position.x + reach, sprite.position.y + reach);
+            }
+            return true;
+        }
+
+        case RenderCommand::Type::DRAW_POLYGON: {
+            if (command.polygon_points.empty()) {
+                return false;
+            }
+            SpatialBounds polygon = EMPTY_BOUNDS;
+            for (const auto& point : command.polygon_points) {
+                extend(polygon, point.x, point.y);
+            }
+            bounds = expanded(polygon, 1.0f);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+} // namespace Kairos
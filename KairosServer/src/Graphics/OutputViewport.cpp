@@ -0,0 +1,130 @@
+// KairosServer/src/Graphics/OutputViewport.cpp
+#include <Graphics/OutputViewport.hpp>
+
+#include <sstream>
+#include <vector>
+
+namespace Kairos {
+
+namespace {
+
+bool parseNumber(const std::string& text, int32_t& value) {
+    if (text.empty()) {
+        return false;
+    }
+    try {
+        size_t used = 0;
+        long parsed = std::stol(text, &used);
+        if (used != text.size() || parsed < INT32_MIN || parsed > INT32_MAX) {
+            return false;
+        }
+        value = static_cast<int32_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// "x,y,w,h" with a positive size
+bool parseRect(const std::string& text, int32_t& x, int32_t& y, int32_t& width, int32_t& height) {
+    std::vector<int32_t> values;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        int32_t value = 0;
+        if (!parseNumber(item, value)) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    if (values.size() != 4 || values[2] <= 0 || values[3] <= 0) {
+        return false;
+    }
+    x = values[0];
+    y = values[1];
+    width = values[2];
+    height = values[3];
+    return true;
+}
+
+} // anonymous namespace
+
+bool OutputViewport::windowToCanvas(float window_x, float window_y, float& canvas_x, float& canvas_y) const {
+    if (window_x < dest_x || window_y < dest_y ||
+        window_x >= dest_x + dest_width || window_y >= dest_y + dest_height) {
+        return false;
+    }
+    canvas_x = source_x + (window_x - dest_x) / scaleX();
+    canvas_y = source_y + (window_y - dest_y) / scaleY();
+    return true;
+}
+
+bool parseOutputViewport(const std::string& spec, OutputViewport& viewport, std::string& error) {
+    viewport = OutputViewport{};
+    
+    size_t at = spec.find('@');
+    if (at == std::string::npos) {
+        error = "expected <canvas x,y,w,h>@<window x,y,w,h>, got '" + spec + "'";
+        return false;
+    }
+    size_t colon = spec.find(':', at);
+    std::string source = spec.substr(0, at);
+    std::string dest = spec.substr(at + 1, colon == std::string::npos ? std::string::npos : colon - at - 1);
+    
+    if (!parseRect(source, viewport.source_x, viewport.source_y, viewport.source_width, viewport.source_height)) {
+        error = "invalid canvas rectangle '" + source + "'";
+        return false;
+    }
+    if (!parseRect(dest, viewport.dest_x, viewport.dest_y, viewport.dest_width, viewport.dest_height)) {
+        error = "invalid window rectangle '" + dest + "'";
+        return false;
+    }
+    
+    if (colon == std::string::npos) {
+        viewport.layers.set();
+        return true;
+    }
+    
+    std::string option = spec.substr(colon + 1);
+    if (option.rfind("layers=", 0) != 0) {
+        error = "unknown viewport option '" + option + "'";
+        return false;
+    }
+    
+    std::stringstream list(option.substr(7));
+    std::string range;
+    while (std::getline(list, range, ',')) {
+        size_t dash = range.find('-');
+        int32_t first = 0;
+        int32_t last = 0;
+        if (!parseNumber(range.substr(0, dash), first) ||
+            !parseNumber(dash == std::string::npos ? range : range.substr(dash + 1), last) ||
+            first < 0 || last < first || last > 255) {
+            error = "invalid layer range '" + range + "'";
+            return false;
+        }
+        for (int32_t layer = first; layer <= last; ++layer) {
+            viewport.layers.set(static_cast<size_t>(layer));
+        }
+    }
+    
+    if (viewport.layers.none()) {
+        error = "viewport shows no layers";
+        return false;
+    }
+    return true;
+}
+
+std::string formatOutputViewport(const OutputViewport& viewport) {
+    std::stringstream ss;
+    ss << "canvas " << viewport.source_x << "," << viewport.source_y << " "
+       << viewport.source_width << "x" << viewport.source_height
+       << " -> window " << viewport.dest_x << "," << viewport.dest_y << " "
+       << viewport.dest_width << "x" << viewport.dest_height;
+    if (!viewport.layers.all()) {
+        ss << ", " << viewport.layers.count() << " layers";
+    }
+    return ss.str();
+}
+
+} // namespace Kairos
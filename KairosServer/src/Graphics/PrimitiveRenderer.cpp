@@ -167,43 +167,31 @@ void PrimitiveRenderer::drawRectangleGradient(const Rectangle& rect, const Color
 }
 
 void PrimitiveRenderer::drawRectangleRounded(const Rectangle& rect, float radius, const Color& color, bool filled) {
-    // Simplified rounded rectangle - use arcs at corners
-    radius = std::min(radius, std::min(rect.width, rect.height) * 0.5f);
-    
+    const float radii[4] = {radius, radius, radius, radius};
+    drawRectangleRounded(rect, radii, color, filled);
+}
+
+void PrimitiveRenderer::drawRectangleRounded(const Rectangle& rect, const float radii[4], const Color& color,
+                                             bool filled) {
+    // One outline for both, so a translucent fill never overlaps itself
+    std::vector<Point> outline = roundedRectangleOutline(rect, radii);
     if (filled) {
-        // Central rectangle
-        Rectangle center_rect = {rect.x + radius, rect.y, rect.width - 2 * radius, rect.height};
-        drawRectangle(center_rect, color, true);
-        
-        // Left and right rectangles
-        Rectangle left_rect = {rect.x, rect.y + radius, radius, rect.height - 2 * radius};
-        Rectangle right_rect = {rect.x + rect.width - radius, rect.y + radius, radius, rect.height - 2 * radius};
-        drawRectangle(left_rect, color, true);
-        drawRectangle(right_rect, color, true);
-        
-        // Corner arcs
-        drawArc({rect.x + radius, rect.y + radius}, radius, 180, 270, color, true);
-        drawArc({rect.x + rect.width - radius, rect.y + radius}, radius, 270, 360, color, true);
-        drawArc({rect.x + rect.width - radius, rect.y + rect.height - radius}, radius, 0, 90, color, true);
-        drawArc({rect.x + radius, rect.y + rect.height - radius}, radius, 90, 180, color, true);
+        drawPolygon(outline, color, true, true);
     } else {
-        // Draw outline with rounded corners
-        // Top and bottom lines
-        drawLine({rect.x + radius, rect.y}, {rect.x + rect.width - radius, rect.y}, color);
-        drawLine({rect.x + radius, rect.y + rect.height}, {rect.x + rect.width - radius, rect.y + rect.height}, color);
-        
-        // Left and right lines
-        drawLine({rect.x, rect.y + radius}, {rect.x, rect.y + rect.height - radius}, color);
-        drawLine({rect.x + rect.width, rect.y + radius}, {rect.x + rect.width, rect.y + rect.height - radius}, color);
-        
-        // Corner arcs
-        drawArc({rect.x + radius, rect.y + radius}, radius, 180, 270, color, false);
-        drawArc({rect.x + rect.width - radius, rect.y + radius}, radius, 270, 360, color, false);
-        drawArc({rect.x + rect.width - radius, rect.y + rect.height - radius}, radius, 0, 90, color, false);
-        drawArc({rect.x + radius, rect.y + rect.height - radius}, radius, 90, 180, color, false);
+        drawLineLoop(outline, color, 1.0f);
     }
 }
 
+void PrimitiveRenderer::fillRectangleGradient(const Rectangle& rect, const Gradient& gradient) {
+    std::vector<Point> outline = {
+        {rect.x, rect.y},
+        {rect.x + rect.width, rect.y},
+        {rect.x + rect.width, rect.y + rect.height},
+        {rect.x, rect.y + rect.height}
+    };
+    fillConvexGradient(outline, gradient);
+}
+
 void PrimitiveRenderer::drawCircle(const Point& center, float radius, const Color& color, bool filled) {
     std::vector<TriangleVertex> vertices;
     generateCircleVertices(center, radius, color, filled, 32, vertices);
@@ -295,8 +283,35 @@ void PrimitiveRenderer::drawEllipse(const Point& center, float radius_x, float r
     addToBatch(filled ? PrimitiveBatch::TRIANGLES : PrimitiveBatch::LINES, vertices, indices, m_current_layer);
 }
 
+void PrimitiveRenderer::fillEllipseGradient(const Point& center, float radius_x, float radius_y,
+                                            const Gradient& gradient) {
+    radius_x = std::fabs(radius_x);
+    radius_y = std::fabs(radius_y);
+    if (radius_x <= 0.0f || radius_y <= 0.0f) {
+        return;
+    }
+    
+    const int segments = arcSegments(std::max(radius_x, radius_y), 2.0f * M_PI);
+    std::vector<Point> outline;
+    outline.reserve(segments);
+    for (int i = 0; i < segments; ++i) {
+        float angle = (2.0f * M_PI * i) / segments;
+        outline.push_back({center.x + radius_x * std::cos(angle), center.y + radius_y * std::sin(angle)});
+    }
+    fillConvexGradient(outline, gradient);
+}
+
 void PrimitiveRenderer::drawArc(const Point& center, float radius, float start_angle, float end_angle, 
                                const Color& color, bool filled) {
+    drawArc(center, radius, radius, start_angle, end_angle, color, filled);
+}
+
+void PrimitiveRenderer::drawArc(const Point& center, float radius_x, float radius_y, float start_angle,
+                               float end_angle, const Color& color, bool filled) {
+    if (radius_x <= 0.0f && radius_y <= 0.0f) {
+        return;
+    }
+    
     std::vector<TriangleVertex> vertices;
     
     // Convert angles to radians
@@ -309,8 +324,9 @@ void PrimitiveRenderer::drawArc(const Point& center, float radius, float start_a
     }
     
     float angle_range = end_rad - start_rad;
-    int segments = std::max(4, static_cast<int>(angle_range * 16.0f / (2.0f * M_PI)));
+    int segments = arcSegments(std::max(radius_x, radius_y), angle_range);
     
+    vertices.reserve(segments + 2);
     if (filled) {
         // Center vertex for filled arc
         vertices.push_back({center, color});
@@ -320,8 +336,8 @@ void PrimitiveRenderer::drawArc(const Point& center, float radius, float start_a
     for (int i = 0; i <= segments; ++i) {
         float angle = start_rad + (angle_range * i) / segments;
         Point pos = {
-            center.x + radius * std::cos(angle),
-            center.y + radius * std::sin(angle)
+            center.x + radius_x * std::cos(angle),
+            center.y + radius_y * std::sin(angle)
         };
         vertices.push_back({pos, color});
     }
@@ -350,7 +366,8 @@ void PrimitiveRenderer::drawTriangle(const Point& p1, const Point& p2, const Poi
     drawPolygon(points, color, filled);
 }
 
-void PrimitiveRenderer::drawPolygon(const std::vector<Point>& points, const Color& color, bool filled) {
+void PrimitiveRenderer::drawPolygon(const std::vector<Point>& points, const Color& color, bool filled,
+                                    bool known_convex) {
     if (points.size() < 3) {
         return;
     }
@@ -361,7 +378,7 @@ void PrimitiveRenderer::drawPolygon(const std::vector<Point>& points, const Colo
     std::vector<uint16_t> indices;
     if (filled) {
         // Triangulate the polygon
-        indices = triangulatePolygon(points);
+        indices = triangulatePolygon(points, known_convex);
     } else {
         // Line loop around perimeter
         indices.reserve(points.size() * 2);
@@ -402,6 +419,124 @@ void PrimitiveRenderer::drawPolygonGradient(const std::vector<Point>& points, co
     addToBatch(filled ? PrimitiveBatch::TRIANGLES : PrimitiveBatch::LINES, vertices, indices, m_current_layer);
 }
 
+Color PrimitiveRenderer::Gradient::colorAt(const Point& position) const {
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float px = position.x - from.x;
+    const float py = position.y - from.y;
+    
+    // A zero-length gradient is to_color everywhere
+    float t = 1.0f;
+    if (radial) {
+        const float radius = std::sqrt(dx * dx + dy * dy);
+        if (radius > 0.0f) {
+            t = std::sqrt(px * px + py * py) / radius;
+        }
+    } else {
+        const float length_sq = dx * dx + dy * dy;
+        if (length_sq > 0.0f) {
+            t = (px * dx + py * dy) / length_sq;
+        }
+    }
+    t = std::clamp(t, 0.0f, 1.0f);
+    
+    auto mix = [t](uint8_t a, uint8_t b) {
+        return static_cast<uint8_t>(std::lround(a + (static_cast<int>(b) - a) * t));
+    };
+    return Color(mix(from_color.r, to_color.r), mix(from_color.g, to_color.g),
+                 mix(from_color.b, to_color.b), mix(from_color.a, to_color.a));
+}
+
+void PrimitiveRenderer::fillConvexGradient(const std::vector<Point>& outline, const Gradient& gradient) {
+    if (outline.size() < 3) {
+        return;
+    }
+    
+    // Vertex colours are exact and interpolate linearly between vertices. A
+    // linear gradient that does not clamp inside the shape is linear
+    // everywhere, so a fan is exact; radial or clamped gradients get a web
+    // of rings around the centroid, with edges split to match
+    Point center{0.0f, 0.0f};
+    for (const Point& point : outline) {
+        center.x += point.x;
+        center.y += point.y;
+    }
+    center.x /= static_cast<float>(outline.size());
+    center.y /= static_cast<float>(outline.size());
+    
+    bool exact = !gradient.radial;
+    const float dx = gradient.to.x - gradient.from.x;
+    const float dy = gradient.to.y - gradient.from.y;
+    const float length_sq = dx * dx + dy * dy;
+    if (exact && length_sq > 0.0f) {
+        for (const Point& point : outline) {
+            const float t = ((point.x - gradient.from.x) * dx + (point.y - gradient.from.y) * dy) / length_sq;
+            if (t < 0.0f || t > 1.0f) {
+                exact = false;
+                break;
+            }
+        }
+    }
+    
+    std::vector<Point> rim;
+    int rings = 1;
+    if (exact) {
+        rim = outline;
+    } else {
+        // About 8px cells, coarser for huge shapes so the mesh stays in one batch
+        constexpr size_t max_rim = 512;
+        constexpr int max_rings = 16;
+        float perimeter = 0.0f;
+        float extent = 0.0f;
+        for (size_t i = 0; i < outline.size(); ++i) {
+            perimeter += calculateDistance(outline[i], outline[(i + 1) % outline.size()]);
+            extent = std::max(extent, calculateDistance(center, outline[i]));
+        }
+        const float step = std::max({8.0f, perimeter / max_rim, extent / max_rings});
+        
+        for (size_t i = 0; i < outline.size(); ++i) {
+            const Point& a = outline[i];
+            const Point& b = outline[(i + 1) % outline.size()];
+            const int pieces = std::max(1, static_cast<int>(std::ceil(calculateDistance(a, b) / step)));
+            for (int k = 0; k < pieces; ++k) {
+                rim.push_back(interpolatePoints(a, b, static_cast<float>(k) / pieces));
+            }
+        }
+        rings = std::clamp(static_cast<int>(std::ceil(extent / step)), 1, max_rings);
+    }
+    
+    const size_t count = rim.size();
+    if (1 + count * rings > 0xFFFF) {
+        Logger::warning("Gradient outline of {} points is too large to tessellate", outline.size());
+        return;
+    }
+    
+    std::vector<TriangleVertex> vertices;
+    vertices.reserve(1 + count * rings);
+    vertices.push_back({center, gradient.colorAt(center)});
+    for (int ring = 1; ring <= rings; ++ring) {
+        const float scale = static_cast<float>(ring) / rings;
+        for (const Point& point : rim) {
+            Point position = interpolatePoints(center, point, scale);
+            vertices.push_back({position, gradient.colorAt(position)});
+        }
+    }
+    
+    auto at = [count](int ring, size_t i) { return static_cast<uint16_t>(1 + (ring - 1) * count + i % count); };
+    
+    std::vector<uint16_t> indices;
+    indices.reserve(count * (rings * 2 - 1) * 3);
+    for (size_t i = 0; i < count; ++i) {
+        indices.insert(indices.end(), {0, at(1, i), at(1, i + 1)});
+        for (int ring = 2; ring <= rings; ++ring) {
+            indices.insert(indices.end(), {at(ring - 1, i), at(ring, i), at(ring, i + 1),
+                                           at(ring - 1, i), at(ring, i + 1), at(ring - 1, i + 1)});
+        }
+    }
+    
+    addToBatch(PrimitiveBatch::TRIANGLES, vertices, indices, m_current_layer);
+}
+
 void PrimitiveRenderer::drawBezierQuadratic(const Point& start, const Point& control, const Point& end, 
                                            const Color& color, float thickness, int segments) {
     std::vector<Point> curve_points = PrimitiveGeometry::generateBezierPoints(start, control, end, segments);
@@ -458,6 +593,16 @@ void PrimitiveRenderer::flushLayer(uint8_t layer_id) {
         m_primitive_batches.end());
 }
 
+std::vector<uint8_t> PrimitiveRenderer::getPendingLayers() const {
+    std::vector<uint8_t> layers;
+    for (const auto& batch : m_primitive_batches) {
+        if (!batch.isEmpty() && std::find(layers.begin(), layers.end(), batch.layer_id) == layers.end()) {
+            layers.push_back(batch.layer_id);
+        }
+    }
+    return layers;
+}
+
 void PrimitiveRenderer::setAntialiasing(bool enabled) {
     m_antialiasing_enabled = enabled;
 }
@@ -560,8 +705,7 @@ void PrimitiveRenderer::generatePolygonVertices(const std::vector<Point>& points
     }
 }
 
-std::vector<uint16_t> PrimitiveRenderer::triangulatePolygon(const std::vector<Point>& points) {
-    // Simple ear clipping triangulation
+std::vector<uint16_t> PrimitiveRenderer::triangulatePolygon(const std::vector<Point>& points, bool known_convex) {
     std::vector<uint16_t> indices;
     
     if (points.size() < 3) {
@@ -574,14 +718,12 @@ std::vector<uint16_t> PrimitiveRenderer::triangulatePolygon(const std::vector<Po
         return indices;
     }
     
-    if (points.size() == 4) {
-        // Quad - split into two triangles
-        indices = {0, 1, 2, 0, 2, 3};
+    if (!known_convex && !PrimitiveGeometry::isConvexPolygon(points)) {
+        earClipPolygon(points, indices);
         return indices;
     }
     
-    // For complex polygons, use a simple fan triangulation from first vertex
-    // This works for convex polygons
+    // Convex: a fan from the first vertex
     indices.reserve((points.size() - 2) * 3);
     for (size_t i = 1; i < points.size() - 1; ++i) {
         indices.insert(indices.end(), {0, static_cast<uint16_t>(i), static_cast<uint16_t>(i + 1)});
@@ -590,6 +732,126 @@ std::vector<uint16_t> PrimitiveRenderer::triangulatePolygon(const std::vector<Po
     return indices;
 }
 
+void PrimitiveRenderer::earClipPolygon(const std::vector<Point>& points, std::vector<uint16_t>& indices) {
+    const size_t count = points.size();
+    std::vector<uint16_t> remaining(count);
+    for (size_t i = 0; i < count; ++i) {
+        remaining[i] = static_cast<uint16_t>(i);
+    }
+    
+    // Winding from the signed area, so either orientation works
+    float signed_area = 0.0f;
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        signed_area += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    const float winding = signed_area >= 0.0f ? 1.0f : -1.0f;
+    
+    auto cross = [&](const Point& a, const Point& b, const Point& c) {
+        return ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * winding;
+    };
+    
+    auto isEar = [&](size_t position) {
+        const size_t size = remaining.size();
+        const Point& a = points[remaining[(position + size - 1) % size]];
+        const Point& b = points[remaining[position]];
+        const Point& c = points[remaining[(position + 1) % size]];
+        if (cross(a, b, c) <= 0.0f) {
+            return false;  // Reflex corner
+        }
+        for (size_t k = 0; k < size; ++k) {
+            const Point& p = points[remaining[k]];
+            if (&p == &a || &p == &b || &p == &c) {
+                continue;
+            }
+            if (cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f) {
+                return false;  // Another vertex inside the candidate ear
+            }
+        }
+        return true;
+    };
+    
+    indices.reserve((count - 2) * 3);
+    size_t position = 0;
+    size_t misses = 0;
+    while (remaining.size() > 3) {
+        const size_t size = remaining.size();
+        position %= size;
+        
+        if (isEar(position)) {
+            indices.insert(indices.end(), {remaining[(position + size - 1) % size], remaining[position],
+                                           remaining[(position + 1) % size]});
+            remaining.erase(remaining.begin() + position);
+            misses = 0;
+        } else if (++misses > size) {
+            break;  // Self-intersecting or degenerate: no ear left, fan what remains
+        } else {
+            ++position;
+        }
+    }
+    
+    for (size_t i = 1; i + 1 < remaining.size(); ++i) {
+        indices.insert(indices.end(), {remaining[0], remaining[i], remaining[i + 1]});
+    }
+}
+
+int PrimitiveRenderer::arcSegments(float radius, float angle_range) {
+    // Keep the chord within half a pixel of the true curve
+    constexpr float tolerance = 0.5f;
+    float step = radius > tolerance ? 2.0f * std::acos(1.0f - tolerance / radius) : angle_range;
+    int segments = static_cast<int>(std::ceil(angle_range / std::max(step, 0.01f)));
+    return std::clamp(segments, 4, 512);
+}
+
+std::vector<Point> PrimitiveRenderer::roundedRectangleOutline(const Rectangle& rect, const float radii[4]) {
+    const float left = std::min(rect.x, rect.x + rect.width);
+    const float top = std::min(rect.y, rect.y + rect.height);
+    const float right = std::max(rect.x, rect.x + rect.width);
+    const float bottom = std::max(rect.y, rect.y + rect.height);
+    
+    float r[4];
+    for (int i = 0; i < 4; ++i) {
+        r[i] = std::max(0.0f, radii[i]);
+    }
+    
+    // Scale all radii by one factor until every side fits its two corners
+    float scale = 1.0f;
+    auto fit = [&scale](float side, float a, float b) {
+        if (a + b > side) {
+            scale = std::min(scale, side / (a + b));
+        }
+    };
+    fit(right - left, r[0], r[1]);
+    fit(bottom - top, r[1], r[2]);
+    fit(right - left, r[2], r[3]);
+    fit(bottom - top, r[3], r[0]);
+    
+    // Corner centres and start angles, clockwise from the top-left corner
+    const Point centers[4] = {
+        {left + r[0] * scale, top + r[0] * scale},
+        {right - r[1] * scale, top + r[1] * scale},
+        {right - r[2] * scale, bottom - r[2] * scale},
+        {left + r[3] * scale, bottom - r[3] * scale}
+    };
+    const float starts[4] = {static_cast<float>(M_PI), 1.5f * static_cast<float>(M_PI), 0.0f,
+                             0.5f * static_cast<float>(M_PI)};
+    
+    std::vector<Point> outline;
+    for (int corner = 0; corner < 4; ++corner) {
+        const float radius = r[corner] * scale;
+        if (radius <= 0.0f) {
+            outline.push_back(centers[corner]);
+            continue;
+        }
+        const int segments = arcSegments(radius, 0.5f * M_PI);
+        for (int i = 0; i <= segments; ++i) {
+            float angle = starts[corner] + (0.5f * M_PI * i) / segments;
+            outline.push_back({centers[corner].x + radius * std::cos(angle),
+                               centers[corner].y + radius * std::sin(angle)});
+        }
+    }
+    return outline;
+}
+
 void PrimitiveRenderer::tessellateComplexPolygon(const std::vector<Point>& points, 
                                                 std::vector<TriangleVertex>& vertices,
                                                 std::vector<uint16_t>& indices) {
@@ -601,11 +863,11 @@ void PrimitiveRenderer::tessellateComplexPolygon(const std::vector<Point>& point
 
 void PrimitiveRenderer::addToBatch(PrimitiveBatch::Type type, const std::vector<TriangleVertex>& vertices,
                                   const std::vector<uint16_t>& indices, uint8_t layer_id) {
-    // Find existing batch of same type and layer
+    // Find existing batch of same type, layer and clip
     PrimitiveBatch* target_batch = nullptr;
     
     for (auto& batch : m_primitive_batches) {
-        if (batch.type == type && batch.layer_id == layer_id &&
+        if (batch.type == type && batch.layer_id == layer_id && batch.clip_id == m_current_clip &&
             batch.vertices.size() + vertices.size() <= m_max_vertices_per_batch &&
             batch.indices.size() + indices.size() <= m_max_indices_per_batch) {
             target_batch = &batch;
@@ -619,6 +881,7 @@ void PrimitiveRenderer::addToBatch(PrimitiveBatch::Type type, const std::vector<
         target_batch = &m_primitive_batches.back();
         target_batch->type = type;
         target_batch->layer_id = layer_id;
+        target_batch->clip_id = m_current_clip;
     }
     
     // Add vertices and indices to batch
@@ -640,6 +903,11 @@ void PrimitiveRenderer::flushBatch(PrimitiveBatch& batch) {
     
     optimizeBatch(batch);
     
+    const bool clipped = batch.clip_id != 0 && m_clip_handler;
+    if (clipped) {
+        m_clip_handler(batch.clip_id);
+    }
+    
     // Set blend mode
     BeginBlendMode(m_blend_mode);
     
@@ -666,6 +934,10 @@ void PrimitiveRenderer::flushBatch(PrimitiveBatch& batch) {
     rlEnd();
     EndBlendMode();
     
+    if (clipped) {
+        m_clip_handler(0);
+    }
+    
     m_stats.draw_calls_issued++;
     m_stats.batches_flushed++;
     
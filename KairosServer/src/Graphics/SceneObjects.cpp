@@ -0,0 +1,292 @@
+// KairosServer/src/Graphics/SceneObjects.cpp
+#include "Graphics/SceneObjects.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Kairos {
+
+namespace {
+
+// The UPDATE_OBJECT field that sets each property
+constexpr uint8_t PROPERTY_FIELDS[SceneObjects::PROPERTY_COUNT] = {
+    Constants::OBJECT_FIELD_POSITION, Constants::OBJECT_FIELD_POSITION,
+    Constants::OBJECT_FIELD_SIZE, Constants::OBJECT_FIELD_SIZE,
+    Constants::OBJECT_FIELD_ROTATION,
+    Constants::OBJECT_FIELD_COLOR, Constants::OBJECT_FIELD_COLOR,
+    Constants::OBJECT_FIELD_COLOR, Constants::OBJECT_FIELD_COLOR,
+    Constants::OBJECT_FIELD_OPACITY};
+
+std::array<float, SceneObjects::PROPERTY_COUNT> valuesOf(const RenderCommand& command) {
+    const auto& object = command.object;
+    return {object.position.x, object.position.y, object.width, object.height, object.rotation,
+            static_cast<float>(object.color.r), static_cast<float>(object.color.g),
+            static_cast<float>(object.color.b), static_cast<float>(object.color.a), object.opacity};
+}
+
+} // anonymous namespace
+
+bool SceneObjects::create(uint32_t client_id, const RenderCommand& command) {
+    const uint64_t object_key = key(client_id, command.object.id);
+    auto existing = m_entries.find(object_key);
+    if (existing != m_entries.end()) {
+        erase(existing);
+    }
+
+    uint32_t& count = m_client_objects[client_id];
+    if (count >= Limits::MAX_OBJECTS_PER_CLIENT) {
+        Logger::warning("Client {} has {} objects; object {} refused", client_id, count, command.object.id);
+        return false;
+    }
+    count++;
+
+    Entry& entry = m_entries[object_key];
+    entry.object.client_id = client_id;
+    entry.object.object_id = command.object.id;
+    entry.object.layer_id = command.layer_id;
+    entry.object.shape = command.object.shape;
+    entry.object.texture_id = command.object.texture_id;
+    entry.object.corner_radius = command.object.corner_radius;
+    entry.object.values = valuesOf(command);
+    m_layers[command.layer_id].push_back(object_key);
+    return true;
+}
+
+bool SceneObjects::update(uint32_t client_id, const RenderCommand& command, Clock::time_point now) {
+    auto it = m_entries.find(key(client_id, command.object.id));
+    if (it == m_entries.end()) {
+        Logger::warning("Client {} updated unknown object {}", client_id, command.object.id);
+        return false;
+    }
+
+    Entry& entry = it->second;
+    const auto targets = valuesOf(command);
+    for (size_t property = 0; property < PROPERTY_COUNT; ++property) {
+        if (!(command.object.fields & PROPERTY_FIELDS[property])) {
+            continue;
+        }
+
+        // A running tween stops where it is now, which is where the new one starts
+        Tween& tween = entry.tweens[property];
+        float& value = entry.object.values[property];
+        if (tween.active) {
+            bool finished = false;
+            value = evaluate(tween, now, finished);
+            tween.active = false;
+            m_active_tweens--;
+        }
+
+        if (command.object.duration_ms == 0) {
+            value = targets[property];
+            continue;
+        }
+        tween.active = true;
+        tween.from = value;
+        tween.to = targets[property];
+        tween.start = now;
+        tween.duration_ms = command.object.duration_ms;
+        tween.easing = command.object.easing;
+        tween.flags = command.object.flags;
+        m_active_tweens++;
+    }
+    return true;
+}
+
+bool SceneObjects::remove(uint32_t client_id, uint32_t object_id) {
+    auto it = m_entries.find(key(client_id, object_id));
+    if (it == m_entries.end()) {
+        return false;
+    }
+    erase(it);
+    return true;
+}
+
+void SceneObjects::removeClient(uint32_t client_id) {
+    if (m_client_objects.find(client_id) == m_client_objects.end()) {
+        return;
+    }
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto next = std::next(it);
+        if (it->second.object.client_id == client_id) {
+            erase(it);
+        }
+        it = next;
+    }
+}
+
+void SceneObjects::clear() {
+    m_entries.clear();
+    for (auto& keys : m_layers) {
+        keys.clear();
+    }
+    m_client_objects.clear();
+    m_active_tweens = 0;
+}
+
+void SceneObjects::advance(Clock::time_point now) {
+    if (m_active_tweens == 0) {
+        return;
+    }
+    for (auto& [object_key, entry] : m_entries) {
+        for (size_t property = 0; property < PROPERTY_COUNT; ++property) {
+            Tween& tween = entry.tweens[property];
+            if (!tween.active) {
+                continue;
+            }
+            bool finished = false;
+            entry.object.values[property] = evaluate(tween, now, finished);
+            if (finished) {
+                tween.active = false;
+                m_active_tweens--;
+            }
+        }
+    }
+}
+
+void SceneObjects::exportObjects(std::vector<SceneState::Object>& objects, Clock::time_point now) const {
+    for (const auto& keys : m_layers) {
+        for (uint64_t object_key : keys) {
+            const Entry& entry = m_entries.at(object_key);
+            SceneState::Object object;
+            object.client_id = entry.object.client_id;
+            object.object_id = entry.object.object_id;
+            object.layer_id = entry.object.layer_id;
+            object.shape = entry.object.shape;
+            object.texture_id = entry.object.texture_id;
+            object.corner_radius = entry.object.corner_radius;
+            object.values.assign(entry.object.values.begin(), entry.object.values.end());
+
+            for (size_t property = 0; property < PROPERTY_COUNT; ++property) {
+                const Tween& tween = entry.tweens[property];
+                if (!tween.active) {
+                    continue;
+                }
+                SceneState::ObjectTween state;
+                state.property = static_cast<uint8_t>(property);
+                state.from = tween.from;
+                state.to = tween.to;
+                state.elapsed_ms = std::chrono::duration<double, std::milli>(now - tween.start).count();
+                state.duration_ms = tween.duration_ms;
+                state.easing = tween.easing;
+                state.flags = tween.flags;
+                object.tweens.push_back(state);
+            }
+            objects.push_back(std::move(object));
+        }
+    }
+}
+
+void SceneObjects::importObjects(const std::vector<SceneState::Object>& objects, Clock::time_point now) {
+    size_t skipped = 0;
+    for (const auto& object : objects) {
+        uint32_t& count = m_client_objects[object.client_id];
+        if (object.values.size() != PROPERTY_COUNT || count >= Limits::MAX_OBJECTS_PER_CLIENT ||
+            m_entries.find(key(object.client_id, object.object_id)) != m_entries.end()) {
+            if (count == 0) {
+                m_client_objects.erase(object.client_id);
+            }
+            ++skipped;
+            continue;
+        }
+        count++;
+
+        const uint64_t object_key = key(object.client_id, object.object_id);
+        Entry& entry = m_entries[object_key];
+        entry.object.client_id = object.client_id;
+        entry.object.object_id = object.object_id;
+        entry.object.layer_id = object.layer_id;
+        entry.object.shape = object.shape;
+        entry.object.texture_id = object.texture_id;
+        entry.object.corner_radius = object.corner_radius;
+        std::copy(object.values.begin(), object.values.end(), entry.object.values.begin());
+        m_layers[object.layer_id].push_back(object_key);
+
+        for (const auto& state : object.tweens) {
+            if (state.property >= PROPERTY_COUNT || state.duration_ms == 0 ||
+                entry.tweens[state.property].active) {
+                continue;
+            }
+            Tween& tween = entry.tweens[state.property];
+            tween.active = true;
+            tween.from = state.from;
+            tween.to = state.to;
+            tween.start = now - std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(std::max(0.0, state.elapsed_ms)));
+            tween.duration_ms = state.duration_ms;
+            tween.easing = state.easing;
+            tween.flags = state.flags;
+            m_active_tweens++;
+        }
+    }
+
+    if (skipped > 0) {
+        Logger::warning("Object import skipped {} of {} objects", skipped, objects.size());
+    }
+}
+
+float SceneObjects::ease(uint8_t easing, float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    switch (easing) {
+        case Constants::EASING_IN:
+            return t * t * t;
+        case Constants::EASING_OUT: {
+            const float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        case Constants::EASING_IN_OUT: {
+            if (t < 0.5f) {
+                return 4.0f * t * t * t;
+            }
+            const float u = 2.0f - 2.0f * t;
+            return 1.0f - u * u * u * 0.5f;
+        }
+        case Constants::EASING_OUT_BACK: {
+            // Past the target by up to about 10%, then back
+            constexpr float overshoot = 1.70158f;
+            const float u = t - 1.0f;
+            return 1.0f + (overshoot + 1.0f) * u * u * u + overshoot * u * u;
+        }
+        default:
+            return t;
+    }
+}
+
+float SceneObjects::evaluate(const Tween& tween, Clock::time_point now, bool& finished) {
+    const bool repeat = tween.flags & Constants::OBJECT_TWEEN_REPEAT;
+    const bool alternate = tween.flags & Constants::OBJECT_TWEEN_ALTERNATE;
+    const double elapsed_ms = std::max(0.0, std::chrono::duration<double, std::milli>(now - tween.start).count());
+    const double cycles = elapsed_ms / tween.duration_ms;
+
+    // Once through, or there and back again with alternate; repeats never end
+    finished = !repeat && cycles >= (alternate ? 2.0 : 1.0);
+    if (finished) {
+        return alternate ? tween.from : tween.to;
+    }
+
+    const double cycle = std::floor(cycles);
+    float progress = static_cast<float>(cycles - cycle);
+    if (alternate && std::fmod(cycle, 2.0) >= 1.0) {
+        progress = 1.0f - progress;
+    }
+    return tween.from + (tween.to - tween.from) * ease(tween.easing, progress);
+}
+
+void SceneObjects::erase(std::unordered_map<uint64_t, Entry>::iterator it) {
+    const Entry& entry = it->second;
+    for (const Tween& tween : entry.tweens) {
+        if (tween.active) {
+            m_active_tweens--;
+        }
+    }
+
+    auto& keys = m_layers[entry.object.layer_id];
+    keys.erase(std::find(keys.begin(), keys.end(), it->first));
+
+    auto count = m_client_objects.find(entry.object.client_id);
+    if (count != m_client_objects.end() && --count->second == 0) {
+        m_client_objects.erase(count);
+    }
+    m_entries.erase(it);
+}
+
+} // namespace Kairos
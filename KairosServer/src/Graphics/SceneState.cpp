@@ -0,0 +1,464 @@
+// KairosServer/src/Graphics/SceneState.cpp
+#include <Graphics/SceneState.hpp>
+#include <Utils/Logger.hpp>
+
+namespace Kairos {
+
+void SceneState::serialize(BinaryWriter& writer) const {
+    writer.write(FORMAT_VERSION);
+
+    writer.write(static_cast<uint32_t>(layers.size()));
+    for (const auto& layer : layers) {
+        writer.write(layer.id);
+        writer.write(layer.visible);
+        writer.write(layer.opacity);
+        writer.write(layer.z_order);
+        writer.write(static_cast<int32_t>(layer.blend_mode));
+        for (float value : {layer.transform.a, layer.transform.b, layer.transform.c,
+                            layer.transform.d, layer.transform.tx, layer.transform.ty}) {
+            writer.write(value);
+        }
+        writer.write(static_cast<uint32_t>(layer.commands.size()));
+        for (const auto& command : layer.commands) {
+            writeCommand(writer, command);
+        }
+    }
+
+    writer.write(static_cast<uint32_t>(textures.size()));
+    for (const auto& texture : textures) {
+        writer.write(texture.id);
+        writer.write(texture.width);
+        writer.write(texture.height);
+        writer.write(texture.format);
+        writer.write(texture.content_hash);
+        writer.writeVector(texture.pixels);
+    }
+
+    writer.write(static_cast<uint32_t>(fonts.size()));
+    for (const auto& font : fonts) {
+        writer.write(font.id);
+        writer.writeString(font.file_path);
+        writer.write(font.font_size);
+    }
+
+    writer.write(static_cast<uint32_t>(objects.size()));
+    for (const auto& object : objects) {
+        writer.write(object.client_id);
+        writer.write(object.object_id);
+        writer.write(object.layer_id);
+        writer.write(object.shape);
+        writer.write(object.texture_id);
+        writer.write(object.corner_radius);
+        writer.writeVector(object.values);
+        writer.write(static_cast<uint32_t>(object.tweens.size()));
+        for (const auto& tween : object.tweens) {
+            writer.write(tween.property);
+            writer.write(tween.from);
+            writer.write(tween.to);
+            writer.write(tween.elapsed_ms);
+            writer.write(tween.duration_ms);
+            writer.write(tween.easing);
+            writer.write(tween.flags);
+        }
+    }
+}
+
+bool SceneState::deserialize(BinaryReader& reader) {
+    uint32_t version = 0;
+    if (!reader.read(version) || version != FORMAT_VERSION) {
+        Logger::error("Unsupported scene state format version {} (expected {})", version, FORMAT_VERSION);
+        return false;
+    }
+
+    uint32_t layer_count = 0;
+    reader.read(layer_count);
+    layers.clear();
+    for (uint32_t i = 0; i < layer_count && reader.isValid(); ++i) {
+        Layer layer;
+        int32_t blend_mode = 0;
+        uint32_t command_count = 0;
+        reader.read(layer.id);
+        reader.read(layer.visible);
+        reader.read(layer.opacity);
+        reader.read(layer.z_order);
+        reader.read(blend_mode);
+        for (float* value : {&layer.transform.a, &layer.transform.b, &layer.transform.c,
+                             &layer.transform.d, &layer.transform.tx, &layer.transform.ty}) {
+            reader.read(*value);
+        }
+        reader.read(command_count);
+        layer.blend_mode = blend_mode;
+
+        for (uint32_t c = 0; c < command_count && reader.isValid(); ++c) {
+            RenderCommand command;
+            if (!readCommand(reader, command)) {
+                return false;
+            }
+            layer.commands.push_back(std::move(command));
+        }
+        layers.push_back(std::move(layer));
+    }
+
+    uint32_t texture_count = 0;
+    reader.read(texture_count);
+    textures.clear();
+    for (uint32_t i = 0; i < texture_count && reader.isValid(); ++i) {
+        Texture texture;
+        reader.read(texture.id);
+        reader.read(texture.width);
+        reader.read(texture.height);
+        reader.read(texture.format);
+        reader.read(texture.content_hash);
+        reader.readVector(texture.pixels);
+        textures.push_back(std::move(texture));
+    }
+
+    uint32_t font_count = 0;
+    reader.read(font_count);
+    fonts.clear();
+    for (uint32_t i = 0; i < font_count && reader.isValid(); ++i) {
+        FontRef font;
+        reader.read(font.id);
+        reader.readString(font.file_path);
+        reader.read(font.font_size);
+        fonts.push_back(std::move(font));
+    }
+
+    uint32_t object_count = 0;
+    reader.read(object_count);
+    objects.clear();
+    for (uint32_t i = 0; i < object_count && reader.isValid(); ++i) {
+        Object object;
+        uint32_t tween_count = 0;
+        reader.read(object.client_id);
+        reader.read(object.object_id);
+        reader.read(object.layer_id);
+        reader.read(object.shape);
+        reader.read(object.texture_id);
+        reader.read(object.corner_radius);
+        reader.readVector(object.values);
+        reader.read(tween_count);
+        for (uint32_t t = 0; t < tween_count && reader.isValid(); ++t) {
+            ObjectTween tween;
+            reader.read(tween.property);
+            reader.read(tween.from);
+            reader.read(tween.to);
+            reader.read(tween.elapsed_ms);
+            reader.read(tween.duration_ms);
+            reader.read(tween.easing);
+            reader.read(tween.flags);
+            object.tweens.push_back(tween);
+        }
+        objects.push_back(std::move(object));
+    }
+
+    if (!reader.isValid()) {
+        Logger::error("Scene state is truncated");
+        return false;
+    }
+    return true;
+}
+
+uint64_t SceneState::contentHash(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void SceneState::writeCommand(BinaryWriter& writer, const RenderCommand& command) {
+    writer.write(static_cast<uint8_t>(command.type));
+    writer.write(static_cast<uint8_t>(command.priority));
+    writer.write(command.layer_id);
+    writer.write(command.client_id);
+    writer.write(command.sequence_id);
+
+    switch (command.type) {
+        case RenderCommand::Type::DRAW_POINT:
+            writer.write(command.point.position);
+            writer.write(command.point.color);
+            break;
+
+        case RenderCommand::Type::DRAW_LINE:
+            writer.write(command.line.start);
+            writer.write(command.line.end);
+            writer.write(command.line.color);
+            writer.write(command.line.thickness);
+            break;
+
+        case RenderCommand::Type::DRAW_RECTANGLE:
+            writer.write(command.rectangle.position);
+            writer.write(command.rectangle.width);
+            writer.write(command.rectangle.height);
+            writer.write(command.rectangle.color);
+            writer.write(command.rectangle.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_CIRCLE:
+            writer.write(command.circle.center);
+            writer.write(command.circle.radius);
+            writer.write(command.circle.color);
+            writer.write(command.circle.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_ARC:
+            writer.write(command.arc.center);
+            writer.write(command.arc.radius_x);
+            writer.write(command.arc.radius_y);
+            writer.write(command.arc.start_angle);
+            writer.write(command.arc.end_angle);
+            writer.write(command.arc.color);
+            writer.write(command.arc.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_POLYGON:
+            writer.write(command.polygon.color);
+            writer.write(command.polygon.filled);
+            writer.write(command.polygon.convex);
+            break;
+
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+            writer.write(command.rounded_rectangle.position);
+            writer.write(command.rounded_rectangle.width);
+            writer.write(command.rounded_rectangle.height);
+            for (float radius : command.rounded_rectangle.radii) {
+                writer.write(radius);
+            }
+            writer.write(command.rounded_rectangle.color);
+            writer.write(command.rounded_rectangle.filled);
+            break;
+
+        case RenderCommand::Type::FILL_GRADIENT:
+            writer.write(command.gradient.position);
+            writer.write(command.gradient.width);
+            writer.write(command.gradient.height);
+            writer.write(command.gradient.from);
+            writer.write(command.gradient.to);
+            writer.write(command.gradient.from_color);
+            writer.write(command.gradient.to_color);
+            writer.write(command.gradient.shape);
+            writer.write(command.gradient.radial);
+            break;
+
+        case RenderCommand::Type::DRAW_TEXT:
+            writer.write(command.text.position);
+            writer.write(command.text.font_id);
+            writer.write(command.text.font_size);
+            writer.write(command.text.color);
+            break;
+
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
+            writer.write(command.textured_quads.texture_id);
+            break;
+
+        case RenderCommand::Type::DRAW_SPRITES:
+            writer.write(command.sprites.texture_id);
+            break;
+
+        case RenderCommand::Type::SET_LAYER_VISIBILITY:
+            writer.write(command.layer_visibility.visible);
+            break;
+
+        case RenderCommand::Type::SET_VIEWPORT:
+            writer.write(command.viewport.x);
+            writer.write(command.viewport.y);
+            writer.write(command.viewport.width);
+            writer.write(command.viewport.height);
+            break;
+
+        case RenderCommand::Type::SET_CAMERA:
+            writer.write(command.camera.target);
+            writer.write(command.camera.offset);
+            writer.write(command.camera.rotation);
+            writer.write(command.camera.zoom);
+            break;
+
+        case RenderCommand::Type::SET_LAYER_TRANSFORM:
+            writer.write(command.layer_transform.a);
+            writer.write(command.layer_transform.b);
+            writer.write(command.layer_transform.c);
+            writer.write(command.layer_transform.d);
+            writer.write(command.layer_transform.tx);
+            writer.write(command.layer_transform.ty);
+            writer.write(command.layer_transform.rerasterize);
+            break;
+
+        case RenderCommand::Type::PUSH_CLIP:
+            writer.write(command.clip.x);
+            writer.write(command.clip.y);
+            writer.write(command.clip.width);
+            writer.write(command.clip.height);
+            break;
+
+        case RenderCommand::Type::CLEAR_LAYER:
+        case RenderCommand::Type::BATCH_MARKER:
+        case RenderCommand::Type::POP_CLIP:
+            break;
+
+        case RenderCommand::Type::CREATE_PIXMAP:
+        case RenderCommand::Type::FREE_PIXMAP:
+        case RenderCommand::Type::SET_PIXMAP_TARGET:
+        case RenderCommand::Type::COPY_AREA:
+        case RenderCommand::Type::CREATE_OBJECT:
+        case RenderCommand::Type::UPDATE_OBJECT:
+        case RenderCommand::Type::DELETE_OBJECT:
+            break;      // Never retained: pixmaps and copied pixels are not part of the scene, objects are kept apart
+    }
+
+    writer.writeString(command.text_string);
+    writer.writeVector(command.polygon_points);
+    writer.writeVector(command.vertices);
+    writer.writeVector(command.sprite_instances);
+}
+
+bool SceneState::readCommand(BinaryReader& reader, RenderCommand& command) {
+    uint8_t type = 0;
+    uint8_t priority = 0;
+    reader.read(type);
+    reader.read(priority);
+    reader.read(command.layer_id);
+    reader.read(command.client_id);
+    reader.read(command.sequence_id);
+
+    command.type = static_cast<RenderCommand::Type>(type);
+    command.priority = static_cast<RenderCommand::Priority>(priority);
+
+    switch (command.type) {
+        case RenderCommand::Type::DRAW_POINT:
+            reader.read(command.point.position);
+            reader.read(command.point.color);
+            break;
+
+        case RenderCommand::Type::DRAW_LINE:
+            reader.read(command.line.start);
+            reader.read(command.line.end);
+            reader.read(command.line.color);
+            reader.read(command.line.thickness);
+            break;
+
+        case RenderCommand::Type::DRAW_RECTANGLE:
+            reader.read(command.rectangle.position);
+            reader.read(command.rectangle.width);
+            reader.read(command.rectangle.height);
+            reader.read(command.rectangle.color);
+            reader.read(command.rectangle.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_CIRCLE:
+            reader.read(command.circle.center);
+            reader.read(command.circle.radius);
+            reader.read(command.circle.color);
+            reader.read(command.circle.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_ARC:
+            reader.read(command.arc.center);
+            reader.read(command.arc.radius_x);
+            reader.read(command.arc.radius_y);
+            reader.read(command.arc.start_angle);
+            reader.read(command.arc.end_angle);
+            reader.read(command.arc.color);
+            reader.read(command.arc.filled);
+            break;
+
+        case RenderCommand::Type::DRAW_POLYGON:
+            reader.read(command.polygon.color);
+            reader.read(command.polygon.filled);
+            reader.read(command.polygon.convex);
+            break;
+
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+            reader.read(command.rounded_rectangle.position);
+            reader.read(command.rounded_rectangle.width);
+            reader.read(command.rounded_rectangle.height);
+            for (float& radius : command.rounded_rectangle.radii) {
+                reader.read(radius);
+            }
+            reader.read(command.rounded_rectangle.color);
+            reader.read(command.rounded_rectangle.filled);
+            break;
+
+        case RenderCommand::Type::FILL_GRADIENT:
+            reader.read(command.gradient.position);
+            reader.read(command.gradient.width);
+            reader.read(command.gradient.height);
+            reader.read(command.gradient.from);
+            reader.read(command.gradient.to);
+            reader.read(command.gradient.from_color);
+            reader.read(command.gradient.to_color);
+            reader.read(command.gradient.shape);
+            reader.read(command.gradient.radial);
+            break;
+
+        case RenderCommand::Type::DRAW_TEXT:
+            reader.read(command.text.position);
+            reader.read(command.text.font_id);
+            reader.read(command.text.font_size);
+            reader.read(command.text.color);
+            break;
+
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
+            reader.read(command.textured_quads.texture_id);
+            break;
+
+        case RenderCommand::Type::DRAW_SPRITES:
+            reader.read(command.sprites.texture_id);
+            break;
+
+        case RenderCommand::Type::SET_LAYER_VISIBILITY:
+            reader.read(command.layer_visibility.visible);
+            break;
+
+        case RenderCommand::Type::SET_VIEWPORT:
+            reader.read(command.viewport.x);
+            reader.read(command.viewport.y);
+            reader.read(command.viewport.width);
+            reader.read(command.viewport.height);
+            break;
+
+        case RenderCommand::Type::SET_CAMERA:
+            reader.read(command.camera.target);
+            reader.read(command.camera.offset);
+            reader.read(command.camera.rotation);
+            reader.read(command.camera.zoom);
+            break;
+
+        case RenderCommand::Type::SET_LAYER_TRANSFORM:
+            reader.read(command.layer_transform.a);
+            reader.read(command.layer_transform.b);
+            reader.read(command.layer_transform.c);
+            reader.read(command.layer_transform.d);
+            reader.read(command.layer_transform.tx);
+            reader.read(command.layer_transform.ty);
+            reader.read(command.layer_transform.rerasterize);
+            break;
+
+        case RenderCommand::Type::PUSH_CLIP:
+            reader.read(command.clip.x);
+            reader.read(command.clip.y);
+            reader.read(command.clip.width);
+            reader.read(command.clip.height);
+            break;
+
+        case RenderCommand::Type::CLEAR_LAYER:
+        case RenderCommand::Type::BATCH_MARKER:
+        case RenderCommand::Type::POP_CLIP:
+            break;
+
+        default:
+            Logger::error("Unknown render command type {} in scene state", type);
+            return false;
+    }
+
+    reader.readString(command.text_string);
+    reader.readVector(command.polygon_points);
+    reader.readVector(command.vertices);
+    reader.readVector(command.sprite_instances);
+
+    return reader.isValid();
+}
+
+} // namespace Kairos
@@ -2,6 +2,7 @@
 #include <Network/Client.hpp>
 #include <Utils/Logger.hpp>
 #include <Protocol.hpp>
+#include <Clock.hpp>
 #include <cstring>
 #include <algorithm>
 
@@ -15,6 +16,7 @@
     #include <arpa/inet.h>
     #include <unistd.h>
     #include <fcntl.h>
+    #include <poll.h>
     #include <errno.h>
 #endif
 
@@ -37,9 +39,42 @@ std::shared_ptr<Client> Client::createUnix(socket_t socket, const std::string& p
     return client;
 }
 
+std::shared_ptr<Client> Client::restore(const Session& session, const Config& config) {
+    auto client = std::shared_ptr<Client>(new Client(session.socket, session.connection_type));
+    client->m_config = config;
+    
+    Info& info = client->m_info;
+    info.client_id = session.client_id;
+    info.client_name = session.client_name;
+    info.client_version = session.client_version;
+    info.capabilities = session.capabilities;
+    info.requested_layers = session.requested_layers;
+    info.endpoint_address = session.endpoint_address;
+    info.endpoint_port = session.endpoint_port;
+    info.ping_sequence = session.ping_sequence;
+    info.messages_sent = session.messages_sent;
+    info.messages_received = session.messages_received;
+    info.bytes_sent = session.bytes_sent;
+    info.bytes_received = session.bytes_received;
+    
+    client->m_receive_buffer = session.pending_receive;
+    client->m_send_buffer = session.pending_send;
+    client->m_receive_buffer.reserve(config.receive_buffer_size);
+    client->m_send_buffer.reserve(config.send_buffer_size);
+    if (config.fixed_buffers) {
+        client->prefaultBuffers();
+    }
+    
+    // The handshake happened in the previous process
+    client->m_last_ping_sent = info.last_activity;
+    client->m_last_pong_received = info.last_activity;
+    client->setState(State::CONNECTED);
+    return client;
+}
+
 Client::Client(socket_t socket, Type type) : m_socket(socket) {
     m_info.connection_type = type;
-    m_info.connect_time = std::chrono::steady_clock::now();
+    m_info.connect_time = Clock::now();
     m_info.last_activity = m_info.connect_time;
     
     m_receive_buffer.reserve(64 * 1024); // Default 64KB
@@ -59,6 +94,9 @@ bool Client::initialize(uint32_t client_id, const Config& config) {
     // Resize buffers
     m_receive_buffer.reserve(m_config.receive_buffer_size);
     m_send_buffer.reserve(m_config.send_buffer_size);
+    if (m_config.fixed_buffers) {
+        prefaultBuffers();
+    }
     
     // Configure socket
     if (!configureSocket()) {
@@ -93,6 +131,36 @@ void Client::disconnect(const std::string& reason) {
     setState(State::DISCONNECTED);
 }
 
+Client::Session Client::exportSession() const {
+    std::lock_guard<std::mutex> send_lock(m_send_mutex);
+    std::lock_guard<std::mutex> receive_lock(m_receive_mutex);
+    
+    Session session;
+    session.socket = m_socket;
+    session.client_id = m_info.client_id;
+    session.connection_type = m_info.connection_type;
+    session.client_name = m_info.client_name;
+    session.client_version = m_info.client_version;
+    session.capabilities = m_info.capabilities;
+    session.requested_layers = m_info.requested_layers;
+    session.endpoint_address = m_info.endpoint_address;
+    session.endpoint_port = m_info.endpoint_port;
+    session.ping_sequence = m_info.ping_sequence;
+    session.messages_sent = m_info.messages_sent;
+    session.messages_received = m_info.messages_received;
+    session.bytes_sent = m_info.bytes_sent;
+    session.bytes_received = m_info.bytes_received;
+    
+    session.pending_receive.assign(m_receive_buffer.begin() + m_receive_buffer_pos, m_receive_buffer.end());
+    session.pending_send.assign(m_send_buffer.begin() + m_send_buffer_pos, m_send_buffer.end());
+    return session;
+}
+
+void Client::release() {
+    m_socket = -1;
+    setState(State::DISCONNECTED);
+}
+
 bool Client::isConnected() const {
     State state = m_state.load();
     return state == State::CONNECTED || state == State::HANDSHAKE;
@@ -103,7 +171,7 @@ bool Client::isTimedOut() const {
         return false;
     }
     
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     auto idle_time = std::chrono::duration_cast<std::chrono::seconds>(
         now - m_info.last_activity);
     
@@ -192,6 +260,12 @@ bool Client::receiveMessages(std::vector<std::pair<MessageHeader, std::vector<ui
     return true;
 }
 
+void Client::applyClientHello(const ClientHello& hello) {
+    m_info.client_name.assign(hello.client_name, strnlen(hello.client_name, sizeof(hello.client_name)));
+    m_info.capabilities = hello.capabilities;
+    m_info.requested_layers = hello.requested_layers;
+}
+
 bool Client::performHandshake(const ServerHello& server_hello) {
     if (m_state.load() != State::HANDSHAKE) {
         return false;
@@ -218,13 +292,13 @@ void Client::sendPing() {
                                                        m_info.ping_sequence++, sizeof(PingData));
     
     if (sendMessage(header, &ping_data)) {
-        m_last_ping_sent = std::chrono::steady_clock::now();
+        m_last_ping_sent = Clock::now();
         Logger::debug("Sent ping to client {}", m_info.client_id);
     }
 }
 
 void Client::handlePong(const PongData& pong) {
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     m_last_pong_received = now;
     
     // Calculate latency
@@ -243,7 +317,7 @@ bool Client::needsPing() const {
         return false;
     }
     
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     auto time_since_ping = std::chrono::duration_cast<std::chrono::seconds>(
         now - m_last_ping_sent);
     
@@ -251,7 +325,7 @@ bool Client::needsPing() const {
 }
 
 bool Client::checkRateLimit() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = Clock::now();
     
     // Remove old timestamps
     while (!m_message_times.empty() && 
@@ -270,7 +344,7 @@ bool Client::checkRateLimit() {
 }
 
 void Client::updateActivity() {
-    m_info.last_activity = std::chrono::steady_clock::now();
+    m_info.last_activity = Clock::now();
 }
 
 void Client::updateLatency(double latency_ms) {
@@ -300,7 +374,7 @@ std::string Client::getStatusString() const {
         ss << ", latency=" << std::fixed << std::setprecision(1) << m_info.avg_latency_ms << "ms";
         
         auto uptime = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - m_info.connect_time);
+            Clock::now() - m_info.connect_time);
         ss << ", uptime=" << uptime.count() << "s";
     }
     
@@ -340,8 +414,12 @@ bool Client::sendRawData(const void* data, size_t size) {
 #else
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
 #endif
-                // Would block, try again later
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                // Would block: sleep until the peer drains its receive buffer
+                if (!waitForSocket(true, static_cast<int>(m_config.timeout_seconds * 1000))) {
+                    Logger::error("Send to client {} timed out", m_info.client_id);
+                    setState(State::ERROR);
+                    return false;
+                }
                 continue;
             }
             
@@ -356,6 +434,28 @@ bool Client::sendRawData(const void* data, size_t size) {
     return true;
 }
 
+bool Client::waitForData(int timeout_ms) {
+    return waitForSocket(false, timeout_ms);
+}
+
+bool Client::waitForSocket(bool writable, int timeout_ms) {
+    if (m_socket == -1) {
+        return false;
+    }
+    
+#ifdef _WIN32
+    WSAPOLLFD pfd{m_socket, static_cast<SHORT>(writable ? POLLWRNORM : POLLRDNORM), 0};
+    return WSAPoll(&pfd, 1, timeout_ms) > 0;
+#else
+    pollfd pfd{m_socket, static_cast<short>(writable ? POLLOUT : POLLIN), 0};
+    int result;
+    do {
+        result = poll(&pfd, 1, timeout_ms);
+    } while (result < 0 && errno == EINTR);
+    return result > 0;
+#endif
+}
+
 bool Client::receiveRawData() {
     if (m_socket == -1) {
         return false;
@@ -422,6 +522,12 @@ bool Client::parseMessages() {
         
         // Check if we have the complete message
         size_t message_size = sizeof(MessageHeader) + header.data_size;
+        if (m_config.fixed_buffers && message_size > m_receive_buffer.capacity()) {
+            Logger::error("Message of {} bytes from client {} exceeds the fixed receive buffer",
+                          message_size, m_info.client_id);
+            setState(State::ERROR);
+            return false;
+        }
         if (m_receive_buffer.size() - m_receive_buffer_pos < message_size) {
             // Incomplete message, wait for more data
             break;
@@ -454,6 +560,16 @@ bool Client::parseMessages() {
 bool Client::ensureReceiveBufferSpace(size_t needed_space) {
     size_t available_space = m_receive_buffer.capacity() - m_receive_buffer.size();
     
+    if (m_config.fixed_buffers) {
+        // Never grow: read whatever fits and leave the rest in the socket, so
+        // TCP flow control holds the client back. A whole message always
+        // fits (parseMessages checks), so there is room once it is parsed.
+        if (available_space < needed_space) {
+            compactReceiveBuffer();
+        }
+        return m_receive_buffer.capacity() > m_receive_buffer.size();
+    }
+    
     if (available_space < needed_space) {
         // Try compacting first
         compactReceiveBuffer();
@@ -475,7 +591,8 @@ bool Client::ensureReceiveBufferSpace(size_t needed_space) {
 }
 
 bool Client::ensureSendBufferSpace(size_t needed_space) {
-    if (m_send_buffer.size() + needed_space > m_config.send_buffer_size * 2) {
+    size_t limit = m_config.fixed_buffers ? m_send_buffer.capacity() : m_config.send_buffer_size * 2;
+    if (m_send_buffer.size() + needed_space > limit) {
         Logger::error("Send buffer overflow for client {}", m_info.client_id);
         return false;
     }
@@ -487,6 +604,17 @@ bool Client::ensureSendBufferSpace(size_t needed_space) {
     return true;
 }
 
+void Client::prefaultBuffers() {
+    // Writing every byte once faults the pages in; clearing keeps the capacity
+    size_t receive_used = m_receive_buffer.size();
+    m_receive_buffer.resize(m_receive_buffer.capacity());
+    m_receive_buffer.resize(receive_used);
+    
+    size_t send_used = m_send_buffer.size();
+    m_send_buffer.resize(m_send_buffer.capacity());
+    m_send_buffer.resize(send_used);
+}
+
 void Client::compactReceiveBuffer() {
     if (m_receive_buffer_pos > 0) {
         size_t remaining_data = m_receive_buffer.size() - m_receive_buffer_pos;
@@ -1,10 +1,14 @@
 // KairosServer/src/Utils/Config.cpp
 #include <Utils/Config.hpp>
+#include <Utils/Platform.hpp>
+#include <Graphics/OutputViewport.hpp>
 #include <Constants.hpp>
+#include <nlohmann/json.hpp>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <stdexcept>
 
 namespace Kairos {
 
@@ -40,12 +44,16 @@ void Config::setDefaults() {
     m_renderer.msaa_samples = 4;
     m_renderer.fullscreen = false;
     m_renderer.hidden = false;
+    m_renderer.null_backend = false;
     m_renderer.window_title = Defaults::WINDOW_TITLE;
     m_renderer.max_batch_size = Defaults::BATCH_SIZE;
     m_renderer.vertex_buffer_size = 1024 * 1024;
     m_renderer.texture_atlas_size = 2048;
     m_renderer.max_layers = Defaults::LAYER_COUNT;
     m_renderer.layer_caching = true;
+    m_renderer.canvas_width = 0;
+    m_renderer.canvas_height = 0;
+    m_renderer.viewports.clear();
     
     // Performance defaults
     m_performance.max_frame_time_ms = 33;
@@ -55,6 +63,10 @@ void Config::setDefaults() {
     m_performance.enable_frame_pacing = true;
     m_performance.enable_adaptive_quality = true;
     m_performance.enable_statistics = true;
+    m_performance.virtual_clock = false;
+    m_performance.realtime_mode = false;
+    m_performance.realtime_heap_reserve_mb = 64;
+    m_performance.thread_policies.clear();
     m_performance.max_textures = 1000;
     m_performance.max_fonts = 100;
     m_performance.max_render_commands_per_frame = 10000;
@@ -69,6 +81,8 @@ void Config::setDefaults() {
     m_features.max_layers = Limits::MAX_LAYERS;
     m_features.layer_compositing = true;
     m_features.hardware_acceleration = true;
+    m_features.snapshot_file.clear();
+    m_features.snapshot_interval_ms = 5000;
     
     // Logging defaults
     m_logging.log_level = "info";
@@ -119,38 +133,225 @@ bool Config::saveToFile(const std::string& filename) const {
     }
 }
 
+namespace {
+
+// Sections are optional; one that is present has to be an object
+const nlohmann::json* findSection(const nlohmann::json& root, const char* name) {
+    auto it = root.find(name);
+    if (it == root.end()) {
+        return nullptr;
+    }
+    if (!it->is_object()) {
+        throw std::runtime_error(std::string("\"") + name + "\" must be an object");
+    }
+    return &*it;
+}
+
+// Keys missing from the section keep the value they had
+template<typename T>
+void readValue(const nlohmann::json& section, const char* key, T& value) {
+    auto it = section.find(key);
+    if (it != section.end()) {
+        value = it->get<T>();
+    }
+}
+
+} // anonymous namespace
+
 bool Config::loadFromJson(const std::string& json_content) {
-    // Simplified JSON parsing - in real implementation use nlohmann::json
-    // For now, just return true to indicate success
+    // Parse into copies so a bad file leaves the configuration untouched
+    NetworkConfig network = m_network;
+    RendererConfig renderer = m_renderer;
+    PerformanceConfig performance = m_performance;
+    FeaturesConfig features = m_features;
+    LoggingConfig logging = m_logging;
+    
+    try {
+        const nlohmann::json root = nlohmann::json::parse(json_content);
+        if (!root.is_object()) {
+            std::cerr << "Config file must contain a JSON object" << std::endl;
+            return false;
+        }
+        
+        if (const auto* section = findSection(root, "network")) {
+            readValue(*section, "tcp_bind_address", network.tcp_bind_address);
+            readValue(*section, "tcp_port", network.tcp_port);
+            readValue(*section, "enable_tcp", network.enable_tcp);
+            readValue(*section, "unix_socket_path", network.unix_socket_path);
+            readValue(*section, "enable_unix_socket", network.enable_unix_socket);
+            readValue(*section, "max_clients", network.max_clients);
+            readValue(*section, "max_connections_per_ip", network.max_connections_per_ip);
+            readValue(*section, "client_timeout_seconds", network.client_timeout_seconds);
+            readValue(*section, "handshake_timeout_seconds", network.handshake_timeout_seconds);
+            readValue(*section, "receive_buffer_size", network.receive_buffer_size);
+            readValue(*section, "send_buffer_size", network.send_buffer_size);
+            readValue(*section, "message_queue_size", network.message_queue_size);
+            readValue(*section, "enable_tcp_nodelay", network.enable_tcp_nodelay);
+            readValue(*section, "enable_keepalive", network.enable_keepalive);
+            readValue(*section, "enable_rate_limiting", network.enable_rate_limiting);
+            readValue(*section, "max_commands_per_second", network.max_commands_per_second);
+        }
+        
+        if (const auto* section = findSection(root, "renderer")) {
+            readValue(*section, "window_width", renderer.window_width);
+            readValue(*section, "window_height", renderer.window_height);
+            readValue(*section, "target_fps", renderer.target_fps);
+            readValue(*section, "enable_vsync", renderer.enable_vsync);
+            readValue(*section, "enable_antialiasing", renderer.enable_antialiasing);
+            readValue(*section, "msaa_samples", renderer.msaa_samples);
+            readValue(*section, "fullscreen", renderer.fullscreen);
+            readValue(*section, "hidden", renderer.hidden);
+            readValue(*section, "null_backend", renderer.null_backend);
+            readValue(*section, "window_title", renderer.window_title);
+            readValue(*section, "max_batch_size", renderer.max_batch_size);
+            readValue(*section, "vertex_buffer_size", renderer.vertex_buffer_size);
+            readValue(*section, "texture_atlas_size", renderer.texture_atlas_size);
+            readValue(*section, "max_layers", renderer.max_layers);
+            readValue(*section, "layer_caching", renderer.layer_caching);
+            readValue(*section, "canvas_width", renderer.canvas_width);
+            readValue(*section, "canvas_height", renderer.canvas_height);
+            readValue(*section, "viewports", renderer.viewports);
+        }
+        
+        if (const auto* section = findSection(root, "performance")) {
+            readValue(*section, "max_frame_time_ms", performance.max_frame_time_ms);
+            readValue(*section, "command_batch_size", performance.command_batch_size);
+            readValue(*section, "render_thread_count", performance.render_thread_count);
+            readValue(*section, "network_thread_count", performance.network_thread_count);
+            readValue(*section, "enable_frame_pacing", performance.enable_frame_pacing);
+            readValue(*section, "enable_adaptive_quality", performance.enable_adaptive_quality);
+            readValue(*section, "enable_statistics", performance.enable_statistics);
+            readValue(*section, "virtual_clock", performance.virtual_clock);
+            readValue(*section, "realtime_mode", performance.realtime_mode);
+            readValue(*section, "realtime_heap_reserve_mb", performance.realtime_heap_reserve_mb);
+            readValue(*section, "max_textures", performance.max_textures);
+            readValue(*section, "max_fonts", performance.max_fonts);
+            readValue(*section, "max_render_commands_per_frame", performance.max_render_commands_per_frame);
+            readValue(*section, "max_memory_usage_mb", performance.max_memory_usage_mb);
+            readValue(*section, "thread_policies", performance.thread_policies);
+        }
+        
+        if (const auto* section = findSection(root, "features")) {
+            readValue(*section, "enable_layers", features.enable_layers);
+            readValue(*section, "enable_batching", features.enable_batching);
+            readValue(*section, "enable_caching", features.enable_caching);
+            readValue(*section, "enable_profiling", features.enable_profiling);
+            readValue(*section, "enable_debug_overlay", features.enable_debug_overlay);
+            readValue(*section, "max_layers", features.max_layers);
+            readValue(*section, "layer_compositing", features.layer_compositing);
+            readValue(*section, "hardware_acceleration", features.hardware_acceleration);
+            readValue(*section, "snapshot_file", features.snapshot_file);
+            readValue(*section, "snapshot_interval_ms", features.snapshot_interval_ms);
+        }
+        
+        if (const auto* section = findSection(root, "logging")) {
+            readValue(*section, "log_level", logging.log_level);
+            readValue(*section, "log_file", logging.log_file);
+            readValue(*section, "log_to_console", logging.log_to_console);
+            readValue(*section, "log_to_file", logging.log_to_file);
+            readValue(*section, "log_performance_stats", logging.log_performance_stats);
+            readValue(*section, "max_log_file_size_mb", logging.max_log_file_size_mb);
+            readValue(*section, "max_backup_files", logging.max_backup_files);
+        }
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid config JSON: " << e.what() << std::endl;
+        return false;
+    }
+    
+    m_network = std::move(network);
+    m_renderer = std::move(renderer);
+    m_performance = std::move(performance);
+    m_features = std::move(features);
+    m_logging = std::move(logging);
     return true;
 }
 
 std::string Config::saveToJson() const {
-    // Simplified JSON generation - in real implementation use nlohmann::json
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"network\": {\n";
-    ss << "    \"tcp_bind_address\": \"" << m_network.tcp_bind_address << "\",\n";
-    ss << "    \"tcp_port\": " << m_network.tcp_port << ",\n";
-    ss << "    \"enable_tcp\": " << (m_network.enable_tcp ? "true" : "false") << ",\n";
-    ss << "    \"unix_socket_path\": \"" << m_network.unix_socket_path << "\",\n";
-    ss << "    \"enable_unix_socket\": " << (m_network.enable_unix_socket ? "true" : "false") << ",\n";
-    ss << "    \"max_clients\": " << m_network.max_clients << "\n";
-    ss << "  },\n";
-    ss << "  \"renderer\": {\n";
-    ss << "    \"window_width\": " << m_renderer.window_width << ",\n";
-    ss << "    \"window_height\": " << m_renderer.window_height << ",\n";
-    ss << "    \"target_fps\": " << m_renderer.target_fps << ",\n";
-    ss << "    \"enable_vsync\": " << (m_renderer.enable_vsync ? "true" : "false") << ",\n";
-    ss << "    \"fullscreen\": " << (m_renderer.fullscreen ? "true" : "false") << "\n";
-    ss << "  },\n";
-    ss << "  \"logging\": {\n";
-    ss << "    \"log_level\": \"" << m_logging.log_level << "\",\n";
-    ss << "    \"log_file\": \"" << m_logging.log_file << "\",\n";
-    ss << "    \"log_to_console\": " << (m_logging.log_to_console ? "true" : "false") << "\n";
-    ss << "  }\n";
-    ss << "}\n";
-    return ss.str();
+    nlohmann::json root;
+    
+    root["network"] = {
+        {"tcp_bind_address", m_network.tcp_bind_address},
+        {"tcp_port", m_network.tcp_port},
+        {"enable_tcp", m_network.enable_tcp},
+        {"unix_socket_path", m_network.unix_socket_path},
+        {"enable_unix_socket", m_network.enable_unix_socket},
+        {"max_clients", m_network.max_clients},
+        {"max_connections_per_ip", m_network.max_connections_per_ip},
+        {"client_timeout_seconds", m_network.client_timeout_seconds},
+        {"handshake_timeout_seconds", m_network.handshake_timeout_seconds},
+        {"receive_buffer_size", m_network.receive_buffer_size},
+        {"send_buffer_size", m_network.send_buffer_size},
+        {"message_queue_size", m_network.message_queue_size},
+        {"enable_tcp_nodelay", m_network.enable_tcp_nodelay},
+        {"enable_keepalive", m_network.enable_keepalive},
+        {"enable_rate_limiting", m_network.enable_rate_limiting},
+        {"max_commands_per_second", m_network.max_commands_per_second}
+    };
+    
+    root["renderer"] = {
+        {"window_width", m_renderer.window_width},
+        {"window_height", m_renderer.window_height},
+        {"target_fps", m_renderer.target_fps},
+        {"enable_vsync", m_renderer.enable_vsync},
+        {"enable_antialiasing", m_renderer.enable_antialiasing},
+        {"msaa_samples", m_renderer.msaa_samples},
+        {"fullscreen", m_renderer.fullscreen},
+        {"hidden", m_renderer.hidden},
+        {"null_backend", m_renderer.null_backend},
+        {"window_title", m_renderer.window_title},
+        {"max_batch_size", m_renderer.max_batch_size},
+        {"vertex_buffer_size", m_renderer.vertex_buffer_size},
+        {"texture_atlas_size", m_renderer.texture_atlas_size},
+        {"max_layers", m_renderer.max_layers},
+        {"layer_caching", m_renderer.layer_caching},
+        {"canvas_width", m_renderer.canvas_width},
+        {"canvas_height", m_renderer.canvas_height},
+        {"viewports", m_renderer.viewports}
+    };
+    
+    root["performance"] = {
+        {"max_frame_time_ms", m_performance.max_frame_time_ms},
+        {"command_batch_size", m_performance.command_batch_size},
+        {"render_thread_count", m_performance.render_thread_count},
+        {"network_thread_count", m_performance.network_thread_count},
+        {"enable_frame_pacing", m_performance.enable_frame_pacing},
+        {"enable_adaptive_quality", m_performance.enable_adaptive_quality},
+        {"enable_statistics", m_performance.enable_statistics},
+        {"virtual_clock", m_performance.virtual_clock},
+        {"realtime_mode", m_performance.realtime_mode},
+        {"realtime_heap_reserve_mb", m_performance.realtime_heap_reserve_mb},
+        {"max_textures", m_performance.max_textures},
+        {"max_fonts", m_performance.max_fonts},
+        {"max_render_commands_per_frame", m_performance.max_render_commands_per_frame},
+        {"max_memory_usage_mb", m_performance.max_memory_usage_mb},
+        {"thread_policies", m_performance.thread_policies}
+    };
+    
+    root["features"] = {
+        {"enable_layers", m_features.enable_layers},
+        {"enable_batching", m_features.enable_batching},
+        {"enable_caching", m_features.enable_caching},
+        {"enable_profiling", m_features.enable_profiling},
+        {"enable_debug_overlay", m_features.enable_debug_overlay},
+        {"max_layers", m_features.max_layers},
+        {"layer_compositing", m_features.layer_compositing},
+        {"hardware_acceleration", m_features.hardware_acceleration},
+        {"snapshot_file", m_features.snapshot_file},
+        {"snapshot_interval_ms", m_features.snapshot_interval_ms}
+    };
+    
+    root["logging"] = {
+        {"log_level", m_logging.log_level},
+        {"log_file", m_logging.log_file},
+        {"log_to_console", m_logging.log_to_console},
+        {"log_to_file", m_logging.log_to_file},
+        {"log_performance_stats", m_logging.log_performance_stats},
+        {"max_log_file_size_mb", m_logging.max_log_file_size_mb},
+        {"max_backup_files", m_logging.max_backup_files}
+    };
+    
+    return root.dump(2) + "\n";
 }
 
 bool Config::parseCommandLine(int argc, char* argv[]) {
@@ -195,6 +396,16 @@ bool Config::parseCommandLineArg(const std::string& arg, const std::string& valu
         m_renderer.window_height = static_cast<uint32_t>(std::stoi(value));
         return true;
     }
+    else if (arg == "--canvas") {
+        size_t x = value.find('x');
+        m_renderer.canvas_width = static_cast<uint32_t>(std::stoi(value.substr(0, x)));
+        m_renderer.canvas_height = x == std::string::npos ? 0 : static_cast<uint32_t>(std::stoi(value.substr(x + 1)));
+        return true;
+    }
+    else if (arg == "--viewport") {
+        m_renderer.viewports.push_back(value);
+        return true;
+    }
     else if (arg == "--fps") {
         m_renderer.target_fps = static_cast<uint32_t>(std::stoi(value));
         return true;
@@ -207,6 +418,24 @@ bool Config::parseCommandLineArg(const std::string& arg, const std::string& valu
         m_logging.log_file = value;
         return true;
     }
+    else if (arg == "--realtime-heap") {
+        m_performance.realtime_heap_reserve_mb = static_cast<size_t>(std::stoul(value));
+        return true;
+    }
+    else if (arg == "--thread-policy") {
+        size_t equals = value.find('=');
+        m_performance.thread_policies[value.substr(0, equals)] =
+            equals == std::string::npos ? "" : value.substr(equals + 1);
+        return true;
+    }
+    else if (arg == "--snapshot") {
+        m_features.snapshot_file = value;
+        return true;
+    }
+    else if (arg == "--snapshot-interval") {
+        m_features.snapshot_interval_ms = static_cast<uint32_t>(std::stoi(value));
+        return true;
+    }
     // Boolean flags (no value)
     else if (arg == "--no-tcp") {
         m_network.enable_tcp = false;
@@ -224,10 +453,22 @@ bool Config::parseCommandLineArg(const std::string& arg, const std::string& valu
         m_renderer.hidden = true;
         return false;
     }
+    else if (arg == "--null-renderer") {
+        m_renderer.null_backend = true;
+        return false;
+    }
     else if (arg == "--no-vsync") {
         m_renderer.enable_vsync = false;
         return false;
     }
+    else if (arg == "--virtual-clock") {
+        m_performance.virtual_clock = true;
+        return false;
+    }
+    else if (arg == "--realtime") {
+        m_performance.realtime_mode = true;
+        return false;
+    }
     else if (arg == "--debug") {
         m_logging.log_level = "debug";
         m_features.enable_debug_overlay = true;
@@ -253,7 +494,24 @@ void Config::printUsage(const char* program_name) const {
     std::cout << "  --fps <rate>         Target FPS (default: " << Defaults::TARGET_FPS << ")\n";
     std::cout << "  --fullscreen         Start fullscreen\n";
     std::cout << "  --hidden             Start hidden\n";
-    std::cout << "  --no-vsync           Disable VSync\n\n";
+    std::cout << "  --null-renderer      Run without a window or GL context\n";
+    std::cout << "  --no-vsync           Disable VSync\n";
+    std::cout << "  --canvas <w>x<h>     Virtual canvas size clients draw into (default: window size)\n";
+    std::cout << "  --viewport <canvas x,y,w,h>@<window x,y,w,h>[:layers=<list>]\n";
+    std::cout << "                       Show part of the canvas in part of the window (repeatable)\n\n";
+    
+    std::cout << "Threading Options:\n";
+    std::cout << "  --thread-policy <role>=<cpus>[:nice=<n>|:fifo=<n>]\n";
+    std::cout << "                       Pin a thread role (render|commands|accept|network) and set its scheduling\n";
+    std::cout << "  --realtime           Lock and prefault memory; buffers and pools never grow\n";
+    std::cout << "  --realtime-heap <MB> Heap prefaulted in real-time mode (default: 64)\n\n";
+    
+    std::cout << "Persistence Options:\n";
+    std::cout << "  --snapshot <path>    Snapshot the scene to this file and restore it on startup\n";
+    std::cout << "  --snapshot-interval <ms>  Time between snapshots (default: 5000)\n\n";
+    
+    std::cout << "Testing Options:\n";
+    std::cout << "  --virtual-clock      Deterministic time: frames run back to back, pacing steps the clock\n\n";
     
     std::cout << "Logging Options:\n";
     std::cout << "  --log-level <level>  Log level (debug|info|warning|error)\n";
@@ -292,6 +550,18 @@ std::vector<std::string> Config::getValidationErrors() const {
         errors.push_back("Window size must be at least 320x240");
     }
     
+    if ((m_renderer.canvas_width == 0) != (m_renderer.canvas_height == 0)) {
+        errors.push_back("Canvas size needs both a width and a height");
+    }
+    
+    for (const auto& spec : m_renderer.viewports) {
+        OutputViewport viewport;
+        std::string error;
+        if (!parseOutputViewport(spec, viewport, error)) {
+            errors.push_back("Invalid viewport: " + error);
+        }
+    }
+    
     if (m_renderer.target_fps < Limits::MIN_FPS || m_renderer.target_fps > Limits::MAX_FPS) {
         errors.push_back("Target FPS must be between " + std::to_string(Limits::MIN_FPS) + 
                         " and " + std::to_string(Limits::MAX_FPS));
@@ -302,6 +572,23 @@ std::vector<std::string> Config::getValidationErrors() const {
         errors.push_back("Memory limit exceeds maximum of " + std::to_string(Limits::MAX_MEMORY_LIMIT_MB) + "MB");
     }
     
+    if (m_performance.realtime_mode && m_performance.realtime_heap_reserve_mb > m_performance.max_memory_usage_mb) {
+        errors.push_back("Real-time heap reserve exceeds the memory limit of " +
+                         std::to_string(m_performance.max_memory_usage_mb) + "MB");
+    }
+    
+    for (const auto& [role, spec] : m_performance.thread_policies) {
+        if (role != "render" && role != "commands" && role != "accept" && role != "network") {
+            errors.push_back("Unknown thread role: " + role);
+            continue;
+        }
+        Platform::ThreadPolicy policy;
+        std::string error;
+        if (!Platform::parseThreadPolicy(spec, policy, error)) {
+            errors.push_back("Invalid thread policy for " + role + ": " + error);
+        }
+    }
+    
     // Logging validation
     std::vector<std::string> valid_levels = {"debug", "info", "warning", "error"};
     if (std::find(valid_levels.begin(), valid_levels.end(), m_logging.log_level) == valid_levels.end()) {
@@ -399,6 +686,14 @@ ConfigBuilder::ConfigBuilder() {
     m_config.setDefaults();
 }
 
+ConfigBuilder::ConfigBuilder(const Config& base)
+    : m_config(base) {
+}
+
+bool ConfigBuilder::loadFromFile(const std::string& filename) {
+    return m_config.loadFromFile(filename);
+}
+
 ConfigBuilder& ConfigBuilder::withTcpPort(uint16_t port) {
     m_config.m_network.tcp_port = port;
     return *this;
@@ -465,6 +760,11 @@ ConfigBuilder& ConfigBuilder::enableHiddenWindow(bool enabled) {
     return *this;
 }
 
+ConfigBuilder& ConfigBuilder::enableNullRenderer(bool enabled) {
+    m_config.m_renderer.null_backend = enabled;
+    return *this;
+}
+
 ConfigBuilder& ConfigBuilder::withMaxLayers(uint32_t max_layers) {
     m_config.m_features.max_layers = max_layers;
     return *this;
@@ -490,6 +790,37 @@ ConfigBuilder& ConfigBuilder::enableBatching(bool enabled) {
     return *this;
 }
 
+ConfigBuilder& ConfigBuilder::enableVirtualClock(bool enabled) {
+    m_config.m_performance.virtual_clock = enabled;
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::withCanvasSize(uint32_t width, uint32_t height) {
+    m_config.m_renderer.canvas_width = width;
+    m_config.m_renderer.canvas_height = height;
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::withViewport(const std::string& spec) {
+    m_config.m_renderer.viewports.push_back(spec);
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::enableRealtimeMode(bool enabled) {
+    m_config.m_performance.realtime_mode = enabled;
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::withRealtimeHeapReserve(size_t reserve_mb) {
+    m_config.m_performance.realtime_heap_reserve_mb = reserve_mb;
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::withThreadPolicy(const std::string& role, const std::string& policy) {
+    m_config.m_performance.thread_policies[role] = policy;
+    return *this;
+}
+
 ConfigBuilder& ConfigBuilder::enableProfiling(bool enabled) {
     m_config.m_features.enable_profiling = enabled;
     return *this;
@@ -500,6 +831,16 @@ ConfigBuilder& ConfigBuilder::enableDebugOverlay(bool enabled) {
     return *this;
 }
 
+ConfigBuilder& ConfigBuilder::withSceneSnapshot(const std::string& path) {
+    m_config.m_features.snapshot_file = path;
+    return *this;
+}
+
+ConfigBuilder& ConfigBuilder::withSnapshotInterval(uint32_t interval_ms) {
+    m_config.m_features.snapshot_interval_ms = interval_ms;
+    return *this;
+}
+
 ConfigBuilder& ConfigBuilder::enableStatistics(bool enabled) {
     m_config.m_performance.enable_statistics = enabled;
     return *this;
@@ -0,0 +1,128 @@
+// KairosServer/src/Utils/ConfigWatcher.cpp
+#include <Utils/ConfigWatcher.hpp>
+#include <Utils/Logger.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace Kairos {
+
+namespace {
+    // Editors often produce several events per save; collapse them into one reload
+    constexpr auto DEBOUNCE_INTERVAL = std::chrono::milliseconds(200);
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+bool ConfigWatcher::start(const std::string& path, ChangeCallback callback) {
+    if (m_running) {
+        Logger::warning("Config watcher already running for {}", m_path);
+        return false;
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        Logger::error("Cannot watch missing config file: {}", path);
+        return false;
+    }
+
+    m_path = std::filesystem::absolute(path, ec).string();
+    m_callback = std::move(callback);
+
+#ifdef __linux__
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd < 0) {
+        Logger::error("inotify_init1 failed: {}", strerror(errno));
+        return false;
+    }
+
+    std::string directory = std::filesystem::path(m_path).parent_path().string();
+    if (inotify_add_watch(m_inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        Logger::error("Cannot watch {}: {}", directory, strerror(errno));
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+        return false;
+    }
+#endif
+
+    m_running = true;
+    m_thread = std::thread(&ConfigWatcher::watchLoop, this);
+
+    Logger::info("Watching config file {}", m_path);
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    m_running = false;
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+#ifdef __linux__
+    if (m_inotify_fd >= 0) {
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+    }
+#endif
+}
+
+void ConfigWatcher::watchLoop() {
+    using clock = std::chrono::steady_clock;
+
+    std::string file_name = std::filesystem::path(m_path).filename().string();
+    bool pending = false;
+    clock::time_point last_event;
+
+#ifndef __linux__
+    std::error_code ec;
+    auto last_write = std::filesystem::last_write_time(m_path, ec);
+#endif
+
+    while (m_running) {
+#ifdef __linux__
+        pollfd pfd{m_inotify_fd, POLLIN, 0};
+        if (poll(&pfd, 1, 100) > 0) {
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(m_inotify_fd, buffer, sizeof(buffer))) > 0) {
+                for (char* ptr = buffer; ptr < buffer + length; ) {
+                    auto* event = reinterpret_cast<inotify_event*>(ptr);
+                    if (event->len > 0 && file_name == event->name) {
+                        pending = true;
+                        last_event = clock::now();
+                    }
+                    ptr += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+#else
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        auto write_time = std::filesystem::last_write_time(m_path, ec);
+        if (!ec && write_time != last_write) {
+            last_write = write_time;
+            pending = true;
+            last_event = clock::now();
+        }
+#endif
+
+        if (pending && clock::now() - last_event >= DEBOUNCE_INTERVAL) {
+            pending = false;
+            Logger::info("Config file changed: {}", m_path);
+            if (m_callback) {
+                m_callback(m_path);
+            }
+        }
+    }
+}
+
+} // namespace Kairos
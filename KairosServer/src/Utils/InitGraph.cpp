@@ -0,0 +1,178 @@
+// KairosServer/src/Utils/InitGraph.cpp
+#include <Utils/InitGraph.hpp>
+#include <Utils/Logger.hpp>
+
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace Kairos {
+
+void InitGraph::addStep(const std::string& name, std::vector<std::string> dependencies,
+                        Affinity affinity, Step step) {
+    m_nodes.push_back(Node{name, std::move(dependencies), affinity, std::move(step)});
+}
+
+bool InitGraph::runStep(const Node& node) {
+    try {
+        return node.step();
+    } catch (const std::exception& e) {
+        Logger::error("Exception in startup step {}: {}", node.name, e.what());
+        return false;
+    }
+}
+
+bool InitGraph::run() {
+    enum class State { Pending, Running, Done, Failed };
+
+    const size_t count = m_nodes.size();
+    std::vector<std::vector<size_t>> dependencies(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (const auto& dependency : m_nodes[i].dependencies) {
+            size_t index = 0;
+            while (index < count && m_nodes[index].name != dependency) {
+                ++index;
+            }
+            if (index == count) {
+                Logger::error("Startup step {} depends on unknown step {}", m_nodes[i].name, dependency);
+                return false;
+            }
+            dependencies[i].push_back(index);
+        }
+    }
+
+    m_results.assign(count, StepResult{});
+    for (size_t i = 0; i < count; ++i) {
+        m_results[i].name = m_nodes[i].name;
+        m_results[i].affinity = m_nodes[i].affinity;
+    }
+
+    // Real time on purpose: startup latency is measured, not scheduled
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = [start]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    };
+
+    std::vector<State> states(count, State::Pending);
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool ok = true;
+
+    auto complete = [&](size_t i, bool succeeded) {
+        states[i] = succeeded ? State::Done : State::Failed;
+        m_results[i].succeeded = succeeded;
+        m_results[i].finished_at = elapsed();
+        if (!succeeded) {
+            ok = false;
+        }
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        bool progressed = false;
+        size_t running = 0;
+        size_t pending = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (states[i] == State::Running) {
+                ++running;
+            }
+            if (states[i] != State::Pending) {
+                continue;
+            }
+
+            bool blocked = false;
+            bool dependency_failed = false;
+            for (size_t dependency : dependencies[i]) {
+                dependency_failed |= states[dependency] == State::Failed;
+                blocked |= states[dependency] != State::Done;
+            }
+
+            if (dependency_failed) {
+                states[i] = State::Failed;
+                m_results[i].skipped = true;
+                progressed = true;
+                continue;
+            }
+            if (blocked) {
+                ++pending;
+                continue;
+            }
+
+            states[i] = State::Running;
+            m_results[i].started_at = elapsed();
+            progressed = true;
+
+            if (m_nodes[i].affinity == Affinity::Background) {
+                ++running;
+                workers.emplace_back([&, i]() {
+                    bool succeeded = runStep(m_nodes[i]);
+                    std::lock_guard<std::mutex> worker_lock(mutex);
+                    complete(i, succeeded);
+                    finished.notify_all();
+                });
+            } else {
+                lock.unlock();
+                bool succeeded = runStep(m_nodes[i]);
+                lock.lock();
+                complete(i, succeeded);
+            }
+        }
+
+        if (pending == 0 && running == 0 && !progressed) {
+            break;
+        }
+
+        if (!progressed) {
+            if (running == 0) {
+                Logger::error("Startup steps have a dependency cycle; {} steps not run", pending);
+                for (size_t i = 0; i < count; ++i) {
+                    if (states[i] == State::Pending) {
+                        states[i] = State::Failed;
+                        m_results[i].skipped = true;
+                    }
+                }
+                ok = false;
+                break;
+            }
+            finished.wait(lock);
+        }
+    }
+    lock.unlock();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return ok;
+}
+
+const InitGraph::StepResult* InitGraph::getResult(const std::string& name) const {
+    for (const auto& result : m_results) {
+        if (result.name == name) {
+            return &result;
+        }
+    }
+    return nullptr;
+}
+
+std::string InitGraph::getTimingReport() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    for (const auto& result : m_results) {
+        ss << "  " << std::left << std::setw(12) << result.name
+           << (result.affinity == Affinity::Background ? " [background] " : " [main]       ");
+        if (result.skipped) {
+            ss << "skipped\n";
+            continue;
+        }
+        ss << result.started_at.count() / 1000.0 << " -> " << result.finished_at.count() / 1000.0 << " ms"
+           << (result.succeeded ? "" : " (failed)") << "\n";
+    }
+    return ss.str();
+}
+
+} // namespace Kairos
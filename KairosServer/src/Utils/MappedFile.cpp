@@ -0,0 +1,126 @@
+// KairosServer/src/Utils/MappedFile.cpp
+#include <Utils/MappedFile.hpp>
+#include <Utils/Logger.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Kairos {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        Logger::error("Failed to map {}: {}", path, strerror(errno));
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = static_cast<size_t>(info.st_size);
+    m_mapped = true;
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file || file.tellg() <= 0) {
+        return false;
+    }
+
+    m_buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size())) {
+        m_buffer.clear();
+        return false;
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (m_mapped) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_buffer.clear();
+}
+
+bool MappedFile::writeAtomically(const std::string& path, const void* data, size_t size) {
+    const std::string temp_path = path + ".tmp";
+
+#ifndef _WIN32
+    int fd = ::open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        Logger::error("Failed to create {}: {}", temp_path, strerror(errno));
+        return false;
+    }
+
+    bool ok = size == 0 || ftruncate(fd, static_cast<off_t>(size)) == 0;
+    if (ok && size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ok = mapping != MAP_FAILED;
+        if (ok) {
+            std::memcpy(mapping, data, size);
+            ok = msync(mapping, size, MS_SYNC) == 0;
+            munmap(mapping, size);
+        }
+    }
+    ::close(fd);
+
+    if (!ok) {
+        Logger::error("Failed to write {}: {}", temp_path, strerror(errno));
+        unlink(temp_path.c_str());
+        return false;
+    }
+#else
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size))) {
+            Logger::error("Failed to write {}", temp_path);
+            return false;
+        }
+    }
+#endif
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        Logger::error("Failed to replace {}: {}", path, ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Kairos
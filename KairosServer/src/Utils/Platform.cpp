@@ -1,15 +1,27 @@
 // KairosServer/src/Utils/Platform.cpp
 #include <Utils/Platform.hpp>
+#include <Utils/Logger.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
 
 #ifdef _WIN32
     #include <windows.h>
     #include <psapi.h>
 #else
     #include <unistd.h>
+    #include <alloca.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/resource.h>
     #include <sys/stat.h>
     #include <sys/utsname.h>
     #if defined(__linux__)
+        #include <malloc.h>
         #include <sys/sysinfo.h>
+        #include <sys/syscall.h>
     #elif defined(__APPLE__)
         #include <sys/types.h>
         #include <sys/sysctl.h>
@@ -90,14 +102,6 @@ bool isDebuggerPresent() {
 #endif
 }
 
-void setThreadPriority(int priority) {
-#ifdef _WIN32
-    SetThreadPriority(GetCurrentThread(), priority);
-#else
-    // Unix thread priority setting would go here
-    (void)priority; // Suppress unused parameter warning
-#endif
-}
 
 std::string getExecutablePath() {
 #ifdef _WIN32
@@ -124,6 +128,265 @@ std::string getExecutablePath() {
 #endif
 }
 
+namespace {
+
+bool parseNumber(const std::string& text, int& value) {
+    try {
+        size_t used = 0;
+        value = std::stoi(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // anonymous namespace
+
+bool parseThreadPolicy(const std::string& spec, ThreadPolicy& policy, std::string& error) {
+    policy = ThreadPolicy{};
+    
+    size_t colon = spec.find(':');
+    std::string cpus = spec.substr(0, colon);
+    std::string scheduling = colon == std::string::npos ? "" : spec.substr(colon + 1);
+    
+    std::stringstream list(cpus);
+    std::string range;
+    while (std::getline(list, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = 0;
+        int last = 0;
+        if (!parseNumber(range.substr(0, dash), first) ||
+            !parseNumber(dash == std::string::npos ? range : range.substr(dash + 1), last) ||
+            first < 0 || last < first) {
+            error = "invalid CPU range '" + range + "'";
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            policy.cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+    }
+    
+    if (scheduling.empty()) {
+        return true;
+    }
+    
+    size_t equals = scheduling.find('=');
+    std::string kind = scheduling.substr(0, equals);
+    if (equals == std::string::npos || !parseNumber(scheduling.substr(equals + 1), policy.priority)) {
+        error = "scheduling must be nice=<n> or fifo=<n>, got '" + scheduling + "'";
+        return false;
+    }
+    
+    if (kind == "nice") {
+        if (policy.priority < -20 || policy.priority > 19) {
+            error = "nice value must be between -20 and 19";
+            return false;
+        }
+    } else if (kind == "fifo") {
+        if (policy.priority < 1 || policy.priority > 99) {
+            error = "FIFO priority must be between 1 and 99";
+            return false;
+        }
+        policy.realtime = true;
+    } else {
+        error = "unknown scheduling policy '" + kind + "'";
+        return false;
+    }
+    
+    policy.has_priority = true;
+    return true;
+}
+
+std::string formatThreadPolicy(const ThreadPolicy& policy) {
+    std::stringstream ss;
+    if (policy.cpus.empty()) {
+        ss << "any CPU";
+    } else {
+        ss << "CPUs ";
+        for (size_t i = 0; i < policy.cpus.size(); ++i) {
+            ss << (i > 0 ? "," : "") << policy.cpus[i];
+        }
+    }
+    if (policy.has_priority) {
+        ss << (policy.realtime ? ", SCHED_FIFO " : ", nice ") << policy.priority;
+    }
+    return ss.str();
+}
+
+bool setThreadName(const std::string& name) {
+#if defined(__linux__)
+    // The kernel limit is 16 bytes including the terminator
+    int result = pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+    int result = pthread_setname_np(name.substr(0, 15).c_str());
+#else
+    int result = 0;
+    (void)name;
+#endif
+    if (result != 0) {
+        Logger::warning("Could not name thread {}: {}", name, std::strerror(result));
+        return false;
+    }
+    return true;
+}
+
+bool setThreadAffinity(const std::vector<uint32_t>& cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+    
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : cpus) {
+        if (cpu >= CPU_SETSIZE) {
+            Logger::error("CPU {} is out of range", cpu);
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        // EINVAL: none of the CPUs is online or allowed by the cgroup/cpuset
+        Logger::error("Could not pin thread to CPUs: {}", std::strerror(result));
+        return false;
+    }
+    return true;
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (uint32_t cpu : cpus) {
+        if (cpu >= sizeof(DWORD_PTR) * 8) {
+            Logger::error("CPU {} is out of range", cpu);
+            return false;
+        }
+        mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        Logger::error("Could not pin thread to CPUs: error {}", GetLastError());
+        return false;
+    }
+    return true;
+#else
+    Logger::warning("Thread CPU affinity is not supported on {}", getPlatformName());
+    return false;
+#endif
+}
+
+bool setThreadPriority(int priority) {
+#ifdef _WIN32
+    if (!SetThreadPriority(GetCurrentThread(), priority)) {
+        Logger::error("Could not set thread priority {}: error {}", priority, GetLastError());
+        return false;
+    }
+    return true;
+#else
+    // A FIFO thread asking for a nice value goes back to time sharing first
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    
+#if defined(__linux__)
+    // Linux applies PRIO_PROCESS to a single thread when given its TID
+    id_t target = static_cast<id_t>(syscall(SYS_gettid));
+#else
+    id_t target = 0;
+#endif
+    if (setpriority(PRIO_PROCESS, target, priority) != 0) {
+        int error = errno;
+        Logger::error("Could not set nice {}: {}{}", priority, std::strerror(error),
+                      error == EACCES || error == EPERM ? " (raising priority needs CAP_SYS_NICE or RLIMIT_NICE)" : "");
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool setThreadRealtime(int priority) {
+#ifdef _WIN32
+    return setThreadPriority(THREAD_PRIORITY_TIME_CRITICAL);
+#else
+    sched_param param{};
+    param.sched_priority = priority;
+    int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (result != 0) {
+        Logger::error("Could not set SCHED_FIFO priority {}: {}{}", priority, std::strerror(result),
+                      result == EPERM ? " (needs CAP_SYS_NICE or RLIMIT_RTPRIO)" : "");
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool applyThreadPolicy(const std::string& role, const ThreadPolicy& policy) {
+    if (policy.stack_prefault_bytes > 0) {
+        prefaultStack(policy.stack_prefault_bytes);
+    }
+    
+    if (policy.cpus.empty() && !policy.has_priority) {
+        return true;
+    }
+    
+    bool ok = setThreadAffinity(policy.cpus);
+    if (policy.has_priority) {
+        ok &= policy.realtime ? setThreadRealtime(policy.priority) : setThreadPriority(policy.priority);
+    }
+    
+    if (ok) {
+        Logger::info("{} thread: {}", role, formatThreadPolicy(policy));
+    } else {
+        Logger::error("{} thread runs without its requested policy ({})", role, formatThreadPolicy(policy));
+    }
+    return ok;
+}
+
+bool lockMemory() {
+#if defined(__linux__)
+    // Freed memory stays in the (locked) heap instead of going back to the
+    // kernel, and large blocks come from the heap rather than fresh mmaps.
+    // These only tune the main arena, so threads started from here on share
+    // it rather than getting arenas of their own that trim and fault; call
+    // this before starting threads.
+    mallopt(M_ARENA_MAX, 1);
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+#ifdef _WIN32
+    Logger::warning("Memory locking is not supported on {}", getPlatformName());
+    return false;
+#else
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        int error = errno;
+        Logger::error("Could not lock memory: {}{}", std::strerror(error),
+                      error == ENOMEM || error == EPERM ? " (raise RLIMIT_MEMLOCK or grant CAP_IPC_LOCK)" : "");
+        return false;
+    }
+    return true;
+#endif
+}
+
+void prefaultHeap(size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    std::vector<uint8_t> block(bytes);      // Value-initialized: every page is written
+    volatile uint8_t sink = block[bytes - 1];
+    (void)sink;
+}
+
+void prefaultStack(size_t bytes) {
+#ifdef _WIN32
+    (void)bytes;    // Windows commits stack pages through guard pages; nothing to gain
+#else
+    auto* stack = static_cast<volatile uint8_t*>(alloca(bytes));
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t offset = 0; offset < bytes; offset += page) {
+        stack[offset] = 0;
+    }
+#endif
+}
+
 } // namespace Platform
 
 } // namespace Kairos
\ No newline at end of file
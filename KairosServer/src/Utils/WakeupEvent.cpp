@@ -0,0 +1,110 @@
+// KairosServer/src/Utils/WakeupEvent.cpp
+#include <Utils/WakeupEvent.hpp>
+#include <Utils/Logger.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/eventfd.h>
+    #endif
+#endif
+
+namespace Kairos {
+
+WakeupEvent::WakeupEvent() {
+#if defined(__linux__)
+    m_read_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_write_fd = m_read_fd;
+    if (m_read_fd == -1) {
+        Logger::error("Failed to create eventfd: {}", std::strerror(errno));
+    }
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        m_read_fd = fds[0];
+        m_write_fd = fds[1];
+    } else {
+        Logger::error("Failed to create wakeup pipe: {}", std::strerror(errno));
+    }
+#endif
+}
+
+WakeupEvent::~WakeupEvent() {
+#ifndef _WIN32
+    if (m_read_fd != -1) {
+        close(m_read_fd);
+    }
+    if (m_write_fd != -1 && m_write_fd != m_read_fd) {
+        close(m_write_fd);
+    }
+#endif
+}
+
+void WakeupEvent::notify() {
+#ifndef _WIN32
+    if (m_write_fd != -1) {
+        // A full counter/pipe already means "notified", so EAGAIN is fine
+        uint64_t one = 1;
+        ssize_t written = write(m_write_fd, &one, m_write_fd == m_read_fd ? sizeof(one) : 1);
+        (void)written;
+        return;
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signaled = true;
+    }
+    m_condition.notify_all();
+}
+
+bool WakeupEvent::wait(int timeout_ms) {
+#ifndef _WIN32
+    if (m_read_fd != -1) {
+        pollfd pfd{m_read_fd, POLLIN, 0};
+        int result = poll(&pfd, 1, timeout_ms);
+        if (result > 0) {
+            drain();
+            return true;
+        }
+        return false;
+    }
+#endif
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (timeout_ms < 0) {
+        m_condition.wait(lock, [this]() { return m_signaled; });
+    } else {
+        m_condition.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() { return m_signaled; });
+    }
+    bool signaled = m_signaled;
+    m_signaled = false;
+    return signaled;
+}
+
+void WakeupEvent::drain() {
+#ifndef _WIN32
+    if (m_read_fd != -1) {
+        uint8_t buffer[64];
+        while (read(m_read_fd, buffer, m_read_fd == m_write_fd ? sizeof(uint64_t) : sizeof(buffer)) > 0) {
+            if (m_read_fd == m_write_fd) {
+                break;  // An eventfd read resets the counter in one go
+            }
+        }
+        return;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_signaled = false;
+}
+
+} // namespace Kairos
@@ -52,14 +52,22 @@ void printUsage(const char* program_name) {
     std::cout << "  --fullscreen             Start in fullscreen mode\n";
     std::cout << "  --hidden                 Start with hidden window\n";
     std::cout << "  --no-vsync              Disable VSync\n";
-    std::cout << "  --no-antialiasing       Disable antialiasing\n\n";
+    std::cout << "  --no-antialiasing       Disable antialiasing\n";
+    std::cout << "  --canvas <w>x<h>         Virtual canvas size clients draw into (default: window size)\n";
+    std::cout << "  --viewport <canvas x,y,w,h>@<window x,y,w,h>[:layers=<list>]\n";
+    std::cout << "                           Show part of the canvas in part of the window (repeatable)\n\n";
     
     std::cout << "Performance Options:\n";
     std::cout << "  --max-layers <count>     Maximum layers (default: 255)\n";
     std::cout << "  --batch-size <size>      Command batch size (default: 1000)\n";
     std::cout << "  --no-caching            Disable layer caching\n";
     std::cout << "  --no-batching           Disable command batching\n";
-    std::cout << "  --memory-limit <MB>      Memory limit in MB (default: 512)\n\n";
+    std::cout << "  --memory-limit <MB>      Memory limit in MB (default: 512)\n";
+    std::cout << "  --thread-policy <role>=<cpus>[:nice=<n>|:fifo=<n>]\n";
+    std::cout << "                           Pin render|commands|accept|network threads and set their\n";
+    std::cout << "                           scheduling, e.g. render=3:fifo=80 (repeatable)\n";
+    std::cout << "  --realtime               Lock and prefault memory; buffers and pools never grow\n";
+    std::cout << "  --realtime-heap <MB>     Heap prefaulted in real-time mode (default: 64)\n\n";
     
     std::cout << "Debugging Options:\n";
     std::cout << "  --debug                  Enable debug mode\n";
@@ -69,8 +77,13 @@ void printUsage(const char* program_name) {
     std::cout << "  --profile               Enable performance profiling\n";
     std::cout << "  --debug-overlay         Show debug overlay\n\n";
     
+    std::cout << "Persistence Options:\n";
+    std::cout << "  --snapshot <path>        Snapshot the scene to this file and restore it on startup\n";
+    std::cout << "  --snapshot-interval <ms> Time between snapshots (default: 5000)\n\n";
+    
     std::cout << "Configuration Options:\n";
-    std::cout << "  --config <file>          Load configuration from file\n";
+    std::cout << "  --config <file>          Load configuration from file (other options override it)\n";
+    std::cout << "  --watch-config           Reload the config file when it changes (SIGHUP also reloads)\n";
     std::cout << "  --save-config <file>     Save current config to file\n\n";
     
     std::cout << "System Options:\n";
@@ -79,6 +92,10 @@ void printUsage(const char* program_name) {
     std::cout << "  --help                   Show this help message\n";
     std::cout << "  --version                Show version information\n\n";
     
+    std::cout << "Signals (Linux/macOS):\n";
+    std::cout << "  SIGHUP                   Reload the config file\n";
+    std::cout << "  SIGUSR2                  Hot upgrade: re-exec this binary, handing over clients and scene\n\n";
+    
     std::cout << "Examples:\n";
     std::cout << "  " << program_name << " --port 8080 --width 1920 --height 1080\n";
     std::cout << "  " << program_name << " --unix-socket /tmp/kairos.sock --no-tcp\n";
@@ -116,12 +133,26 @@ void signalHandler(int signal) {
         case SIGTERM: signal_name = "SIGTERM"; break;
 #ifndef _WIN32
         case SIGHUP: signal_name = "SIGHUP"; break;
+        case SIGUSR2: signal_name = "SIGUSR2"; break;
         case SIGPIPE: signal_name = "SIGPIPE"; break;
 #endif
     }
     
     std::cout << "\nReceived signal " << signal << " (" << signal_name << ")" << std::endl;
     
+#ifndef _WIN32
+    // Until the server installs its own handlers, a reload or upgrade waits
+    // for the first frame rather than stopping the server
+    if (g_server && signal == SIGHUP) {
+        g_server->requestConfigReload();
+        return;
+    }
+    if (g_server && signal == SIGUSR2) {
+        g_server->requestHotUpgrade();
+        return;
+    }
+#endif
+    
     if (g_server && g_server->isRunning()) {
         std::cout << "Shutting down server gracefully..." << std::endl;
         g_server->requestShutdown("Signal received");
@@ -137,23 +168,18 @@ void setupSignalHandlers() {
     
 #ifndef _WIN32
     std::signal(SIGHUP, signalHandler);
+    std::signal(SIGUSR2, signalHandler);
     std::signal(SIGPIPE, SIG_IGN);  // Ignore broken pipe
 #endif
 }
 
-bool parseCommandLine(int argc, char* argv[], ConfigBuilder& builder) {
+// Applies the options that set configuration values over the builder's
+// config; config file reloads apply them again so they keep overriding it
+bool applyConfigOptions(int argc, char* argv[], ConfigBuilder& builder) {
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         
-        if (arg == "--help" || arg == "-h") {
-            printUsage(argv[0]);
-            return false;
-        }
-        else if (arg == "--version" || arg == "-v") {
-            printVersion();
-            return false;
-        }
-        else if (arg == "--port" && i + 1 < argc) {
+        if (arg == "--port" && i + 1 < argc) {
             builder.withTcpPort(static_cast<uint16_t>(std::stoi(argv[++i])));
         }
         else if (arg == "--bind" && i + 1 < argc) {
@@ -194,6 +220,15 @@ bool parseCommandLine(int argc, char* argv[], ConfigBuilder& builder) {
         else if (arg == "--no-antialiasing") {
             builder.enableAntialiasing(false);
         }
+        else if (arg == "--canvas" && i + 1 < argc) {
+            std::string value = argv[++i];
+            size_t x = value.find('x');
+            builder.withCanvasSize(static_cast<uint32_t>(std::stoi(value.substr(0, x))),
+                                   x == std::string::npos ? 0 : static_cast<uint32_t>(std::stoi(value.substr(x + 1))));
+        }
+        else if (arg == "--viewport" && i + 1 < argc) {
+            builder.withViewport(argv[++i]);
+        }
         else if (arg == "--max-layers" && i + 1 < argc) {
             builder.withMaxLayers(static_cast<uint32_t>(std::stoi(argv[++i])));
         }
@@ -210,9 +245,29 @@ bool parseCommandLine(int argc, char* argv[], ConfigBuilder& builder) {
         else if (arg == "--log-file" && i + 1 < argc) {
             builder.withLogFile(argv[++i]);
         }
-        else if (arg == "--config" && i + 1 < argc) {
-            // TODO: Load configuration from file
-            std::cout << "Loading config from: " << argv[++i] << std::endl;
+        else if (arg == "--realtime") {
+            builder.enableRealtimeMode(true);
+        }
+        else if (arg == "--realtime-heap" && i + 1 < argc) {
+            builder.withRealtimeHeapReserve(static_cast<size_t>(std::stoul(argv[++i])));
+        }
+        else if (arg == "--thread-policy" && i + 1 < argc) {
+            std::string value = argv[++i];
+            size_t equals = value.find('=');
+            builder.withThreadPolicy(value.substr(0, equals),
+                                     equals == std::string::npos ? "" : value.substr(equals + 1));
+        }
+        else if (arg == "--snapshot" && i + 1 < argc) {
+            builder.withSceneSnapshot(argv[++i]);
+        }
+        else if (arg == "--snapshot-interval" && i + 1 < argc) {
+            builder.withSnapshotInterval(static_cast<uint32_t>(std::stoi(argv[++i])));
+        }
+        else if ((arg == "--config" || arg == "--takeover-fd") && i + 1 < argc) {
+            ++i;  // Handled by parseCommandLine()
+        }
+        else if (arg == "--watch-config") {
+            // Handled by parseCommandLine()
         }
         else {
             std::cerr << "Unknown option: " << arg << std::endl;
@@ -224,6 +279,42 @@ bool parseCommandLine(int argc, char* argv[], ConfigBuilder& builder) {
     return true;
 }
 
+bool parseCommandLine(int argc, char* argv[], ConfigBuilder& builder,
+                      std::string& config_file, bool& watch_config, int& takeover_fd) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return false;
+        }
+        else if (arg == "--version" || arg == "-v") {
+            printVersion();
+            return false;
+        }
+        else if (arg == "--watch-config") {
+            watch_config = true;
+        }
+        else if (arg == "--takeover-fd" && i + 1 < argc) {
+            // Internal: passed by a running server handing itself over (SIGUSR2)
+            takeover_fd = std::stoi(argv[++i]);
+        }
+    }
+    
+    // Load the config file first so command line options override it
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--config") {
+            config_file = argv[i + 1];
+            if (!builder.loadFromFile(config_file)) {
+                std::cerr << "Failed to load configuration from: " << config_file << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    return applyConfigOptions(argc, argv, builder);
+}
+
 void printStartupInfo(const Server& server) {
     const auto& config = server.getConfig();
     
@@ -297,7 +388,10 @@ int main(int argc, char* argv[]) {
         
         // Parse command line arguments
         ConfigBuilder builder;
-        if (!parseCommandLine(argc, argv, builder)) {
+        std::string config_file;
+        bool watch_config = false;
+        int takeover_fd = -1;
+        if (!parseCommandLine(argc, argv, builder, config_file, watch_config, takeover_fd)) {
             return 0; // Help or version was shown
         }
         
@@ -330,6 +424,29 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        if (!config_file.empty()) {
+            g_server->setConfigFile(config_file, watch_config);
+            g_server->setConfigOverrides([argc, argv](Config& reloaded) {
+                ConfigBuilder overrides(reloaded);
+                applyConfigOptions(argc, argv, overrides);
+                reloaded = overrides.build();
+            });
+        } else if (watch_config) {
+            std::cerr << "--watch-config needs --config <file>; not watching" << std::endl;
+        }
+        
+        // A hot upgrade re-runs this command line (minus any takeover fd of our own)
+        std::vector<std::string> upgrade_command;
+        for (int i = 0; i < argc; ++i) {
+            if (std::string(argv[i]) == "--takeover-fd" && i + 1 < argc) {
+                ++i;
+                continue;
+            }
+            upgrade_command.push_back(argv[i]);
+        }
+        g_server->setUpgradeCommand(upgrade_command);
+        g_server->setTakeoverFd(takeover_fd);
+        
         // Setup signal handlers
         setupSignalHandlers();
         
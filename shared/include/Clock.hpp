@@ -0,0 +1,53 @@
+// shared/include/Clock.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Kairos {
+
+/**
+ * @brief Process-wide time source for pacing, rate limiting, timeouts and stats
+ *
+ * In Real mode this is std::chrono::steady_clock. In Virtual mode time only
+ * moves when it is stepped: advance()/setTime() from a harness, or sleepFor()
+ * from the frame pacer, which steps the clock instead of blocking. Frames then
+ * run back to back and every schedule derived from the clock is reproducible.
+ *
+ * Time points are steady_clock time points in both modes, so existing members
+ * and arithmetic stay unchanged. Socket polling back-offs are I/O waits, not
+ * schedule, and keep using real sleeps.
+ */
+class Clock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    enum class Mode {
+        Real,
+        Virtual
+    };
+
+    // Current time
+    static time_point now();
+    static uint64_t nowMicros();
+
+    // Real: blocks. Virtual: advances the clock by the duration and returns
+    static void sleepFor(duration delay);
+
+    // Mode control; entering Virtual starts from the current real time
+    static void setMode(Mode mode);
+    static Mode getMode();
+    static bool isVirtual();
+
+    // Virtual time stepping (ignored in Real mode)
+    static void advance(duration delta);
+    static void setTime(time_point time);
+
+private:
+    static std::atomic<Mode> s_mode;
+    static std::atomic<int64_t> s_virtual_ticks;
+};
+
+} // namespace Kairos
@@ -41,6 +41,42 @@ namespace Constants {
     constexpr uint8_t COORD_MODE_ORIGIN = 0;
     constexpr uint8_t COORD_MODE_PREVIOUS = 1;
     
+    // Gradient fills
+    constexpr uint8_t GRADIENT_SHAPE_RECTANGLE = 0;
+    constexpr uint8_t GRADIENT_SHAPE_ELLIPSE = 1;
+    constexpr uint8_t GRADIENT_LINEAR = 0;
+    constexpr uint8_t GRADIENT_RADIAL = 1;
+    
+    // Layer transforms: re-rasterize the layer at its new scale once the
+    // transform stops changing, instead of stretching the cached pixels
+    constexpr uint8_t LAYER_TRANSFORM_RERASTERIZE = 0x01;
+    
+    // Pixmap targets: clear the pixmap to transparent before drawing into it
+    constexpr uint8_t PIXMAP_TARGET_CLEAR = 0x01;
+    
+    // Retained objects
+    constexpr uint8_t OBJECT_SHAPE_RECTANGLE = 0;
+    constexpr uint8_t OBJECT_SHAPE_ROUNDED_RECTANGLE = 1;
+    constexpr uint8_t OBJECT_SHAPE_ELLIPSE = 2;
+    constexpr uint8_t OBJECT_SHAPE_IMAGE = 3;
+    constexpr uint8_t OBJECT_FIELD_POSITION = 0x01;
+    constexpr uint8_t OBJECT_FIELD_SIZE = 0x02;
+    constexpr uint8_t OBJECT_FIELD_ROTATION = 0x04;
+    constexpr uint8_t OBJECT_FIELD_COLOR = 0x08;
+    constexpr uint8_t OBJECT_FIELD_OPACITY = 0x10;
+    
+    // Object tweens run once unless repeated; alternate runs each pass
+    // there and back, so alone it ends where it started
+    constexpr uint8_t OBJECT_TWEEN_REPEAT = 0x01;
+    constexpr uint8_t OBJECT_TWEEN_ALTERNATE = 0x02;
+    
+    // Easing curves (in/out are cubic; out-back overshoots, then settles)
+    constexpr uint8_t EASING_LINEAR = 0;
+    constexpr uint8_t EASING_IN = 1;
+    constexpr uint8_t EASING_OUT = 2;
+    constexpr uint8_t EASING_IN_OUT = 3;
+    constexpr uint8_t EASING_OUT_BACK = 4;
+    
     // Graphics functions
     constexpr uint8_t GX_CLEAR = 0;
     constexpr uint8_t GX_AND = 1;
@@ -77,6 +113,38 @@ namespace Capabilities {
     constexpr uint32_t UNIX_SOCKETS = 0x00000040;
     constexpr uint32_t HIGH_DPI = 0x00000080;
     constexpr uint32_t MULTI_TOUCH = 0x00000100;
+    constexpr uint32_t PROXY = 0x00000200;             // Multiplexes virtual clients (kairos-proxy)
+}
+
+// Input routing (SET_INPUT_REGION / SET_INPUT_GRAB)
+namespace InputRouting {
+    constexpr uint8_t REGION_REMOVE = 0x01;
+    
+    constexpr uint8_t GRAB_POINTER = 0x01;      // Every pointer event, wherever it happens
+    constexpr uint8_t GRAB_KEYBOARD = 0x02;     // Keyboard focus that clicks cannot move
+    constexpr uint8_t FOCUS_KEYBOARD = 0x04;    // Keyboard focus until the next click elsewhere
+    
+    // Key codes are GLFW/raylib key codes; those from 256 up (escape,
+    // arrows, function and keypad keys, modifiers) are sent minus this
+    constexpr uint16_t SPECIAL_KEY_OFFSET = 128;
+    
+    // InputEvent::modifiers
+    constexpr uint16_t MOD_SHIFT = 0x0001;
+    constexpr uint16_t MOD_CONTROL = 0x0002;
+    constexpr uint16_t MOD_ALT = 0x0004;
+    constexpr uint16_t MOD_SUPER = 0x0008;
+    
+    // InputMaskData::event_mask, one bit per InputEventType value
+    constexpr uint32_t EVENT_MASK_KEYS = (1u << 0x01) | (1u << 0x02);
+    constexpr uint32_t EVENT_MASK_MOTION = (1u << 0x03);
+    constexpr uint32_t EVENT_MASK_BUTTONS = (1u << 0x04) | (1u << 0x05);
+    constexpr uint32_t EVENT_MASK_WHEEL = (1u << 0x06);
+    constexpr uint32_t EVENT_MASK_TOUCH = (1u << 0x07) | (1u << 0x08) | (1u << 0x09);
+    constexpr uint32_t EVENT_MASK_ALL = 0xFFFFFFFF;
+    
+    // InputMaskData::flags
+    constexpr uint8_t DELIVER_BATCHED = 0x01;           // One INPUT_BATCH per frame instead of INPUT_EVENTs
+    constexpr uint8_t DELIVER_MOTION_HISTORY = 0x02;    // Keep every motion event rather than the latest
 }
 
 // System limits
@@ -87,7 +155,13 @@ namespace Limits {
     constexpr uint32_t MAX_FONTS = 1000;
     constexpr uint32_t MAX_MESSAGE_SIZE = 10 * 1024 * 1024; // 10MB
     constexpr uint32_t MAX_BATCH_SIZE = 10000;
+    constexpr uint32_t MAX_INPUT_BATCH_EVENTS = 1024;
     constexpr uint32_t MAX_COMMAND_QUEUE_SIZE = 100000;
+    constexpr uint32_t MAX_CLIP_DEPTH = 64;                 // PUSH_CLIPs open per client and layer
+    constexpr uint32_t MAX_PIXMAP_SIZE = 8192;              // Pixels per side
+    constexpr uint32_t MAX_OBJECTS_PER_CLIENT = 4096;
+    constexpr uint32_t MAX_POLYGON_POINTS = 1024;           // Ear clipping is quadratic or worse
+    constexpr uint32_t MAX_INPUT_REGIONS_PER_CLIENT = 1024;
     
     // Performance limits
     constexpr uint32_t MAX_FPS = 300;
@@ -27,6 +27,11 @@ enum class MessageType : uint8_t {
     DRAW_TEXT = 0x18,
     DRAW_IMAGE_STRING = 0x19,
     DRAW_TEXTURED_QUADS = 0x1A,
+    DRAW_ROUNDED_RECTANGLE = 0x1B,
+    FILL_ROUNDED_RECTANGLE = 0x1C,
+    FILL_GRADIENT = 0x1D,
+    DRAW_SPRITES_INSTANCED = 0x1E,
+    COPY_AREA = 0x1F,
     
     // Graphics context
     CREATE_GC = 0x20,
@@ -42,6 +47,7 @@ enum class MessageType : uint8_t {
     UPLOAD_FONT_TEXTURE = 0x30,
     CREATE_PIXMAP = 0x31,
     FREE_PIXMAP = 0x32,
+    SET_PIXMAP_TARGET = 0x33,
     
     // Layer management
     CLEAR_LAYER = 0x40,
@@ -49,11 +55,32 @@ enum class MessageType : uint8_t {
     SET_LAYER_VISIBILITY = 0x42,
     BATCH_BEGIN = 0x43,
     BATCH_END = 0x44,
+    SET_LAYER_TRANSFORM = 0x45,
+    PUSH_CLIP = 0x46,
+    POP_CLIP = 0x47,
     
     // Events (server to client)
     INPUT_EVENT = 0x50,
     FRAME_CALLBACK = 0x51,
     
+    // Input routing (client to server)
+    SET_INPUT_REGION = 0x52,
+    SET_INPUT_GRAB = 0x53,
+    SET_INPUT_MASK = 0x54,
+    
+    // Batched input (server to client)
+    INPUT_BATCH = 0x55,
+    
+    // Retained objects
+    CREATE_OBJECT = 0x60,
+    UPDATE_OBJECT = 0x61,
+    DELETE_OBJECT = 0x62,
+    
+    // Connection multiplexing (kairos-proxy <-> server)
+    PROXY_ATTACH = 0xE0,
+    PROXY_DETACH = 0xE1,
+    PROXY_FRAME = 0xE2,
+    
     // System
     PING = 0xF0,
     PONG = 0xF1,
@@ -114,6 +141,10 @@ struct DrawRectangleData {
     float height;
 } __attribute__((packed));
 
+// An arc of the ellipse centred on center with the given diameters. Angles
+// are in 1/64 degree counter-clockwise from 3 o'clock, as in X11 (90 degrees
+// is 5760); angle2 is the extent from angle1 (negative: clockwise), capped
+// at a full turn (23040). FILL_ARC fills the pie slice.
 struct DrawArcData {
     uint32_t gc_id;
     Point center;
@@ -123,14 +154,48 @@ struct DrawArcData {
     int16_t angle2;
 } __attribute__((packed));
 
+// FILL_POLYGON closes the outline and fills it; Complex and Nonconvex
+// shapes are ear-clipped, Convex ones fanned. Self-intersecting outlines
+// fill as well as ear clipping manages. Polygons with more than
+// Limits::MAX_POLYGON_POINTS points are dropped.
 struct DrawPolygonData {
     uint32_t gc_id;
-    uint8_t shape;           // Complex, Convex, etc.
-    uint8_t coord_mode;      // Origin or Previous
+    uint8_t shape;           // Constants::COMPLEX / NONCONVEX / CONVEX
+    uint8_t coord_mode;      // Constants::COORD_MODE_*: absolute, or relative to the previous point
     uint16_t point_count;
     // Followed by Point[point_count]
 } __attribute__((packed));
 
+// Corner radii run clockwise from the top-left corner. Radii that do not
+// fit are scaled down together, so adjacent corners never overlap.
+struct DrawRoundedRectangleData {
+    uint32_t gc_id;
+    Point position;
+    float width;
+    float height;
+    float radii[4];          // Top-left, top-right, bottom-right, bottom-left
+} __attribute__((packed));
+
+// Fills a rectangle (position is its top-left corner) or an ellipse
+// (position is its centre, width/height its diameters) with a two-stop
+// gradient. Linear: from_color at from, to_color at to, constant across
+// the axis between them. Radial: from_color at from, to_color from the
+// circle through to outwards. Colours are 0xRRGGBBAA and do not come from
+// the GC.
+struct FillGradientData {
+    uint32_t gc_id;
+    uint8_t shape;           // Constants::GRADIENT_SHAPE_*
+    uint8_t kind;            // Constants::GRADIENT_LINEAR / GRADIENT_RADIAL
+    uint16_t reserved;
+    Point position;
+    float width;
+    float height;
+    Point from;
+    Point to;
+    uint32_t from_rgba;
+    uint32_t to_rgba;
+} __attribute__((packed));
+
 struct DrawTextData {
     uint32_t gc_id;
     uint32_t font_id;
@@ -150,6 +215,43 @@ struct DrawTexturedQuadsData {
     // Followed by TexturedVertex[quad_count * 4]
 } __attribute__((packed));
 
+// One texture, many sprites. Each instance draws its atlas rect centred on
+// position, scaled, then rotated about its centre: 32 bytes per sprite
+// instead of four textured vertices and, often, a header of its own.
+struct SpriteInstance {
+    Point position;          // Centre
+    float scale_x;
+    float scale_y;
+    float rotation;          // Degrees, clockwise on screen
+    uint16_t atlas_x;        // Source rect in texels
+    uint16_t atlas_y;
+    uint16_t atlas_width;
+    uint16_t atlas_height;
+    uint32_t color;          // Tint, 0xRRGGBBAA
+} __attribute__((packed));
+
+struct DrawSpritesInstancedData {
+    uint32_t gc_id;
+    uint32_t texture_id;
+    uint32_t instance_count;
+    uint32_t reserved;
+    // Followed by SpriteInstance[instance_count]
+} __attribute__((packed));
+
+// Moves pixels within what the sender draws to: its pixmap target, else
+// the header's layer. Source and destination may overlap. Coordinates are
+// the target's pixels (the canvas for a layer: no transform, camera or
+// clip applies); source pixels outside the target are not copied. Scroll
+// by copying, then draw only the strip the copy exposed.
+struct CopyAreaData {
+    int32_t src_x;
+    int32_t src_y;
+    uint32_t width;
+    uint32_t height;
+    int32_t dst_x;
+    int32_t dst_y;
+} __attribute__((packed));
+
 // Graphics context management
 struct CreateGCData {
     uint32_t drawable_id;
@@ -185,11 +287,27 @@ struct FontTextureData {
     // Followed by pixel data[data_size]
 } __attribute__((packed));
 
+// Pixmaps are offscreen RGBA images kept by the server. Their ids share
+// the texture id space: DRAW_TEXTURED_QUADS and DRAW_SPRITES_INSTANCED draw
+// a pixmap like an uploaded texture. CREATE_PIXMAP on an existing id
+// resizes it, keeping its pixels anchored at the top left.
 struct CreatePixmapData {
     uint32_t pixmap_id;
     uint32_t width;
     uint32_t height;
-    uint8_t depth;
+    uint8_t depth;           // 32, or 0 for the default (also 32)
+    uint8_t reserved[3];
+} __attribute__((packed));
+
+struct FreePixmapData {
+    uint32_t pixmap_id;
+} __attribute__((packed));
+
+// Sends the sender's later drawing into a pixmap, in pixmap coordinates,
+// instead of the header's layer; pixmap_id 0 draws to the layers again.
+struct PixmapTargetData {
+    uint32_t pixmap_id;
+    uint8_t flags;           // Constants::PIXMAP_TARGET_*
     uint8_t reserved[3];
 } __attribute__((packed));
 
@@ -200,6 +318,135 @@ struct LayerVisibilityData {
     uint16_t reserved;
 } __attribute__((packed));
 
+// Maps the header's layer to the canvas: x' = a*x + c*y + tx,
+// y' = b*x + d*y + ty. The identity removes the transform.
+struct LayerTransformData {
+    float a;
+    float b;
+    float c;
+    float d;
+    float tx;
+    float ty;
+    uint8_t flags;           // Constants::LAYER_TRANSFORM_*
+    uint8_t reserved[3];
+} __attribute__((packed));
+
+// Clips the sender's later drawing on the header's layer to a rectangle in
+// layer coordinates, intersected with any clip already pushed there, until
+// the matching POP_CLIP (no payload). Clip stacks are per client and layer.
+struct ClipRectData {
+    float x;
+    float y;
+    float width;
+    float height;
+} __attribute__((packed));
+
+// Retained objects, kept by the server on the header's layer and drawn
+// every frame over the layer's pixels (in creation order, below the layers
+// above) until deleted or their client disconnects. Object ids are per
+// client. Animating one costs an UPDATE_OBJECT with a duration: the server
+// tweens the properties itself rather than being sent each frame.
+struct ObjectData {
+    uint32_t object_id;
+    uint8_t shape;           // Constants::OBJECT_SHAPE_*
+    uint8_t reserved[3];
+    uint32_t texture_id;     // OBJECT_SHAPE_IMAGE: a texture or pixmap, drawn whole
+    Point position;          // Centre
+    float width;
+    float height;
+    float rotation;          // Degrees, clockwise on screen, about the centre
+    float corner_radius;     // OBJECT_SHAPE_ROUNDED_RECTANGLE
+    uint32_t color;          // 0xRRGGBBAA; tints OBJECT_SHAPE_IMAGE
+    float opacity;           // 0..1, multiplied into the colour's alpha
+} __attribute__((packed));
+
+// Sets the properties in fields; with a duration they are tweened there
+// from their values when the update arrives. Updating a property again
+// replaces its tween.
+struct ObjectUpdateData {
+    uint32_t object_id;
+    uint8_t fields;          // Constants::OBJECT_FIELD_*
+    uint8_t easing;          // Constants::EASING_*
+    uint8_t flags;           // Constants::OBJECT_TWEEN_*
+    uint8_t reserved;
+    uint32_t duration_ms;    // 0: at once
+    Point position;
+    float width;
+    float height;
+    float rotation;
+    uint32_t color;
+    float opacity;
+} __attribute__((packed));
+
+struct DeleteObjectData {
+    uint32_t object_id;
+} __attribute__((packed));
+
+// Input routing. Pointer events go to the owner of the topmost input
+// region under the pointer (highest layer, then most recently set);
+// keyboard events go to the client with keyboard focus. A press grabs the
+// pointer for the pressed client until every button is released.
+struct InputRegionData {
+    uint32_t region_id;      // Chosen by the client; setting it again moves it
+    uint8_t layer_id;        // Stacking order, and hidden with its layer
+    uint8_t flags;           // InputRouting::REGION_*
+    uint16_t reserved;
+    float x;                 // Canvas coordinates
+    float y;
+    float width;
+    float height;
+} __attribute__((packed));
+
+struct InputGrabData {
+    uint8_t acquire;         // InputRouting::GRAB_* / FOCUS_* to take
+    uint8_t release;         // InputRouting::GRAB_* to give up
+    uint16_t reserved;
+} __attribute__((packed));
+
+// Input selection. Until a client sends SET_INPUT_MASK it gets every event
+// type as one INPUT_EVENT each. Consecutive motion (mouse move, the same
+// touch point moving, wheel with the same modifiers) is folded into the
+// latest event of the frame unless DELIVER_MOTION_HISTORY is set.
+struct InputMaskData {
+    uint32_t event_mask;     // Bit (1 << InputEventType) per wanted type
+    uint8_t flags;           // InputRouting::DELIVER_*
+    uint8_t reserved[3];
+} __attribute__((packed));
+
+// INPUT_BATCH data: this header, then event_count InputBatchEvents in the
+// order they happened. At most one batch per client per frame, unless a
+// frame holds more than Limits::MAX_INPUT_BATCH_EVENTS.
+struct InputBatchHeader {
+    uint32_t frame_number;
+    uint16_t event_count;
+    uint16_t coalesced_count;    // Motion events folded into the ones sent
+} __attribute__((packed));
+
+struct InputBatchEvent {
+    uint32_t region_id;      // Input region hit, 0 for keyboard and grabs
+    uint8_t layer_id;
+    uint8_t reserved[3];
+    InputEvent event;
+} __attribute__((packed));
+
+// Connection multiplexing. A connection whose CLIENT_HELLO declares
+// Capabilities::PROXY carries many local clients, each with a virtual id
+// chosen by the proxy. PROXY_FRAME data is a run of complete messages
+// (header + data, network byte order) whose header client_id is the
+// virtual id; the server wraps what it sends to one virtual client the
+// same way, and sends broadcasts unwrapped, once per proxy.
+struct ProxyAttachData {
+    uint32_t virtual_id;
+    uint32_t assigned_client_id;    // Server's id for the virtual client; 0 in the request
+    char client_name[64];           // From the local client's CLIENT_HELLO
+    uint32_t client_version;
+    uint32_t capabilities;
+} __attribute__((packed));
+
+struct ProxyDetachData {
+    uint32_t virtual_id;
+} __attribute__((packed));
+
 // Error handling
 struct ErrorResponse {
     ErrorCode error_code;
@@ -256,4 +503,8 @@ public:
     static void networkToHost(MessageHeader& header);
 };
 
+// Error message helpers (Serialization.cpp)
+std::string errorCodeToString(ErrorCode code);
+std::string messageTypeToString(MessageType type);
+
 } // namespace Kairos
\ No newline at end of file
@@ -0,0 +1,70 @@
+// shared/src/Clock.cpp
+#include <Clock.hpp>
+#include <thread>
+
+namespace Kairos {
+
+std::atomic<Clock::Mode> Clock::s_mode{Clock::Mode::Real};
+std::atomic<int64_t> Clock::s_virtual_ticks{0};
+
+Clock::time_point Clock::now() {
+    if (s_mode.load(std::memory_order_acquire) == Mode::Virtual) {
+        return time_point(duration(s_virtual_ticks.load(std::memory_order_acquire)));
+    }
+    return std::chrono::steady_clock::now();
+}
+
+uint64_t Clock::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(now().time_since_epoch()).count();
+}
+
+void Clock::sleepFor(duration delay) {
+    if (delay <= duration::zero()) {
+        return;
+    }
+
+    if (s_mode.load(std::memory_order_acquire) == Mode::Virtual) {
+        advance(delay);
+    } else {
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+void Clock::setMode(Mode mode) {
+    if (mode == Mode::Virtual && s_mode.load() != Mode::Virtual) {
+        // Continue from real time so existing time points stay in the past
+        s_virtual_ticks.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                              std::memory_order_release);
+    }
+    s_mode.store(mode, std::memory_order_release);
+}
+
+Clock::Mode Clock::getMode() {
+    return s_mode.load(std::memory_order_acquire);
+}
+
+bool Clock::isVirtual() {
+    return getMode() == Mode::Virtual;
+}
+
+void Clock::advance(duration delta) {
+    if (!isVirtual() || delta <= duration::zero()) {
+        return;
+    }
+    s_virtual_ticks.fetch_add(delta.count(), std::memory_order_acq_rel);
+}
+
+void Clock::setTime(time_point time) {
+    if (!isVirtual()) {
+        return;
+    }
+
+    // Virtual time never runs backwards
+    int64_t target = time.time_since_epoch().count();
+    int64_t current = s_virtual_ticks.load(std::memory_order_acquire);
+    while (target > current &&
+           !s_virtual_ticks.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+    }
+}
+
+} // namespace Kairos
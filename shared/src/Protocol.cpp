@@ -2,6 +2,7 @@
 #include <Protocol.hpp>
 #include <Types.hpp>
 #include <Constants.hpp>
+#include <Clock.hpp>
 #include <chrono>
 #include <cstring>
 
@@ -46,9 +47,7 @@ size_t ProtocolHelper::getMessageSize(const MessageHeader& header) {
 }
 
 uint64_t ProtocolHelper::getCurrentTimestamp() {
-    auto now = std::chrono::steady_clock::now();
-    auto duration = now.time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    return Clock::nowMicros();
 }
 
 MessageHeader ProtocolHelper::createHeader(MessageType type, uint32_t client_id, 
@@ -239,6 +239,11 @@ std::string messageTypeToString(MessageType type) {
         case MessageType::DRAW_TEXT: return "DRAW_TEXT";
         case MessageType::DRAW_IMAGE_STRING: return "DRAW_IMAGE_STRING";
         case MessageType::DRAW_TEXTURED_QUADS: return "DRAW_TEXTURED_QUADS";
+        case MessageType::DRAW_ROUNDED_RECTANGLE: return "DRAW_ROUNDED_RECTANGLE";
+        case MessageType::FILL_ROUNDED_RECTANGLE: return "FILL_ROUNDED_RECTANGLE";
+        case MessageType::FILL_GRADIENT: return "FILL_GRADIENT";
+        case MessageType::DRAW_SPRITES_INSTANCED: return "DRAW_SPRITES_INSTANCED";
+        case MessageType::COPY_AREA: return "COPY_AREA";
         case MessageType::CREATE_GC: return "CREATE_GC";
         case MessageType::FREE_GC: return "FREE_GC";
         case MessageType::SET_FOREGROUND: return "SET_FOREGROUND";
@@ -250,13 +255,27 @@ std::string messageTypeToString(MessageType type) {
         case MessageType::UPLOAD_FONT_TEXTURE: return "UPLOAD_FONT_TEXTURE";
         case MessageType::CREATE_PIXMAP: return "CREATE_PIXMAP";
         case MessageType::FREE_PIXMAP: return "FREE_PIXMAP";
+        case MessageType::SET_PIXMAP_TARGET: return "SET_PIXMAP_TARGET";
         case MessageType::CLEAR_LAYER: return "CLEAR_LAYER";
         case MessageType::CLEAR_ALL_LAYERS: return "CLEAR_ALL_LAYERS";
         case MessageType::SET_LAYER_VISIBILITY: return "SET_LAYER_VISIBILITY";
         case MessageType::BATCH_BEGIN: return "BATCH_BEGIN";
         case MessageType::BATCH_END: return "BATCH_END";
+        case MessageType::SET_LAYER_TRANSFORM: return "SET_LAYER_TRANSFORM";
+        case MessageType::PUSH_CLIP: return "PUSH_CLIP";
+        case MessageType::POP_CLIP: return "POP_CLIP";
         case MessageType::INPUT_EVENT: return "INPUT_EVENT";
         case MessageType::FRAME_CALLBACK: return "FRAME_CALLBACK";
+        case MessageType::SET_INPUT_REGION: return "SET_INPUT_REGION";
+        case MessageType::SET_INPUT_GRAB: return "SET_INPUT_GRAB";
+        case MessageType::SET_INPUT_MASK: return "SET_INPUT_MASK";
+        case MessageType::INPUT_BATCH: return "INPUT_BATCH";
+        case MessageType::CREATE_OBJECT: return "CREATE_OBJECT";
+        case MessageType::UPDATE_OBJECT: return "UPDATE_OBJECT";
+        case MessageType::DELETE_OBJECT: return "DELETE_OBJECT";
+        case MessageType::PROXY_ATTACH: return "PROXY_ATTACH";
+        case MessageType::PROXY_DETACH: return "PROXY_DETACH";
+        case MessageType::PROXY_FRAME: return "PROXY_FRAME";
         case MessageType::PING: return "PING";
         case MessageType::PONG: return "PONG";
         case MessageType::ERROR_RESPONSE: return "ERROR_RESPONSE";
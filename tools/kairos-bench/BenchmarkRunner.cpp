@@ -0,0 +1,260 @@
+// tools/kairos-bench/BenchmarkRunner.cpp
+#include "BenchmarkRunner.hpp"
+
+#include <Protocol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace Kairos::Bench {
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    double elapsedNs(BenchClock::time_point start, BenchClock::time_point end) {
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+}
+
+BenchmarkRunner::BenchmarkRunner() : BenchmarkRunner(Config{}) {}
+
+BenchmarkRunner::BenchmarkRunner(const Config& config) : m_config(config) {
+    if (m_config.samples == 0) {
+        m_config.samples = 1;
+    }
+}
+
+void BenchmarkRunner::add(Benchmark benchmark) {
+    m_benchmarks.push_back(std::move(benchmark));
+}
+
+void BenchmarkRunner::add(const std::string& group, const std::string& name, const std::string& description,
+                          Factory factory, bool needs_window) {
+    Benchmark benchmark;
+    benchmark.group = group;
+    benchmark.name = name;
+    benchmark.description = description;
+    benchmark.needs_window = needs_window;
+    benchmark.factory = std::move(factory);
+    add(std::move(benchmark));
+}
+
+std::vector<BenchmarkRunner::Result> BenchmarkRunner::runAll() {
+    std::vector<Result> results;
+
+    for (const auto& benchmark : m_benchmarks) {
+        if (!isSelected(benchmark)) {
+            continue;
+        }
+
+        std::cerr << "Running " << benchmark.group << "/" << benchmark.name << "..." << std::endl;
+        results.push_back(runBenchmark(benchmark));
+    }
+
+    return results;
+}
+
+bool BenchmarkRunner::needsWindow() const {
+    for (const auto& benchmark : m_benchmarks) {
+        if (benchmark.needs_window && isSelected(benchmark)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<const BenchmarkRunner::Benchmark*> BenchmarkRunner::getSelected() const {
+    std::vector<const Benchmark*> selected;
+    for (const auto& benchmark : m_benchmarks) {
+        if (isSelected(benchmark)) {
+            selected.push_back(&benchmark);
+        }
+    }
+    return selected;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::runBenchmark(const Benchmark& benchmark) {
+    Result result;
+    result.group = benchmark.group;
+    result.name = benchmark.name;
+
+    if (benchmark.needs_window && !m_config.window_available) {
+        result.skipped = true;
+        result.skip_reason = "requires a window/GL context";
+        return result;
+    }
+
+    Body body = benchmark.factory();
+    if (!body) {
+        result.skipped = true;
+        result.skip_reason = "setup failed";
+        return result;
+    }
+
+    uint64_t items_per_iter = 0;
+    uint64_t iterations = calibrate(body, items_per_iter);
+
+    for (uint32_t i = 0; i < m_config.warmup_samples; ++i) {
+        body(iterations);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(m_config.samples);
+    uint64_t total_items = 0;
+    double total_ns = 0.0;
+
+    for (uint32_t i = 0; i < m_config.samples; ++i) {
+        auto start = BenchClock::now();
+        uint64_t items = body(iterations);
+        auto end = BenchClock::now();
+
+        double ns = elapsedNs(start, end);
+        samples.push_back(ns / static_cast<double>(iterations));
+        total_items += items;
+        total_ns += ns;
+    }
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    double variance = 0.0;
+    for (double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance /= samples.size();
+
+    result.iterations_per_sample = iterations;
+    result.samples = m_config.samples;
+    result.ns_per_iter_mean = mean;
+    result.ns_per_iter_median = sorted.size() % 2 == 0
+        ? (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0
+        : sorted[sorted.size() / 2];
+    result.ns_per_iter_min = sorted.front();
+    result.ns_per_iter_max = sorted.back();
+    result.ns_per_iter_stddev = std::sqrt(variance);
+    result.items_per_iter = static_cast<double>(total_items) /
+                            (static_cast<double>(iterations) * m_config.samples);
+    result.items_per_second = total_ns > 0.0 ? total_items / (total_ns / 1e9) : 0.0;
+
+    return result;
+}
+
+uint64_t BenchmarkRunner::calibrate(const Body& body, uint64_t& items_per_iter) {
+    // Grow the iteration count until one sample takes at least min_sample_time_ms
+    const double target_ns = m_config.min_sample_time_ms * 1e6;
+    uint64_t iterations = 1;
+
+    while (true) {
+        auto start = BenchClock::now();
+        uint64_t items = body(iterations);
+        double ns = elapsedNs(start, BenchClock::now());
+
+        items_per_iter = iterations > 0 ? items / iterations : 0;
+
+        if (ns >= target_ns || iterations >= (1ull << 32)) {
+            return iterations;
+        }
+
+        // Jump close to the target, but never more than 10x per round
+        double factor = ns > 0.0 ? (target_ns * 1.2) / ns : 10.0;
+        factor = std::clamp(factor, 2.0, 10.0);
+        iterations = static_cast<uint64_t>(iterations * factor);
+    }
+}
+
+bool BenchmarkRunner::isSelected(const Benchmark& benchmark) const {
+    if (m_config.filter.empty()) {
+        return true;
+    }
+    std::string full_name = benchmark.group + "/" + benchmark.name;
+    return full_name.find(m_config.filter) != std::string::npos;
+}
+
+std::string BenchmarkRunner::toJson(const std::vector<Result>& results) {
+    std::stringstream ss;
+    ss << std::setprecision(6) << std::fixed;
+
+    ss << "{\n";
+    ss << "  \"tool\": \"kairos-bench\",\n";
+    ss << "  \"protocol_version\": " << PROTOCOL_VERSION << ",\n";
+    ss << "  \"timestamp_us\": " << std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count() << ",\n";
+    ss << "  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        ss << "    {\n";
+        ss << "      \"group\": \"" << escapeJson(r.group) << "\",\n";
+        ss << "      \"name\": \"" << escapeJson(r.name) << "\",\n";
+        if (r.skipped) {
+            ss << "      \"skipped\": true,\n";
+            ss << "      \"skip_reason\": \"" << escapeJson(r.skip_reason) << "\"\n";
+        } else {
+            ss << "      \"skipped\": false,\n";
+            ss << "      \"iterations_per_sample\": " << r.iterations_per_sample << ",\n";
+            ss << "      \"samples\": " << r.samples << ",\n";
+            ss << "      \"ns_per_iter\": {\n";
+            ss << "        \"mean\": " << r.ns_per_iter_mean << ",\n";
+            ss << "        \"median\": " << r.ns_per_iter_median << ",\n";
+            ss << "        \"min\": " << r.ns_per_iter_min << ",\n";
+            ss << "        \"max\": " << r.ns_per_iter_max << ",\n";
+            ss << "        \"stddev\": " << r.ns_per_iter_stddev << "\n";
+            ss << "      },\n";
+            ss << "      \"items_per_iter\": " << r.items_per_iter << ",\n";
+            ss << "      \"items_per_second\": " << r.items_per_second << "\n";
+        }
+        ss << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    ss << "  ]\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+std::string BenchmarkRunner::toTable(const std::vector<Result>& results) {
+    std::stringstream ss;
+    ss << std::left << std::setw(48) << "Benchmark"
+       << std::right << std::setw(14) << "median ns"
+       << std::setw(14) << "stddev ns"
+       << std::setw(16) << "items/s" << "\n";
+    ss << std::string(92, '-') << "\n";
+
+    for (const auto& r : results) {
+        std::string full_name = r.group + "/" + r.name;
+        ss << std::left << std::setw(48) << full_name;
+        if (r.skipped) {
+            ss << "skipped (" << r.skip_reason << ")\n";
+            continue;
+        }
+        ss << std::right << std::fixed << std::setprecision(1)
+           << std::setw(14) << r.ns_per_iter_median
+           << std::setw(14) << r.ns_per_iter_stddev
+           << std::setw(16) << std::setprecision(0) << r.items_per_second << "\n";
+    }
+
+    return ss.str();
+}
+
+std::string BenchmarkRunner::escapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+} // namespace Kairos::Bench
@@ -0,0 +1,108 @@
+// tools/kairos-bench/BenchmarkRunner.hpp
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Kairos::Bench {
+
+/**
+ * @brief Keeps a computed value alive so the optimizer cannot drop the work
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Minimal microbenchmark runner with JSON output
+ *
+ * Each benchmark is a factory that performs its setup once and returns a
+ * body. The body runs a requested number of iterations and returns how many
+ * items (messages, commands, quads, glyphs...) it processed, so results can
+ * be reported both as ns/iteration and items/second.
+ */
+class BenchmarkRunner {
+public:
+    using Body = std::function<uint64_t(uint64_t iterations)>;
+    using Factory = std::function<Body()>;
+
+    struct Benchmark {
+        std::string group;
+        std::string name;
+        std::string description;
+        bool needs_window = false;     // Requires a (hidden) raylib window / GL context
+        Factory factory;
+    };
+
+    struct Config {
+        std::string filter;            // Substring match on "group/name"
+        uint32_t samples = 10;
+        uint32_t min_sample_time_ms = 50;
+        uint32_t warmup_samples = 1;
+        bool window_available = true;
+    };
+
+    struct Result {
+        std::string group;
+        std::string name;
+        uint64_t iterations_per_sample = 0;
+        uint32_t samples = 0;
+
+        double ns_per_iter_mean = 0.0;
+        double ns_per_iter_median = 0.0;
+        double ns_per_iter_min = 0.0;
+        double ns_per_iter_max = 0.0;
+        double ns_per_iter_stddev = 0.0;
+
+        double items_per_iter = 0.0;
+        double items_per_second = 0.0;
+
+        bool skipped = false;
+        std::string skip_reason;
+    };
+
+public:
+    BenchmarkRunner();
+    explicit BenchmarkRunner(const Config& config);
+
+    void add(Benchmark benchmark);
+    void add(const std::string& group, const std::string& name, const std::string& description,
+             Factory factory, bool needs_window = false);
+
+    // Execution
+    std::vector<Result> runAll();
+    bool needsWindow() const;
+    std::vector<const Benchmark*> getSelected() const;
+
+    // Reporting
+    static std::string toJson(const std::vector<Result>& results);
+    static std::string toTable(const std::vector<Result>& results);
+
+    const Config& getConfig() const { return m_config; }
+    void setWindowAvailable(bool available) { m_config.window_available = available; }
+
+private:
+    Result runBenchmark(const Benchmark& benchmark);
+    uint64_t calibrate(const Body& body, uint64_t& items_per_iter);
+    bool isSelected(const Benchmark& benchmark) const;
+    static std::string escapeJson(const std::string& text);
+
+private:
+    Config m_config;
+    std::vector<Benchmark> m_benchmarks;
+};
+
+// Benchmark registration (one function per component family)
+void registerProtocolBenchmarks(BenchmarkRunner& runner);
+void registerRenderBenchmarks(BenchmarkRunner& runner);
+void registerLoggerBenchmarks(BenchmarkRunner& runner);
+
+} // namespace Kairos::Bench
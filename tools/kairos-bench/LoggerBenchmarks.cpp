@@ -0,0 +1,56 @@
+// tools/kairos-bench/LoggerBenchmarks.cpp
+#include "BenchmarkRunner.hpp"
+
+#include <Utils/Logger.hpp>
+
+#include <string>
+
+namespace Kairos::Bench {
+
+namespace {
+
+/**
+ * @brief Logger calls below the active level (the common case on hot paths)
+ */
+BenchmarkRunner::Factory loggerFiltered() {
+    return []() -> BenchmarkRunner::Body {
+        Logger::setLevel(Logger::Level::Warning);
+
+        return [](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                Logger::debug("Processed {} commands for client {}", it, 7);
+            }
+            return iterations;
+        };
+    };
+}
+
+/**
+ * @brief Logger calls that pass the level filter and are written to the log file
+ */
+BenchmarkRunner::Factory loggerEmitted() {
+    return []() -> BenchmarkRunner::Body {
+        Logger::setLevel(Logger::Level::Info);
+
+        return [](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                Logger::info("Client {} connected from {}", it, "127.0.0.1");
+            }
+            Logger::flush();
+            return iterations;
+        };
+    };
+}
+
+} // anonymous namespace
+
+void registerLoggerBenchmarks(BenchmarkRunner& runner) {
+    runner.add("logger", "filtered_debug",
+               "Logger::debug with level=Warning (call is discarded)",
+               loggerFiltered());
+    runner.add("logger", "emitted_info_file",
+               "Logger::info with level=Info written to the bench log file",
+               loggerEmitted());
+}
+
+} // namespace Kairos::Bench
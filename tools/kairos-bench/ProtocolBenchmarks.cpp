@@ -0,0 +1,293 @@
+// tools/kairos-bench/ProtocolBenchmarks.cpp
+#include "BenchmarkRunner.hpp"
+
+#include <Network/Client.hpp>
+#include <Graphics/RenderCommand.hpp>
+#include <Protocol.hpp>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace Kairos::Bench {
+
+namespace {
+
+// Wire message (header in host order + payload), as a client would build it
+struct WireMessage {
+    MessageHeader header;
+    std::vector<uint8_t> payload;
+};
+
+WireMessage makePoint(std::mt19937& rng, uint32_t sequence) {
+    std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+    DrawPointData data{};
+    data.position = {coord(rng), coord(rng)};
+
+    WireMessage message;
+    message.header = ProtocolHelper::createHeader(MessageType::DRAW_POINT, 1, sequence, sizeof(data), 1);
+    message.payload.resize(sizeof(data));
+    std::memcpy(message.payload.data(), &data, sizeof(data));
+    return message;
+}
+
+WireMessage makeLine(std::mt19937& rng, uint32_t sequence) {
+    std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+    DrawLineData data{};
+    data.start = {coord(rng), coord(rng)};
+    data.end = {coord(rng), coord(rng)};
+
+    WireMessage message;
+    message.header = ProtocolHelper::createHeader(MessageType::DRAW_LINE, 1, sequence, sizeof(data), 1);
+    message.payload.resize(sizeof(data));
+    std::memcpy(message.payload.data(), &data, sizeof(data));
+    return message;
+}
+
+WireMessage makeRectangle(std::mt19937& rng, uint32_t sequence) {
+    std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+    DrawRectangleData data{};
+    data.position = {coord(rng), coord(rng)};
+    data.width = coord(rng) / 4.0f;
+    data.height = coord(rng) / 4.0f;
+
+    WireMessage message;
+    message.header = ProtocolHelper::createHeader(MessageType::FILL_RECTANGLE, 1, sequence, sizeof(data), 2);
+    message.payload.resize(sizeof(data));
+    std::memcpy(message.payload.data(), &data, sizeof(data));
+    return message;
+}
+
+WireMessage makeText(std::mt19937& rng, uint32_t sequence) {
+    static const std::string text = "CPU 42%  MEM 1.3GB  NET 12.4MB/s";
+    std::uniform_real_distribution<float> coord(0.0f, 1080.0f);
+    DrawTextData data{};
+    data.font_id = 0;
+    data.position = {coord(rng), coord(rng)};
+    data.font_size = 16.0f;
+    data.text_length = static_cast<uint16_t>(text.size());
+
+    WireMessage message;
+    message.header = ProtocolHelper::createHeader(MessageType::DRAW_TEXT, 1, sequence,
+                                                  static_cast<uint32_t>(sizeof(data) + text.size()), 3);
+    message.payload.resize(sizeof(data) + text.size());
+    std::memcpy(message.payload.data(), &data, sizeof(data));
+    std::memcpy(message.payload.data() + sizeof(data), text.data(), text.size());
+    return message;
+}
+
+WireMessage makeTexturedQuads(std::mt19937& rng, uint32_t sequence, uint32_t quad_count) {
+    std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+    DrawTexturedQuadsData data{};
+    data.texture_id = 1;
+    data.quad_count = quad_count;
+
+    std::vector<TexturedVertex> vertices(quad_count * 4);
+    for (uint32_t q = 0; q < quad_count; ++q) {
+        float x = coord(rng);
+        float y = coord(rng);
+        vertices[q * 4 + 0] = {x, y, 0.0f, 0.0f, Color::WHITE.rgba};
+        vertices[q * 4 + 1] = {x + 8.0f, y, 1.0f, 0.0f, Color::WHITE.rgba};
+        vertices[q * 4 + 2] = {x + 8.0f, y + 8.0f, 1.0f, 1.0f, Color::WHITE.rgba};
+        vertices[q * 4 + 3] = {x, y + 8.0f, 0.0f, 1.0f, Color::WHITE.rgba};
+    }
+
+    size_t vertex_bytes = vertices.size() * sizeof(TexturedVertex);
+    WireMessage message;
+    message.header = ProtocolHelper::createHeader(MessageType::DRAW_TEXTURED_QUADS, 1, sequence,
+                                                  static_cast<uint32_t>(sizeof(data) + vertex_bytes), 4);
+    message.payload.resize(sizeof(data) + vertex_bytes);
+    std::memcpy(message.payload.data(), &data, sizeof(data));
+    std::memcpy(message.payload.data() + sizeof(data), vertices.data(), vertex_bytes);
+    return message;
+}
+
+enum class MessageMix {
+    POINTS,       // Smallest messages: header dominates
+    MIXED,        // Typical dashboard traffic: points, lines, rects, text
+    QUADS         // Large payloads: textured quad runs
+};
+
+std::vector<WireMessage> generateMix(MessageMix mix, size_t count) {
+    std::mt19937 rng(1234);
+    std::vector<WireMessage> messages;
+    messages.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t sequence = static_cast<uint32_t>(i);
+        switch (mix) {
+            case MessageMix::POINTS:
+                messages.push_back(makePoint(rng, sequence));
+                break;
+            case MessageMix::MIXED:
+                switch (i % 4) {
+                    case 0: messages.push_back(makePoint(rng, sequence)); break;
+                    case 1: messages.push_back(makeLine(rng, sequence)); break;
+                    case 2: messages.push_back(makeRectangle(rng, sequence)); break;
+                    default: messages.push_back(makeText(rng, sequence)); break;
+                }
+                break;
+            case MessageMix::QUADS:
+                messages.push_back(makeTexturedQuads(rng, sequence, 32));
+                break;
+        }
+    }
+
+    return messages;
+}
+
+std::vector<uint8_t> encodeStream(const std::vector<WireMessage>& messages) {
+    std::vector<uint8_t> stream;
+    for (const auto& message : messages) {
+        auto encoded = ProtocolHelper::createMessage(message.header, message.payload.data());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    return stream;
+}
+
+BenchmarkRunner::Factory headerByteSwap() {
+    return []() -> BenchmarkRunner::Body {
+        auto headers = std::make_shared<std::vector<MessageHeader>>(1024);
+        for (size_t i = 0; i < headers->size(); ++i) {
+            (*headers)[i] = ProtocolHelper::createHeader(MessageType::DRAW_LINE, 7,
+                                                         static_cast<uint32_t>(i), 20, 1);
+        }
+
+        return [headers](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                for (auto& header : *headers) {
+                    ProtocolHelper::hostToNetwork(header);
+                    ProtocolHelper::networkToHost(header);
+                }
+                doNotOptimize(headers->front());
+            }
+            return iterations * headers->size();
+        };
+    };
+}
+
+#ifndef _WIN32
+/**
+ * @brief Feeds a pre-encoded stream through a socketpair into Client::receiveMessages
+ *
+ * Exercises receiveRawData + parseMessages exactly as the network threads do.
+ * Each iteration writes one block and drains it completely.
+ */
+BenchmarkRunner::Factory parseMessages(MessageMix mix, size_t messages_per_block) {
+    return [mix, messages_per_block]() -> BenchmarkRunner::Body {
+        struct State {
+            int fds[2] = {-1, -1};
+            std::shared_ptr<Client> client;
+            std::vector<uint8_t> block;
+            size_t message_count = 0;
+            std::vector<std::pair<MessageHeader, std::vector<uint8_t>>> received;
+
+            ~State() {
+                client.reset();
+                if (fds[1] >= 0) close(fds[1]);
+            }
+        };
+
+        auto state = std::make_shared<State>();
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, state->fds) != 0) {
+            return {};
+        }
+
+        int send_buffer = 4 * 1024 * 1024;
+        setsockopt(state->fds[1], SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer));
+
+        state->client = Client::createUnix(state->fds[0], "kairos-bench");
+        Client::Config client_config;
+        client_config.receive_buffer_size = 1024 * 1024;
+        if (!state->client || !state->client->initialize(1, client_config)) {
+            return {};
+        }
+
+        auto messages = generateMix(mix, messages_per_block);
+        state->block = encodeStream(messages);
+        state->message_count = messages.size();
+
+        return [state](uint64_t iterations) -> uint64_t {
+            uint64_t parsed = 0;
+            for (uint64_t it = 0; it < iterations; ++it) {
+                size_t written = 0;
+                size_t drained = 0;
+
+                while (drained < state->message_count) {
+                    if (written < state->block.size()) {
+                        ssize_t n = send(state->fds[1], state->block.data() + written,
+                                         state->block.size() - written, MSG_DONTWAIT);
+                        if (n > 0) {
+                            written += static_cast<size_t>(n);
+                        }
+                    }
+
+                    if (!state->client->receiveMessages(state->received)) {
+                        return parsed;
+                    }
+                    drained += state->received.size();
+                }
+
+                parsed += drained;
+            }
+            return parsed;
+        };
+    };
+}
+#endif
+
+BenchmarkRunner::Factory commandConverter(MessageMix mix) {
+    return [mix]() -> BenchmarkRunner::Body {
+        auto messages = std::make_shared<std::vector<WireMessage>>(generateMix(mix, 1024));
+
+        return [messages](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                for (const auto& message : *messages) {
+                    RenderCommand command = CommandConverter::fromNetworkMessage(
+                        message.header, message.payload.data());
+                    doNotOptimize(command.type);
+                }
+            }
+            return iterations * messages->size();
+        };
+    };
+}
+
+} // anonymous namespace
+
+void registerProtocolBenchmarks(BenchmarkRunner& runner) {
+    runner.add("protocol", "header_byteswap_roundtrip",
+               "MessageHeader hostToNetwork + networkToHost over 1024 headers",
+               headerByteSwap());
+
+#ifndef _WIN32
+    runner.add("protocol", "parse_messages_points",
+               "Client::receiveMessages on 512 DRAW_POINT messages per block",
+               parseMessages(MessageMix::POINTS, 512));
+    runner.add("protocol", "parse_messages_mixed",
+               "Client::receiveMessages on 512 point/line/rect/text messages per block",
+               parseMessages(MessageMix::MIXED, 512));
+    runner.add("protocol", "parse_messages_quads",
+               "Client::receiveMessages on 64 DRAW_TEXTURED_QUADS(32) messages per block",
+               parseMessages(MessageMix::QUADS, 64));
+#endif
+
+    runner.add("protocol", "convert_points",
+               "CommandConverter::fromNetworkMessage over 1024 DRAW_POINT messages",
+               commandConverter(MessageMix::POINTS));
+    runner.add("protocol", "convert_mixed",
+               "CommandConverter::fromNetworkMessage over 1024 mixed messages",
+               commandConverter(MessageMix::MIXED));
+    runner.add("protocol", "convert_quads",
+               "CommandConverter::fromNetworkMessage over 1024 DRAW_TEXTURED_QUADS(32) messages",
+               commandConverter(MessageMix::QUADS));
+}
+
+} // namespace Kairos::Bench
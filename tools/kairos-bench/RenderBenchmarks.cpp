@@ -0,0 +1,232 @@
+// tools/kairos-bench/RenderBenchmarks.cpp
+#include "BenchmarkRunner.hpp"
+
+#include <Core/Server.hpp>
+#include <Core/FontManager.hpp>
+#include <Graphics/BatchRenderer.hpp>
+#include <Graphics/PrimitiveRenderer.hpp>
+#include <Graphics/TextRenderer.hpp>
+#include <Graphics/RenderCommand.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Kairos::Bench {
+
+namespace {
+
+std::vector<RenderCommand> generateCommands(size_t count, uint8_t layer_count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> layer(0, layer_count - 1);
+    std::uniform_int_distribution<int> kind(0, 3);
+    std::uniform_real_distribution<float> coord(0.0f, 1920.0f);
+
+    std::vector<RenderCommand> commands;
+    commands.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t layer_id = static_cast<uint8_t>(layer(rng));
+        Point p = {coord(rng), coord(rng)};
+        switch (kind(rng)) {
+            case 0:
+                commands.push_back(RenderCommand::createDrawPoint(p, Color::WHITE, layer_id));
+                break;
+            case 1:
+                commands.push_back(RenderCommand::createDrawLine(p, {p.x + 10, p.y + 10}, Color::WHITE, 1.0f, layer_id));
+                break;
+            case 2:
+                commands.push_back(RenderCommand::createDrawRectangle(p, 20, 20, Color::WHITE, true, layer_id));
+                break;
+            default:
+                commands.push_back(RenderCommand::createDrawCircle(p, 8, Color::WHITE, true, layer_id));
+                break;
+        }
+    }
+
+    return commands;
+}
+
+BenchmarkRunner::Factory optimizeCommandOrder(size_t count, uint8_t layer_count) {
+    return [count, layer_count]() -> BenchmarkRunner::Body {
+        auto source = std::make_shared<std::vector<RenderCommand>>(generateCommands(count, layer_count));
+        auto scratch = std::make_shared<std::vector<RenderCommand>>();
+
+        return [source, scratch](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                *scratch = *source;
+                Server::optimizeCommandOrder(*scratch);
+                doNotOptimize(scratch->front().layer_id);
+            }
+            return iterations * source->size();
+        };
+    };
+}
+
+/**
+ * @brief Measures BatchRenderer::drawQuads -> findOrCreateBatch -> addQuadToBatch
+ *
+ * beginFrame() discards the accumulated vertices without submitting them, so
+ * no GL context is needed; the auto-flush threshold is raised above what a
+ * single iteration produces to keep flushBatch out of the measurement.
+ */
+BenchmarkRunner::Factory batchAddQuads(size_t quads_per_call, uint32_t texture_count) {
+    return [quads_per_call, texture_count]() -> BenchmarkRunner::Body {
+        constexpr size_t max_vertices = 65536;
+        auto renderer = std::make_shared<BatchRenderer>(max_vertices);
+        renderer->initialize();
+        renderer->setAutoFlushThreshold(max_vertices);
+
+        auto vertices = std::make_shared<std::vector<TexturedVertex>>();
+        for (size_t q = 0; q < quads_per_call; ++q) {
+            float x = static_cast<float>(q % 64) * 10.0f;
+            float y = static_cast<float>(q / 64) * 10.0f;
+            vertices->push_back({x, y, 0.0f, 0.0f, Color::WHITE.rgba});
+            vertices->push_back({x + 8, y, 1.0f, 0.0f, Color::WHITE.rgba});
+            vertices->push_back({x + 8, y + 8, 1.0f, 1.0f, Color::WHITE.rgba});
+            vertices->push_back({x, y + 8, 0.0f, 1.0f, Color::WHITE.rgba});
+        }
+
+        // Leave room for one call per texture before the batch must be reset
+        size_t calls_per_frame = std::max<size_t>(1, (max_vertices / 2) / vertices->size());
+
+        return [renderer, vertices, texture_count, calls_per_frame](uint64_t iterations) -> uint64_t {
+            size_t calls = 0;
+            for (uint64_t it = 0; it < iterations; ++it) {
+                for (uint32_t texture = 1; texture <= texture_count; ++texture) {
+                    renderer->drawQuads(*vertices, texture);
+                }
+                if (++calls >= calls_per_frame) {
+                    renderer->beginFrame();
+                    calls = 0;
+                }
+            }
+            renderer->beginFrame();
+            return iterations * texture_count * (vertices->size() / 4);
+        };
+    };
+}
+
+BenchmarkRunner::Factory tessellateArcs(int segments) {
+    return [segments]() -> BenchmarkRunner::Body {
+        return [segments](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                float start = static_cast<float>(it % 360);
+                auto points = PrimitiveGeometry::generateArcPoints({500.0f, 500.0f}, 120.0f,
+                                                                   start, start + 270.0f, segments);
+                doNotOptimize(points.data());
+            }
+            return iterations * static_cast<uint64_t>(segments);
+        };
+    };
+}
+
+BenchmarkRunner::Factory tessellateBeziers(int segments) {
+    return [segments]() -> BenchmarkRunner::Body {
+        return [segments](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                float offset = static_cast<float>(it % 100);
+                auto points = PrimitiveGeometry::generateBezierPoints(
+                    {0.0f, offset}, {100.0f, 300.0f}, {300.0f, -100.0f}, {400.0f, offset}, segments);
+                doNotOptimize(points.data());
+            }
+            return iterations * static_cast<uint64_t>(segments);
+        };
+    };
+}
+
+BenchmarkRunner::Factory polygonAnalysis(size_t vertex_count) {
+    return [vertex_count]() -> BenchmarkRunner::Body {
+        // Star-shaped (non-convex) polygon, typical of map outlines
+        auto polygon = std::make_shared<std::vector<Point>>();
+        for (size_t i = 0; i < vertex_count; ++i) {
+            float angle = static_cast<float>(i) / vertex_count * 6.28318530718f;
+            float radius = (i % 2 == 0) ? 200.0f : 120.0f;
+            polygon->push_back({500.0f + radius * std::cos(angle), 500.0f + radius * std::sin(angle)});
+        }
+
+        return [polygon](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                bool convex = PrimitiveGeometry::isConvexPolygon(*polygon);
+                float area = PrimitiveGeometry::calculatePolygonArea(*polygon);
+                auto simplified = PrimitiveGeometry::simplifyPolygon(*polygon, 1.5f);
+                doNotOptimize(convex);
+                doNotOptimize(area);
+                doNotOptimize(simplified.size());
+            }
+            return iterations * polygon->size();
+        };
+    };
+}
+
+/**
+ * @brief TextRenderer::measureText, which resolves every codepoint through getGlyphInfo
+ */
+BenchmarkRunner::Factory measureText(const std::string& text) {
+    return [text]() -> BenchmarkRunner::Body {
+        auto font_manager = std::make_shared<FontManager>();
+        auto text_renderer = std::make_shared<TextRenderer>(*font_manager);
+        if (!text_renderer->initialize()) {
+            return {};
+        }
+
+        uint32_t font_id = font_manager->getDefaultFontId();
+        if (!font_manager->getFont(font_id)) {
+            return {};
+        }
+
+        return [font_manager, text_renderer, text, font_id](uint64_t iterations) -> uint64_t {
+            for (uint64_t it = 0; it < iterations; ++it) {
+                auto metrics = text_renderer->measureText(text, font_id, 18.0f);
+                doNotOptimize(metrics.width);
+            }
+            return iterations * text.size();
+        };
+    };
+}
+
+} // anonymous namespace
+
+void registerRenderBenchmarks(BenchmarkRunner& runner) {
+    runner.add("render", "optimize_command_order_1k_4layers",
+               "Server::optimizeCommandOrder on 1000 commands across 4 layers",
+               optimizeCommandOrder(1000, 4));
+    runner.add("render", "optimize_command_order_10k_32layers",
+               "Server::optimizeCommandOrder on 10000 commands across 32 layers",
+               optimizeCommandOrder(10000, 32));
+
+    runner.add("render", "batch_add_quads_1tex",
+               "BatchRenderer::drawQuads (addQuadToBatch) 256 quads into one texture batch",
+               batchAddQuads(256, 1));
+    runner.add("render", "batch_add_quads_8tex",
+               "BatchRenderer::drawQuads (addQuadToBatch) 256 quads into each of 8 texture batches",
+               batchAddQuads(256, 8));
+
+    runner.add("render", "tessellate_arc_64",
+               "PrimitiveGeometry::generateArcPoints with 64 segments",
+               tessellateArcs(64));
+    runner.add("render", "tessellate_bezier_cubic_32",
+               "PrimitiveGeometry::generateBezierPoints (cubic) with 32 segments",
+               tessellateBeziers(32));
+    runner.add("render", "polygon_analysis_256",
+               "PrimitiveGeometry convexity/area/simplify on a 256-vertex star",
+               polygonAnalysis(256));
+
+    runner.add("text", "measure_short",
+               "TextRenderer::measureText on a 12-character label",
+               measureText("Temperature:"), true);
+    runner.add("text", "measure_paragraph",
+               "TextRenderer::measureText on a 400-character paragraph",
+               measureText(std::string(
+                   "The quick brown fox jumps over the lazy dog while the server renders "
+                   "dashboards, charts and consoles for dozens of clients at sixty frames "
+                   "per second. ") + std::string(
+                   "Kerning, glyph lookup and UTF-8 decoding all sit on this path, so every "
+                   "label measured for alignment pays for them again and again and again. "
+                   "0123456789 !@#$%^&*() [] {} <> ?/ ;: '\" ~ ` | \\ +-=_ ,. end.")), true);
+}
+
+} // namespace Kairos::Bench
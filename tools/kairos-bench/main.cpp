@@ -0,0 +1,150 @@
+// tools/kairos-bench/main.cpp
+#include "BenchmarkRunner.hpp"
+
+#include <Utils/Logger.hpp>
+
+#include <raylib.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace Kairos;
+using namespace Kairos::Bench;
+
+namespace {
+
+struct Options {
+    BenchmarkRunner::Config runner;
+    std::string output_file;
+    std::string log_file = "kairos_bench.log";
+    bool list_only = false;
+    bool no_window = false;
+    bool print_table = true;
+};
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n\n";
+    std::cout << "Runs microbenchmarks for Kairos server hot paths and emits JSON results.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --filter <text>          Only run benchmarks whose group/name contains <text>\n";
+    std::cout << "  --samples <count>        Timed samples per benchmark (default: 10)\n";
+    std::cout << "  --min-time <ms>          Minimum duration of one sample (default: 50)\n";
+    std::cout << "  --warmup <count>         Untimed warmup samples (default: 1)\n";
+    std::cout << "  --output <file>          Write JSON results to <file> (default: stdout)\n";
+    std::cout << "  --log-file <path>        Log file used by logger benchmarks (default: kairos_bench.log)\n";
+    std::cout << "  --no-window              Skip benchmarks that need a GL context\n";
+    std::cout << "  --quiet                  Do not print the summary table to stderr\n";
+    std::cout << "  --list                   List available benchmarks and exit\n";
+    std::cout << "  --help                   Show this help message\n";
+}
+
+bool parseCommandLine(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.runner.filter = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.runner.samples = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.runner.min_sample_time_ms = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            options.runner.warmup_samples = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output_file = argv[++i];
+        } else if (arg == "--log-file" && i + 1 < argc) {
+            options.log_file = argv[++i];
+        } else if (arg == "--no-window") {
+            options.no_window = true;
+        } else if (arg == "--quiet") {
+            options.print_table = false;
+        } else if (arg == "--list") {
+            options.list_only = true;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        if (!parseCommandLine(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Keep benchmark logging off the console so it does not skew timings or the JSON
+    Logger::Config log_config;
+    log_config.log_level = Logger::Level::Warning;
+    log_config.log_to_console = false;
+    log_config.log_to_file = true;
+    log_config.log_file = options.log_file;
+    Logger::initialize(log_config);
+
+    BenchmarkRunner runner(options.runner);
+    registerProtocolBenchmarks(runner);
+    registerRenderBenchmarks(runner);
+    registerLoggerBenchmarks(runner);
+
+    if (options.list_only) {
+        for (const auto* benchmark : runner.getSelected()) {
+            std::cout << benchmark->group << "/" << benchmark->name
+                      << (benchmark->needs_window ? " [gl]" : "") << "\n"
+                      << "    " << benchmark->description << "\n";
+        }
+        return 0;
+    }
+
+    // Text benchmarks need raylib's default font, which requires a GL context
+    bool window_opened = false;
+    if (runner.needsWindow() && !options.no_window) {
+        SetTraceLogLevel(LOG_WARNING);
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(64, 64, "kairos-bench");
+        window_opened = IsWindowReady();
+        if (!window_opened) {
+            std::cerr << "Could not create a hidden window; GL benchmarks will be skipped" << std::endl;
+        }
+    }
+
+    runner.setWindowAvailable(window_opened);
+    auto results = runner.runAll();
+
+    if (window_opened) {
+        CloseWindow();
+    }
+
+    if (options.print_table) {
+        std::cerr << "\n" << BenchmarkRunner::toTable(results) << std::endl;
+    }
+
+    std::string json = BenchmarkRunner::toJson(results);
+    if (options.output_file.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_file);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.output_file << std::endl;
+            return 1;
+        }
+        file << json;
+        std::cerr << "Results written to " << options.output_file << std::endl;
+    }
+
+    Logger::shutdown();
+    return 0;
+}
@@ -0,0 +1,391 @@
+// tools/kairos-conformance/ConformanceRunner.cpp
+#include "ConformanceRunner.hpp"
+
+#include <Core/CommandProcessor.hpp>
+#include <Core/FontManager.hpp>
+#include <Core/LayerManager.hpp>
+#include <Core/RaylibRenderer.hpp>
+#include <Core/SceneSnapshot.hpp>
+#include <Core/Server.hpp>
+#include <Utils/Logger.hpp>
+#include <Clock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+namespace Kairos::Conformance {
+
+namespace {
+
+bool isDrawing(RenderCommand::Type type) {
+    switch (type) {
+        case RenderCommand::Type::DRAW_POINT:
+        case RenderCommand::Type::DRAW_LINE:
+        case RenderCommand::Type::DRAW_RECTANGLE:
+        case RenderCommand::Type::DRAW_CIRCLE:
+        case RenderCommand::Type::DRAW_ARC:
+        case RenderCommand::Type::DRAW_POLYGON:
+        case RenderCommand::Type::DRAW_ROUNDED_RECTANGLE:
+        case RenderCommand::Type::FILL_GRADIENT:
+        case RenderCommand::Type::DRAW_TEXT:
+        case RenderCommand::Type::DRAW_TEXTURED_QUADS:
+        case RenderCommand::Type::DRAW_SPRITES:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // anonymous namespace
+
+ConformanceRunner::ConformanceRunner() : ConformanceRunner(Config{}) {}
+
+ConformanceRunner::ConformanceRunner(const Config& config) : m_config(config) {}
+
+ConformanceRunner::SceneResult ConformanceRunner::run(const SceneScript& scene, CompositionMode mode) {
+    SceneResult result;
+    result.scene = scene.name;
+    result.mode = mode;
+    result.messages = scene.getMessageCount();
+    result.frames = scene.frames.size();
+
+    Image actual = {0};
+    std::string snapshot_error;
+    if (!render(scene, mode, actual, result.unconverted, result.message, snapshot_error)) {
+        result.status = Status::Error;
+        return result;
+    }
+    if (!snapshot_error.empty()) {
+        result.status = Status::Failed;
+        result.message = snapshot_error;
+        UnloadImage(actual);
+        return result;
+    }
+    ImageCompare::toRGBA8(actual);
+
+    std::error_code ec;
+    std::string golden_path = goldenPath(result);
+
+    if (m_config.update) {
+        std::filesystem::create_directories(m_config.golden_dir, ec);
+        if (ExportImage(actual, golden_path.c_str())) {
+            result.status = Status::Updated;
+            result.message = golden_path;
+        } else {
+            result.status = Status::Error;
+            result.message = "Failed to write " + golden_path;
+        }
+        UnloadImage(actual);
+        return result;
+    }
+
+    std::filesystem::create_directories(m_config.output_dir, ec);
+    std::string actual_path = outputPath(result, "actual");
+
+    if (!std::filesystem::exists(golden_path)) {
+        ExportImage(actual, actual_path.c_str());
+        result.status = Status::MissingGolden;
+        result.message = "No golden image, capture written to " + actual_path;
+        UnloadImage(actual);
+        return result;
+    }
+
+    Image expected = LoadImage(golden_path.c_str());
+    ImageCompare::toRGBA8(expected);
+    result.compare = ImageCompare::compare(expected, actual, m_config.tolerance);
+
+    if (!result.compare.size_match) {
+        result.status = Status::Failed;
+        result.message = "Size mismatch: golden " + std::to_string(expected.width) + "x" +
+                         std::to_string(expected.height);
+        ExportImage(actual, actual_path.c_str());
+    } else if (result.compare.differing_pixels > m_config.max_diff_pixels) {
+        result.status = Status::Failed;
+        std::string diff_path = outputPath(result, "diff");
+        Image diff = ImageCompare::makeDiffImage(expected, actual, m_config.tolerance);
+        ExportImage(diff, diff_path.c_str());
+        ExportImage(actual, actual_path.c_str());
+        UnloadImage(diff);
+        result.message = "See " + diff_path;
+    } else {
+        result.status = Status::Passed;
+    }
+
+    UnloadImage(expected);
+    UnloadImage(actual);
+    return result;
+}
+
+bool ConformanceRunner::render(const SceneScript& scene, CompositionMode mode, Image& frame,
+                               std::vector<MessageType>& unconverted, std::string& error,
+                               std::string& snapshot_error) {
+    // Determinism over fidelity: no MSAA, no vsync, no frame cap
+    RaylibRenderer::Config renderer_config;
+    renderer_config.window_width = scene.width;
+    renderer_config.window_height = scene.height;
+    renderer_config.target_fps = 0;
+    renderer_config.enable_vsync = false;
+    renderer_config.enable_antialiasing = false;
+    renderer_config.hidden = true;
+    renderer_config.window_title = "kairos-conformance";
+    renderer_config.layer_caching = (mode != CompositionMode::Direct);
+    if (mode == CompositionMode::Viewport) {
+        renderer_config.canvas_width = scene.width;
+        renderer_config.canvas_height = scene.height;
+        renderer_config.viewports = viewportsFor(scene);
+    }
+    renderer_config.retain_scene = true;    // As with --snapshot
+
+    RaylibRenderer renderer(renderer_config);
+    if (!renderer.initialize()) {
+        error = "Renderer initialization failed (is a GL context available?)";
+        return false;
+    }
+
+    bool captured = false;
+    {
+        // Scoped so fonts are unloaded while the GL context still exists
+        LayerManager layer_manager(renderer_config.max_layers);
+        FontManager font_manager;
+        if (!font_manager.initialize()) {
+            error = "Font manager initialization failed";
+        } else {
+            // No processing thread: batches are submitted on this thread, as in Server::processFrame
+            CommandProcessor processor(renderer, layer_manager, font_manager);
+
+            // Virtual time, so tweens are where the script's waits put them
+            const Clock::Mode clock_mode = Clock::getMode();
+            Clock::setMode(Clock::Mode::Virtual);
+
+            for (size_t index = 0; index < scene.frames.size(); ++index) {
+                if (index < scene.frame_waits_ms.size()) {
+                    Clock::advance(std::chrono::milliseconds(scene.frame_waits_ms[index]));
+                }
+                std::vector<RenderCommand> commands;
+
+                for (const auto& message : scene.frames[index]) {
+                    const MessageHeader& header = message.header;
+
+                    if (header.type == MessageType::UPLOAD_FONT_TEXTURE) {
+                        FontTextureData data;
+                        std::memcpy(&data, message.payload.data(), sizeof(FontTextureData));
+                        renderer.uploadTexture(data.texture_id, data.width, data.height, data.format,
+                                               message.payload.data() + sizeof(FontTextureData),
+                                               data.data_size);
+                        continue;
+                    }
+
+                    if (!CommandConverter::canConvert(header.type)) {
+                        if (std::find(unconverted.begin(), unconverted.end(), header.type) == unconverted.end()) {
+                            unconverted.push_back(header.type);
+                        }
+                        continue;
+                    }
+
+                    RenderCommand command = CommandConverter::fromNetworkMessage(header, message.payload.data());
+                    command.layer_id = header.layer_id;
+                    command.sequence_id = header.sequence;
+                    command.priority = CommandConverter::assignPriority(header.type, header.layer_id);
+                    commands.push_back(std::move(command));
+                }
+
+                renderer.beginFrame();
+                Server::optimizeCommandOrder(commands);
+                processor.processCommandBatch(commands);
+
+                if (index + 1 == scene.frames.size()) {
+                    renderer.requestFrameCapture();
+                }
+                renderer.endFrame();
+            }
+            Clock::setMode(clock_mode);
+
+            captured = renderer.takeCapturedFrame(frame);
+            if (!captured) {
+                error = "Frame readback failed";
+            } else {
+                checkSnapshot(scene, mode, renderer, snapshot_error);
+            }
+        }
+    }
+
+    renderer.shutdown();
+    return captured;
+}
+
+bool ConformanceRunner::checkSnapshot(const SceneScript& scene, CompositionMode mode, RaylibRenderer& renderer,
+                                      std::string& error) const {
+    // A layer keeps the drawing of the latest frame that drew on it, less
+    // what went into pixmaps or was cleared after it
+    std::map<uint8_t, size_t> expected;
+    std::unordered_map<uint32_t, bool> into_pixmap;
+    for (const auto& messages : scene.frames) {
+        std::map<uint8_t, size_t> drawn;
+        for (const auto& message : messages) {
+            const MessageHeader& header = message.header;
+            if (!CommandConverter::canConvert(header.type)) {
+                continue;
+            }
+            RenderCommand command = CommandConverter::fromNetworkMessage(header, message.payload.data());
+            if (command.type == RenderCommand::Type::SET_PIXMAP_TARGET) {
+                into_pixmap[header.client_id] = (command.pixmap.id != 0);
+            } else if (command.type == RenderCommand::Type::CLEAR_LAYER) {
+                drawn.erase(header.layer_id);
+                expected.erase(header.layer_id);
+            } else if (isDrawing(command.type) && !into_pixmap[header.client_id]) {
+                drawn[header.layer_id]++;
+            }
+        }
+        for (const auto& [layer_id, count] : drawn) {
+            expected[layer_id] = count;
+        }
+    }
+    
+    SceneState state;
+    renderer.exportScene(state, [](const SceneState::Texture&) { return false; });
+    
+    std::error_code ec;
+    std::filesystem::create_directories(m_config.output_dir, ec);
+    std::filesystem::path path(m_config.output_dir);
+    path /= scene.name + "." + getModeName(mode) + ".snapshot";
+    
+    SceneSnapshot snapshot(SceneSnapshot::Config{path.string()});
+    SceneState restored;
+    if (!snapshot.writeNow(std::move(state)) || !snapshot.load(restored)) {
+        error = "Could not write and read back " + path.string();
+        return false;
+    }
+    
+    for (const auto& [layer_id, count] : expected) {
+        size_t retained = 0;
+        for (const auto& layer : restored.layers) {
+            if (layer.id == layer_id) {
+                retained = static_cast<size_t>(std::count_if(layer.commands.begin(), layer.commands.end(),
+                    [](const RenderCommand& command) { return isDrawing(command.type); }));
+            }
+        }
+        if (retained < count) {
+            error = "Snapshot holds " + std::to_string(retained) + " of layer " + std::to_string(layer_id) +
+                    "'s " + std::to_string(count) + " draws";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<OutputViewport> ConformanceRunner::viewportsFor(const SceneScript& scene) {
+    // The whole canvas at half size, its top-left quarter at full size
+    // beside it, and the whole canvas squashed to half height below both
+    // showing layers 0-1 only: mapping, scale and layer subsets at once
+    const int32_t width = static_cast<int32_t>(scene.width);
+    const int32_t height = static_cast<int32_t>(scene.height);
+    
+    std::vector<OutputViewport> viewports(3);
+    viewports[0] = {0, 0, width, height, 0, 0, width / 2, height / 2};
+    viewports[1] = {0, 0, width / 2, height / 2, width / 2, 0, width / 2, height / 2};
+    viewports[2] = {0, 0, width, height, 0, height / 2, width, height / 2};
+    viewports[0].layers.set();
+    viewports[1].layers.set();
+    viewports[2].layers.set(0);
+    viewports[2].layers.set(1);
+    return viewports;
+}
+
+std::string ConformanceRunner::goldenPath(const SceneResult& result) const {
+    std::filesystem::path path(m_config.golden_dir);
+    path /= result.scene + "." + getModeName(result.mode) + ".png";
+    return path.string();
+}
+
+std::string ConformanceRunner::outputPath(const SceneResult& result, const char* suffix) const {
+    std::filesystem::path path(m_config.output_dir);
+    path /= result.scene + "." + getModeName(result.mode) + "." + suffix + ".png";
+    return path.string();
+}
+
+const char* ConformanceRunner::getModeName(CompositionMode mode) {
+    switch (mode) {
+        case CompositionMode::Direct: return "direct";
+        case CompositionMode::Cached: return "cached";
+        case CompositionMode::Viewport: return "viewport";
+        default: return "unknown";
+    }
+}
+
+const char* ConformanceRunner::getStatusName(Status status) {
+    switch (status) {
+        case Status::Passed: return "passed";
+        case Status::Failed: return "failed";
+        case Status::Updated: return "updated";
+        case Status::MissingGolden: return "missing_golden";
+        case Status::Error: return "error";
+        default: return "unknown";
+    }
+}
+
+std::string ConformanceRunner::toJson(const std::vector<SceneResult>& results) {
+    std::stringstream ss;
+    ss << std::setprecision(4) << std::fixed;
+
+    ss << "{\n";
+    ss << "  \"tool\": \"kairos-conformance\",\n";
+    ss << "  \"protocol_version\": " << PROTOCOL_VERSION << ",\n";
+    ss << "  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        ss << "    {\n";
+        ss << "      \"scene\": \"" << result.scene << "\",\n";
+        ss << "      \"mode\": \"" << getModeName(result.mode) << "\",\n";
+        ss << "      \"status\": \"" << getStatusName(result.status) << "\",\n";
+        ss << "      \"frames\": " << result.frames << ",\n";
+        ss << "      \"messages\": " << result.messages << ",\n";
+        ss << "      \"differing_pixels\": " << result.compare.differing_pixels << ",\n";
+        ss << "      \"max_channel_delta\": " << static_cast<int>(result.compare.max_channel_delta) << ",\n";
+        ss << "      \"mean_abs_error\": " << result.compare.mean_abs_error << ",\n";
+        ss << "      \"unconverted\": [";
+        for (size_t t = 0; t < result.unconverted.size(); ++t) {
+            ss << (t ? ", " : "") << "\"" << messageTypeToString(result.unconverted[t]) << "\"";
+        }
+        ss << "],\n";
+        ss << "      \"message\": \"" << result.message << "\"\n";
+        ss << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    ss << "  ]\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+std::string ConformanceRunner::toTable(const std::vector<SceneResult>& results) {
+    std::stringstream ss;
+    ss << std::left << std::setw(28) << "scene" << std::setw(8) << "mode"
+       << std::setw(16) << "status" << std::right << std::setw(10) << "diff px"
+       << std::setw(8) << "max d" << "  unconverted\n";
+    ss << std::string(90, '-') << "\n";
+
+    for (const auto& result : results) {
+        ss << std::left << std::setw(28) << result.scene
+           << std::setw(8) << getModeName(result.mode)
+           << std::setw(16) << getStatusName(result.status) << std::right
+           << std::setw(10) << result.compare.differing_pixels
+           << std::setw(8) << static_cast<int>(result.compare.max_channel_delta) << "  ";
+        for (size_t t = 0; t < result.unconverted.size(); ++t) {
+            ss << (t ? "," : "") << messageTypeToString(result.unconverted[t]);
+        }
+        ss << "\n";
+        if (!result.message.empty() && result.status != Status::Passed) {
+            ss << "    " << result.message << "\n";
+        }
+    }
+
+    return ss.str();
+}
+
+} // namespace Kairos::Conformance
@@ -0,0 +1,98 @@
+// tools/kairos-conformance/ConformanceRunner.hpp
+#pragma once
+
+#include "ImageCompare.hpp"
+#include "SceneScript.hpp"
+
+#include <Graphics/OutputViewport.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos {
+class RaylibRenderer;
+}
+
+namespace Kairos::Conformance {
+
+/**
+ * @brief Replays scene scripts through the real command path and checks the pixels
+ *
+ * Each scene gets a hidden window (no MSAA, no vsync) and the same pipeline the
+ * server frame loop uses: CommandConverter -> priority assignment ->
+ * Server::optimizeCommandOrder -> CommandProcessor::processCommandBatch ->
+ * RaylibRenderer. The last frame is read back before it is presented and
+ * compared with golden/<scene>.<mode>.png. Texture uploads go straight to
+ * the renderer, like Server::uploadTexture.
+ *
+ * The renderer retains the scene as with --snapshot; after the last frame a
+ * snapshot is written to the output directory and read back, and a scene
+ * fails if it lacks the drawing of any layer.
+ */
+class ConformanceRunner {
+public:
+    // RaylibRenderer's composition paths
+    enum class CompositionMode {
+        Direct,     // layer_caching = false
+        Cached,     // layer_caching = true, layers composited from render textures
+        Viewport    // Layer caches composited through viewports (see viewportsFor)
+    };
+
+    struct Config {
+        std::string golden_dir;
+        std::string output_dir = "conformance-out";
+        uint8_t tolerance = 2;           // Per-channel delta still considered equal
+        uint64_t max_diff_pixels = 0;    // Differing pixels allowed before failing
+        bool update = false;             // Write the capture as the new golden
+    };
+
+    enum class Status {
+        Passed,
+        Failed,
+        Updated,
+        MissingGolden,
+        Error
+    };
+
+    struct SceneResult {
+        std::string scene;
+        CompositionMode mode = CompositionMode::Direct;
+        Status status = Status::Error;
+        ImageCompare::Result compare;
+        size_t messages = 0;
+        size_t frames = 0;
+        std::vector<MessageType> unconverted;   // Message types CommandConverter skipped
+        std::string message;
+    };
+
+public:
+    ConformanceRunner();
+    explicit ConformanceRunner(const Config& config);
+
+    SceneResult run(const SceneScript& scene, CompositionMode mode);
+
+    const Config& getConfig() const { return m_config; }
+
+    static const char* getModeName(CompositionMode mode);
+    static const char* getStatusName(Status status);
+
+    // Reporting
+    static std::string toJson(const std::vector<SceneResult>& results);
+    static std::string toTable(const std::vector<SceneResult>& results);
+
+private:
+    bool render(const SceneScript& scene, CompositionMode mode, Image& frame,
+                std::vector<MessageType>& unconverted, std::string& error,
+                std::string& snapshot_error);
+    bool checkSnapshot(const SceneScript& scene, CompositionMode mode, RaylibRenderer& renderer,
+                       std::string& error) const;
+    static std::vector<OutputViewport> viewportsFor(const SceneScript& scene);
+    std::string goldenPath(const SceneResult& result) const;
+    std::string outputPath(const SceneResult& result, const char* suffix) const;
+
+private:
+    Config m_config;
+};
+
+} // namespace Kairos::Conformance
@@ -0,0 +1,89 @@
+// tools/kairos-conformance/ImageCompare.cpp
+#include "ImageCompare.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Kairos::Conformance {
+
+namespace {
+
+uint8_t maxChannelDelta(const uint8_t* a, const uint8_t* b) {
+    uint8_t delta = 0;
+    for (int c = 0; c < 4; ++c) {
+        delta = std::max<uint8_t>(delta, static_cast<uint8_t>(std::abs(int(a[c]) - int(b[c]))));
+    }
+    return delta;
+}
+
+} // anonymous namespace
+
+ImageCompare::Result ImageCompare::compare(const Image& expected, const Image& actual, uint8_t tolerance) {
+    Result result;
+    result.width = static_cast<uint32_t>(actual.width);
+    result.height = static_cast<uint32_t>(actual.height);
+    result.size_match = expected.width == actual.width && expected.height == actual.height;
+    if (!result.size_match || !expected.data || !actual.data) {
+        return result;
+    }
+
+    const auto* e = static_cast<const uint8_t*>(expected.data);
+    const auto* a = static_cast<const uint8_t*>(actual.data);
+    size_t pixel_count = static_cast<size_t>(actual.width) * actual.height;
+    uint64_t total_delta = 0;
+
+    for (size_t i = 0; i < pixel_count; ++i) {
+        const uint8_t* ep = e + i * 4;
+        const uint8_t* ap = a + i * 4;
+        for (int c = 0; c < 4; ++c) {
+            total_delta += static_cast<uint64_t>(std::abs(int(ep[c]) - int(ap[c])));
+        }
+
+        uint8_t delta = maxChannelDelta(ep, ap);
+        result.max_channel_delta = std::max(result.max_channel_delta, delta);
+        if (delta > tolerance) {
+            result.differing_pixels++;
+        }
+    }
+
+    result.mean_abs_error = pixel_count > 0 ? static_cast<double>(total_delta) / (pixel_count * 4) : 0.0;
+    return result;
+}
+
+Image ImageCompare::makeDiffImage(const Image& expected, const Image& actual, uint8_t tolerance) {
+    Image diff = GenImageColor(actual.width, actual.height, BLACK);
+    if (expected.width != actual.width || expected.height != actual.height) {
+        return diff;
+    }
+
+    const auto* e = static_cast<const uint8_t*>(expected.data);
+    const auto* a = static_cast<const uint8_t*>(actual.data);
+    auto* d = static_cast<uint8_t*>(diff.data);
+    size_t pixel_count = static_cast<size_t>(actual.width) * actual.height;
+
+    for (size_t i = 0; i < pixel_count; ++i) {
+        const uint8_t* ep = e + i * 4;
+        uint8_t* dp = d + i * 4;
+        uint8_t delta = maxChannelDelta(ep, a + i * 4);
+
+        if (delta > tolerance) {
+            dp[0] = static_cast<uint8_t>(std::min(255, 128 + delta));
+            dp[1] = 0;
+            dp[2] = 0;
+        } else {
+            uint8_t luma = static_cast<uint8_t>((ep[0] * 77 + ep[1] * 150 + ep[2] * 29) >> 10);
+            dp[0] = dp[1] = dp[2] = luma;
+        }
+        dp[3] = 255;
+    }
+
+    return diff;
+}
+
+void ImageCompare::toRGBA8(Image& image) {
+    if (image.data && image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+}
+
+} // namespace Kairos::Conformance
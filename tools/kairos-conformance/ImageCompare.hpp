@@ -0,0 +1,36 @@
+// tools/kairos-conformance/ImageCompare.hpp
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+
+namespace Kairos::Conformance {
+
+/**
+ * @brief Per-pixel comparison of two RGBA8 images
+ *
+ * A pixel differs when any channel differs by more than the tolerance.
+ */
+class ImageCompare {
+public:
+    struct Result {
+        bool size_match = false;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t differing_pixels = 0;
+        uint8_t max_channel_delta = 0;
+        double mean_abs_error = 0.0;     // Mean per-channel delta over all pixels
+    };
+
+public:
+    // Both images must be PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    static Result compare(const Image& expected, const Image& actual, uint8_t tolerance);
+
+    // Differing pixels in red (brighter = larger delta) over a dimmed copy of expected
+    static Image makeDiffImage(const Image& expected, const Image& actual, uint8_t tolerance);
+
+    static void toRGBA8(Image& image);
+};
+
+} // namespace Kairos::Conformance
@@ -0,0 +1,511 @@
+// tools/kairos-conformance/SceneScript.cpp
+#include "SceneScript.hpp"
+
+#include <Constants.hpp>
+#include <Utils/Logger.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace Kairos::Conformance {
+
+namespace {
+
+/**
+ * @brief Splits a script line into words; a double-quoted run is one word
+ */
+std::vector<std::string> tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+
+    while (i < line.size()) {
+        while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i]))) {
+            ++i;
+        }
+        if (i >= line.size() || line[i] == '#') {
+            break;
+        }
+
+        if (line[i] == '"') {
+            size_t end = line.find('"', i + 1);
+            if (end == std::string::npos) {
+                end = line.size();
+            }
+            tokens.push_back(line.substr(i + 1, end - i - 1));
+            i = end + 1;
+        } else {
+            size_t end = i;
+            while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end]))) {
+                ++end;
+            }
+            tokens.push_back(line.substr(i, end - i));
+            i = end;
+        }
+    }
+
+    return tokens;
+}
+
+class Builder {
+public:
+    explicit Builder(SceneScript& scene) : m_scene(scene) {
+        m_scene.frames.emplace_back();
+        m_scene.frame_waits_ms.push_back(0);
+    }
+
+    void setLayer(uint8_t layer_id) { m_layer_id = layer_id; }
+
+    template<typename T>
+    void add(MessageType type, uint32_t line, const T& data,
+             const void* extra = nullptr, size_t extra_size = 0) {
+        ScriptMessage message;
+        message.line = line;
+        message.payload.resize(sizeof(T) + extra_size);
+        std::memcpy(message.payload.data(), &data, sizeof(T));
+        if (extra_size > 0) {
+            std::memcpy(message.payload.data() + sizeof(T), extra, extra_size);
+        }
+        message.header = ProtocolHelper::createHeader(type, 0, m_sequence++,
+                                                      static_cast<uint32_t>(message.payload.size()),
+                                                      m_layer_id);
+        m_scene.frames.back().push_back(std::move(message));
+    }
+
+    void addEmpty(MessageType type, uint32_t line) {
+        ScriptMessage message;
+        message.line = line;
+        message.header = ProtocolHelper::createHeader(type, 0, m_sequence++, 0, m_layer_id);
+        m_scene.frames.back().push_back(std::move(message));
+    }
+
+    void nextFrame() {
+        m_scene.frames.emplace_back();
+        m_scene.frame_waits_ms.push_back(0);
+    }
+
+    void wait(uint32_t ms) { m_scene.frame_waits_ms.back() += ms; }
+
+private:
+    SceneScript& m_scene;
+    uint8_t m_layer_id = 1;
+    uint32_t m_sequence = 0;
+};
+
+std::vector<uint8_t> makeTexturePixels(uint32_t width, uint32_t height, const std::string& pattern) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            if (pattern == "checker") {
+                bool on = ((x / 4) + (y / 4)) % 2 == 0;
+                p[0] = on ? 255 : 32;
+                p[1] = on ? 200 : 32;
+                p[2] = on ? 0 : 96;
+            } else if (pattern == "gradient") {
+                p[0] = static_cast<uint8_t>(x * 255 / (width > 1 ? width - 1 : 1));
+                p[1] = static_cast<uint8_t>(y * 255 / (height > 1 ? height - 1 : 1));
+                p[2] = 128;
+            } else {
+                p[0] = 64;
+                p[1] = 160;
+                p[2] = 255;
+            }
+            p[3] = 255;
+        }
+    }
+
+    return pixels;
+}
+
+} // anonymous namespace
+
+size_t SceneScript::getMessageCount() const {
+    size_t count = 0;
+    for (const auto& frame : frames) {
+        count += frame.size();
+    }
+    return count;
+}
+
+bool SceneScript::load(const std::string& path, SceneScript& scene) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        Logger::error("Cannot open scene script: {}", path);
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    std::string error;
+    std::string name = std::filesystem::path(path).stem().string();
+    if (!parse(name, buffer.str(), scene, error)) {
+        Logger::error("{}: {}", path, error);
+        return false;
+    }
+    return true;
+}
+
+bool SceneScript::parse(const std::string& name, const std::string& text,
+                        SceneScript& scene, std::string& error) {
+    scene = SceneScript{};
+    scene.name = name;
+    Builder builder(scene);
+
+    std::istringstream input(text);
+    std::string raw_line;
+    uint32_t line_number = 0;
+
+    try {
+        while (std::getline(input, raw_line)) {
+            ++line_number;
+            if (!raw_line.empty() && raw_line.back() == '\r') {
+                raw_line.pop_back();
+            }
+
+            auto tokens = tokenize(raw_line);
+            if (tokens.empty()) {
+                continue;
+            }
+
+            const std::string& op = tokens[0];
+            size_t argc = tokens.size() - 1;
+            auto f = [&](size_t index) { return std::stof(tokens.at(index)); };
+            auto u = [&](size_t index) { return static_cast<uint32_t>(std::stoul(tokens.at(index))); };
+            auto need = [&](size_t count) {
+                if (argc < count) {
+                    throw std::invalid_argument(op + " expects " + std::to_string(count) + " arguments");
+                }
+            };
+
+            if (op == "description") {
+                size_t start = raw_line.find_first_not_of(" \t", raw_line.find(op) + op.size());
+                scene.description = start == std::string::npos ? "" : raw_line.substr(start);
+            } else if (op == "size") {
+                need(2);
+                scene.width = u(1);
+                scene.height = u(2);
+            } else if (op == "layer") {
+                need(1);
+                builder.setLayer(static_cast<uint8_t>(u(1)));
+            } else if (op == "color" || op == "background") {
+                need(3);
+                SetColorData data{};
+                data.gc_id = 0;
+                data.color = Color(static_cast<uint8_t>(u(1)), static_cast<uint8_t>(u(2)),
+                                   static_cast<uint8_t>(u(3)),
+                                   static_cast<uint8_t>(argc >= 4 ? u(4) : 255));
+                builder.add(op == "color" ? MessageType::SET_FOREGROUND : MessageType::SET_BACKGROUND,
+                            line_number, data);
+            } else if (op == "line_width") {
+                need(1);
+                SetLineAttributesData data{};
+                data.line_width = static_cast<uint8_t>(u(1));
+                data.line_style = Constants::LINE_SOLID;
+                builder.add(MessageType::SET_LINE_ATTRIBUTES, line_number, data);
+            } else if (op == "point") {
+                need(2);
+                DrawPointData data{};
+                data.position = {f(1), f(2)};
+                builder.add(MessageType::DRAW_POINT, line_number, data);
+            } else if (op == "line") {
+                need(4);
+                DrawLineData data{};
+                data.start = {f(1), f(2)};
+                data.end = {f(3), f(4)};
+                builder.add(MessageType::DRAW_LINE, line_number, data);
+            } else if (op == "rect" || op == "fill_rect") {
+                need(4);
+                DrawRectangleData data{};
+                data.position = {f(1), f(2)};
+                data.width = f(3);
+                data.height = f(4);
+                builder.add(op == "rect" ? MessageType::DRAW_RECTANGLE : MessageType::FILL_RECTANGLE,
+                            line_number, data);
+            } else if (op == "arc" || op == "fill_arc") {
+                need(6);
+                DrawArcData data{};
+                data.center = {f(1), f(2)};
+                data.width = f(3);
+                data.height = f(4);
+                // Scripts use degrees; the protocol carries 1/64 degree
+                data.angle1 = static_cast<int16_t>(std::lround(f(5) * 64.0f));
+                data.angle2 = static_cast<int16_t>(std::lround(f(6) * 64.0f));
+                builder.add(op == "arc" ? MessageType::DRAW_ARC : MessageType::FILL_ARC, line_number, data);
+            } else if (op == "polygon" || op == "fill_polygon") {
+                if (argc < 6 || argc % 2 != 0) {
+                    throw std::invalid_argument(op + " expects at least 3 x/y pairs");
+                }
+                std::vector<Point> points;
+                for (size_t i = 1; i + 1 <= argc; i += 2) {
+                    points.emplace_back(f(i), f(i + 1));
+                }
+                DrawPolygonData data{};
+                data.point_count = static_cast<uint16_t>(points.size());
+                builder.add(op == "polygon" ? MessageType::DRAW_POLYGON : MessageType::FILL_POLYGON,
+                            line_number, data, points.data(), points.size() * sizeof(Point));
+            } else if (op == "rounded_rect" || op == "fill_rounded_rect") {
+                need(5);
+                DrawRoundedRectangleData data{};
+                data.position = {f(1), f(2)};
+                data.width = f(3);
+                data.height = f(4);
+                for (size_t i = 0; i < 4; ++i) {
+                    data.radii[i] = argc >= 8 ? f(5 + i) : f(5);
+                }
+                builder.add(op == "rounded_rect" ? MessageType::DRAW_ROUNDED_RECTANGLE
+                                                 : MessageType::FILL_ROUNDED_RECTANGLE,
+                            line_number, data);
+            } else if (op == "gradient") {
+                need(12);
+                if ((tokens[1] != "rect" && tokens[1] != "ellipse") ||
+                    (tokens[2] != "linear" && tokens[2] != "radial")) {
+                    throw std::invalid_argument("gradient expects rect|ellipse linear|radial");
+                }
+                FillGradientData data{};
+                data.shape = tokens[1] == "rect" ? Constants::GRADIENT_SHAPE_RECTANGLE
+                                                 : Constants::GRADIENT_SHAPE_ELLIPSE;
+                data.kind = tokens[2] == "linear" ? Constants::GRADIENT_LINEAR : Constants::GRADIENT_RADIAL;
+                data.position = {f(3), f(4)};
+                data.width = f(5);
+                data.height = f(6);
+                data.from = {f(7), f(8)};
+                data.to = {f(9), f(10)};
+                data.from_rgba = static_cast<uint32_t>(std::stoul(tokens[11], nullptr, 16));
+                data.to_rgba = static_cast<uint32_t>(std::stoul(tokens[12], nullptr, 16));
+                builder.add(MessageType::FILL_GRADIENT, line_number, data);
+            } else if (op == "text" || op == "image_string") {
+                need(4);
+                const std::string& string = tokens[4];
+                DrawTextData data{};
+                data.font_id = 0;
+                data.position = {f(1), f(2)};
+                data.font_size = f(3);
+                data.text_length = static_cast<uint16_t>(string.size());
+                builder.add(op == "text" ? MessageType::DRAW_TEXT : MessageType::DRAW_IMAGE_STRING,
+                            line_number, data, string.data(), string.size());
+            } else if (op == "texture") {
+                need(4);
+                uint32_t width = u(2);
+                uint32_t height = u(3);
+                auto pixels = makeTexturePixels(width, height, tokens[4]);
+                FontTextureData data{};
+                data.texture_id = u(1);
+                data.width = width;
+                data.height = height;
+                data.format = Constants::PIXEL_FORMAT_RGBA8;
+                data.data_size = static_cast<uint32_t>(pixels.size());
+                builder.add(MessageType::UPLOAD_FONT_TEXTURE, line_number, data, pixels.data(), pixels.size());
+            } else if (op == "quads") {
+                if (argc < 5 || (argc - 1) % 4 != 0) {
+                    throw std::invalid_argument("quads expects a texture id and x/y/w/h groups");
+                }
+                std::vector<TexturedVertex> vertices;
+                for (size_t i = 2; i + 3 <= argc; i += 4) {
+                    float x = f(i), y = f(i + 1), w = f(i + 2), h = f(i + 3);
+                    vertices.emplace_back(x, y, 0.0f, 0.0f);
+                    vertices.emplace_back(x + w, y, 1.0f, 0.0f);
+                    vertices.emplace_back(x + w, y + h, 1.0f, 1.0f);
+                    vertices.emplace_back(x, y + h, 0.0f, 1.0f);
+                }
+                DrawTexturedQuadsData data{};
+                data.texture_id = u(1);
+                data.quad_count = static_cast<uint32_t>(vertices.size() / 4);
+                builder.add(MessageType::DRAW_TEXTURED_QUADS, line_number, data,
+                            vertices.data(), vertices.size() * sizeof(TexturedVertex));
+            } else if (op == "sprites") {
+                if (argc < 7 || (argc - 3) % 4 != 0) {
+                    throw std::invalid_argument("sprites expects a texture id, an atlas w/h and x/y/scale/rotation groups");
+                }
+                std::vector<SpriteInstance> instances;
+                for (size_t i = 4; i + 3 <= argc; i += 4) {
+                    SpriteInstance sprite{};
+                    sprite.position = {f(i), f(i + 1)};
+                    sprite.scale_x = f(i + 2);
+                    sprite.scale_y = f(i + 2);
+                    sprite.rotation = f(i + 3);
+                    sprite.atlas_width = static_cast<uint16_t>(u(2));
+                    sprite.atlas_height = static_cast<uint16_t>(u(3));
+                    sprite.color = 0xFFFFFFFF;
+                    instances.push_back(sprite);
+                }
+                DrawSpritesInstancedData data{};
+                data.texture_id = u(1);
+                data.instance_count = static_cast<uint32_t>(instances.size());
+                builder.add(MessageType::DRAW_SPRITES_INSTANCED, line_number, data,
+                            instances.data(), instances.size() * sizeof(SpriteInstance));
+            } else if (op == "visibility") {
+                need(2);
+                LayerVisibilityData data{};
+                data.layer_id = static_cast<uint8_t>(u(1));
+                data.visible = static_cast<uint8_t>(u(2) != 0);
+                builder.add(MessageType::SET_LAYER_VISIBILITY, line_number, data);
+            } else if (op == "layer_transform") {
+                need(6);
+                LayerTransformData data{};
+                data.a = f(1);
+                data.b = f(2);
+                data.c = f(3);
+                data.d = f(4);
+                data.tx = f(5);
+                data.ty = f(6);
+                if (tokens.size() > 7 && tokens[7] == "rerasterize") {
+                    data.flags = Constants::LAYER_TRANSFORM_RERASTERIZE;
+                }
+                builder.add(MessageType::SET_LAYER_TRANSFORM, line_number, data);
+            } else if (op == "clip") {
+                need(4);
+                ClipRectData data{};
+                data.x = f(1);
+                data.y = f(2);
+                data.width = f(3);
+                data.height = f(4);
+                builder.add(MessageType::PUSH_CLIP, line_number, data);
+            } else if (op == "unclip") {
+                builder.addEmpty(MessageType::POP_CLIP, line_number);
+            } else if (op == "pixmap") {
+                need(3);
+                CreatePixmapData data{};
+                data.pixmap_id = u(1);
+                data.width = u(2);
+                data.height = u(3);
+                builder.add(MessageType::CREATE_PIXMAP, line_number, data);
+            } else if (op == "free_pixmap") {
+                need(1);
+                FreePixmapData data{};
+                data.pixmap_id = u(1);
+                builder.add(MessageType::FREE_PIXMAP, line_number, data);
+            } else if (op == "target") {
+                need(1);
+                PixmapTargetData data{};
+                data.pixmap_id = u(1);
+                if (tokens.size() > 2 && tokens[2] == "clear") {
+                    data.flags = Constants::PIXMAP_TARGET_CLEAR;
+                }
+                builder.add(MessageType::SET_PIXMAP_TARGET, line_number, data);
+            } else if (op == "copy") {
+                need(6);
+                CopyAreaData data{};
+                data.src_x = static_cast<int32_t>(f(1));
+                data.src_y = static_cast<int32_t>(f(2));
+                data.width = u(3);
+                data.height = u(4);
+                data.dst_x = static_cast<int32_t>(f(5));
+                data.dst_y = static_cast<int32_t>(f(6));
+                builder.add(MessageType::COPY_AREA, line_number, data);
+            } else if (op == "object") {
+                need(7);
+                // In Constants::OBJECT_SHAPE_* order
+                static const std::vector<std::string> shapes = {"rect", "rounded_rect", "ellipse", "image"};
+                auto shape = std::find(shapes.begin(), shapes.end(), tokens[2]);
+                if (shape == shapes.end()) {
+                    throw std::invalid_argument("object expects rect|rounded_rect|ellipse|image");
+                }
+                ObjectData data{};
+                data.object_id = u(1);
+                data.shape = static_cast<uint8_t>(shape - shapes.begin());
+                data.position = {f(3), f(4)};
+                data.width = f(5);
+                data.height = f(6);
+                data.color = static_cast<uint32_t>(std::stoul(tokens[7], nullptr, 16));
+                data.rotation = argc >= 8 ? f(8) : 0.0f;
+                if (argc >= 9 && data.shape == Constants::OBJECT_SHAPE_IMAGE) {
+                    data.texture_id = u(9);
+                } else if (argc >= 9) {
+                    data.corner_radius = f(9);
+                }
+                data.opacity = 1.0f;
+                builder.add(MessageType::CREATE_OBJECT, line_number, data);
+            } else if (op == "animate") {
+                need(3);
+                // In Constants::EASING_* order
+                static const std::vector<std::string> easings = {"linear", "in", "out", "in_out", "out_back"};
+                auto easing = std::find(easings.begin(), easings.end(), tokens[3]);
+                if (easing == easings.end()) {
+                    throw std::invalid_argument("animate expects linear|in|out|in_out|out_back");
+                }
+                ObjectUpdateData data{};
+                data.object_id = u(1);
+                data.duration_ms = u(2);
+                data.easing = static_cast<uint8_t>(easing - easings.begin());
+
+                size_t next = 4;
+                while (next < tokens.size()) {
+                    const std::string word = tokens[next++];
+                    auto take = [&]() {
+                        if (next >= tokens.size()) {
+                            throw std::invalid_argument("animate " + word + " is missing a value");
+                        }
+                        return tokens[next++];
+                    };
+                    if (word == "repeat") {
+                        data.flags |= Constants::OBJECT_TWEEN_REPEAT;
+                    } else if (word == "alternate") {
+                        data.flags |= Constants::OBJECT_TWEEN_ALTERNATE;
+                    } else if (word == "position") {
+                        data.fields |= Constants::OBJECT_FIELD_POSITION;
+                        data.position.x = std::stof(take());
+                        data.position.y = std::stof(take());
+                    } else if (word == "size") {
+                        data.fields |= Constants::OBJECT_FIELD_SIZE;
+                        data.width = std::stof(take());
+                        data.height = std::stof(take());
+                    } else if (word == "rotation") {
+                        data.fields |= Constants::OBJECT_FIELD_ROTATION;
+                        data.rotation = std::stof(take());
+                    } else if (word == "color") {
+                        data.fields |= Constants::OBJECT_FIELD_COLOR;
+                        data.color = static_cast<uint32_t>(std::stoul(take(), nullptr, 16));
+                    } else if (word == "opacity") {
+                        data.fields |= Constants::OBJECT_FIELD_OPACITY;
+                        data.opacity = std::stof(take());
+                    } else {
+                        throw std::invalid_argument("unknown animate property '" + word + "'");
+                    }
+                }
+                builder.add(MessageType::UPDATE_OBJECT, line_number, data);
+            } else if (op == "delete_object") {
+                need(1);
+                DeleteObjectData data{};
+                data.object_id = u(1);
+                builder.add(MessageType::DELETE_OBJECT, line_number, data);
+            } else if (op == "wait") {
+                need(1);
+                builder.wait(u(1));
+            } else if (op == "clear") {
+                builder.addEmpty(MessageType::CLEAR_LAYER, line_number);
+            } else if (op == "clear_all") {
+                builder.addEmpty(MessageType::CLEAR_ALL_LAYERS, line_number);
+            } else if (op == "frame") {
+                builder.nextFrame();
+            } else {
+                throw std::invalid_argument("unknown operation '" + op + "'");
+            }
+        }
+    } catch (const std::exception& e) {
+        error = "line " + std::to_string(line_number) + ": " + e.what();
+        return false;
+    }
+
+    // A trailing "frame" would otherwise capture an empty frame (one
+    // after a wait is kept: it shows where time took the objects)
+    while (scene.frames.size() > 1 && scene.frames.back().empty() && scene.frame_waits_ms.back() == 0) {
+        scene.frames.pop_back();
+        scene.frame_waits_ms.pop_back();
+    }
+
+    if (scene.width == 0 || scene.height == 0) {
+        error = "scene size must be non-zero";
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Kairos::Conformance
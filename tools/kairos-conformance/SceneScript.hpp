@@ -0,0 +1,73 @@
+// tools/kairos-conformance/SceneScript.hpp
+#pragma once
+
+#include <Protocol.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos::Conformance {
+
+/**
+ * @brief One protocol message from a scene script, header in host byte order
+ */
+struct ScriptMessage {
+    MessageHeader header;
+    std::vector<uint8_t> payload;
+    uint32_t line = 0;
+};
+
+/**
+ * @brief A replayable scene: protocol messages grouped into frames
+ *
+ * Scripts (*.kcs) are line based; '#' starts a comment. The last frame is
+ * the one captured and compared.
+ *
+ *   description <text>          size <width> <height>        layer <id>
+ *   color <r> <g> <b> [a]       SET_FOREGROUND
+ *   background <r> <g> <b> [a]  SET_BACKGROUND
+ *   line_width <w>              SET_LINE_ATTRIBUTES
+ *   point <x> <y>               DRAW_POINT
+ *   line <x1> <y1> <x2> <y2>    DRAW_LINE
+ *   rect / fill_rect <x> <y> <w> <h>
+ *   arc / fill_arc <cx> <cy> <w> <h> <angle1> <angle2>   degrees, sent as 1/64 degree
+ *   polygon / fill_polygon <x> <y> <x> <y> <x> <y> ...
+ *   rounded_rect / fill_rounded_rect <x> <y> <w> <h> <r> [<r> <r> <r>]
+ *   gradient rect|ellipse linear|radial <x> <y> <w> <h> <x1> <y1> <x2> <y2> <rrggbbaa> <rrggbbaa>
+ *   text / image_string <x> <y> <size> "<text>"
+ *   texture <id> <w> <h> solid|checker|gradient   UPLOAD_FONT_TEXTURE
+ *   quads <texture> <x> <y> <w> <h> [<x> <y> <w> <h> ...]
+ *   sprites <texture> <atlas w> <atlas h> <cx> <cy> <scale> <degrees> [...]   DRAW_SPRITES_INSTANCED
+ *   visibility <layer> 0|1      SET_LAYER_VISIBILITY
+ *   layer_transform <a> <b> <c> <d> <tx> <ty> [rerasterize]   SET_LAYER_TRANSFORM, current layer
+ *   clip <x> <y> <w> <h> / unclip   PUSH_CLIP / POP_CLIP, current layer
+ *   pixmap <id> <w> <h>         CREATE_PIXMAP; draw it with quads / sprites
+ *   free_pixmap <id>            FREE_PIXMAP
+ *   target <id> [clear]         SET_PIXMAP_TARGET, 0 for the layers
+ *   copy <sx> <sy> <w> <h> <dx> <dy>   COPY_AREA, current layer or pixmap target
+ *   object <id> rect|rounded_rect|ellipse|image <cx> <cy> <w> <h> <rrggbbaa> [<degrees> [<radius>|<texture>]]
+ *                               CREATE_OBJECT, current layer
+ *   animate <id> <ms> linear|in|out|in_out|out_back [repeat] [alternate] [position <x> <y>]
+ *           [size <w> <h>] [rotation <degrees>] [color <rrggbbaa>] [opacity <o>]   UPDATE_OBJECT
+ *   delete_object <id>          DELETE_OBJECT
+ *   wait <ms>                   virtual time passing before this frame; frames are otherwise instant
+ *   clear / clear_all           CLEAR_LAYER / CLEAR_ALL_LAYERS
+ *   frame                       start the next frame
+ */
+struct SceneScript {
+    std::string name;
+    std::string description;
+    uint32_t width = 320;
+    uint32_t height = 240;
+    std::vector<std::vector<ScriptMessage>> frames;
+    std::vector<uint32_t> frame_waits_ms;   // Per frame, from "wait"
+
+    size_t getMessageCount() const;
+
+    static bool load(const std::string& path, SceneScript& scene);
+    static bool parse(const std::string& name, const std::string& text,
+                      SceneScript& scene, std::string& error);
+};
+
+} // namespace Kairos::Conformance
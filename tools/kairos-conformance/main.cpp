@@ -0,0 +1,211 @@
+// tools/kairos-conformance/main.cpp
+#include "ConformanceRunner.hpp"
+#include "SceneScript.hpp"
+
+#include <Utils/Logger.hpp>
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Kairos;
+using namespace Kairos::Conformance;
+
+namespace {
+
+struct Options {
+    ConformanceRunner::Config runner;
+    std::string scenes_dir = KAIROS_CONFORMANCE_DIR "/scenes";
+    std::string filter;
+    std::string json_file;
+    std::string log_file = "kairos_conformance.log";
+    bool run_direct = true;
+    bool run_cached = true;
+    bool run_viewport = true;
+    bool list_only = false;
+    bool print_table = true;
+};
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n\n";
+    std::cout << "Replays scene scripts through the server's command path and compares the\n";
+    std::cout << "rendered frame against golden images. Needs a GL context (hidden window).\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --scenes <dir>           Directory of .kcs scene scripts\n";
+    std::cout << "  --golden <dir>           Directory of golden images\n";
+    std::cout << "  --output <dir>           Where actual/diff images of failures go (default: conformance-out)\n";
+    std::cout << "  --filter <substring>     Only run scenes whose name contains <substring>\n";
+    std::cout << "  --mode <mode>            direct, cached, viewport or all (default: all)\n";
+    std::cout << "  --tolerance <delta>      Per-channel delta treated as equal (default: 2)\n";
+    std::cout << "  --max-diff-pixels <n>    Differing pixels allowed per scene (default: 0)\n";
+    std::cout << "  --update                 Write the rendered frames as the new golden images\n";
+    std::cout << "  --json <file>            Also write results as JSON to <file>\n";
+    std::cout << "  --log-file <path>        Server log file (default: kairos_conformance.log)\n";
+    std::cout << "  --quiet                  Do not print the results table\n";
+    std::cout << "  --list                   List scenes and exit\n";
+    std::cout << "  --help                   Show this help message\n";
+}
+
+bool parseCommandLine(int argc, char* argv[], Options& options) {
+    auto& runner = options.runner;
+    runner.golden_dir = KAIROS_CONFORMANCE_DIR "/golden";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--scenes" && i + 1 < argc) {
+            options.scenes_dir = argv[++i];
+        } else if (arg == "--golden" && i + 1 < argc) {
+            runner.golden_dir = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            runner.output_dir = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode != "direct" && mode != "cached" && mode != "viewport" && mode != "all") {
+                std::cerr << "Unknown mode: " << mode << std::endl;
+                return false;
+            }
+            options.run_direct = (mode == "direct" || mode == "all");
+            options.run_cached = (mode == "cached" || mode == "all");
+            options.run_viewport = (mode == "viewport" || mode == "all");
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            runner.tolerance = static_cast<uint8_t>(std::min(255ul, std::stoul(argv[++i])));
+        } else if (arg == "--max-diff-pixels" && i + 1 < argc) {
+            runner.max_diff_pixels = std::stoull(argv[++i]);
+        } else if (arg == "--update") {
+            runner.update = true;
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.json_file = argv[++i];
+        } else if (arg == "--log-file" && i + 1 < argc) {
+            options.log_file = argv[++i];
+        } else if (arg == "--quiet") {
+            options.print_table = false;
+        } else if (arg == "--list") {
+            options.list_only = true;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> findScenes(const Options& options) {
+    std::vector<std::string> paths;
+    std::error_code ec;
+
+    for (const auto& entry : std::filesystem::directory_iterator(options.scenes_dir, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".kcs") {
+            continue;
+        }
+        if (!options.filter.empty() &&
+            entry.path().stem().string().find(options.filter) == std::string::npos) {
+            continue;
+        }
+        paths.push_back(entry.path().string());
+    }
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        if (!parseCommandLine(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Server and raylib logging go to a file so the table stays readable
+    Logger::Config log_config;
+    log_config.log_level = Logger::Level::Warning;
+    log_config.log_to_console = false;
+    log_config.log_to_file = true;
+    log_config.log_file = options.log_file;
+    Logger::initialize(log_config);
+    SetTraceLogLevel(LOG_WARNING);
+
+    auto paths = findScenes(options);
+    if (paths.empty()) {
+        std::cerr << "No scene scripts found in " << options.scenes_dir << std::endl;
+        Logger::shutdown();
+        return 1;
+    }
+
+    std::vector<SceneScript> scenes;
+    bool load_failed = false;
+    for (const auto& path : paths) {
+        SceneScript scene;
+        if (SceneScript::load(path, scene)) {
+            scenes.push_back(std::move(scene));
+        } else {
+            std::cerr << "Failed to load " << path << ", see " << options.log_file << std::endl;
+            load_failed = true;
+        }
+    }
+
+    if (options.list_only) {
+        for (const auto& scene : scenes) {
+            std::cout << scene.name << " (" << scene.width << "x" << scene.height << ", "
+                      << scene.frames.size() << " frames, " << scene.getMessageCount() << " messages)\n"
+                      << "    " << scene.description << "\n";
+        }
+        Logger::shutdown();
+        return load_failed ? 1 : 0;
+    }
+
+    std::vector<ConformanceRunner::CompositionMode> modes;
+    if (options.run_direct) modes.push_back(ConformanceRunner::CompositionMode::Direct);
+    if (options.run_cached) modes.push_back(ConformanceRunner::CompositionMode::Cached);
+    if (options.run_viewport) modes.push_back(ConformanceRunner::CompositionMode::Viewport);
+
+    ConformanceRunner runner(options.runner);
+    std::vector<ConformanceRunner::SceneResult> results;
+    bool failed = load_failed;
+
+    for (const auto& scene : scenes) {
+        for (auto mode : modes) {
+            auto result = runner.run(scene, mode);
+            if (result.status != ConformanceRunner::Status::Passed &&
+                result.status != ConformanceRunner::Status::Updated) {
+                failed = true;
+            }
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (options.print_table) {
+        std::cout << ConformanceRunner::toTable(results) << std::endl;
+    }
+
+    if (!options.json_file.empty()) {
+        std::ofstream file(options.json_file);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.json_file << std::endl;
+            failed = true;
+        } else {
+            file << ConformanceRunner::toJson(results);
+        }
+    }
+
+    Logger::shutdown();
+    return failed ? 1 : 0;
+}
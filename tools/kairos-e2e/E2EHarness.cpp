@@ -0,0 +1,262 @@
+// tools/kairos-e2e/E2EHarness.cpp
+#include "E2EHarness.hpp"
+#include "SyntheticClient.hpp"
+#include "Workloads.hpp"
+
+#include <Core/Server.hpp>
+#include <Protocol.hpp>
+#include <Utils/Config.hpp>
+#include <Utils/Logger.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Kairos::E2E {
+
+namespace {
+
+SyntheticClient::Snapshot sumSnapshots(const std::vector<std::unique_ptr<SyntheticClient>>& clients) {
+    SyntheticClient::Snapshot total;
+    for (const auto& client : clients) {
+        auto snapshot = client->snapshot();
+        total.ticks_sent += snapshot.ticks_sent;
+        total.messages_sent += snapshot.messages_sent;
+        total.commands_sent += snapshot.commands_sent;
+        total.bytes_sent += snapshot.bytes_sent;
+        total.frame_callbacks += snapshot.frame_callbacks;
+    }
+    return total;
+}
+
+void writeSummary(std::stringstream& ss, const char* name, const SampleSet::Summary& summary, bool last) {
+    ss << "    \"" << name << "\": {"
+       << "\"count\": " << summary.count
+       << ", \"mean\": " << summary.mean
+       << ", \"p50\": " << summary.p50
+       << ", \"p90\": " << summary.p90
+       << ", \"p99\": " << summary.p99
+       << ", \"p999\": " << summary.p999
+       << ", \"max\": " << summary.max << "}"
+       << (last ? "" : ",") << "\n";
+}
+
+void writeRow(std::stringstream& ss, const char* name, const SampleSet::Summary& summary) {
+    ss << std::left << std::setw(22) << name << std::right
+       << std::setw(10) << summary.p50
+       << std::setw(10) << summary.p90
+       << std::setw(10) << summary.p99
+       << std::setw(10) << summary.p999
+       << std::setw(10) << summary.max << "\n";
+}
+
+} // anonymous namespace
+
+E2EHarness::E2EHarness() : E2EHarness(Config{}) {}
+
+E2EHarness::E2EHarness(const Config& config) : m_config(config) {
+    if (m_config.clients == 0) {
+        m_config.clients = 1;
+    }
+}
+
+bool E2EHarness::run(Result& result) {
+    auto workload = createWorkload(m_config.workload, m_config.items_per_tick);
+    if (!workload) {
+        Logger::error("Unknown workload: {}", m_config.workload);
+        return false;
+    }
+    result.workload_description = workload->getDescription();
+
+    // Null renderer, no listening sockets: clients arrive through adoptClientSocket()
+    Kairos::Config server_config = ConfigBuilder()
+        .enableTcp(false)
+        .enableUnixSocket(false)
+        .enableNullRenderer(true)
+        .enableVSync(false)
+        .withTargetFPS(m_config.target_fps)
+        .withMaxClients(m_config.clients)
+        .withBatchSize(m_config.command_batch_size)
+        .enableConsoleLogging(false)
+        .build();
+    server_config.performance().enable_frame_pacing = m_config.frame_pacing;
+
+    Server server(server_config);
+    if (!server.initialize()) {
+        Logger::error("Server initialization failed");
+        return false;
+    }
+
+    // Frame samples are written on the server main loop and read after it is joined
+    std::atomic<bool> measuring{false};
+    SampleSet frame_times;
+    SampleSet frame_work;
+    SampleSet command_latency;
+    uint64_t frames = 0;
+    uint64_t commands_processed = 0;
+
+    server.setFrameObserver([&](const Server::FrameSample& sample) {
+        if (!measuring.load(std::memory_order_relaxed)) {
+            return;
+        }
+        frames++;
+        frame_times.add(static_cast<uint32_t>(sample.frame_time.count()));
+        frame_work.add(static_cast<uint32_t>(sample.work_time.count()));
+        if (sample.command_latencies_us) {
+            commands_processed += sample.command_latencies_us->size();
+            for (uint32_t latency : *sample.command_latencies_us) {
+                command_latency.add(latency);
+            }
+        }
+    });
+
+    std::vector<std::unique_ptr<SyntheticClient>> clients;
+    for (uint32_t i = 0; i < m_config.clients; ++i) {
+        auto client = std::make_unique<SyntheticClient>(i, *workload);
+        if (!client->connect(server)) {
+            Logger::error("Failed to connect synthetic client {}", i);
+            server.shutdown();
+            return false;
+        }
+        clients.push_back(std::move(client));
+    }
+
+    std::thread server_thread([&server]() { server.run(); });
+
+    for (auto& client : clients) {
+        client->start(m_config.ticks_per_second, m_config.ping_interval_ms);
+    }
+
+    std::cerr << "Warming up for " << m_config.warmup_seconds << "s with " << clients.size()
+              << " " << workload->getName() << " clients..." << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(m_config.warmup_seconds));
+
+    // Measurement window
+    auto begin_snapshot = sumSnapshots(clients);
+    for (auto& client : clients) {
+        client->setRecording(true);
+    }
+    auto begin_time = std::chrono::steady_clock::now();
+    measuring = true;
+
+    std::cerr << "Measuring for " << m_config.duration_seconds << "s..." << std::endl;
+    std::this_thread::sleep_for(std::chrono::seconds(m_config.duration_seconds));
+
+    measuring = false;
+    auto end_time = std::chrono::steady_clock::now();
+    auto end_snapshot = sumSnapshots(clients);
+
+    SampleSet ping_rtt;
+    for (auto& client : clients) {
+        client->setRecording(false);
+        client->stop();
+        client->collectRoundTrips(ping_rtt);
+    }
+
+    server.requestShutdown("Harness finished");
+    server_thread.join();
+    server.shutdown();
+
+    // Results
+    result.measured_seconds = std::chrono::duration<double>(end_time - begin_time).count();
+    result.ticks_sent = end_snapshot.ticks_sent - begin_snapshot.ticks_sent;
+    result.messages_sent = end_snapshot.messages_sent - begin_snapshot.messages_sent;
+    result.commands_sent = end_snapshot.commands_sent - begin_snapshot.commands_sent;
+    result.bytes_sent = end_snapshot.bytes_sent - begin_snapshot.bytes_sent;
+    result.frame_callbacks_received = end_snapshot.frame_callbacks - begin_snapshot.frame_callbacks;
+
+    result.frames = frames;
+    result.commands_processed = commands_processed;
+
+    double seconds = result.measured_seconds > 0.0 ? result.measured_seconds : 1.0;
+    result.messages_per_second = result.messages_sent / seconds;
+    result.commands_sent_per_second = result.commands_sent / seconds;
+    result.commands_processed_per_second = result.commands_processed / seconds;
+    result.megabytes_per_second = result.bytes_sent / seconds / (1024.0 * 1024.0);
+    result.frames_per_second = result.frames / seconds;
+
+    result.frame_time_us = frame_times.summarize();
+    result.frame_work_us = frame_work.summarize();
+    result.command_latency_us = command_latency.summarize();
+    result.ping_rtt_us = ping_rtt.summarize();
+
+    return true;
+}
+
+std::string E2EHarness::toJson(const Config& config, const Result& result) {
+    std::stringstream ss;
+    ss << std::setprecision(3) << std::fixed;
+
+    ss << "{\n";
+    ss << "  \"tool\": \"kairos-e2e\",\n";
+    ss << "  \"protocol_version\": " << PROTOCOL_VERSION << ",\n";
+    ss << "  \"config\": {\n";
+    ss << "    \"workload\": \"" << config.workload << "\",\n";
+    ss << "    \"workload_description\": \"" << result.workload_description << "\",\n";
+    ss << "    \"clients\": " << config.clients << ",\n";
+    ss << "    \"ticks_per_second\": " << config.ticks_per_second << ",\n";
+    ss << "    \"target_fps\": " << config.target_fps << ",\n";
+    ss << "    \"frame_pacing\": " << (config.frame_pacing ? "true" : "false") << ",\n";
+    ss << "    \"command_batch_size\": " << config.command_batch_size << ",\n";
+    ss << "    \"duration_seconds\": " << config.duration_seconds << "\n";
+    ss << "  },\n";
+    ss << "  \"totals\": {\n";
+    ss << "    \"measured_seconds\": " << result.measured_seconds << ",\n";
+    ss << "    \"ticks_sent\": " << result.ticks_sent << ",\n";
+    ss << "    \"messages_sent\": " << result.messages_sent << ",\n";
+    ss << "    \"commands_sent\": " << result.commands_sent << ",\n";
+    ss << "    \"commands_processed\": " << result.commands_processed << ",\n";
+    ss << "    \"bytes_sent\": " << result.bytes_sent << ",\n";
+    ss << "    \"frames\": " << result.frames << ",\n";
+    ss << "    \"frame_callbacks_received\": " << result.frame_callbacks_received << "\n";
+    ss << "  },\n";
+    ss << "  \"rates\": {\n";
+    ss << "    \"messages_per_second\": " << result.messages_per_second << ",\n";
+    ss << "    \"commands_sent_per_second\": " << result.commands_sent_per_second << ",\n";
+    ss << "    \"commands_processed_per_second\": " << result.commands_processed_per_second << ",\n";
+    ss << "    \"megabytes_per_second\": " << result.megabytes_per_second << ",\n";
+    ss << "    \"frames_per_second\": " << result.frames_per_second << "\n";
+    ss << "  },\n";
+    ss << "  \"latency_us\": {\n";
+    writeSummary(ss, "frame_time", result.frame_time_us, false);
+    writeSummary(ss, "frame_work", result.frame_work_us, false);
+    writeSummary(ss, "command_latency", result.command_latency_us, false);
+    writeSummary(ss, "ping_rtt", result.ping_rtt_us, true);
+    ss << "  }\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+std::string E2EHarness::toTable(const Config& config, const Result& result) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(0);
+
+    ss << config.workload << " x " << config.clients << " clients (" << result.workload_description << ")\n";
+    ss << "  messages/s: " << result.messages_per_second
+       << "   commands/s sent: " << result.commands_sent_per_second
+       << "   processed: " << result.commands_processed_per_second << "\n";
+    ss << std::setprecision(1)
+       << "  MB/s: " << result.megabytes_per_second
+       << "   frames/s: " << result.frames_per_second << "\n\n";
+
+    ss << std::left << std::setw(22) << "latency (us)" << std::right
+       << std::setw(10) << "p50"
+       << std::setw(10) << "p90"
+       << std::setw(10) << "p99"
+       << std::setw(10) << "p99.9"
+       << std::setw(10) << "max" << "\n";
+    ss << std::string(72, '-') << "\n";
+    writeRow(ss, "frame_time", result.frame_time_us);
+    writeRow(ss, "frame_work", result.frame_work_us);
+    writeRow(ss, "command_latency", result.command_latency_us);
+    writeRow(ss, "ping_rtt", result.ping_rtt_us);
+
+    return ss.str();
+}
+
+} // namespace Kairos::E2E
@@ -0,0 +1,79 @@
+// tools/kairos-e2e/E2EHarness.hpp
+#pragma once
+
+#include "SampleSet.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace Kairos::E2E {
+
+/**
+ * @brief Runs the whole server stack in-process against synthetic clients
+ *
+ * A Server is started with the null renderer backend and no listening
+ * sockets; clients are attached through socketpairs, so network threads,
+ * handshake, parsing, command conversion, queueing, frame loop and frame
+ * callbacks all run exactly as in production, minus the GPU.
+ */
+class E2EHarness {
+public:
+    struct Config {
+        std::string workload = "sprite_storm";
+        uint32_t clients = 4;
+        uint32_t items_per_tick = 0;       // 0 = workload default
+        uint32_t ticks_per_second = 60;    // Per client; 0 = as fast as the socket accepts
+        uint32_t ping_interval_ms = 100;
+
+        uint32_t warmup_seconds = 2;
+        uint32_t duration_seconds = 10;
+
+        uint32_t target_fps = 60;
+        bool frame_pacing = true;
+        uint32_t command_batch_size = 1000;
+    };
+
+    struct Result {
+        std::string workload_description;
+        double measured_seconds = 0.0;
+
+        // Client side (what was offered)
+        uint64_t ticks_sent = 0;
+        uint64_t messages_sent = 0;
+        uint64_t commands_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t frame_callbacks_received = 0;
+
+        // Server side (what was handled)
+        uint64_t frames = 0;
+        uint64_t commands_processed = 0;
+
+        double messages_per_second = 0.0;
+        double commands_sent_per_second = 0.0;
+        double commands_processed_per_second = 0.0;
+        double megabytes_per_second = 0.0;
+        double frames_per_second = 0.0;
+
+        SampleSet::Summary frame_time_us;       // Whole frame including pacing
+        SampleSet::Summary frame_work_us;       // Frame before pacing
+        SampleSet::Summary command_latency_us;  // Network conversion -> processed
+        SampleSet::Summary ping_rtt_us;         // PING -> PONG through the network threads
+    };
+
+public:
+    E2EHarness();
+    explicit E2EHarness(const Config& config);
+
+    bool run(Result& result);
+
+    const Config& getConfig() const { return m_config; }
+
+    // Reporting
+    static std::string toJson(const Config& config, const Result& result);
+    static std::string toTable(const Config& config, const Result& result);
+
+private:
+    Config m_config;
+};
+
+} // namespace Kairos::E2E
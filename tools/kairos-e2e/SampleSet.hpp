@@ -0,0 +1,93 @@
+// tools/kairos-e2e/SampleSet.hpp
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Kairos::E2E {
+
+/**
+ * @brief Bounded sample store for percentile reporting
+ *
+ * Keeps every sample until max_samples is reached, then switches to
+ * reservoir sampling so long runs stay within a fixed memory budget while
+ * percentiles remain unbiased. Count, mean and max always cover all samples.
+ */
+class SampleSet {
+public:
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0.0;
+        uint32_t p50 = 0;
+        uint32_t p90 = 0;
+        uint32_t p99 = 0;
+        uint32_t p999 = 0;
+        uint32_t max = 0;
+    };
+
+    explicit SampleSet(size_t max_samples = 1 << 20) : m_max_samples(max_samples), m_rng(0x4B41524F) {
+        m_samples.reserve(std::min<size_t>(max_samples, 1 << 16));
+    }
+
+    void add(uint32_t value) {
+        ++m_count;
+        m_sum += value;
+        m_max = std::max(m_max, value);
+
+        if (m_samples.size() < m_max_samples) {
+            m_samples.push_back(value);
+            return;
+        }
+
+        std::uniform_int_distribution<uint64_t> slot(0, m_count - 1);
+        uint64_t index = slot(m_rng);
+        if (index < m_max_samples) {
+            m_samples[index] = value;
+        }
+    }
+
+    void clear() {
+        m_samples.clear();
+        m_count = 0;
+        m_sum = 0;
+        m_max = 0;
+    }
+
+    uint64_t count() const { return m_count; }
+
+    Summary summarize() const {
+        Summary summary;
+        summary.count = m_count;
+        if (m_count == 0) {
+            return summary;
+        }
+
+        std::vector<uint32_t> sorted = m_samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto at = [&sorted](double quantile) {
+            size_t index = static_cast<size_t>(quantile * (sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        };
+
+        summary.mean = static_cast<double>(m_sum) / static_cast<double>(m_count);
+        summary.p50 = at(0.50);
+        summary.p90 = at(0.90);
+        summary.p99 = at(0.99);
+        summary.p999 = at(0.999);
+        summary.max = m_max;
+        return summary;
+    }
+
+private:
+    size_t m_max_samples;
+    std::vector<uint32_t> m_samples;
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint32_t m_max = 0;
+    std::mt19937_64 m_rng;
+};
+
+} // namespace Kairos::E2E
@@ -0,0 +1,302 @@
+// tools/kairos-e2e/SyntheticClient.cpp
+#include "SyntheticClient.hpp"
+
+#include <Core/Server.hpp>
+#include <Protocol.hpp>
+#include <Utils/Logger.hpp>
+
+#include <chrono>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Kairos::E2E {
+
+namespace {
+    uint64_t steadyMicros() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+SyntheticClient::SyntheticClient(uint32_t index, const Workload& workload)
+    : m_index(index), m_workload(workload) {
+}
+
+SyntheticClient::~SyntheticClient() {
+    stop();
+}
+
+bool SyntheticClient::connect(Server& server) {
+    int fds[2] = {-1, -1};
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        Logger::error("socketpair failed for synthetic client {}: {}", m_index, strerror(errno));
+        return false;
+    }
+
+    // Large buffers so the sender measures the server, not the socket
+    int buffer_size = 4 * 1024 * 1024;
+    setsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    m_socket = fds[1];
+
+    // The server performs the handshake inline, so CLIENT_HELLO must be waiting
+    ClientHello hello{};
+    std::string name = "kairos-e2e-" + std::to_string(m_index);
+    std::strncpy(hello.client_name, name.c_str(), sizeof(hello.client_name) - 1);
+    hello.client_version = PROTOCOL_VERSION;
+    hello.requested_layers = 8;
+    hello.capabilities = 0;
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::CLIENT_HELLO, 0, m_sequence++,
+                                                        sizeof(ClientHello));
+    auto message = ProtocolHelper::createMessage(header, &hello);
+    if (!sendAll(message.data(), message.size())) {
+        close(fds[0]);
+        return false;
+    }
+
+    if (!server.adoptClientSocket(fds[0], name)) {
+        Logger::error("Server refused synthetic client {}", m_index);
+        close(fds[0]);
+        return false;
+    }
+
+    std::vector<uint8_t> payload;
+    if (!readMessage(header, payload, 5000) || header.type != MessageType::SERVER_HELLO ||
+        payload.size() != sizeof(ServerHello)) {
+        Logger::error("Synthetic client {} did not receive SERVER_HELLO", m_index);
+        return false;
+    }
+
+    ServerHello server_hello;
+    std::memcpy(&server_hello, payload.data(), sizeof(ServerHello));
+    m_client_id = server_hello.assigned_client_id;
+    return true;
+}
+
+void SyntheticClient::start(uint32_t ticks_per_second, uint32_t ping_interval_ms) {
+    if (m_running || m_socket < 0) {
+        return;
+    }
+
+    m_ticks_per_second = ticks_per_second;
+    m_ping_interval_ms = ping_interval_ms;
+    m_running = true;
+    m_receiver_thread = std::thread(&SyntheticClient::receiverMain, this);
+    m_sender_thread = std::thread(&SyntheticClient::senderMain, this);
+}
+
+void SyntheticClient::stop() {
+    m_running = false;
+
+    if (m_socket >= 0) {
+        // Unblocks a sender stuck in send() and tells the server we are gone
+        shutdown(m_socket, SHUT_RDWR);
+    }
+    if (m_sender_thread.joinable()) {
+        m_sender_thread.join();
+    }
+    if (m_receiver_thread.joinable()) {
+        m_receiver_thread.join();
+    }
+    if (m_socket >= 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+}
+
+SyntheticClient::Snapshot SyntheticClient::snapshot() const {
+    Snapshot snapshot;
+    snapshot.ticks_sent = m_stats.ticks_sent.load();
+    snapshot.messages_sent = m_stats.messages_sent.load();
+    snapshot.commands_sent = m_stats.commands_sent.load();
+    snapshot.bytes_sent = m_stats.bytes_sent.load();
+    snapshot.frame_callbacks = m_stats.frame_callbacks.load();
+    return snapshot;
+}
+
+void SyntheticClient::collectRoundTrips(SampleSet& samples) {
+    std::lock_guard<std::mutex> lock(m_rtt_mutex);
+    for (uint32_t rtt : m_rtt_samples_us) {
+        samples.add(rtt);
+    }
+    m_rtt_samples_us.clear();
+}
+
+void SyntheticClient::senderMain() {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<uint8_t> stream;
+    stream.reserve(256 * 1024);
+
+    auto tick_interval = m_ticks_per_second > 0
+        ? std::chrono::nanoseconds(1000000000ull / m_ticks_per_second)
+        : std::chrono::nanoseconds(0);
+    auto ping_interval = std::chrono::milliseconds(m_ping_interval_ms);
+    auto next_tick = clock::now();
+    auto next_ping = next_tick;
+    uint64_t tick = 0;
+
+    while (m_running) {
+        if (m_ping_interval_ms > 0 && clock::now() >= next_ping) {
+            if (!sendPing()) {
+                break;
+            }
+            next_ping += ping_interval;
+        }
+
+        stream.clear();
+        Workload::Tick built = m_workload.build(m_client_id, tick, m_sequence, stream);
+        if (!sendAll(stream.data(), stream.size())) {
+            break;
+        }
+
+        m_stats.ticks_sent.fetch_add(1);
+        m_stats.messages_sent.fetch_add(built.messages);
+        m_stats.commands_sent.fetch_add(built.commands);
+        m_stats.bytes_sent.fetch_add(stream.size());
+        ++tick;
+
+        if (m_ticks_per_second > 0) {
+            next_tick += tick_interval;
+            auto now = clock::now();
+            if (next_tick > now) {
+                std::this_thread::sleep_until(next_tick);
+            } else if (now - next_tick > std::chrono::seconds(1)) {
+                // Far behind schedule (server backpressure): do not burst to catch up
+                next_tick = now;
+            }
+        }
+    }
+}
+
+void SyntheticClient::receiverMain() {
+    MessageHeader header;
+    std::vector<uint8_t> payload;
+
+    while (m_running && !m_peer_closed) {
+        if (!readMessage(header, payload, 50)) {
+            continue;
+        }
+
+        switch (header.type) {
+            case MessageType::FRAME_CALLBACK:
+                m_stats.frame_callbacks.fetch_add(1);
+                break;
+
+            case MessageType::PONG: {
+                if (payload.size() != sizeof(PongData)) {
+                    break;
+                }
+                PongData pong;
+                std::memcpy(&pong, payload.data(), sizeof(PongData));
+                m_stats.pongs_received.fetch_add(1);
+
+                if (m_recording) {
+                    uint64_t rtt = steadyMicros() - pong.client_timestamp;
+                    std::lock_guard<std::mutex> lock(m_rtt_mutex);
+                    m_rtt_samples_us.push_back(static_cast<uint32_t>(rtt));
+                }
+                break;
+            }
+
+            case MessageType::PING: {
+                // Server keep-alive: answer so the connection is not timed out
+                if (payload.size() != sizeof(PingData)) {
+                    break;
+                }
+                PingData ping;
+                std::memcpy(&ping, payload.data(), sizeof(PingData));
+                PongData pong = ProtocolHelper::createPongResponse(ping, 0, 0);
+                MessageHeader reply = ProtocolHelper::createHeader(MessageType::PONG, m_client_id,
+                                                                   0, sizeof(PongData));
+                auto message = ProtocolHelper::createMessage(reply, &pong);
+                sendAll(message.data(), message.size());
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+bool SyntheticClient::sendAll(const uint8_t* data, size_t size) {
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = send(m_socket, data + sent, size - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (m_running) {
+                Logger::warning("Synthetic client {} send failed: {}", m_index, strerror(errno));
+                m_stats.send_errors.fetch_add(1);
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool SyntheticClient::sendPing() {
+    PingData ping{};
+    ping.client_timestamp = steadyMicros();
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::PING, m_client_id,
+                                                        m_sequence++, sizeof(PingData));
+    auto message = ProtocolHelper::createMessage(header, &ping);
+    if (!sendAll(message.data(), message.size())) {
+        return false;
+    }
+
+    m_stats.pings_sent.fetch_add(1);
+    return true;
+}
+
+bool SyntheticClient::readExact(uint8_t* data, size_t size, int timeout_ms) {
+    size_t received = 0;
+    while (received < size) {
+        pollfd pfd{m_socket, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready <= 0) {
+            // Only a timeout before the first byte is a clean "nothing yet"
+            if (ready == 0 && received > 0 && m_running) {
+                continue;
+            }
+            return false;
+        }
+
+        ssize_t result = recv(m_socket, data + received, size - received, 0);
+        if (result <= 0) {
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            m_peer_closed = true;
+            return false;
+        }
+        received += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool SyntheticClient::readMessage(MessageHeader& header, std::vector<uint8_t>& payload, int timeout_ms) {
+    if (!readExact(reinterpret_cast<uint8_t*>(&header), sizeof(MessageHeader), timeout_ms)) {
+        return false;
+    }
+    ProtocolHelper::networkToHost(header);
+
+    payload.resize(header.data_size);
+    if (header.data_size > 0 && !readExact(payload.data(), payload.size(), 1000)) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace Kairos::E2E
@@ -0,0 +1,102 @@
+// tools/kairos-e2e/SyntheticClient.hpp
+#pragma once
+
+#include "SampleSet.hpp"
+#include "Workloads.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Kairos {
+class Server;
+struct MessageHeader;
+}
+
+namespace Kairos::E2E {
+
+/**
+ * @brief In-process client talking to the server over a socketpair
+ *
+ * connect() creates the socketpair, queues CLIENT_HELLO and hands the server
+ * end to Server::adoptClientSocket, so the regular handshake and network
+ * threads are exercised. start() then runs a sender thread that replays the
+ * workload at a fixed tick rate (or as fast as the socket accepts data) and a
+ * receiver thread that drains frame callbacks and measures PING round trips.
+ */
+class SyntheticClient {
+public:
+    struct Stats {
+        std::atomic<uint64_t> ticks_sent{0};
+        std::atomic<uint64_t> messages_sent{0};
+        std::atomic<uint64_t> commands_sent{0};
+        std::atomic<uint64_t> bytes_sent{0};
+        std::atomic<uint64_t> frame_callbacks{0};
+        std::atomic<uint64_t> pings_sent{0};
+        std::atomic<uint64_t> pongs_received{0};
+        std::atomic<uint64_t> send_errors{0};
+    };
+
+    struct Snapshot {
+        uint64_t ticks_sent = 0;
+        uint64_t messages_sent = 0;
+        uint64_t commands_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t frame_callbacks = 0;
+    };
+
+public:
+    SyntheticClient(uint32_t index, const Workload& workload);
+    ~SyntheticClient();
+
+    SyntheticClient(const SyntheticClient&) = delete;
+    SyntheticClient& operator=(const SyntheticClient&) = delete;
+
+    bool connect(Server& server);
+    void start(uint32_t ticks_per_second, uint32_t ping_interval_ms);
+    void stop();
+
+    uint32_t getClientId() const { return m_client_id; }
+    const Stats& getStats() const { return m_stats; }
+    Snapshot snapshot() const;
+
+    // Round-trip samples are only kept while recording is enabled
+    void setRecording(bool recording) { m_recording = recording; }
+    void collectRoundTrips(SampleSet& samples);
+
+private:
+    void senderMain();
+    void receiverMain();
+
+    bool sendAll(const uint8_t* data, size_t size);
+    bool sendPing();
+    bool readExact(uint8_t* data, size_t size, int timeout_ms);
+    bool readMessage(MessageHeader& header, std::vector<uint8_t>& payload, int timeout_ms);
+
+private:
+    uint32_t m_index;
+    const Workload& m_workload;
+    uint32_t m_client_id = 0;
+
+    int m_socket = -1;
+    uint32_t m_ticks_per_second = 60;
+    uint32_t m_ping_interval_ms = 100;
+    uint32_t m_sequence = 0;
+
+    std::thread m_sender_thread;
+    std::thread m_receiver_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_recording{false};
+    std::atomic<bool> m_peer_closed{false};
+    std::mutex m_send_mutex;
+
+    Stats m_stats;
+
+    std::mutex m_rtt_mutex;
+    std::vector<uint32_t> m_rtt_samples_us;
+};
+
+} // namespace Kairos::E2E
@@ -0,0 +1,513 @@
+// tools/kairos-e2e/Workloads.cpp
+#include "Workloads.hpp"
+
+#include <Protocol.hpp>
+#include <Constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace Kairos::E2E {
+
+namespace {
+
+void appendMessage(std::vector<uint8_t>& stream, MessageType type, uint32_t client_id,
+                   uint32_t& sequence, uint8_t layer_id,
+                   const void* payload, size_t payload_size,
+                   const void* extra = nullptr, size_t extra_size = 0) {
+    MessageHeader header = ProtocolHelper::createHeader(type, client_id, sequence++,
+                                                        static_cast<uint32_t>(payload_size + extra_size),
+                                                        layer_id);
+    ProtocolHelper::hostToNetwork(header);
+
+    size_t offset = stream.size();
+    stream.resize(offset + sizeof(MessageHeader) + payload_size + extra_size);
+    std::memcpy(stream.data() + offset, &header, sizeof(MessageHeader));
+    offset += sizeof(MessageHeader);
+
+    if (payload_size > 0) {
+        std::memcpy(stream.data() + offset, payload, payload_size);
+        offset += payload_size;
+    }
+    if (extra_size > 0) {
+        std::memcpy(stream.data() + offset, extra, extra_size);
+    }
+}
+
+/**
+ * @brief Many small animated sprites, grouped into a few texture runs
+ */
+class SpriteStorm : public Workload {
+public:
+    explicit SpriteStorm(uint32_t sprites) : m_sprites(sprites ? sprites : 256) {}
+
+    std::string getName() const override { return "sprite_storm"; }
+    std::string getDescription() const override {
+        return std::to_string(m_sprites) + " animated 16x16 sprites per tick in 4 DRAW_TEXTURED_QUADS runs";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint32_t texture_count = 4;
+        Tick result;
+
+        std::vector<TexturedVertex> vertices;
+        for (uint32_t texture = 0; texture < texture_count; ++texture) {
+            uint32_t first = m_sprites * texture / texture_count;
+            uint32_t last = m_sprites * (texture + 1) / texture_count;
+            if (first == last) {
+                continue;
+            }
+
+            vertices.clear();
+            for (uint32_t i = first; i < last; ++i) {
+                float phase = static_cast<float>(tick) * 0.05f + static_cast<float>(i) * 0.37f;
+                float x = 960.0f + std::cos(phase) * (200.0f + (i % 37) * 18.0f);
+                float y = 540.0f + std::sin(phase * 1.3f) * (120.0f + (i % 23) * 16.0f);
+                vertices.emplace_back(x, y, 0.0f, 0.0f);
+                vertices.emplace_back(x + 16.0f, y, 1.0f, 0.0f);
+                vertices.emplace_back(x + 16.0f, y + 16.0f, 1.0f, 1.0f);
+                vertices.emplace_back(x, y + 16.0f, 0.0f, 1.0f);
+            }
+
+            DrawTexturedQuadsData data{};
+            data.texture_id = texture + 1;
+            data.quad_count = last - first;
+            appendMessage(stream, MessageType::DRAW_TEXTURED_QUADS, client_id, sequence, 4,
+                          &data, sizeof(data), vertices.data(), vertices.size() * sizeof(TexturedVertex));
+            result.messages++;
+            result.commands++;
+        }
+
+        return result;
+    }
+
+private:
+    uint32_t m_sprites;
+};
+
+/**
+ * @brief The sprite storm again, one DRAW_SPRITES_INSTANCED per texture run
+ */
+class SpriteStormInstanced : public Workload {
+public:
+    explicit SpriteStormInstanced(uint32_t sprites) : m_sprites(sprites ? sprites : 256) {}
+
+    std::string getName() const override { return "sprite_storm_instanced"; }
+    std::string getDescription() const override {
+        return std::to_string(m_sprites) + " animated 16x16 sprites per tick in 4 DRAW_SPRITES_INSTANCED runs";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint32_t texture_count = 4;
+        Tick result;
+
+        std::vector<SpriteInstance> instances;
+        for (uint32_t texture = 0; texture < texture_count; ++texture) {
+            uint32_t first = m_sprites * texture / texture_count;
+            uint32_t last = m_sprites * (texture + 1) / texture_count;
+            if (first == last) {
+                continue;
+            }
+
+            instances.clear();
+            for (uint32_t i = first; i < last; ++i) {
+                float phase = static_cast<float>(tick) * 0.05f + static_cast<float>(i) * 0.37f;
+                SpriteInstance sprite{};
+                sprite.position = {968.0f + std::cos(phase) * (200.0f + (i % 37) * 18.0f),
+                                   548.0f + std::sin(phase * 1.3f) * (120.0f + (i % 23) * 16.0f)};
+                sprite.scale_x = 1.0f;
+                sprite.scale_y = 1.0f;
+                sprite.rotation = phase * 57.29578f;
+                sprite.atlas_width = 16;
+                sprite.atlas_height = 16;
+                sprite.color = 0xFFFFFFFF;
+                instances.push_back(sprite);
+            }
+
+            DrawSpritesInstancedData data{};
+            data.texture_id = texture + 1;
+            data.instance_count = last - first;
+            appendMessage(stream, MessageType::DRAW_SPRITES_INSTANCED, client_id, sequence, 4,
+                          &data, sizeof(data), instances.data(), instances.size() * sizeof(SpriteInstance));
+            result.messages++;
+            result.commands++;
+        }
+
+        return result;
+    }
+
+private:
+    uint32_t m_sprites;
+};
+
+/**
+ * @brief The sprite storm as retained objects: created once, then each sent
+ * a new target every RETARGET_TICKS ticks and tweened there by the server
+ */
+class SpriteTweens : public Workload {
+public:
+    explicit SpriteTweens(uint32_t sprites) : m_sprites(sprites ? sprites : 256) {}
+
+    std::string getName() const override { return "sprite_tweens"; }
+    std::string getDescription() const override {
+        return std::to_string(m_sprites) + " 16x16 sprites as objects, each retargeted by one UPDATE_OBJECT every " +
+               std::to_string(RETARGET_TICKS) + " ticks";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint8_t layer_id = 4;
+        Tick result;
+
+        if (tick == 0) {
+            for (uint32_t i = 0; i < m_sprites; ++i) {
+                ObjectData object{};
+                object.object_id = i + 1;
+                object.shape = Constants::OBJECT_SHAPE_IMAGE;
+                object.texture_id = i % 4 + 1;
+                object.position = target(i, 0);
+                object.width = 16.0f;
+                object.height = 16.0f;
+                object.color = 0xFFFFFFFF;
+                object.opacity = 1.0f;
+                appendMessage(stream, MessageType::CREATE_OBJECT, client_id, sequence, layer_id,
+                              &object, sizeof(object));
+                result.messages++;
+                result.commands++;
+            }
+        }
+
+        // Staggered: a slice of the sprites sets off on each tick
+        const uint64_t leg = tick / RETARGET_TICKS + 1;
+        for (uint32_t i = static_cast<uint32_t>(tick % RETARGET_TICKS); i < m_sprites; i += RETARGET_TICKS) {
+            ObjectUpdateData update{};
+            update.object_id = i + 1;
+            update.fields = Constants::OBJECT_FIELD_POSITION | Constants::OBJECT_FIELD_ROTATION;
+            update.easing = Constants::EASING_IN_OUT;
+            update.duration_ms = RETARGET_TICKS * 1000 / 60;
+            update.position = target(i, leg);
+            update.rotation = static_cast<float>(leg % 3) * 120.0f;
+            appendMessage(stream, MessageType::UPDATE_OBJECT, client_id, sequence, layer_id,
+                          &update, sizeof(update));
+            result.messages++;
+            result.commands++;
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr uint32_t RETARGET_TICKS = 60;
+
+    // The storm's orbit, sampled once per leg
+    static Point target(uint32_t i, uint64_t leg) {
+        float phase = static_cast<float>(leg) * 3.0f + static_cast<float>(i) * 0.37f;
+        return {968.0f + std::cos(phase) * (200.0f + (i % 37) * 18.0f),
+                548.0f + std::sin(phase * 1.3f) * (120.0f + (i % 23) * 16.0f)};
+    }
+
+    uint32_t m_sprites;
+};
+
+/**
+ * @brief Live chart: clear the plot layer, redraw the series as segments and markers
+ */
+class ChartUpdate : public Workload {
+public:
+    explicit ChartUpdate(uint32_t points) : m_points(points ? points : 200) {}
+
+    std::string getName() const override { return "chart_update"; }
+    std::string getDescription() const override {
+        return "CLEAR_LAYER + " + std::to_string(m_points) + " DRAW_LINE segments + " +
+               std::to_string(m_points) + " DRAW_POINT markers per tick";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint8_t layer_id = 2;
+        Tick result;
+
+        appendMessage(stream, MessageType::CLEAR_LAYER, client_id, sequence, layer_id, nullptr, 0);
+        result.messages++;
+        result.commands++;
+
+        float step = 1800.0f / static_cast<float>(m_points);
+        Point previous = {60.0f, sample(tick, 0)};
+        for (uint32_t i = 1; i <= m_points; ++i) {
+            Point current = {60.0f + step * i, sample(tick, i)};
+
+            DrawLineData line{};
+            line.start = previous;
+            line.end = current;
+            appendMessage(stream, MessageType::DRAW_LINE, client_id, sequence, layer_id, &line, sizeof(line));
+
+            DrawPointData point{};
+            point.position = current;
+            appendMessage(stream, MessageType::DRAW_POINT, client_id, sequence, layer_id, &point, sizeof(point));
+
+            result.messages += 2;
+            result.commands += 2;
+            previous = current;
+        }
+
+        return result;
+    }
+
+private:
+    static float sample(uint64_t tick, uint32_t index) {
+        float t = static_cast<float>(tick + index) * 0.1f;
+        return 540.0f + std::sin(t) * 300.0f + std::sin(t * 3.7f) * 60.0f;
+    }
+
+    uint32_t m_points;
+};
+
+/**
+ * @brief Console/log view: a full screen of text lines redrawn every tick
+ */
+class TextWall : public Workload {
+public:
+    explicit TextWall(uint32_t lines) : m_lines(lines ? lines : 48) {}
+
+    std::string getName() const override { return "text_wall"; }
+    std::string getDescription() const override {
+        return std::to_string(m_lines) + " DRAW_TEXT lines of ~80 characters per tick";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint8_t layer_id = 3;
+        Tick result;
+
+        for (uint32_t line = 0; line < m_lines; ++line) {
+            std::string text = "[" + std::to_string(tick) + ":" + std::to_string(line) + "] " +
+                               "worker-" + std::to_string(line % 16) +
+                               " processed batch in 3.2ms, queue depth 17, 0 errors, status OK";
+
+            DrawTextData data{};
+            data.font_id = 0;
+            data.position = {8.0f, 8.0f + line * 20.0f};
+            data.font_size = 16.0f;
+            data.text_length = static_cast<uint16_t>(text.size());
+            appendMessage(stream, MessageType::DRAW_TEXT, client_id, sequence, layer_id,
+                          &data, sizeof(data), text.data(), text.size());
+            result.messages++;
+            result.commands++;
+        }
+
+        return result;
+    }
+
+private:
+    uint32_t m_lines;
+};
+
+/**
+ * @brief text_wall's console kept in a pixmap: each tick scrolls it with
+ * COPY_AREA and draws only the new lines, then shows it as one quad
+ */
+class ConsoleScroll : public Workload {
+public:
+    explicit ConsoleScroll(uint32_t lines) : m_lines(lines ? lines : 1) {}
+
+    std::string getName() const override { return "console_scroll"; }
+    std::string getDescription() const override {
+        return std::to_string(m_lines) + " new DRAW_TEXT lines per tick, scrolled in by COPY_AREA in a " +
+               std::to_string(VISIBLE_LINES) + "-line pixmap";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint8_t layer_id = 3;
+        constexpr float line_height = 20.0f;
+        const uint32_t pixmap_id = 0x10000 + client_id;
+        const uint32_t new_lines = std::min(m_lines, VISIBLE_LINES);
+        const int32_t scroll = static_cast<int32_t>(new_lines * line_height);
+        Tick result;
+
+        if (tick == 0) {
+            CreatePixmapData pixmap{};
+            pixmap.pixmap_id = pixmap_id;
+            pixmap.width = WIDTH;
+            pixmap.height = HEIGHT;
+            appendMessage(stream, MessageType::CREATE_PIXMAP, client_id, sequence, layer_id,
+                          &pixmap, sizeof(pixmap));
+            result.messages++;
+            result.commands++;
+        }
+
+        PixmapTargetData target{};
+        target.pixmap_id = pixmap_id;
+        target.flags = tick == 0 ? Constants::PIXMAP_TARGET_CLEAR : 0;
+        appendMessage(stream, MessageType::SET_PIXMAP_TARGET, client_id, sequence, layer_id,
+                      &target, sizeof(target));
+        result.messages++;
+        result.commands++;
+
+        CopyAreaData copy{};
+        copy.src_x = 0;
+        copy.src_y = scroll;
+        copy.width = WIDTH;
+        copy.height = HEIGHT - static_cast<uint32_t>(scroll);
+        copy.dst_x = 0;
+        copy.dst_y = 0;
+        appendMessage(stream, MessageType::COPY_AREA, client_id, sequence, layer_id, &copy, sizeof(copy));
+        result.messages++;
+        result.commands++;
+
+        // The exposed strip: background, then the new lines
+        DrawRectangleData strip{};
+        strip.position = {0.0f, static_cast<float>(HEIGHT - scroll)};
+        strip.width = static_cast<float>(WIDTH);
+        strip.height = static_cast<float>(scroll);
+        appendMessage(stream, MessageType::FILL_RECTANGLE, client_id, sequence, layer_id,
+                      &strip, sizeof(strip));
+        result.messages++;
+        result.commands++;
+
+        for (uint32_t line = 0; line < new_lines; ++line) {
+            std::string text = "[" + std::to_string(tick) + ":" + std::to_string(line) + "] " +
+                               "worker-" + std::to_string(line % 16) +
+                               " processed batch in 3.2ms, queue depth 17, 0 errors, status OK";
+
+            DrawTextData data{};
+            data.font_id = 0;
+            data.position = {8.0f, HEIGHT - scroll + line * line_height};
+            data.font_size = 16.0f;
+            data.text_length = static_cast<uint16_t>(text.size());
+            appendMessage(stream, MessageType::DRAW_TEXT, client_id, sequence, layer_id,
+                          &data, sizeof(data), text.data(), text.size());
+            result.messages++;
+            result.commands++;
+        }
+
+        target.pixmap_id = 0;
+        target.flags = 0;
+        appendMessage(stream, MessageType::SET_PIXMAP_TARGET, client_id, sequence, layer_id,
+                      &target, sizeof(target));
+        result.messages++;
+        result.commands++;
+
+        TexturedVertex quad[4] = {
+            {8.0f, 8.0f, 0.0f, 0.0f},
+            {8.0f + WIDTH, 8.0f, 1.0f, 0.0f},
+            {8.0f + WIDTH, 8.0f + HEIGHT, 1.0f, 1.0f},
+            {8.0f, 8.0f + HEIGHT, 0.0f, 1.0f}
+        };
+        DrawTexturedQuadsData draw{};
+        draw.texture_id = pixmap_id;
+        draw.quad_count = 1;
+        appendMessage(stream, MessageType::DRAW_TEXTURED_QUADS, client_id, sequence, layer_id,
+                      &draw, sizeof(draw), quad, sizeof(quad));
+        result.messages++;
+        result.commands++;
+
+        return result;
+    }
+
+private:
+    static constexpr uint32_t VISIBLE_LINES = 48;
+    static constexpr uint32_t WIDTH = 1200;
+    static constexpr uint32_t HEIGHT = VISIBLE_LINES * 20;
+    uint32_t m_lines;
+};
+
+/**
+ * @brief Streaming texture content (thumbnails, video frames) plus a quad to show it
+ */
+class TextureUpload : public Workload {
+public:
+    explicit TextureUpload(uint32_t uploads) : m_uploads(uploads ? uploads : 1) {
+        // 64x64 RGBA8 keeps each upload below the default 64KB receive buffer
+        m_pixels.resize(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+        for (size_t i = 0; i < m_pixels.size(); ++i) {
+            m_pixels[i] = static_cast<uint8_t>(i * 31);
+        }
+    }
+
+    std::string getName() const override { return "texture_upload"; }
+    std::string getDescription() const override {
+        return std::to_string(m_uploads) + " UPLOAD_FONT_TEXTURE(64x64 RGBA8) + DRAW_TEXTURED_QUADS per tick";
+    }
+
+    Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+               std::vector<uint8_t>& stream) const override {
+        constexpr uint8_t layer_id = 5;
+        Tick result;
+
+        for (uint32_t upload = 0; upload < m_uploads; ++upload) {
+            uint32_t texture_id = 1000 + client_id * 16 + (upload % 16);
+
+            FontTextureData data{};
+            data.texture_id = texture_id;
+            data.width = TEXTURE_SIZE;
+            data.height = TEXTURE_SIZE;
+            data.format = Constants::PIXEL_FORMAT_RGBA8;
+            data.data_size = static_cast<uint32_t>(m_pixels.size());
+            appendMessage(stream, MessageType::UPLOAD_FONT_TEXTURE, client_id, sequence, layer_id,
+                          &data, sizeof(data), m_pixels.data(), m_pixels.size());
+            result.messages++;
+
+            float x = static_cast<float>((tick * 8 + upload * 72) % 1800);
+            TexturedVertex quad[4] = {
+                {x, 100.0f, 0.0f, 0.0f},
+                {x + 64.0f, 100.0f, 1.0f, 0.0f},
+                {x + 64.0f, 164.0f, 1.0f, 1.0f},
+                {x, 164.0f, 0.0f, 1.0f}
+            };
+
+            DrawTexturedQuadsData draw{};
+            draw.texture_id = texture_id;
+            draw.quad_count = 1;
+            appendMessage(stream, MessageType::DRAW_TEXTURED_QUADS, client_id, sequence, layer_id,
+                          &draw, sizeof(draw), quad, sizeof(quad));
+            result.messages++;
+            result.commands++;
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr uint32_t TEXTURE_SIZE = 64;
+    uint32_t m_uploads;
+    std::vector<uint8_t> m_pixels;
+};
+
+} // anonymous namespace
+
+std::unique_ptr<Workload> createWorkload(const std::string& name, uint32_t items_per_tick) {
+    if (name == "sprite_storm") {
+        return std::make_unique<SpriteStorm>(items_per_tick);
+    }
+    if (name == "sprite_storm_instanced") {
+        return std::make_unique<SpriteStormInstanced>(items_per_tick);
+    }
+    if (name == "sprite_tweens") {
+        return std::make_unique<SpriteTweens>(items_per_tick);
+    }
+    if (name == "chart_update") {
+        return std::make_unique<ChartUpdate>(items_per_tick);
+    }
+    if (name == "text_wall") {
+        return std::make_unique<TextWall>(items_per_tick);
+    }
+    if (name == "console_scroll") {
+        return std::make_unique<ConsoleScroll>(items_per_tick);
+    }
+    if (name == "texture_upload") {
+        return std::make_unique<TextureUpload>(items_per_tick);
+    }
+    return nullptr;
+}
+
+std::vector<std::string> getWorkloadNames() {
+    return {"sprite_storm", "sprite_storm_instanced", "sprite_tweens", "chart_update", "text_wall",
+            "console_scroll", "texture_upload"};
+}
+
+} // namespace Kairos::E2E
@@ -0,0 +1,38 @@
+// tools/kairos-e2e/Workloads.hpp
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Kairos::E2E {
+
+/**
+ * @brief Scripted client traffic, encoded exactly as it goes on the wire
+ *
+ * A workload describes what one client sends per tick. build() appends the
+ * encoded messages (network-order header + payload) to a stream buffer and
+ * is const, so every synthetic client can share one instance.
+ */
+class Workload {
+public:
+    struct Tick {
+        uint32_t messages = 0;
+        uint32_t commands = 0;     // Messages the server turns into render commands
+    };
+
+    virtual ~Workload() = default;
+
+    virtual std::string getName() const = 0;
+    virtual std::string getDescription() const = 0;
+
+    virtual Tick build(uint32_t client_id, uint64_t tick, uint32_t& sequence,
+                       std::vector<uint8_t>& stream) const = 0;
+};
+
+// Factory; items_per_tick = 0 selects the workload's default size
+std::unique_ptr<Workload> createWorkload(const std::string& name, uint32_t items_per_tick = 0);
+std::vector<std::string> getWorkloadNames();
+
+} // namespace Kairos::E2E
@@ -0,0 +1,150 @@
+// tools/kairos-e2e/main.cpp
+#include "E2EHarness.hpp"
+#include "Workloads.hpp"
+
+#include <Utils/Logger.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace Kairos;
+using namespace Kairos::E2E;
+
+namespace {
+
+struct Options {
+    E2EHarness::Config harness;
+    std::string output_file;
+    std::string log_file = "kairos_e2e.log";
+    bool list_only = false;
+    bool print_table = true;
+};
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n\n";
+    std::cout << "Runs the full server in-process (null renderer) against synthetic socketpair\n";
+    std::cout << "clients and emits end-to-end throughput and latency as JSON.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --workload <name>        Workload to replay (default: sprite_storm, see --list)\n";
+    std::cout << "  --clients <count>        Number of synthetic clients (default: 4)\n";
+    std::cout << "  --items <count>          Items per tick, 0 = workload default (default: 0)\n";
+    std::cout << "  --rate <ticks>           Ticks per second per client, 0 = unthrottled (default: 60)\n";
+    std::cout << "  --ping-interval <ms>     PING interval for round-trip samples, 0 = off (default: 100)\n";
+    std::cout << "  --warmup <seconds>       Unmeasured warmup (default: 2)\n";
+    std::cout << "  --duration <seconds>     Measured duration (default: 10)\n";
+    std::cout << "  --fps <fps>              Server target FPS (default: 60)\n";
+    std::cout << "  --no-pacing              Disable server frame pacing\n";
+    std::cout << "  --batch-size <count>     Server command batch size (default: 1000)\n";
+    std::cout << "  --output <file>          Write JSON results to <file> (default: stdout)\n";
+    std::cout << "  --log-file <path>        Server log file (default: kairos_e2e.log)\n";
+    std::cout << "  --quiet                  Do not print the summary table to stderr\n";
+    std::cout << "  --list                   List available workloads and exit\n";
+    std::cout << "  --help                   Show this help message\n";
+}
+
+bool parseCommandLine(int argc, char* argv[], Options& options) {
+    auto& harness = options.harness;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--workload" && i + 1 < argc) {
+            harness.workload = argv[++i];
+        } else if (arg == "--clients" && i + 1 < argc) {
+            harness.clients = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--items" && i + 1 < argc) {
+            harness.items_per_tick = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--rate" && i + 1 < argc) {
+            harness.ticks_per_second = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--ping-interval" && i + 1 < argc) {
+            harness.ping_interval_ms = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            harness.warmup_seconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--duration" && i + 1 < argc) {
+            harness.duration_seconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--fps" && i + 1 < argc) {
+            harness.target_fps = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--no-pacing") {
+            harness.frame_pacing = false;
+        } else if (arg == "--batch-size" && i + 1 < argc) {
+            harness.command_batch_size = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output_file = argv[++i];
+        } else if (arg == "--log-file" && i + 1 < argc) {
+            options.log_file = argv[++i];
+        } else if (arg == "--quiet") {
+            options.print_table = false;
+        } else if (arg == "--list") {
+            options.list_only = true;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        if (!parseCommandLine(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (options.list_only) {
+        for (const auto& name : getWorkloadNames()) {
+            auto workload = createWorkload(name, 0);
+            std::cout << name << "\n"
+                      << "    " << workload->getDescription() << "\n";
+        }
+        return 0;
+    }
+
+    // Server logging goes to a file so it does not skew timings or the JSON
+    Logger::Config log_config;
+    log_config.log_level = Logger::Level::Warning;
+    log_config.log_to_console = false;
+    log_config.log_to_file = true;
+    log_config.log_file = options.log_file;
+    Logger::initialize(log_config);
+
+    E2EHarness harness(options.harness);
+    E2EHarness::Result result;
+    if (!harness.run(result)) {
+        std::cerr << "End-to-end run failed, see " << options.log_file << std::endl;
+        Logger::shutdown();
+        return 1;
+    }
+
+    if (options.print_table) {
+        std::cerr << "\n" << E2EHarness::toTable(harness.getConfig(), result) << std::endl;
+    }
+
+    std::string json = E2EHarness::toJson(harness.getConfig(), result);
+    if (options.output_file.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_file);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.output_file << std::endl;
+            return 1;
+        }
+        file << json;
+        std::cerr << "Results written to " << options.output_file << std::endl;
+    }
+
+    Logger::shutdown();
+    return 0;
+}
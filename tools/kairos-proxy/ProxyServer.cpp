@@ -0,0 +1,808 @@
+// tools/kairos-proxy/ProxyServer.cpp
+#include "ProxyServer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Kairos::Proxy {
+
+namespace {
+
+// Stop reading from an upstream's clients while this much waits to be sent to
+// the server, so TCP flow control slows them down instead of the proxy growing
+constexpr size_t MAX_UPSTREAM_BACKLOG = 4 * 1024 * 1024;
+
+// A local client that lets this much pile up is not reading; drop it
+constexpr size_t MAX_CLIENT_BACKLOG = 1024 * 1024;
+
+constexpr size_t NO_UPSTREAM = std::numeric_limits<size_t>::max();
+
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Parses the header at the front of buffer; false until a whole message is there
+bool peekMessage(const std::vector<uint8_t>& buffer, size_t offset, MessageHeader& header, bool& valid) {
+    valid = true;
+    if (buffer.size() - offset < sizeof(MessageHeader)) {
+        return false;
+    }
+    std::memcpy(&header, buffer.data() + offset, sizeof(MessageHeader));
+    ProtocolHelper::networkToHost(header);
+    if (!ProtocolHelper::validateHeader(header)) {
+        valid = false;
+        return false;
+    }
+    return buffer.size() - offset >= sizeof(MessageHeader) + header.data_size;
+}
+
+} // anonymous namespace
+
+ProxyServer::ProxyServer(const Config& config) : m_config(config) {
+    m_config.upstream_count = std::max<uint32_t>(m_config.upstream_count, 1);
+}
+
+ProxyServer::~ProxyServer() {
+    stop();
+}
+
+bool ProxyServer::start() {
+    for (uint32_t i = 0; i < m_config.upstream_count; ++i) {
+        Upstream upstream;
+        upstream.fd = connectUpstream();
+        if (upstream.fd < 0 || !handshakeUpstream(upstream, i)) {
+            std::cerr << "Failed to open upstream connection " << i << std::endl;
+            if (upstream.fd >= 0) {
+                close(upstream.fd);
+            }
+            stop();
+            return false;
+        }
+        setNonBlocking(upstream.fd);
+        m_upstreams.push_back(std::move(upstream));
+    }
+
+    if (!m_config.listen_unix_path.empty()) {
+        m_unix_listener = listenUnix();
+        if (m_unix_listener < 0) {
+            stop();
+            return false;
+        }
+    }
+    if (m_config.listen_tcp_port != 0) {
+        m_tcp_listener = listenTcp();
+        if (m_tcp_listener < 0) {
+            stop();
+            return false;
+        }
+    }
+    if (m_unix_listener < 0 && m_tcp_listener < 0) {
+        std::cerr << "No listener configured" << std::endl;
+        stop();
+        return false;
+    }
+
+    return true;
+}
+
+bool ProxyServer::run(const std::atomic<bool>& running) {
+    enum class Kind { Listener, Upstream, Local };
+    struct Owner {
+        Kind kind;
+        uint32_t id;        // Upstream index or virtual id
+    };
+
+    std::vector<pollfd> pfds;
+    std::vector<Owner> owners;
+    std::vector<uint32_t> dead_clients;
+    auto last_stats = std::chrono::steady_clock::now();
+
+    while (running) {
+        auto now = std::chrono::steady_clock::now();
+
+        if (m_config.stats_interval_seconds > 0 &&
+            now - last_stats >= std::chrono::seconds(m_config.stats_interval_seconds)) {
+            std::cerr << "kairos-proxy: " << getStatsLine() << std::endl;
+            last_stats = now;
+        }
+
+        if (std::none_of(m_upstreams.begin(), m_upstreams.end(), [](const Upstream& u) { return u.fd >= 0; })) {
+            std::cerr << "Every upstream connection is closed" << std::endl;
+            return false;
+        }
+
+        closeSlowClients();
+
+        pfds.clear();
+        owners.clear();
+        for (int listener : {m_unix_listener, m_tcp_listener}) {
+            if (listener >= 0 && m_clients.size() < m_config.max_clients) {
+                pfds.push_back({listener, POLLIN, 0});
+                owners.push_back({Kind::Listener, static_cast<uint32_t>(listener)});
+            }
+        }
+
+        // Sleep no longer than the oldest pending frame may wait
+        int timeout_ms = 1000;
+        for (uint32_t i = 0; i < m_upstreams.size(); ++i) {
+            const auto& upstream = m_upstreams[i];
+            if (upstream.fd < 0) {
+                continue;
+            }
+            short events = POLLIN;
+            if (!upstream.outbox.empty()) {
+                events |= POLLOUT;
+            }
+            pfds.push_back({upstream.fd, events, 0});
+            owners.push_back({Kind::Upstream, i});
+
+            if (!upstream.frame.empty()) {
+                auto waited = std::chrono::duration_cast<std::chrono::microseconds>(now - upstream.frame_started).count();
+                auto remaining = std::max<int64_t>(static_cast<int64_t>(m_config.flush_interval_us) - waited, 0);
+                timeout_ms = std::min(timeout_ms, static_cast<int>((remaining + 999) / 1000));
+            }
+        }
+
+        bool backpressured = false;
+        for (const auto& [virtual_id, client] : m_clients) {
+            short events = 0;
+            if (m_upstreams[client.upstream].outbox.size() < MAX_UPSTREAM_BACKLOG) {
+                events |= POLLIN;
+            } else {
+                backpressured = true;
+            }
+            if (!client.outbox.empty()) {
+                events |= POLLOUT;
+            }
+            // Listed even without events so hangups are still reported
+            pfds.push_back({client.fd, events, 0});
+            owners.push_back({Kind::Local, virtual_id});
+        }
+        if (backpressured) {
+            m_stats.backpressure_waits++;
+        }
+
+        int ready = poll(pfds.data(), pfds.size(), timeout_ms);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "poll failed: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        dead_clients.clear();
+        for (size_t i = 0; i < pfds.size() && ready > 0; ++i) {
+            const short revents = pfds[i].revents;
+            if (revents == 0) {
+                continue;
+            }
+            --ready;
+
+            const Owner& owner = owners[i];
+            if (owner.kind == Kind::Listener) {
+                acceptClients(pfds[i].fd);
+                continue;
+            }
+
+            if (owner.kind == Kind::Upstream) {
+                auto& upstream = m_upstreams[owner.id];
+                if (upstream.fd < 0) {
+                    continue;
+                }
+                bool alive = true;
+                if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                    alive = readSocket(upstream.fd, upstream.inbox) && processUpstream(owner.id);
+                }
+                if (alive && (revents & POLLOUT)) {
+                    alive = writeSocket(upstream.fd, upstream.outbox);
+                }
+                if (!alive) {
+                    std::cerr << "Upstream connection " << owner.id << " closed" << std::endl;
+                    closeUpstream(owner.id);
+                }
+                continue;
+            }
+
+            // Closed earlier in this pass (its upstream went away)
+            auto it = m_clients.find(owner.id);
+            if (it == m_clients.end()) {
+                continue;
+            }
+            auto& client = it->second;
+            bool alive = true;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                alive = readSocket(client.fd, client.inbox) && processLocal(client);
+            }
+            if (alive && (revents & POLLOUT)) {
+                alive = writeSocket(client.fd, client.outbox);
+            }
+            if (!alive) {
+                dead_clients.push_back(owner.id);
+            }
+        }
+
+        for (uint32_t virtual_id : dead_clients) {
+            closeLocal(virtual_id, true);
+        }
+
+        // Ship frames that have waited long enough
+        now = std::chrono::steady_clock::now();
+        for (auto& upstream : m_upstreams) {
+            if (upstream.fd >= 0 && !upstream.frame.empty() &&
+                now - upstream.frame_started >= std::chrono::microseconds(m_config.flush_interval_us)) {
+                flushFrame(upstream);
+            }
+        }
+    }
+
+    return true;
+}
+
+void ProxyServer::stop() {
+    for (auto& [virtual_id, client] : m_clients) {
+        close(client.fd);
+    }
+    m_clients.clear();
+    m_stats.clients_active = 0;
+
+    for (auto& upstream : m_upstreams) {
+        if (upstream.fd >= 0) {
+            // Best effort: let the server detach everything at once
+            flushFrame(upstream);
+            sendUpstream(upstream, MessageType::DISCONNECT, nullptr, 0);
+            close(upstream.fd);
+            upstream.fd = -1;
+        }
+    }
+
+    if (m_unix_listener >= 0) {
+        close(m_unix_listener);
+        unlink(m_config.listen_unix_path.c_str());
+        m_unix_listener = -1;
+    }
+    if (m_tcp_listener >= 0) {
+        close(m_tcp_listener);
+        m_tcp_listener = -1;
+    }
+}
+
+std::string ProxyServer::getStatsLine() const {
+    std::stringstream ss;
+    ss << m_stats.clients_active << " clients (" << m_stats.clients_accepted << " accepted, "
+       << m_stats.clients_rejected << " rejected), up " << m_stats.messages_up << " messages in "
+       << m_stats.frames_up << " frames (" << m_stats.bytes_up << " bytes), down "
+       << m_stats.messages_down << " routed + " << m_stats.broadcasts_down << " broadcast ("
+       << m_stats.bytes_down << " bytes), " << m_stats.pings_answered << " pings answered locally";
+    return ss.str();
+}
+
+int ProxyServer::listenUnix() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "socket(AF_UNIX) failed: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, m_config.listen_unix_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(m_config.listen_unix_path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << m_config.listen_unix_path << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    setNonBlocking(fd);
+    return fd;
+}
+
+int ProxyServer::listenTcp() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "socket(AF_INET) failed: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(m_config.listen_tcp_port);
+    inet_pton(AF_INET, m_config.listen_tcp_address.c_str(), &addr.sin_addr);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << m_config.listen_tcp_address << ":" << m_config.listen_tcp_port
+                  << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    setNonBlocking(fd);
+    return fd;
+}
+
+int ProxyServer::connectUpstream() {
+    int fd = -1;
+
+    if (!m_config.upstream_unix_path.empty()) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "socket(AF_UNIX) failed: " << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, m_config.upstream_unix_path.c_str(), sizeof(addr.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Cannot connect to " << m_config.upstream_unix_path << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+    } else {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "socket(AF_INET) failed: " << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(m_config.upstream_tcp_port);
+        inet_pton(AF_INET, m_config.upstream_tcp_address.c_str(), &addr.sin_addr);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Cannot connect to " << m_config.upstream_tcp_address << ":" << m_config.upstream_tcp_port
+                      << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+
+    return fd;
+}
+
+bool ProxyServer::handshakeUpstream(Upstream& upstream, uint32_t index) {
+    ClientHello hello{};
+    std::string name = "kairos-proxy-" + std::to_string(index);
+    std::strncpy(hello.client_name, name.c_str(), sizeof(hello.client_name) - 1);
+    hello.client_version = PROTOCOL_VERSION;
+    hello.requested_layers = 0;
+    hello.capabilities = Capabilities::PROXY;
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::CLIENT_HELLO, 0, upstream.sequence++,
+                                                        sizeof(ClientHello));
+    auto message = ProtocolHelper::createMessage(header, &hello);
+    if (send(upstream.fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd{upstream.fd, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+
+        uint8_t chunk[4096];
+        ssize_t received = recv(upstream.fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        upstream.inbox.insert(upstream.inbox.end(), chunk, chunk + received);
+
+        MessageHeader reply;
+        bool valid = true;
+        while (peekMessage(upstream.inbox, 0, reply, valid)) {
+            size_t total = sizeof(MessageHeader) + reply.data_size;
+            if (reply.type == MessageType::SERVER_HELLO && reply.data_size == sizeof(ServerHello)) {
+                ServerHello server_hello;
+                std::memcpy(&server_hello, upstream.inbox.data() + sizeof(MessageHeader), sizeof(ServerHello));
+                upstream.client_id = server_hello.assigned_client_id;
+                // Anything after SERVER_HELLO belongs to the event loop
+                upstream.inbox.erase(upstream.inbox.begin(), upstream.inbox.begin() + total);
+                return true;
+            }
+            upstream.inbox.erase(upstream.inbox.begin(), upstream.inbox.begin() + total);
+        }
+        if (!valid) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+void ProxyServer::acceptClients(int listen_fd) {
+    while (true) {
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "accept failed: " << strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        size_t upstream = pickUpstream();
+        if (m_clients.size() >= m_config.max_clients || upstream == NO_UPSTREAM) {
+            close(fd);
+            m_stats.clients_rejected++;
+            continue;
+        }
+
+        setNonBlocking(fd);
+        if (listen_fd == m_tcp_listener) {
+            int nodelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        }
+
+        // Virtual ids only need to be unique among this proxy's live clients
+        while (m_next_virtual_id == 0 || m_clients.count(m_next_virtual_id) > 0) {
+            ++m_next_virtual_id;
+        }
+
+        LocalClient client;
+        client.fd = fd;
+        client.virtual_id = m_next_virtual_id++;
+        client.upstream = upstream;
+        m_upstreams[upstream].clients++;
+        m_clients.emplace(client.virtual_id, std::move(client));
+
+        m_stats.clients_accepted++;
+        m_stats.clients_active++;
+    }
+}
+
+bool ProxyServer::readSocket(int fd, std::vector<uint8_t>& inbox) {
+    uint8_t chunk[16 * 1024];
+    while (true) {
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            inbox.insert(inbox.end(), chunk, chunk + received);
+            continue;
+        }
+        if (received == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+bool ProxyServer::writeSocket(int fd, std::vector<uint8_t>& outbox) {
+    size_t sent = 0;
+    while (sent < outbox.size()) {
+        ssize_t result = send(fd, outbox.data() + sent, outbox.size() - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    outbox.erase(outbox.begin(), outbox.begin() + sent);
+    return true;
+}
+
+bool ProxyServer::processLocal(LocalClient& client) {
+    auto& upstream = m_upstreams[client.upstream];
+
+    size_t offset = 0;
+    MessageHeader header;
+    bool valid = true;
+    while (peekMessage(client.inbox, offset, header, valid)) {
+        const uint8_t* payload = client.inbox.data() + offset + sizeof(MessageHeader);
+        offset += sizeof(MessageHeader) + header.data_size;
+
+        if (!client.hello_received) {
+            if (header.type != MessageType::CLIENT_HELLO || header.data_size != sizeof(ClientHello)) {
+                return false;
+            }
+            ClientHello hello;
+            std::memcpy(&hello, payload, sizeof(ClientHello));
+            client.hello_received = true;
+
+            // Answer locally: the client talks to its virtual id from now on
+            ServerHello server_hello = ProtocolHelper::createServerHello(client.virtual_id);
+            server_hello.max_clients = m_config.max_clients;
+            MessageHeader reply = ProtocolHelper::createHeader(MessageType::SERVER_HELLO, client.virtual_id, 0,
+                                                               sizeof(ServerHello));
+            sendLocal(client, reply, &server_hello);
+
+            ProxyAttachData attach{};
+            attach.virtual_id = client.virtual_id;
+            std::memcpy(attach.client_name, hello.client_name, sizeof(attach.client_name));
+            attach.client_version = hello.client_version;
+            attach.capabilities = hello.capabilities;
+            sendUpstream(upstream, MessageType::PROXY_ATTACH, &attach, sizeof(attach));
+            continue;
+        }
+
+        switch (header.type) {
+            case MessageType::PING: {
+                if (header.data_size == sizeof(PingData)) {
+                    PingData ping;
+                    std::memcpy(&ping, payload, sizeof(PingData));
+                    PongData pong = ProtocolHelper::createPongResponse(ping, 0,
+                        static_cast<uint32_t>(upstream.outbox.size() + upstream.frame.size()));
+                    MessageHeader reply = ProtocolHelper::createHeader(MessageType::PONG, client.virtual_id, 0,
+                                                                       sizeof(PongData));
+                    sendLocal(client, reply, &pong);
+                    m_stats.pings_answered++;
+                }
+                break;
+            }
+
+            case MessageType::DISCONNECT:
+                return false;
+
+            // Handled by the proxy or meaningless from a local client
+            case MessageType::PONG:
+            case MessageType::CLIENT_HELLO:
+            case MessageType::PROXY_ATTACH:
+            case MessageType::PROXY_DETACH:
+            case MessageType::PROXY_FRAME:
+                break;
+
+            default:
+                header.client_id = client.virtual_id;
+                appendToFrame(upstream, header, payload);
+                m_stats.messages_up++;
+                break;
+        }
+    }
+
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+    return valid;
+}
+
+bool ProxyServer::processUpstream(size_t index) {
+    auto& upstream = m_upstreams[index];
+
+    size_t offset = 0;
+    MessageHeader header;
+    bool valid = true;
+    bool alive = true;
+    while (alive && peekMessage(upstream.inbox, offset, header, valid)) {
+        const uint8_t* payload = upstream.inbox.data() + offset + sizeof(MessageHeader);
+        offset += sizeof(MessageHeader) + header.data_size;
+
+        switch (header.type) {
+            case MessageType::PING: {
+                // Server keep-alive for the proxy connection itself
+                if (header.data_size == sizeof(PingData)) {
+                    PingData ping;
+                    std::memcpy(&ping, payload, sizeof(PingData));
+                    PongData pong = ProtocolHelper::createPongResponse(ping, 0, 0);
+                    sendUpstream(upstream, MessageType::PONG, &pong, sizeof(PongData));
+                }
+                break;
+            }
+
+            case MessageType::PROXY_ATTACH: {
+                if (header.data_size == sizeof(ProxyAttachData)) {
+                    ProxyAttachData attach;
+                    std::memcpy(&attach, payload, sizeof(ProxyAttachData));
+                    auto it = m_clients.find(attach.virtual_id);
+                    if (it != m_clients.end()) {
+                        it->second.server_client_id = attach.assigned_client_id;
+                    }
+                }
+                break;
+            }
+
+            case MessageType::PROXY_FRAME:
+                routeFrame(index, payload, header.data_size);
+                break;
+
+            case MessageType::DISCONNECT:
+                alive = false;
+                break;
+
+            case MessageType::SERVER_HELLO:
+            case MessageType::PONG:
+                break;
+
+            default:
+                broadcast(index, header, payload);
+                break;
+        }
+    }
+
+    // The upstream may have been closed while routing
+    if (upstream.fd >= 0) {
+        upstream.inbox.erase(upstream.inbox.begin(), upstream.inbox.begin() + offset);
+    }
+    return alive && valid;
+}
+
+void ProxyServer::routeFrame(size_t index, const uint8_t* data, size_t size) {
+    size_t offset = 0;
+    while (size - offset >= sizeof(MessageHeader)) {
+        MessageHeader inner;
+        std::memcpy(&inner, data + offset, sizeof(MessageHeader));
+        ProtocolHelper::networkToHost(inner);
+        size_t total = sizeof(MessageHeader) + inner.data_size;
+        if (!ProtocolHelper::validateHeader(inner) || size - offset < total) {
+            std::cerr << "Malformed PROXY_FRAME from upstream " << index << std::endl;
+            return;
+        }
+
+        auto it = m_clients.find(inner.client_id);
+        if (it != m_clients.end() && it->second.upstream == index) {
+            auto& client = it->second;
+            if (inner.type == MessageType::DISCONNECT) {
+                // The server already dropped this client: nothing to detach
+                closeLocal(client.virtual_id, false);
+            } else {
+                // Already in wire format and addressed to the client's virtual id
+                client.outbox.insert(client.outbox.end(), data + offset, data + offset + total);
+                writeSocket(client.fd, client.outbox);
+                m_stats.messages_down++;
+                m_stats.bytes_down += total;
+            }
+        }
+        offset += total;
+    }
+}
+
+void ProxyServer::broadcast(size_t index, const MessageHeader& header, const uint8_t* payload) {
+    m_stats.broadcasts_down++;
+    for (auto& [virtual_id, client] : m_clients) {
+        if (client.upstream != index || !client.hello_received) {
+            continue;
+        }
+        MessageHeader copy = header;
+        copy.client_id = virtual_id;
+        sendLocal(client, copy, payload);
+    }
+}
+
+void ProxyServer::appendToFrame(Upstream& upstream, const MessageHeader& header, const uint8_t* payload) {
+    const size_t message_size = sizeof(MessageHeader) + header.data_size;
+    if (!upstream.frame.empty() && upstream.frame.size() + message_size > m_config.max_frame_bytes) {
+        flushFrame(upstream);
+    }
+    if (upstream.frame.empty()) {
+        upstream.frame_started = std::chrono::steady_clock::now();
+    }
+
+    MessageHeader wire = header;
+    ProtocolHelper::hostToNetwork(wire);
+    const auto* header_bytes = reinterpret_cast<const uint8_t*>(&wire);
+    upstream.frame.insert(upstream.frame.end(), header_bytes, header_bytes + sizeof(MessageHeader));
+    upstream.frame.insert(upstream.frame.end(), payload, payload + header.data_size);
+    upstream.frame_messages++;
+
+    if (upstream.frame.size() >= m_config.max_frame_bytes) {
+        flushFrame(upstream);
+    }
+}
+
+void ProxyServer::flushFrame(Upstream& upstream) {
+    if (upstream.frame.empty() || upstream.fd < 0) {
+        return;
+    }
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::PROXY_FRAME, upstream.client_id,
+                                                        upstream.sequence++,
+                                                        static_cast<uint32_t>(upstream.frame.size()));
+    auto message = ProtocolHelper::createMessage(header, upstream.frame.data());
+    upstream.outbox.insert(upstream.outbox.end(), message.begin(), message.end());
+    writeSocket(upstream.fd, upstream.outbox);
+
+    m_stats.frames_up++;
+    m_stats.bytes_up += message.size();
+    upstream.frame.clear();
+    upstream.frame_messages = 0;
+}
+
+void ProxyServer::sendUpstream(Upstream& upstream, MessageType type, const void* data, uint32_t size) {
+    if (upstream.fd < 0) {
+        return;
+    }
+    flushFrame(upstream);
+
+    MessageHeader header = ProtocolHelper::createHeader(type, upstream.client_id, upstream.sequence++, size);
+    auto message = ProtocolHelper::createMessage(header, data);
+    upstream.outbox.insert(upstream.outbox.end(), message.begin(), message.end());
+    writeSocket(upstream.fd, upstream.outbox);
+    m_stats.bytes_up += message.size();
+}
+
+void ProxyServer::sendLocal(LocalClient& client, const MessageHeader& header, const void* data) {
+    auto message = ProtocolHelper::createMessage(header, data);
+    client.outbox.insert(client.outbox.end(), message.begin(), message.end());
+    writeSocket(client.fd, client.outbox);
+    m_stats.bytes_down += message.size();
+}
+
+void ProxyServer::closeLocal(uint32_t virtual_id, bool detach) {
+    auto it = m_clients.find(virtual_id);
+    if (it == m_clients.end()) {
+        return;
+    }
+
+    auto& client = it->second;
+    auto& upstream = m_upstreams[client.upstream];
+    if (detach && client.hello_received) {
+        ProxyDetachData detach_data{};
+        detach_data.virtual_id = virtual_id;
+        sendUpstream(upstream, MessageType::PROXY_DETACH, &detach_data, sizeof(detach_data));
+    }
+
+    close(client.fd);
+    upstream.clients--;
+    m_clients.erase(it);
+    m_stats.clients_active--;
+}
+
+void ProxyServer::closeSlowClients() {
+    std::vector<uint32_t> slow;
+    for (const auto& [virtual_id, client] : m_clients) {
+        if (client.outbox.size() > MAX_CLIENT_BACKLOG) {
+            slow.push_back(virtual_id);
+        }
+    }
+    for (uint32_t virtual_id : slow) {
+        std::cerr << "Dropping client " << virtual_id << ": it stopped reading" << std::endl;
+        closeLocal(virtual_id, true);
+    }
+}
+
+void ProxyServer::closeUpstream(size_t index) {
+    auto& upstream = m_upstreams[index];
+    if (upstream.fd < 0) {
+        return;
+    }
+    close(upstream.fd);
+    upstream.fd = -1;
+    upstream.inbox.clear();
+    upstream.outbox.clear();
+    upstream.frame.clear();
+
+    // Its clients are gone as far as the server is concerned
+    std::vector<uint32_t> orphans;
+    for (const auto& [virtual_id, client] : m_clients) {
+        if (client.upstream == index) {
+            orphans.push_back(virtual_id);
+        }
+    }
+    for (uint32_t virtual_id : orphans) {
+        closeLocal(virtual_id, false);
+    }
+}
+
+size_t ProxyServer::pickUpstream() const {
+    size_t best = NO_UPSTREAM;
+    for (size_t i = 0; i < m_upstreams.size(); ++i) {
+        if (m_upstreams[i].fd >= 0 && (best == NO_UPSTREAM || m_upstreams[i].clients < m_upstreams[best].clients)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace Kairos::Proxy
@@ -0,0 +1,139 @@
+// tools/kairos-proxy/ProxyServer.hpp
+#pragma once
+
+#include <Protocol.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Kairos::Proxy {
+
+/**
+ * @brief Multiplexes many local clients over a few upstream server connections
+ *
+ * Local clients connect to the proxy exactly as they would to the server.
+ * The proxy answers CLIENT_HELLO and PINGs itself, gives each client a
+ * virtual id and attaches it upstream with PROXY_ATTACH. Client messages
+ * are coalesced per upstream into PROXY_FRAMEs, sent once a frame is full
+ * or has waited flush_interval_us. What the server sends back is routed by
+ * virtual id; unwrapped messages (broadcasts) go to every client of that
+ * upstream. One thread and one poll() loop keep the proxy itself cheap.
+ */
+class ProxyServer {
+public:
+    struct Config {
+        // Where local clients connect
+        std::string listen_unix_path = "/tmp/kairos_proxy.sock";   // Empty: no Unix listener
+        std::string listen_tcp_address = "127.0.0.1";
+        uint16_t listen_tcp_port = 0;                               // 0: no TCP listener
+
+        // The server
+        std::string upstream_unix_path = DEFAULT_UNIX_SOCKET;       // Empty: connect over TCP
+        std::string upstream_tcp_address = "127.0.0.1";
+        uint16_t upstream_tcp_port = DEFAULT_SERVER_PORT;
+        uint32_t upstream_count = 1;                                // Clients are spread across them
+
+        uint32_t max_clients = 4096;
+        uint32_t flush_interval_us = 500;       // Longest a message waits to be coalesced
+        size_t max_frame_bytes = 32 * 1024;     // A frame is sent as soon as it reaches this size
+        uint32_t stats_interval_seconds = 0;    // Print getStatsLine() this often; 0: never
+    };
+
+    struct Stats {
+        uint64_t clients_accepted = 0;
+        uint64_t clients_rejected = 0;
+        uint32_t clients_active = 0;
+        uint64_t messages_up = 0;               // Client messages forwarded to the server
+        uint64_t frames_up = 0;                 // PROXY_FRAMEs they were coalesced into
+        uint64_t bytes_up = 0;
+        uint64_t messages_down = 0;             // Routed to a single client
+        uint64_t broadcasts_down = 0;           // Fanned out to every client of an upstream
+        uint64_t bytes_down = 0;
+        uint64_t pings_answered = 0;            // Answered locally, never sent upstream
+        uint64_t backpressure_waits = 0;        // Loop passes that left clients unread
+    };
+
+public:
+    explicit ProxyServer(const Config& config);
+    ~ProxyServer();
+
+    ProxyServer(const ProxyServer&) = delete;
+    ProxyServer& operator=(const ProxyServer&) = delete;
+
+    // Connects and handshakes every upstream, then opens the listeners
+    bool start();
+
+    // Serves until running turns false or every upstream is gone
+    bool run(const std::atomic<bool>& running);
+    void stop();
+
+    const Config& getConfig() const { return m_config; }
+    const Stats& getStats() const { return m_stats; }
+    std::string getStatsLine() const;
+
+private:
+    struct Upstream {
+        int fd = -1;
+        uint32_t client_id = 0;                 // The proxy's own id on the server
+        uint32_t sequence = 0;
+        uint32_t clients = 0;
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+        std::vector<uint8_t> frame;             // Client messages waiting to be sent as one PROXY_FRAME
+        uint32_t frame_messages = 0;
+        std::chrono::steady_clock::time_point frame_started;
+    };
+
+    struct LocalClient {
+        int fd = -1;
+        uint32_t virtual_id = 0;
+        size_t upstream = 0;
+        bool hello_received = false;
+        uint32_t server_client_id = 0;          // Known once the server confirms PROXY_ATTACH
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+    };
+
+    // Sockets
+    int listenUnix();
+    int listenTcp();
+    int connectUpstream();
+    bool handshakeUpstream(Upstream& upstream, uint32_t index);
+    void acceptClients(int listen_fd);
+
+    // Traffic
+    bool readSocket(int fd, std::vector<uint8_t>& inbox);
+    bool writeSocket(int fd, std::vector<uint8_t>& outbox);
+    bool processLocal(LocalClient& client);
+    bool processUpstream(size_t index);
+    void routeFrame(size_t index, const uint8_t* data, size_t size);
+    void broadcast(size_t index, const MessageHeader& header, const uint8_t* payload);
+
+    // Upstream framing; control messages flush the pending frame first so
+    // the server sees everything in the order the proxy received it
+    void appendToFrame(Upstream& upstream, const MessageHeader& header, const uint8_t* payload);
+    void flushFrame(Upstream& upstream);
+    void sendUpstream(Upstream& upstream, MessageType type, const void* data, uint32_t size);
+    void sendLocal(LocalClient& client, const MessageHeader& header, const void* data);
+
+    void closeLocal(uint32_t virtual_id, bool detach);
+    void closeSlowClients();
+    void closeUpstream(size_t index);
+    size_t pickUpstream() const;
+
+private:
+    Config m_config;
+    Stats m_stats;
+
+    int m_unix_listener = -1;
+    int m_tcp_listener = -1;
+    std::vector<Upstream> m_upstreams;
+    std::unordered_map<uint32_t, LocalClient> m_clients;       // By virtual id
+    uint32_t m_next_virtual_id = 1;
+};
+
+} // namespace Kairos::Proxy
@@ -0,0 +1,153 @@
+// tools/kairos-proxy/main.cpp
+#include "ProxyServer.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <sys/resource.h>
+
+using namespace Kairos::Proxy;
+
+namespace {
+
+std::atomic<bool> g_running{true};
+
+struct Options {
+    ProxyServer::Config proxy;
+};
+
+void signalHandler(int) {
+    g_running = false;
+}
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n\n";
+    std::cout << "Accepts many local Kairos clients and forwards their traffic to the server over\n";
+    std::cout << "a few upstream connections. Handshakes and PINGs are answered locally; client\n";
+    std::cout << "messages are coalesced into PROXY_FRAMEs so the server sees few, large reads.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --listen <path>           Unix socket for local clients, \"\" = none (default: /tmp/kairos_proxy.sock)\n";
+    std::cout << "  --listen-tcp <host:port>  Also accept local clients over TCP\n";
+    std::cout << "  --upstream <path>         Server Unix socket (default: " << Kairos::DEFAULT_UNIX_SOCKET << ")\n";
+    std::cout << "  --upstream-tcp <host:port> Connect to the server over TCP instead\n";
+    std::cout << "  --upstreams <n>           Upstream connections to spread clients over (default: 1)\n";
+    std::cout << "  --max-clients <n>         Local client limit (default: 4096)\n";
+    std::cout << "  --flush-interval <us>     Longest a message waits to be coalesced, 0 = every pass (default: 500)\n";
+    std::cout << "  --max-frame <bytes>       Send a frame once it reaches this size (default: 32768)\n";
+    std::cout << "  --stats-interval <s>      Print a stats line every s seconds, 0 = only on exit (default: 0)\n";
+    std::cout << "  --help                    Show this help message\n";
+}
+
+bool parseHostPort(const std::string& text, std::string& host, uint16_t& port) {
+    auto colon = text.rfind(':');
+    if (colon == std::string::npos || colon + 1 == text.size()) {
+        return false;
+    }
+    if (colon > 0) {
+        host = text.substr(0, colon);
+    }
+    port = static_cast<uint16_t>(std::stoul(text.substr(colon + 1)));
+    return port != 0;
+}
+
+bool parseCommandLine(int argc, char* argv[], Options& options) {
+    auto& proxy = options.proxy;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--listen" && i + 1 < argc) {
+            proxy.listen_unix_path = argv[++i];
+        } else if (arg == "--listen-tcp" && i + 1 < argc) {
+            if (!parseHostPort(argv[++i], proxy.listen_tcp_address, proxy.listen_tcp_port)) {
+                std::cerr << "Expected host:port for --listen-tcp" << std::endl;
+                return false;
+            }
+        } else if (arg == "--upstream" && i + 1 < argc) {
+            proxy.upstream_unix_path = argv[++i];
+        } else if (arg == "--upstream-tcp" && i + 1 < argc) {
+            if (!parseHostPort(argv[++i], proxy.upstream_tcp_address, proxy.upstream_tcp_port)) {
+                std::cerr << "Expected host:port for --upstream-tcp" << std::endl;
+                return false;
+            }
+            proxy.upstream_unix_path.clear();
+        } else if (arg == "--upstreams" && i + 1 < argc) {
+            proxy.upstream_count = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--max-clients" && i + 1 < argc) {
+            proxy.max_clients = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--flush-interval" && i + 1 < argc) {
+            proxy.flush_interval_us = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--max-frame" && i + 1 < argc) {
+            proxy.max_frame_bytes = std::stoul(argv[++i]);
+        } else if (arg == "--stats-interval" && i + 1 < argc) {
+            proxy.stats_interval_seconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (proxy.max_frame_bytes < 1024 || proxy.max_frame_bytes > Kairos::Limits::MAX_MESSAGE_SIZE) {
+        std::cerr << "--max-frame must be between 1024 and " << Kairos::Limits::MAX_MESSAGE_SIZE << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Raises the descriptor limit; the proxy holds one per local client
+ */
+void raiseDescriptorLimit(uint32_t connections) {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return;
+    }
+
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+
+    rlim_t needed = static_cast<rlim_t>(connections) + 64;
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+        std::cerr << "Warning: descriptor limit " << limit.rlim_cur << " is below the " << needed
+                  << " needed for --max-clients; raise it with ulimit -n" << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        if (!parseCommandLine(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+    raiseDescriptorLimit(options.proxy.max_clients);
+
+    ProxyServer proxy(options.proxy);
+    if (!proxy.start()) {
+        std::cerr << "Failed to start kairos-proxy" << std::endl;
+        return 1;
+    }
+    std::cerr << "kairos-proxy: " << proxy.getConfig().upstream_count << " upstream connection(s) ready" << std::endl;
+
+    bool ok = proxy.run(g_running);
+
+    proxy.stop();
+    std::cerr << "kairos-proxy: " << proxy.getStatsLine() << std::endl;
+    return ok ? 0 : 1;
+}
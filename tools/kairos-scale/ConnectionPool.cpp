@@ -0,0 +1,404 @@
+// tools/kairos-scale/ConnectionPool.cpp
+#include "ConnectionPool.hpp"
+
+#include <Protocol.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Kairos::Scale {
+
+namespace {
+
+// Drop new traffic for a connection once this much is waiting to be written
+constexpr size_t MAX_OUTBOX_BYTES = 256 * 1024;
+
+uint64_t steadyMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // anonymous namespace
+
+ConnectionPool::ConnectionPool(const Target& target) : m_target(target) {}
+
+ConnectionPool::~ConnectionPool() {
+    closeAll();
+}
+
+bool ConnectionPool::open(Transport transport, bool active, uint32_t& accept_latency_us) {
+    auto start = std::chrono::steady_clock::now();
+
+    Connection connection;
+    connection.transport = transport;
+    connection.active = active;
+    connection.fd = connectSocket(transport);
+    if (connection.fd < 0) {
+        return false;
+    }
+
+    if (!handshake(connection)) {
+        close(connection.fd);
+        return false;
+    }
+
+    accept_latency_us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    // From here on the event loop owns the socket
+    fcntl(connection.fd, F_SETFL, fcntl(connection.fd, F_GETFL, 0) | O_NONBLOCK);
+
+    // Spread active connections across the first interval instead of sending in lockstep
+    auto now = std::chrono::steady_clock::now();
+    auto offset = std::chrono::microseconds((m_connections.size() * 7919) % 100000);
+    connection.next_send = now + offset;
+    connection.next_ping = now + offset;
+
+    m_connections.push_back(std::move(connection));
+    return true;
+}
+
+void ConnectionPool::closeAll() {
+    for (auto& connection : m_connections) {
+        closeConnection(connection);
+    }
+    m_connections.clear();
+}
+
+size_t ConnectionPool::countOpen() const {
+    return static_cast<size_t>(std::count_if(m_connections.begin(), m_connections.end(),
+        [](const Connection& c) { return c.fd >= 0; }));
+}
+
+size_t ConnectionPool::countActive() const {
+    return static_cast<size_t>(std::count_if(m_connections.begin(), m_connections.end(),
+        [](const Connection& c) { return c.fd >= 0 && c.active; }));
+}
+
+size_t ConnectionPool::countTcp() const {
+    return static_cast<size_t>(std::count_if(m_connections.begin(), m_connections.end(),
+        [](const Connection& c) { return c.fd >= 0 && c.transport == Transport::Tcp; }));
+}
+
+void ConnectionPool::drive(std::chrono::milliseconds duration, const Traffic& traffic, SampleSet* rtt_samples) {
+    using clock = std::chrono::steady_clock;
+
+    auto deadline = clock::now() + duration;
+    auto send_interval = traffic.message_rate > 0
+        ? std::chrono::nanoseconds(1000000000ull / traffic.message_rate)
+        : std::chrono::nanoseconds(0);
+    auto ping_interval = std::chrono::milliseconds(traffic.ping_interval_ms);
+
+    std::vector<pollfd> pfds;
+    std::vector<size_t> owners;
+    pfds.reserve(m_connections.size());
+    owners.reserve(m_connections.size());
+
+    do {
+        auto now = clock::now();
+
+        // Generate traffic that is due
+        for (auto& connection : m_connections) {
+            if (connection.fd < 0 || !connection.active) {
+                continue;
+            }
+
+            if (traffic.message_rate > 0 && now >= connection.next_send) {
+                if (connection.outbox.size() < MAX_OUTBOX_BYTES) {
+                    DrawRectangleData rect{};
+                    rect.position = {static_cast<float>(connection.sequence % 1024),
+                                     static_cast<float>(connection.client_id % 768)};
+                    rect.width = 8.0f;
+                    rect.height = 8.0f;
+                    MessageHeader header = ProtocolHelper::createHeader(MessageType::FILL_RECTANGLE,
+                                                                        connection.client_id,
+                                                                        connection.sequence++,
+                                                                        sizeof(DrawRectangleData), 1);
+                    queue(connection, ProtocolHelper::createMessage(header, &rect));
+                    m_counters.messages_sent++;
+                } else {
+                    m_counters.send_stalls++;
+                }
+
+                connection.next_send += send_interval;
+                if (now - connection.next_send > std::chrono::seconds(1)) {
+                    // Far behind schedule: do not burst to catch up
+                    connection.next_send = now + send_interval;
+                }
+            }
+
+            if (traffic.ping_interval_ms > 0 && now >= connection.next_ping) {
+                PingData ping{};
+                ping.client_timestamp = steadyMicros();
+                MessageHeader header = ProtocolHelper::createHeader(MessageType::PING, connection.client_id,
+                                                                    connection.sequence++, sizeof(PingData));
+                queue(connection, ProtocolHelper::createMessage(header, &ping));
+                m_counters.pings_sent++;
+                connection.next_ping = now + ping_interval;
+            }
+        }
+
+        // Wait for readability (and writability where output is pending)
+        pfds.clear();
+        owners.clear();
+        for (size_t i = 0; i < m_connections.size(); ++i) {
+            const auto& connection = m_connections[i];
+            if (connection.fd < 0) {
+                continue;
+            }
+            short events = POLLIN;
+            if (!connection.outbox.empty()) {
+                events |= POLLOUT;
+            }
+            pfds.push_back({connection.fd, events, 0});
+            owners.push_back(i);
+        }
+
+        if (pfds.empty()) {
+            break;
+        }
+
+        int ready = poll(pfds.data(), pfds.size(), 1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "poll failed: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        for (size_t i = 0; i < pfds.size() && ready > 0; ++i) {
+            if (pfds[i].revents == 0) {
+                continue;
+            }
+            --ready;
+
+            auto& connection = m_connections[owners[i]];
+            bool alive = true;
+            if (pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                alive = receive(connection, rtt_samples);
+            }
+            if (alive && (pfds[i].revents & POLLOUT)) {
+                alive = flush(connection);
+            }
+            if (!alive) {
+                closeConnection(connection);
+                m_counters.disconnects++;
+            }
+        }
+    } while (clock::now() < deadline);
+}
+
+int ConnectionPool::connectSocket(Transport transport) {
+    int fd = -1;
+
+    if (transport == Transport::Unix) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "socket(AF_UNIX) failed: " << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, m_target.unix_socket_path.c_str(), sizeof(addr.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Unix connect failed: " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+    } else {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "socket(AF_INET) failed: " << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(m_target.tcp_port);
+        inet_pton(AF_INET, m_target.tcp_address.c_str(), &addr.sin_addr);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "TCP connect failed: " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+
+    return fd;
+}
+
+bool ConnectionPool::handshake(Connection& connection) {
+    ClientHello hello{};
+    std::string name = "kairos-scale-" + std::to_string(m_connections.size());
+    std::strncpy(hello.client_name, name.c_str(), sizeof(hello.client_name) - 1);
+    hello.client_version = PROTOCOL_VERSION;
+    hello.requested_layers = 1;
+    hello.capabilities = 0;
+
+    MessageHeader header = ProtocolHelper::createHeader(MessageType::CLIENT_HELLO, 0, connection.sequence++,
+                                                        sizeof(ClientHello));
+    auto message = ProtocolHelper::createMessage(header, &hello);
+    if (send(connection.fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+        return false;
+    }
+
+    // The server handshakes on its accept thread, well within its own 5s timeout
+    std::vector<uint8_t> buffer;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd{connection.fd, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+
+        uint8_t chunk[4096];
+        ssize_t received = recv(connection.fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer.insert(buffer.end(), chunk, chunk + received);
+
+        while (buffer.size() >= sizeof(MessageHeader)) {
+            MessageHeader reply;
+            std::memcpy(&reply, buffer.data(), sizeof(MessageHeader));
+            ProtocolHelper::networkToHost(reply);
+            size_t total = sizeof(MessageHeader) + reply.data_size;
+            if (buffer.size() < total) {
+                break;
+            }
+
+            if (reply.type == MessageType::SERVER_HELLO && reply.data_size == sizeof(ServerHello)) {
+                ServerHello server_hello;
+                std::memcpy(&server_hello, buffer.data() + sizeof(MessageHeader), sizeof(ServerHello));
+                connection.client_id = server_hello.assigned_client_id;
+                // Anything after SERVER_HELLO belongs to the event loop
+                connection.inbox.assign(buffer.begin() + total, buffer.end());
+                return true;
+            }
+            buffer.erase(buffer.begin(), buffer.begin() + total);
+        }
+    }
+
+    return false;
+}
+
+void ConnectionPool::queue(Connection& connection, const std::vector<uint8_t>& message) {
+    connection.outbox.insert(connection.outbox.end(), message.begin(), message.end());
+    m_counters.bytes_sent += message.size();
+    flush(connection);
+}
+
+bool ConnectionPool::flush(Connection& connection) {
+    size_t sent = 0;
+    while (sent < connection.outbox.size()) {
+        ssize_t result = send(connection.fd, connection.outbox.data() + sent,
+                              connection.outbox.size() - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    connection.outbox.erase(connection.outbox.begin(), connection.outbox.begin() + sent);
+    return true;
+}
+
+bool ConnectionPool::receive(Connection& connection, SampleSet* rtt_samples) {
+    uint8_t chunk[16 * 1024];
+    while (true) {
+        ssize_t received = recv(connection.fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection.inbox.insert(connection.inbox.end(), chunk, chunk + received);
+            continue;
+        }
+        if (received == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    size_t offset = 0;
+    while (connection.inbox.size() - offset >= sizeof(MessageHeader)) {
+        MessageHeader header;
+        std::memcpy(&header, connection.inbox.data() + offset, sizeof(MessageHeader));
+        ProtocolHelper::networkToHost(header);
+        size_t total = sizeof(MessageHeader) + header.data_size;
+        if (connection.inbox.size() - offset < total) {
+            break;
+        }
+        const uint8_t* payload = connection.inbox.data() + offset + sizeof(MessageHeader);
+
+        switch (header.type) {
+            case MessageType::FRAME_CALLBACK:
+                m_counters.frame_callbacks++;
+                break;
+
+            case MessageType::PONG:
+                if (header.data_size == sizeof(PongData)) {
+                    PongData pong;
+                    std::memcpy(&pong, payload, sizeof(PongData));
+                    m_counters.pongs_received++;
+                    if (rtt_samples) {
+                        rtt_samples->add(static_cast<uint32_t>(steadyMicros() - pong.client_timestamp));
+                    }
+                }
+                break;
+
+            case MessageType::PING:
+                // Server keep-alive: answer so the connection is not timed out
+                if (header.data_size == sizeof(PingData)) {
+                    PingData ping;
+                    std::memcpy(&ping, payload, sizeof(PingData));
+                    PongData pong = ProtocolHelper::createPongResponse(ping, 0, 0);
+                    MessageHeader reply = ProtocolHelper::createHeader(MessageType::PONG, connection.client_id,
+                                                                       0, sizeof(PongData));
+                    queue(connection, ProtocolHelper::createMessage(reply, &pong));
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        offset += total;
+    }
+
+    connection.inbox.erase(connection.inbox.begin(), connection.inbox.begin() + offset);
+    return true;
+}
+
+void ConnectionPool::closeConnection(Connection& connection) {
+    if (connection.fd >= 0) {
+        close(connection.fd);
+        connection.fd = -1;
+    }
+    connection.inbox.clear();
+    connection.outbox.clear();
+}
+
+} // namespace Kairos::Scale
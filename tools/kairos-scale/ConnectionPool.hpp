@@ -0,0 +1,100 @@
+// tools/kairos-scale/ConnectionPool.hpp
+#pragma once
+
+#include "SampleSet.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos::Scale {
+
+using E2E::SampleSet;
+
+/**
+ * @brief Thousands of real client connections driven from one poll() loop
+ *
+ * Each connection does a full CLIENT_HELLO/SERVER_HELLO handshake over a Unix
+ * socket or TCP. Active connections then send FILL_RECTANGLE commands at a
+ * fixed rate plus periodic PINGs for round-trip samples; idle connections only
+ * drain what the server broadcasts (frame callbacks) and answer keep-alive
+ * PINGs. One thread keeps the client side cheap and out of the way.
+ */
+class ConnectionPool {
+public:
+    enum class Transport {
+        Unix,
+        Tcp
+    };
+
+    struct Target {
+        std::string unix_socket_path;
+        std::string tcp_address = "127.0.0.1";
+        uint16_t tcp_port = 0;
+    };
+
+    struct Traffic {
+        uint32_t message_rate = 60;         // Commands per second per active connection
+        uint32_t ping_interval_ms = 100;    // Per active connection, 0 = off
+    };
+
+    struct Counters {
+        uint64_t messages_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t pings_sent = 0;
+        uint64_t pongs_received = 0;
+        uint64_t frame_callbacks = 0;
+        uint64_t send_stalls = 0;          // Ticks skipped because the socket was backed up
+        uint64_t disconnects = 0;
+    };
+
+public:
+    explicit ConnectionPool(const Target& target);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Connects and completes the handshake; accept latency is connect() -> SERVER_HELLO
+    bool open(Transport transport, bool active, uint32_t& accept_latency_us);
+    void closeAll();
+
+    // Runs the event loop; PING round trips are added to rtt_samples when given
+    void drive(std::chrono::milliseconds duration, const Traffic& traffic, SampleSet* rtt_samples);
+
+    size_t size() const { return m_connections.size(); }
+    size_t countOpen() const;
+    size_t countActive() const;
+    size_t countTcp() const;
+
+    const Counters& getCounters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters{}; }
+
+private:
+    struct Connection {
+        int fd = -1;
+        Transport transport = Transport::Unix;
+        bool active = false;
+        uint32_t client_id = 0;
+        uint32_t sequence = 0;
+        std::chrono::steady_clock::time_point next_send;
+        std::chrono::steady_clock::time_point next_ping;
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+    };
+
+    int connectSocket(Transport transport);
+    bool handshake(Connection& connection);
+    void queue(Connection& connection, const std::vector<uint8_t>& message);
+    bool flush(Connection& connection);
+    bool receive(Connection& connection, SampleSet* rtt_samples);
+    void closeConnection(Connection& connection);
+
+private:
+    Target m_target;
+    std::vector<Connection> m_connections;
+    Counters m_counters;
+};
+
+} // namespace Kairos::Scale
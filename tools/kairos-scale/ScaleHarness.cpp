@@ -0,0 +1,263 @@
+// tools/kairos-scale/ScaleHarness.cpp
+#include "ScaleHarness.hpp"
+#include "ServerProcess.hpp"
+
+#include <Protocol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace Kairos::Scale {
+
+namespace {
+
+// Consecutive connect failures after which the sweep stops growing
+constexpr uint32_t MAX_CONSECUTIVE_FAILURES = 8;
+
+// Spreads a ratio evenly over connection indices: exactly round(n * ratio) of the first n are picked
+bool pickByRatio(size_t index, double ratio) {
+    auto count = [ratio](size_t n) { return static_cast<uint64_t>(n * ratio + 0.5); };
+    return count(index + 1) > count(index);
+}
+
+void measure(ServerProcess& server, ConnectionPool& pool, const ScaleHarness::Config& config,
+             ScaleHarness::StepResult& step) {
+    ConnectionPool::Traffic traffic;
+    traffic.message_rate = config.message_rate;
+    traffic.ping_interval_ms = config.ping_interval_ms;
+
+    pool.drive(std::chrono::seconds(config.settle_seconds), traffic, nullptr);
+    pool.resetCounters();
+
+    SampleSet rtt;
+    auto begin_sample = server.sample();
+    auto begin_time = std::chrono::steady_clock::now();
+
+    pool.drive(std::chrono::seconds(config.duration_seconds), traffic, &rtt);
+
+    auto end_time = std::chrono::steady_clock::now();
+    auto end_sample = server.sample();
+
+    step.measured_seconds = std::chrono::duration<double>(end_time - begin_time).count();
+    double seconds = step.measured_seconds > 0.0 ? step.measured_seconds : 1.0;
+    if (begin_sample.valid && end_sample.valid) {
+        step.server_cpu_percent = (end_sample.cpu_seconds - begin_sample.cpu_seconds) / seconds * 100.0;
+        step.server_rss_kb = end_sample.rss_kb;
+        step.server_threads = end_sample.threads;
+    }
+
+    const auto& counters = pool.getCounters();
+    step.connections = static_cast<uint32_t>(pool.countOpen());
+    step.active = static_cast<uint32_t>(pool.countActive());
+    step.tcp = static_cast<uint32_t>(pool.countTcp());
+    step.disconnects = counters.disconnects;
+    step.send_stalls = counters.send_stalls;
+    step.messages_per_second = counters.messages_sent / seconds;
+    step.frame_callbacks_per_second = counters.frame_callbacks / seconds;
+    step.message_rtt_us = rtt.summarize();
+}
+
+void writeSummary(std::stringstream& ss, const char* name, const SampleSet::Summary& summary, bool last) {
+    ss << "\"" << name << "\": {"
+       << "\"count\": " << summary.count
+       << ", \"mean\": " << summary.mean
+       << ", \"p50\": " << summary.p50
+       << ", \"p99\": " << summary.p99
+       << ", \"max\": " << summary.max << "}"
+       << (last ? "" : ", ");
+}
+
+void writeStep(std::stringstream& ss, const ScaleHarness::StepResult& step, bool last) {
+    ss << "    {"
+       << "\"target_connections\": " << step.target_connections
+       << ", \"connections\": " << step.connections
+       << ", \"active\": " << step.active
+       << ", \"tcp\": " << step.tcp
+       << ", \"failed_connects\": " << step.failed_connects
+       << ", \"disconnects\": " << step.disconnects
+       << ", \"measured_seconds\": " << step.measured_seconds
+       << ", \"server_cpu_percent\": " << step.server_cpu_percent
+       << ", \"server_rss_kb\": " << step.server_rss_kb
+       << ", \"rss_per_connection_kb\": " << step.rss_per_connection_kb
+       << ", \"server_threads\": " << step.server_threads
+       << ", \"messages_per_second\": " << step.messages_per_second
+       << ", \"frame_callbacks_per_second\": " << step.frame_callbacks_per_second
+       << ", \"send_stalls\": " << step.send_stalls
+       << ", ";
+    writeSummary(ss, "accept_latency_us", step.accept_latency_us, false);
+    writeSummary(ss, "message_rtt_us", step.message_rtt_us, true);
+    ss << "}" << (last ? "" : ",") << "\n";
+}
+
+} // anonymous namespace
+
+ScaleHarness::ScaleHarness() : ScaleHarness(Config{}) {}
+
+ScaleHarness::ScaleHarness(const Config& config) : m_config(config) {
+    std::sort(m_config.steps.begin(), m_config.steps.end());
+    m_config.steps.erase(std::unique(m_config.steps.begin(), m_config.steps.end()), m_config.steps.end());
+    m_config.active_ratio = std::clamp(m_config.active_ratio, 0.0, 1.0);
+    m_config.tcp_ratio = std::clamp(m_config.tcp_ratio, 0.0, 1.0);
+    if (m_config.unix_socket_path.empty()) {
+        m_config.unix_socket_path = "/tmp/kairos_scale_" + std::to_string(getpid()) + ".sock";
+    }
+}
+
+bool ScaleHarness::run(Result& result) {
+    if (m_config.steps.empty()) {
+        std::cerr << "No connection steps configured" << std::endl;
+        return false;
+    }
+
+    ServerProcess::Config server_config;
+    server_config.unix_socket_path = m_config.unix_socket_path;
+    server_config.tcp_port = m_config.tcp_port;
+    server_config.max_clients = m_config.steps.back();
+    server_config.network_threads = m_config.network_threads;
+    server_config.target_fps = m_config.target_fps;
+    server_config.log_file = m_config.log_file;
+
+    ServerProcess server;
+    if (!server.start(server_config)) {
+        return false;
+    }
+
+    ConnectionPool::Target target;
+    target.unix_socket_path = m_config.unix_socket_path;
+    target.tcp_port = m_config.tcp_port;
+    ConnectionPool pool(target);
+
+    std::cerr << "Measuring zero-connection baseline..." << std::endl;
+    measure(server, pool, m_config, result.baseline);
+
+    for (uint32_t goal : m_config.steps) {
+        StepResult step;
+        step.target_connections = goal;
+
+        std::cerr << "Growing to " << goal << " connections..." << std::endl;
+        SampleSet accept_latency;
+        uint32_t consecutive_failures = 0;
+
+        while (pool.size() < goal && consecutive_failures < MAX_CONSECUTIVE_FAILURES) {
+            size_t index = pool.size() + step.failed_connects;
+            auto transport = pickByRatio(index, m_config.tcp_ratio)
+                ? ConnectionPool::Transport::Tcp : ConnectionPool::Transport::Unix;
+            bool active = pickByRatio(index, m_config.active_ratio);
+
+            uint32_t latency_us = 0;
+            if (pool.open(transport, active, latency_us)) {
+                accept_latency.add(latency_us);
+                consecutive_failures = 0;
+            } else {
+                step.failed_connects++;
+                consecutive_failures++;
+            }
+
+            // Keep draining frame callbacks so earlier connections do not back up the server
+            if (pool.size() % 64 == 0) {
+                pool.drive(std::chrono::milliseconds(0), ConnectionPool::Traffic{0, 0}, nullptr);
+            }
+        }
+        step.accept_latency_us = accept_latency.summarize();
+
+        if (!server.isAlive()) {
+            std::cerr << "Server process exited, see " << m_config.log_file << std::endl;
+            result.truncated = true;
+            break;
+        }
+
+        measure(server, pool, m_config, step);
+        if (step.connections > 0 && step.server_rss_kb > result.baseline.server_rss_kb) {
+            step.rss_per_connection_kb =
+                static_cast<double>(step.server_rss_kb - result.baseline.server_rss_kb) / step.connections;
+        }
+        result.steps.push_back(step);
+
+        if (consecutive_failures >= MAX_CONSECUTIVE_FAILURES) {
+            std::cerr << "Stopping sweep: " << consecutive_failures
+                      << " consecutive connect failures (server full or descriptor limit?)" << std::endl;
+            result.truncated = true;
+            break;
+        }
+    }
+
+    pool.closeAll();
+    server.stop();
+    unlink(m_config.unix_socket_path.c_str());
+    return true;
+}
+
+std::string ScaleHarness::toJson(const Config& config, const Result& result) {
+    std::stringstream ss;
+    ss << std::setprecision(3) << std::fixed;
+
+    ss << "{\n";
+    ss << "  \"tool\": \"kairos-scale\",\n";
+    ss << "  \"protocol_version\": " << PROTOCOL_VERSION << ",\n";
+    ss << "  \"config\": {\n";
+    ss << "    \"active_ratio\": " << config.active_ratio << ",\n";
+    ss << "    \"tcp_ratio\": " << config.tcp_ratio << ",\n";
+    ss << "    \"message_rate\": " << config.message_rate << ",\n";
+    ss << "    \"ping_interval_ms\": " << config.ping_interval_ms << ",\n";
+    ss << "    \"target_fps\": " << config.target_fps << ",\n";
+    ss << "    \"network_threads\": " << config.network_threads << ",\n";
+    ss << "    \"duration_seconds\": " << config.duration_seconds << "\n";
+    ss << "  },\n";
+    ss << "  \"truncated\": " << (result.truncated ? "true" : "false") << ",\n";
+    ss << "  \"baseline\":\n";
+    writeStep(ss, result.baseline, true);
+    ss << "  ,\n";
+    ss << "  \"steps\": [\n";
+    for (size_t i = 0; i < result.steps.size(); ++i) {
+        writeStep(ss, result.steps[i], i + 1 == result.steps.size());
+    }
+    ss << "  ]\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+std::string ScaleHarness::toTable(const Config& config, const Result& result) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+
+    ss << "active " << config.active_ratio * 100.0 << "%, tcp " << config.tcp_ratio * 100.0
+       << "%, " << config.message_rate << " msg/s per active connection, "
+       << config.network_threads << " network threads\n\n";
+
+    ss << std::right
+       << std::setw(8) << "conns" << std::setw(8) << "active"
+       << std::setw(8) << "cpu %" << std::setw(11) << "rss MB" << std::setw(10) << "KB/conn"
+       << std::setw(9) << "threads" << std::setw(11) << "accept p50" << std::setw(11) << "accept p99"
+       << std::setw(10) << "rtt p50" << std::setw(10) << "rtt p99" << std::setw(9) << "failed" << "\n";
+    ss << std::string(105, '-') << "\n";
+
+    auto row = [&ss](const StepResult& step) {
+        ss << std::setw(8) << step.connections << std::setw(8) << step.active
+           << std::setw(8) << step.server_cpu_percent
+           << std::setw(11) << step.server_rss_kb / 1024.0
+           << std::setw(10) << step.rss_per_connection_kb
+           << std::setw(9) << step.server_threads
+           << std::setw(11) << step.accept_latency_us.p50
+           << std::setw(11) << step.accept_latency_us.p99
+           << std::setw(10) << step.message_rtt_us.p50
+           << std::setw(10) << step.message_rtt_us.p99
+           << std::setw(9) << step.failed_connects << "\n";
+    };
+
+    row(result.baseline);
+    for (const auto& step : result.steps) {
+        row(step);
+    }
+    if (result.truncated) {
+        ss << "(sweep stopped early)\n";
+    }
+    ss << "latencies in microseconds\n";
+    return ss.str();
+}
+
+} // namespace Kairos::Scale
@@ -0,0 +1,86 @@
+// tools/kairos-scale/ScaleHarness.hpp
+#pragma once
+
+#include "ConnectionPool.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Kairos::Scale {
+
+/**
+ * @brief Connection scalability sweep against a real listening server
+ *
+ * The server runs in a child process (ServerProcess) with the null renderer.
+ * For each step the pool is grown to the step's connection count, split
+ * between Unix and TCP by tcp_ratio and between active and idle by
+ * active_ratio, then measured for duration_seconds. Each step records server
+ * CPU, RSS and thread count from /proc, accept latency of the connections
+ * added in that step, and PING round trips from active connections. The
+ * result is one point per step on each scaling curve.
+ */
+class ScaleHarness {
+public:
+    struct Config {
+        std::vector<uint32_t> steps = {100, 250, 500, 1000, 2000, 4000};
+        double active_ratio = 0.1;          // Fraction of connections sending traffic
+        double tcp_ratio = 0.5;             // Fraction of connections over TCP (rest Unix)
+        uint32_t message_rate = 60;         // Commands per second per active connection
+        uint32_t ping_interval_ms = 100;
+
+        uint32_t settle_seconds = 1;
+        uint32_t duration_seconds = 5;
+
+        uint32_t target_fps = 60;
+        uint32_t network_threads = 2;
+        uint16_t tcp_port = 19180;
+        std::string unix_socket_path;       // Empty = /tmp/kairos_scale_<pid>.sock
+        std::string log_file = "kairos_scale_server.log";
+    };
+
+    struct StepResult {
+        uint32_t target_connections = 0;
+        uint32_t connections = 0;           // Actually open at the end of the step
+        uint32_t active = 0;
+        uint32_t tcp = 0;
+        uint32_t failed_connects = 0;
+        uint64_t disconnects = 0;
+
+        double measured_seconds = 0.0;
+        double server_cpu_percent = 0.0;    // 100 = one core
+        uint64_t server_rss_kb = 0;
+        double rss_per_connection_kb = 0.0; // Growth over the zero-connection baseline
+        uint32_t server_threads = 0;
+
+        double messages_per_second = 0.0;
+        double frame_callbacks_per_second = 0.0;
+        uint64_t send_stalls = 0;
+
+        SampleSet::Summary accept_latency_us;
+        SampleSet::Summary message_rtt_us;
+    };
+
+    struct Result {
+        StepResult baseline;                // No connections
+        std::vector<StepResult> steps;
+        bool truncated = false;             // Stopped early (connect failures or server exit)
+    };
+
+public:
+    ScaleHarness();
+    explicit ScaleHarness(const Config& config);
+
+    bool run(Result& result);
+
+    const Config& getConfig() const { return m_config; }
+
+    // Reporting
+    static std::string toJson(const Config& config, const Result& result);
+    static std::string toTable(const Config& config, const Result& result);
+
+private:
+    Config m_config;
+};
+
+} // namespace Kairos::Scale
@@ -0,0 +1,192 @@
+// tools/kairos-scale/ServerProcess.cpp
+#include "ServerProcess.hpp"
+
+#include <Core/Server.hpp>
+#include <Utils/Config.hpp>
+#include <Utils/Logger.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Kairos::Scale {
+
+ServerProcess::~ServerProcess() {
+    stop();
+}
+
+bool ServerProcess::start(const Config& config) {
+    if (m_pid > 0) {
+        return true;
+    }
+
+    int ready_pipe[2];
+    if (pipe(ready_pipe) != 0) {
+        std::cerr << "pipe failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "fork failed: " << strerror(errno) << std::endl;
+        close(ready_pipe[0]);
+        close(ready_pipe[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(ready_pipe[0]);
+        childMain(config, ready_pipe[1]);
+    }
+
+    close(ready_pipe[1]);
+    m_pid = pid;
+
+    // The child writes one byte once Server::initialize() has returned
+    pollfd pfd{ready_pipe[0], POLLIN, 0};
+    char ready = 0;
+    bool started = poll(&pfd, 1, 15000) == 1 && read(ready_pipe[0], &ready, 1) == 1 && ready == 1;
+    close(ready_pipe[0]);
+
+    if (!started) {
+        std::cerr << "Server process failed to start, see " << config.log_file << std::endl;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void ServerProcess::stop() {
+    if (m_pid <= 0) {
+        return;
+    }
+
+    // SIGTERM goes through Server's own signal handler and a clean shutdown
+    kill(m_pid, SIGTERM);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    int status = 0;
+    while (waitpid(m_pid, &status, WNOHANG) == 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            kill(m_pid, SIGKILL);
+            waitpid(m_pid, &status, 0);
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    m_pid = -1;
+}
+
+bool ServerProcess::isAlive() {
+    if (m_pid <= 0) {
+        return false;
+    }
+    if (waitpid(m_pid, nullptr, WNOHANG) != 0) {
+        m_pid = -1;   // Exited (and now reaped)
+        return false;
+    }
+    return true;
+}
+
+ServerProcess::Sample ServerProcess::sample() const {
+    Sample sample;
+    if (m_pid <= 0) {
+        return sample;
+    }
+
+    std::string proc = "/proc/" + std::to_string(m_pid);
+
+    // /proc/<pid>/stat: the command name may contain spaces, so parse after the last ')'
+    std::ifstream stat_file(proc + "/stat");
+    std::string stat;
+    if (!std::getline(stat_file, stat)) {
+        return sample;
+    }
+    size_t paren = stat.rfind(')');
+    if (paren == std::string::npos) {
+        return sample;
+    }
+
+    std::istringstream fields(stat.substr(paren + 2));
+    std::string field;
+    unsigned long utime = 0;
+    unsigned long stime = 0;
+    long threads = 0;
+    // Field 3 (state) is the first after ')'; utime/stime are 14/15, num_threads is 20
+    for (int index = 3; index <= 20 && fields >> field; ++index) {
+        if (index == 14) utime = std::stoul(field);
+        if (index == 15) stime = std::stoul(field);
+        if (index == 20) threads = std::stol(field);
+    }
+
+    static const long ticks_per_second = sysconf(_SC_CLK_TCK);
+    sample.cpu_seconds = static_cast<double>(utime + stime) / static_cast<double>(ticks_per_second);
+    sample.threads = static_cast<uint32_t>(threads);
+
+    std::ifstream status_file(proc + "/status");
+    std::string line;
+    while (std::getline(status_file, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            sample.rss_kb = std::stoull(line.substr(6));
+            break;
+        }
+    }
+
+    sample.valid = true;
+    return sample;
+}
+
+void ServerProcess::childMain(const Config& config, int ready_fd) {
+    Logger::Config log_config;
+    log_config.log_level = Logger::Level::Warning;
+    log_config.log_to_console = false;
+    log_config.log_to_file = true;
+    log_config.log_file = config.log_file;
+    Logger::initialize(log_config);
+
+    Kairos::Config server_config = ConfigBuilder()
+        .enableTcp(true)
+        .withBindAddress(config.tcp_bind_address)
+        .withTcpPort(config.tcp_port)
+        .enableUnixSocket(true)
+        .withUnixSocket(config.unix_socket_path)
+        .withMaxClients(config.max_clients)
+        .enableNullRenderer(true)
+        .enableVSync(false)
+        .withTargetFPS(config.target_fps)
+        .enableConsoleLogging(false)
+        .build();
+    server_config.performance().network_thread_count = config.network_threads;
+    // Idle connections are the point of the exercise: never time them out
+    server_config.network().client_timeout_seconds = 24 * 60 * 60;
+
+    int exit_code = 0;
+    {
+        Server server(server_config);
+        char ready = server.initialize() ? 1 : 0;
+        ssize_t written = write(ready_fd, &ready, 1);
+        close(ready_fd);
+
+        if (ready && written == 1) {
+            server.run();
+        } else {
+            exit_code = 2;
+        }
+        server.shutdown();
+    }
+
+    Logger::shutdown();
+    // Skip the parent's atexit handlers and static destructors inherited through fork()
+    _exit(exit_code);
+}
+
+} // namespace Kairos::Scale
@@ -0,0 +1,61 @@
+// tools/kairos-scale/ServerProcess.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <sys/types.h>
+
+namespace Kairos::Scale {
+
+/**
+ * @brief Kairos server running in a forked child process
+ *
+ * Keeping the server in its own process means /proc/<pid> reports only
+ * server CPU time, resident memory and thread count; the thousands of client
+ * sockets driven by the harness are not charged to it. The child uses the
+ * null renderer and listens on both a Unix socket and TCP.
+ */
+class ServerProcess {
+public:
+    struct Config {
+        std::string unix_socket_path;
+        std::string tcp_bind_address = "127.0.0.1";
+        uint16_t tcp_port = 19180;
+        uint32_t max_clients = 1000;
+        uint32_t network_threads = 2;
+        uint32_t target_fps = 60;
+        std::string log_file = "kairos_scale_server.log";
+    };
+
+    struct Sample {
+        bool valid = false;
+        double cpu_seconds = 0.0;       // utime + stime
+        uint64_t rss_kb = 0;
+        uint32_t threads = 0;
+    };
+
+public:
+    ServerProcess() = default;
+    ~ServerProcess();
+
+    ServerProcess(const ServerProcess&) = delete;
+    ServerProcess& operator=(const ServerProcess&) = delete;
+
+    // Forks and waits until the child reports that both listeners are up
+    bool start(const Config& config);
+    void stop();
+
+    bool isAlive();
+    pid_t getPid() const { return m_pid; }
+
+    Sample sample() const;
+
+private:
+    [[noreturn]] static void childMain(const Config& config, int ready_fd);
+
+private:
+    pid_t m_pid = -1;
+};
+
+} // namespace Kairos::Scale
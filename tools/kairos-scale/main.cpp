@@ -0,0 +1,167 @@
+// tools/kairos-scale/main.cpp
+#include "ScaleHarness.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace Kairos::Scale;
+
+namespace {
+
+struct Options {
+    ScaleHarness::Config harness;
+    std::string output_file;
+    bool print_table = true;
+};
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n\n";
+    std::cout << "Starts the server in a child process (null renderer, Unix + TCP listeners),\n";
+    std::cout << "opens a growing number of real client connections and records server CPU,\n";
+    std::cout << "memory, accept latency and message round trips at each step as JSON.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --steps <n,n,...>        Connection counts to measure (default: 100,250,500,1000,2000,4000)\n";
+    std::cout << "  --active-ratio <0..1>    Fraction of connections sending traffic (default: 0.1)\n";
+    std::cout << "  --tcp-ratio <0..1>       Fraction of connections over TCP, rest Unix (default: 0.5)\n";
+    std::cout << "  --rate <msgs>            Commands per second per active connection (default: 60)\n";
+    std::cout << "  --ping-interval <ms>     PING interval per active connection, 0 = off (default: 100)\n";
+    std::cout << "  --settle <seconds>       Unmeasured time after each ramp (default: 1)\n";
+    std::cout << "  --duration <seconds>     Measured time per step (default: 5)\n";
+    std::cout << "  --fps <fps>              Server target FPS (default: 60)\n";
+    std::cout << "  --network-threads <n>    Server network threads (default: 2)\n";
+    std::cout << "  --port <port>            TCP port for the server (default: 19180)\n";
+    std::cout << "  --socket <path>          Unix socket path (default: /tmp/kairos_scale_<pid>.sock)\n";
+    std::cout << "  --output <file>          Write JSON results to <file> (default: stdout)\n";
+    std::cout << "  --log-file <path>        Server log file (default: kairos_scale_server.log)\n";
+    std::cout << "  --quiet                  Do not print the summary table to stderr\n";
+    std::cout << "  --help                   Show this help message\n";
+}
+
+std::vector<uint32_t> parseSteps(const std::string& text) {
+    std::vector<uint32_t> steps;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            steps.push_back(static_cast<uint32_t>(std::stoul(item)));
+        }
+    }
+    return steps;
+}
+
+bool parseCommandLine(int argc, char* argv[], Options& options) {
+    auto& harness = options.harness;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--steps" && i + 1 < argc) {
+            harness.steps = parseSteps(argv[++i]);
+        } else if (arg == "--active-ratio" && i + 1 < argc) {
+            harness.active_ratio = std::stod(argv[++i]);
+        } else if (arg == "--tcp-ratio" && i + 1 < argc) {
+            harness.tcp_ratio = std::stod(argv[++i]);
+        } else if (arg == "--rate" && i + 1 < argc) {
+            harness.message_rate = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--ping-interval" && i + 1 < argc) {
+            harness.ping_interval_ms = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--settle" && i + 1 < argc) {
+            harness.settle_seconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--duration" && i + 1 < argc) {
+            harness.duration_seconds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--fps" && i + 1 < argc) {
+            harness.target_fps = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--network-threads" && i + 1 < argc) {
+            harness.network_threads = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--port" && i + 1 < argc) {
+            harness.tcp_port = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (arg == "--socket" && i + 1 < argc) {
+            harness.unix_socket_path = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output_file = argv[++i];
+        } else if (arg == "--log-file" && i + 1 < argc) {
+            harness.log_file = argv[++i];
+        } else if (arg == "--quiet") {
+            options.print_table = false;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Raises the descriptor limit; both processes need one per connection
+ */
+void raiseDescriptorLimit(uint32_t connections) {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return;
+    }
+
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+
+    rlim_t needed = static_cast<rlim_t>(connections) + 64;
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+        std::cerr << "Warning: descriptor limit " << limit.rlim_cur << " is below the " << needed
+                  << " needed; raise it with ulimit -n or the sweep will stop early" << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        if (!parseCommandLine(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // No Logger in this process: the forked server child owns logging
+    ScaleHarness harness(options.harness);
+    if (!harness.getConfig().steps.empty()) {
+        raiseDescriptorLimit(harness.getConfig().steps.back());
+    }
+
+    ScaleHarness::Result result;
+    if (!harness.run(result)) {
+        std::cerr << "Scalability run failed, see " << harness.getConfig().log_file << std::endl;
+        return 1;
+    }
+
+    if (options.print_table) {
+        std::cerr << "\n" << ScaleHarness::toTable(harness.getConfig(), result) << std::endl;
+    }
+
+    std::string json = ScaleHarness::toJson(harness.getConfig(), result);
+    if (options.output_file.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_file);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open output file: " << options.output_file << std::endl;
+            return 1;
+        }
+        file << json;
+        std::cerr << "Results written to " << options.output_file << std::endl;
+    }
+
+    return 0;
+}